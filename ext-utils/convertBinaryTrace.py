@@ -0,0 +1,90 @@
+#!/usr/bin/env python
+#
+# Copyright (c) 2013 Magister Solutions Ltd
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License version 2 as
+# published by the Free Software Foundation;
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+#
+
+"""
+Converts a binary output trace file written with the EnableBinaryOutput
+attribute of the satellite trace containers into the text trace files, one
+file per key, in the same layout as written without binary output.
+
+Usage: convertBinaryTrace.py <binary trace file> [output directory]
+"""
+
+import os
+import struct
+import sys
+
+COLUMN_TYPE_DOUBLE = 1
+
+
+def read(f, fmt):
+    data = f.read(struct.calcsize(fmt))
+    if len(data) != struct.calcsize(fmt):
+        raise IOError("unexpected end of file")
+    return struct.unpack(fmt, data)
+
+
+def convert(fileName, outputDir):
+    with open(fileName, "rb") as f:
+        if f.read(8) != b"SATTRACE":
+            raise IOError("not a binary trace file: " + fileName)
+
+        version, columns = read(f, "=II")
+        if version != 1:
+            raise IOError("unsupported format version %d" % version)
+
+        columnTypes = read(f, "=%dB" % columns)
+        if any(t != COLUMN_TYPE_DOUBLE for t in columnTypes):
+            raise IOError("unsupported column type")
+
+        f.seek(-16, os.SEEK_END)
+        indexOffset, = read(f, "=Q")
+        if f.read(8) != b"SATINDEX":
+            raise IOError("index not found, the file was not closed properly")
+
+        f.seek(indexOffset)
+        numOfKeys, = read(f, "=I")
+        index = []
+        for i in range(numOfKeys):
+            length, = read(f, "=I")
+            key = f.read(length).decode()
+            offset, rows = read(f, "=QQ")
+            index.append((key, offset, rows))
+
+        for key, offset, rows in index:
+            f.seek(offset)
+            storedRows, = read(f, "=Q")
+            if storedRows != rows:
+                raise IOError("corrupted block for " + key)
+
+            values = [read(f, "=%dd" % rows) if rows > 0 else () for c in range(columns)]
+
+            with open(os.path.join(outputDir, key), "w") as out:
+                for r in range(rows):
+                    # same formatting as the default C++ stream output of a double
+                    out.write("\t".join("%g" % values[c][r] for c in range(columns)) + "\n")
+
+            print("%s: %d rows" % (key, rows))
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 2 or len(sys.argv) > 3:
+        print(__doc__)
+        sys.exit(1)
+
+    outputDir = sys.argv[2] if len(sys.argv) == 3 else os.path.dirname(os.path.abspath(sys.argv[1]))
+    convert(sys.argv[1], outputDir)
@@ -0,0 +1,104 @@
+#!/usr/bin/env python
+#
+# Copyright (c) 2013 Magister Solutions Ltd
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License version 2 as
+# published by the Free Software Foundation;
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+#
+
+
+"""
+Decodes a binary packet trace written with the BinaryFormat attribute of
+SatPacketTrace into the same text format as written without binary format.
+
+Usage: decodePacketTrace.py <binary packet trace file> [output file]
+"""
+
+import os
+import struct
+import sys
+
+HEADER = ("COLUMN DESCRIPTIONS\n"
+          "-------------------\n"
+          "Time\n"
+          "Packet event (SND, RCV, DRP, ENQ)\n"
+          "Node type (UT, SAT, GW, NCC, TER)\n"
+          "Node id\n"
+          "MAC address\n"
+          "Log level (ND, LLC, MAC, PHY, CH)\n"
+          "Link direction (FWD, RTN)\n"
+          "Packet info (List of: Packet id, source MAC address, destination MAC address)\n"
+          "-------------------\n\n")
+
+# time, event, node type, node id, MAC address, log level, link direction, packet info length
+RECORD = struct.Struct("=dBBI6sBBH")
+
+
+def read(f, fmt):
+    data = f.read(struct.calcsize(fmt))
+    if len(data) != struct.calcsize(fmt):
+        raise IOError("unexpected end of file")
+    return struct.unpack(fmt, data)
+
+
+def readNames(f):
+    count, = read(f, "=B")
+    names = []
+    for i in range(count):
+        length, = read(f, "=B")
+        names.append(f.read(length).decode())
+    return names
+
+
+def decode(fileName, out):
+    with open(fileName, "rb") as f:
+        if f.read(8) != b"SATPKTTR":
+            raise IOError("not a binary packet trace file: " + fileName)
+
+        version, = read(f, "=I")
+        if version != 1:
+            raise IOError("unsupported format version %d" % version)
+
+        events = readNames(f)
+        nodeTypes = readNames(f)
+        logLevels = readNames(f)
+        linkDirs = readNames(f)
+
+        out.write(HEADER)
+
+        while True:
+            data = f.read(RECORD.size)
+            if not data:
+                break
+            if len(data) != RECORD.size:
+                raise IOError("truncated record at the end of file")
+
+            time, event, nodeType, nodeId, mac, level, linkDir, infoLength = RECORD.unpack(data)
+            info = f.read(infoLength).decode()
+
+            # same formatting as the default C++ stream output of a double and a Mac48Address
+            out.write("%g %s %s %d %s %s %s %s\n" % (time, events[event], nodeTypes[nodeType], nodeId,
+                                                     ":".join("%02x" % b for b in bytearray(mac)),
+                                                     logLevels[level], linkDirs[linkDir], info))
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 2 or len(sys.argv) > 3:
+        print(__doc__)
+        sys.exit(1)
+
+    if len(sys.argv) == 3:
+        with open(sys.argv[2], "w") as out:
+            decode(sys.argv[1], out)
+    else:
+        decode(sys.argv[1], sys.stdout)
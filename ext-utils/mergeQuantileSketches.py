@@ -0,0 +1,131 @@
+#!/usr/bin/env python
+#
+# Copyright (c) 2013 Magister Solutions Ltd
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License version 2 as
+# published by the Free Software Foundation;
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+#
+
+
+"""
+Merges the quantile sketch files (*-quantile-sketch.txt) written by the
+QUANTILE_FILE statistics of several simulation replications, and prints the
+percentiles of the merged sketches in the same format as the quantile files.
+
+Usage: mergeQuantileSketches.py <sketch file> [<sketch file> ...]
+"""
+
+import math
+import sys
+
+QUANTILES = [0.5, 0.95, 0.99, 0.999]
+
+
+class Sketch(object):
+    def __init__(self, fields):
+        self.accuracy = float(fields[0])
+        self.count = int(fields[1])
+        self.min = float(fields[2])
+        self.max = float(fields[3])
+        self.zero = int(fields[4])
+        pos = 5
+        self.positive, pos = self.readBuckets(fields, pos)
+        self.negative, pos = self.readBuckets(fields, pos)
+        self.gamma = (1.0 + self.accuracy) / (1.0 - self.accuracy)
+
+    @staticmethod
+    def readBuckets(fields, pos):
+        offset, n = int(fields[pos]), int(fields[pos + 1])
+        buckets = {}
+        for i in range(n):
+            count = int(fields[pos + 2 + i])
+            if count > 0:
+                buckets[offset + i] = count
+        return buckets, pos + 2 + n
+
+    def merge(self, other):
+        if other.accuracy != self.accuracy:
+            raise ValueError("only sketches with the same relative accuracy can be merged")
+        if other.count == 0:
+            return
+        if self.count == 0:
+            self.min, self.max = other.min, other.max
+        else:
+            self.min, self.max = min(self.min, other.min), max(self.max, other.max)
+        for mine, theirs in ((self.positive, other.positive), (self.negative, other.negative)):
+            for index, count in theirs.items():
+                mine[index] = mine.get(index, 0) + count
+        self.zero += other.zero
+        self.count += other.count
+
+    def value(self, index):
+        return 2.0 * math.pow(self.gamma, index) / (self.gamma + 1.0)
+
+    def quantile(self, q):
+        # Same estimate as SatStatsQuantileSketch::GetQuantile ()
+        if self.count == 0:
+            return 0.0
+        rank = int(q * (self.count - 1))
+        n = 0
+        value = None
+        for index in sorted(self.negative, reverse=True):
+            n += self.negative[index]
+            if n > rank:
+                value = -self.value(index)
+                break
+        if value is None:
+            n += self.zero
+            if n > rank:
+                value = 0.0
+        if value is None:
+            for index in sorted(self.positive):
+                n += self.positive[index]
+                if n > rank:
+                    value = self.value(index)
+                    break
+        return max(self.min, min(self.max, value))
+
+
+def merge(fileNames):
+    heading = None
+    sketches = {}
+    for fileName in fileNames:
+        with open(fileName) as f:
+            for line in f:
+                if line.startswith("%"):
+                    heading = heading or line.rstrip("\n")
+                    continue
+                fields = line.split()
+                if not fields:
+                    continue
+                identifier = int(fields[0])
+                sketch = Sketch(fields[1:])
+                if identifier in sketches:
+                    sketches[identifier].merge(sketch)
+                else:
+                    sketches[identifier] = sketch
+
+    if heading:
+        print(heading)
+    for identifier in sorted(sketches):
+        sketch = sketches[identifier]
+        print(" ".join([str(identifier), str(sketch.count)] +
+                       ["%g" % sketch.quantile(q) for q in QUANTILES]))
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 2:
+        print(__doc__)
+        sys.exit(1)
+
+    merge(sys.argv[1:])
@@ -85,7 +85,9 @@ SatBeamHelper::GetTypeId (void)
                    MakeEnumAccessor (&SatBeamHelper::m_raInterferenceModel),
                    MakeEnumChecker (SatPhyRxCarrierConf::IF_CONSTANT, "Constant",
                                     SatPhyRxCarrierConf::IF_TRACE, "Trace",
-                                    SatPhyRxCarrierConf::IF_PER_PACKET, "PerPacket"))
+                                    SatPhyRxCarrierConf::IF_PER_PACKET, "PerPacket",
+                                    SatPhyRxCarrierConf::IF_PER_PACKET_TIMELINE, "PerPacketTimeline",
+                                    SatPhyRxCarrierConf::IF_SLOT_SYNCHRONOUS, "SlotSynchronous"))
     .AddAttribute ("RaCollisionModel",
                    "Collision model for random access",
                    EnumValue (SatPhyRxCarrierConf::RA_COLLISION_CHECK_AGAINST_SINR),
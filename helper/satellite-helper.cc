@@ -18,6 +18,7 @@
  * Author: Sami Rantanen <sami.rantanen@magister.fi>
  */
 
+#include "ns3/boolean.h"
 #include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/names.h"
@@ -32,6 +33,8 @@
 #include "ns3/ipv4-routing-table-entry.h"
 #include "../model/satellite-position-allocator.h"
 #include "../model/satellite-rtn-link-time.h"
+#include "../model/satellite-id-mapper.h"
+#include "../model/satellite-fading-external-input-trace-container.h"
 #include "satellite-helper.h"
 #include "../model/satellite-log.h"
 #include "ns3/singleton.h"
@@ -524,6 +527,8 @@ SatHelper::DoCreateScenario (BeamUserInfoMap_t& beamInfos, uint32_t gwUsers)
 
       m_userHelper->InstallGw (m_beamHelper->GetGwNodes (), gwUsers);
 
+      CreateExternalFadingTraces ();
+
       if (m_packetTraces)
         {
           EnablePacketTrace ();
@@ -635,6 +640,61 @@ SatHelper::InstallMobilityObserver (NodeContainer nodes) const
     }
 }
 
+void
+SatHelper::CreateExternalFadingTraces () const
+{
+  NS_LOG_FUNCTION (this);
+
+  // the traces are needed only if enabled by the SatChannel attribute default value
+  TypeId::AttributeInformation info;
+  Ptr<const BooleanValue> enabled;
+
+  if (TypeId::LookupByName ("ns3::SatChannel").LookupAttributeByName ("EnableExternalFadingInputTrace", &info))
+    {
+      enabled = DynamicCast<const BooleanValue> (info.initialValue);
+    }
+
+  if (enabled == NULL || !enabled->Get ())
+    {
+      return;
+    }
+
+  SatFadingExternalInputTraceContainer::NodeMobilityMap_t uts;
+  SatFadingExternalInputTraceContainer::NodeMobilityMap_t gws;
+
+  NodeContainer utNodes = m_beamHelper->GetUtNodes ();
+
+  for ( NodeContainer::Iterator i = utNodes.Begin ();  i != utNodes.End (); i++ )
+    {
+      for (uint32_t j = 0; j < (*i)->GetNDevices (); j++)
+        {
+          int32_t utId = Singleton<SatIdMapper>::Get ()->GetUtIdWithMac ((*i)->GetDevice (j)->GetAddress ());
+
+          if (utId >= 0)
+            {
+              uts[utId] = (*i)->GetObject<MobilityModel> ();
+            }
+        }
+    }
+
+  NodeContainer gwNodes = m_beamHelper->GetGwNodes ();
+
+  for ( NodeContainer::Iterator i = gwNodes.Begin ();  i != gwNodes.End (); i++ )
+    {
+      for (uint32_t j = 0; j < (*i)->GetNDevices (); j++)
+        {
+          int32_t gwId = Singleton<SatIdMapper>::Get ()->GetGwIdWithMac ((*i)->GetDevice (j)->GetAddress ());
+
+          if (gwId >= 0)
+            {
+              gws[gwId] = (*i)->GetObject<MobilityModel> ();
+            }
+        }
+    }
+
+  Singleton<SatFadingExternalInputTraceContainer>::Get ()->CreateFadingTraces (uts, gws);
+}
+
 void
 SatHelper::SetMulticastGroupRoutes (Ptr<Node> source, NodeContainer receivers, Ipv4Address sourceAddress, Ipv4Address groupAddress)
 {
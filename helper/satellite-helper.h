@@ -401,6 +401,12 @@ private:
    */
   void InstallMobilityObserver (NodeContainer nodes) const;
 
+  /**
+   * Create the external fading traces of all the UTs and GWs at once, if
+   * external fading input traces are enabled in SatChannel.
+   */
+  void CreateExternalFadingTraces () const;
+
   /**
    * Find given device's counterpart (device belonging to same network) device from given node.
    *
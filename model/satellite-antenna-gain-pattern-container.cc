@@ -67,6 +67,42 @@ SatAntennaGainPatternContainer::SatAntennaGainPatternContainer ()
           NS_FATAL_ERROR (this << " an antenna pattern for beam " << i << " already exists!");
         }
     }
+
+  BuildMultiBeamGains ();
+}
+
+void
+SatAntennaGainPatternContainer::BuildMultiBeamGains ()
+{
+  NS_LOG_FUNCTION (this);
+
+  Ptr<SatAntennaGainPattern> reference = m_antennaPatternMap.at (1);
+
+  for (gpIterator it = m_antennaPatternMap.begin (); it != m_antennaPatternMap.end (); ++it)
+    {
+      if (!reference->HasSameGrid (it->second))
+        {
+          NS_LOG_INFO (this << " antenna pattern of beam " << it->first << " uses a different grid, gains are interpolated per beam");
+          m_multiBeamGains.clear ();
+          return;
+        }
+    }
+
+  const uint32_t numOfBeams = m_antennaPatternMap.size ();
+  const uint32_t numOfGridPoints = reference->GetNumOfGridPoints ();
+
+  m_multiBeamGains.resize (numOfGridPoints * numOfBeams);
+
+  // Note, that the beam ids start from 1
+  for (gpIterator it = m_antennaPatternMap.begin (); it != m_antennaPatternMap.end (); ++it)
+    {
+      const double* grid = it->second->GetAntennaGainGrid_lin ();
+
+      for (uint32_t i = 0; i < numOfGridPoints; ++i)
+        {
+          m_multiBeamGains[i * numOfBeams + it->first - 1] = grid[i];
+        }
+    }
 }
 
 Ptr<SatAntennaGainPattern>
@@ -92,9 +128,12 @@ SatAntennaGainPatternContainer::GetBestBeamId (GeoCoordinate coord) const
   double bestGain (-100.0);
   uint32_t bestId (0);
 
+  std::vector<double> gains;
+  GetAntennaGains_lin (coord, gains);
+
   for (uint32_t i = 1; i <= NUMBER_OF_BEAMS; ++i)
     {
-      double gain = m_antennaPatternMap.at (i)->GetAntennaGain_lin (coord);
+      double gain = gains[i - 1];
 
       // The antenna pattern has returned a NAN gain. This means
       // that this position is not valid. Return 0, which is not a valid beam id.
@@ -112,4 +151,50 @@ SatAntennaGainPatternContainer::GetBestBeamId (GeoCoordinate coord) const
   return bestId;
 }
 
+void
+SatAntennaGainPatternContainer::GetAntennaGains_lin (GeoCoordinate coord, std::vector<double>& gains) const
+{
+  NS_LOG_FUNCTION (this << coord.GetLatitude () << coord.GetLongitude ());
+
+  const uint32_t numOfBeams = m_antennaPatternMap.size ();
+  gains.resize (numOfBeams);
+
+  if (m_multiBeamGains.empty ())
+    {
+      for (gpIterator it = m_antennaPatternMap.begin (); it != m_antennaPatternMap.end (); ++it)
+        {
+          SatAntennaGainPattern::InterpolationPoint_s point = it->second->GetInterpolationPoint (coord);
+          const double* grid = it->second->GetAntennaGainGrid_lin ();
+
+          gains[it->first - 1] =
+            point.upperLatShare * (point.upperLonShare * grid[point.lowerLeftIndex] + point.lowerLonShare * grid[point.lowerLeftIndex + 1]) +
+            point.lowerLatShare * (point.upperLonShare * grid[point.upperLeftIndex] + point.lowerLonShare * grid[point.upperLeftIndex + 1]);
+        }
+      return;
+    }
+
+  // All the beams share the same grid, thus the interpolation point is the same
+  SatAntennaGainPattern::InterpolationPoint_s point = m_antennaPatternMap.at (1)->GetInterpolationPoint (coord);
+
+  /**
+   * The gains of the four grid points are stored beam-innermost, thus the
+   * interpolation is done for all the beams with contiguous memory accesses.
+   * The loop has no dependencies between the beams, which allows the compiler
+   * to vectorize it. NaN gains of the invalid grid points propagate to the
+   * interpolated gain.
+   */
+  const double* g11 = &m_multiBeamGains[point.lowerLeftIndex * numOfBeams];
+  const double* g12 = g11 + numOfBeams;
+  const double* g21 = &m_multiBeamGains[point.upperLeftIndex * numOfBeams];
+  const double* g22 = g21 + numOfBeams;
+  double* out = &gains[0];
+
+  for (uint32_t i = 0; i < numOfBeams; ++i)
+    {
+      double valLatLower = point.upperLonShare * g11[i] + point.lowerLonShare * g12[i];
+      double valLatUpper = point.upperLonShare * g21[i] + point.lowerLonShare * g22[i];
+      out[i] = point.upperLatShare * valLatLower + point.lowerLatShare * valLatUpper;
+    }
+}
+
 } // namespace ns3
@@ -21,6 +21,8 @@
 #ifndef SATELLITE_ANTENNA_GAIN_PATTERN_CONTAINER_H_
 #define SATELLITE_ANTENNA_GAIN_PATTERN_CONTAINER_H_
 
+#include <vector>
+#include <map>
 #include "satellite-antenna-gain-pattern.h"
 #include "geo-coordinate.h"
 
@@ -36,6 +38,11 @@ namespace ns3 {
  * Each antenna gain pattern is stored in a separate class
  * SatAntennaGainPattern. The best beam may be chosen based on
  * the antenna patterns by using GetBestBeamId for a given position.
+ *
+ * If all the antenna patterns share the same latitude-longitude grid, the
+ * container holds additionally all the gains in one contiguous beam-innermost
+ * array in linear format, so that the gains of all the beams for a certain
+ * position may be interpolated with one pass (see GetAntennaGains_lin).
  */
 class SatAntennaGainPatternContainer : public Object
 {
@@ -75,6 +82,21 @@ public:
    */
   uint32_t GetBestBeamId (GeoCoordinate coord) const;
 
+  /**
+   * \brief Get the antenna gains of all the beams in a specified geo coordinate.
+   * Invalid gains (i.e. the position is not covered by the antenna pattern of
+   * the beam) are NaN.
+   * \param coord Geo coordinate
+   * \param gains Container for the gains in linear format, indexed by beam id - 1
+   */
+  void GetAntennaGains_lin (GeoCoordinate coord, std::vector<double>& gains) const;
+
+  /**
+   * \brief Get the number of antenna patterns (beams) in the container
+   * \return Number of beams
+   */
+  inline uint32_t GetNumOfBeams () const { return m_antennaPatternMap.size (); }
+
 private:
   /**
    * \brief Definition of number of beams (72-beam reference scenario).
@@ -88,6 +110,20 @@ private:
    */
   std::map< uint32_t, Ptr<SatAntennaGainPattern> > m_antennaPatternMap;
 
+  /**
+   * \brief Build the multi-beam gain array, if all the antenna patterns share
+   * the same grid.
+   */
+  void BuildMultiBeamGains ();
+
+  /**
+   * Gains of all the beams in linear format. Index is
+   * gridPointIndex * number of beams + (beam id - 1), where the grid point index
+   * follows SatAntennaGainPattern::GetAntennaGainGrid_lin. Empty, if the antenna
+   * patterns do not share the same grid.
+   */
+  std::vector<double> m_multiBeamGains;
+
 };
 
 } // namespace ns3
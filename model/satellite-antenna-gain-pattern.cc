@@ -19,8 +19,18 @@
  */
 
 #include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
 #include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "ns3/double.h"
+#include "ns3/boolean.h"
+#include "ns3/string.h"
 #include "ns3/log.h"
 #include "satellite-utils.h"
 #include "satellite-antenna-gain-pattern.h"
@@ -45,6 +55,15 @@ SatAntennaGainPattern::GetTypeId (void)
                    DoubleValue (48.0),
                    MakeDoubleAccessor (&SatAntennaGainPattern::m_minAcceptableAntennaGainInDb),
                    MakeDoubleChecker<double> ())
+    .AddAttribute ("EnableBinaryCache", "Enable the binary cache file of the parsed antenna pattern",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&SatAntennaGainPattern::m_enableBinaryCache),
+                   MakeBooleanChecker ())
+    .AddAttribute ("BinaryCacheDirectory", "Directory of the binary antenna pattern cache files. "
+                   "If empty, the directory given by the TMPDIR environment variable or /tmp is used.",
+                   StringValue (""),
+                   MakeStringAccessor (&SatAntennaGainPattern::m_binaryCacheDirectory),
+                   MakeStringChecker ())
   ;
   return tid;
 }
@@ -58,8 +77,19 @@ SatAntennaGainPattern::GetInstanceTypeId (void) const
 
 SatAntennaGainPattern::SatAntennaGainPattern ()
   : m_antennaPattern (),
+    m_validGridPoints (),
     m_validPositions (),
+    m_validCells (),
     m_minAcceptableAntennaGainInDb (40.0),
+    m_enableBinaryCache (false),
+    m_binaryCacheDirectory (),
+    m_gains (0),
+    m_validMask (0),
+    m_validPositionData (0),
+    m_numOfGridPoints (0),
+    m_numOfValidPositions (0),
+    m_cacheData (0),
+    m_cacheSize (0),
     m_uniformRandomVariable (),
     m_latitudes (),
     m_longitudes (),
@@ -75,7 +105,14 @@ SatAntennaGainPattern::SatAntennaGainPattern ()
 }
 
 SatAntennaGainPattern::SatAntennaGainPattern (std::string filePathName)
-  : m_nanStrings (m_nanStringArray, m_nanStringArray + (sizeof m_nanStringArray / sizeof m_nanStringArray[0]))
+  : m_gains (0),
+    m_validMask (0),
+    m_validPositionData (0),
+    m_numOfGridPoints (0),
+    m_numOfValidPositions (0),
+    m_cacheData (0),
+    m_cacheSize (0),
+    m_nanStrings (m_nanStringArray, m_nanStringArray + (sizeof m_nanStringArray / sizeof m_nanStringArray[0]))
 {
   // Attributes are needed already in construction phase:
   // - ConstructSelf call in constructor
@@ -83,9 +120,18 @@ SatAntennaGainPattern::SatAntennaGainPattern (std::string filePathName)
   ObjectBase::ConstructSelf (AttributeConstructionList ());
 
   ReadAntennaPatternFromFile (filePathName);
+  BuildValidCells ();
   m_uniformRandomVariable = CreateObject<UniformRandomVariable> ();
 }
 
+SatAntennaGainPattern::~SatAntennaGainPattern ()
+{
+  if (m_cacheData != 0)
+    {
+      munmap (m_cacheData, m_cacheSize);
+    }
+}
+
 
 void SatAntennaGainPattern::ReadAntennaPatternFromFile (std::string filePathName)
 {
@@ -107,8 +153,27 @@ void SatAntennaGainPattern::ReadAntennaPatternFromFile (std::string filePathName
         }
     }
 
-  // Row vector containing all the gain values for a certain latitude
-  std::vector<double> rowVector;
+  uint64_t sourceSize (0);
+  uint64_t sourceChecksum (0);
+  std::string cacheFilePathName;
+
+  if (m_enableBinaryCache)
+    {
+      cacheFilePathName = GetCacheFilePathName (m_binaryCacheDirectory, filePathName);
+
+      if (!CalculateFileChecksum (filePathName, sourceSize, sourceChecksum))
+        {
+          NS_FATAL_ERROR ("The file " << filePathName << " cannot be read.");
+        }
+
+      if (ReadAntennaPatternFromCache (cacheFilePathName, sourceSize, sourceChecksum))
+        {
+          NS_LOG_INFO (this << " antenna pattern read from cache file " << cacheFilePathName);
+          ifs->close ();
+          delete ifs;
+          return;
+        }
+    }
 
   // Start conditions
   double lat, lon, gainDouble;
@@ -133,6 +198,7 @@ void SatAntennaGainPattern::ReadAntennaPatternFromFile (std::string filePathName
       if (find (m_nanStrings.begin (), m_nanStrings.end (), gainString) != m_nanStrings.end ())
         {
           gainDouble = NAN;
+          m_validGridPoints.push_back (0);
         }
       else
         {
@@ -142,8 +208,10 @@ void SatAntennaGainPattern::ReadAntennaPatternFromFile (std::string filePathName
           // above a specified threshold.
           if ( gainDouble >= m_minAcceptableAntennaGainInDb )
             {
-              m_validPositions.push_back (std::make_pair (lat, lon));
+              m_validPositions.push_back (lat);
+              m_validPositions.push_back (lon);
             }
+          m_validGridPoints.push_back (1);
         }
 
       // Collect the valid latitude values
@@ -176,28 +244,20 @@ void SatAntennaGainPattern::ReadAntennaPatternFromFile (std::string filePathName
         }
 
       // If this is the first gain entry
-      if (rowVector.empty ())
+      if (m_antennaPattern.empty ())
         {
           m_minLat = lat;
           m_minLon = lon;
-          rowVector.push_back (gainDouble);
         }
-      // We are still in the same row (= latitude)
-      else if (lat == m_maxLat)
+      // Latitude changed, the previous row has to be complete
+      else if (lat != m_maxLat)
         {
-          rowVector.push_back (gainDouble);
-        }
-      // Latitude changed
-      // - Store the vector
-      // - Clean-up
-      // - Start from another row
-      else
-        {
-          m_antennaPattern.push_back (rowVector);
-          rowVector.clear ();
-          rowVector.push_back (gainDouble);
+          NS_ASSERT ( m_antennaPattern.size () == (m_latitudes.size () - 1) * m_longitudes.size ());
         }
 
+      // Change the gains to linear values, because the interpolation is done in linear domain.
+      m_antennaPattern.push_back (SatUtils::DbToLinear (gainDouble));
+
       // Update the maximum values
       m_maxLat = lat;
       m_maxLon = lon;
@@ -206,63 +266,311 @@ void SatAntennaGainPattern::ReadAntennaPatternFromFile (std::string filePathName
       *ifs >> lat >> lon >> gainString;
     }
 
-  // At this point, the last row should not be stored, since the storing
-  // happens every time the row changes. I.e. the last row is stored here!
-  NS_ASSERT ( rowVector.size () == m_longitudes.size ());
-
-  m_antennaPattern.push_back (rowVector);
-  rowVector.clear ();
+  // All the rows (including the last one) have to be complete
+  NS_ASSERT ( m_antennaPattern.size () == m_latitudes.size () * m_longitudes.size ());
 
   ifs->close ();
   delete ifs;
+
+  // Lookups are served from the parsed containers
+  m_gains = &m_antennaPattern[0];
+  m_validMask = &m_validGridPoints[0];
+  m_validPositionData = m_validPositions.empty () ? 0 : &m_validPositions[0];
+  m_numOfGridPoints = m_antennaPattern.size ();
+  m_numOfValidPositions = m_validPositions.size () / 2;
+
+  if (m_enableBinaryCache)
+    {
+      WriteAntennaPatternToCache (cacheFilePathName, sourceSize, sourceChecksum);
+    }
 }
 
+std::string
+SatAntennaGainPattern::GetCacheFilePathName (std::string cacheDirectory, std::string filePathName)
+{
+  NS_LOG_FUNCTION (cacheDirectory << filePathName);
+
+  std::string directory = cacheDirectory;
 
-GeoCoordinate SatAntennaGainPattern::GetValidRandomPosition () const
+  if (directory.empty ())
+    {
+      const char *tmpDir = getenv ("TMPDIR");
+      directory = (tmpDir != NULL && *tmpDir != '\0') ? tmpDir : "/tmp";
+    }
+
+  std::string::size_type pos = filePathName.find_last_of ('/');
+  std::string fileName = (pos == std::string::npos) ? filePathName : filePathName.substr (pos + 1);
+
+  /**
+   * Antenna pattern files of the same name in different directories must not
+   * share a cache file, thus a hash of the canonical source path is added to
+   * the name of the cache file.
+   */
+  std::string canonicalPathName = filePathName;
+  char *resolvedPath = realpath (filePathName.c_str (), NULL);
+
+  if (resolvedPath != NULL)
+    {
+      canonicalPathName = resolvedPath;
+      free (resolvedPath);
+    }
+
+  // 64-bit FNV-1a hash
+  const uint64_t fnvPrime = 1099511628211ULL;
+  uint64_t pathHash = 14695981039346656037ULL;
+
+  for (std::string::const_iterator it = canonicalPathName.begin (); it != canonicalPathName.end (); ++it)
+    {
+      pathHash ^= static_cast<uint8_t> (*it);
+      pathHash *= fnvPrime;
+    }
+
+  std::ostringstream ss;
+  ss << directory << "/" << fileName << "." << std::hex << std::setw (16) << std::setfill ('0') << pathHash << ".cache";
+
+  return ss.str ();
+}
+
+bool
+SatAntennaGainPattern::CalculateFileChecksum (std::string filePathName, uint64_t& size, uint64_t& checksum)
 {
-  NS_LOG_FUNCTION (this);
+  NS_LOG_FUNCTION (filePathName);
 
-  uint32_t numPosGridPoints = m_validPositions.size ();
-  uint32_t ind (0);
-  std::pair<double, double> lowerLeftCoord;
+  std::ifstream ifs (filePathName.c_str (), std::ifstream::in | std::ifstream::binary);
 
-  while (1)
+  if (!ifs.is_open ())
     {
-      // Get random position (=lower left corner of a grid) from the valid ones
-      ind = m_uniformRandomVariable->GetInteger (0, numPosGridPoints - 1);
-      lowerLeftCoord = m_validPositions[ind];
+      return false;
+    }
 
-      // Test if the three other corners for interpolation are found.
-      // If they do not, loop again to find another position.
+  // 64-bit FNV-1a hash
+  const uint64_t fnvPrime = 1099511628211ULL;
+  checksum = 14695981039346656037ULL;
+  size = 0;
 
-      std::pair<double, double> testPos;
+  std::vector<char> buffer (1 << 20);
 
-      // Upper left corner
-      testPos.first = lowerLeftCoord.first + m_latInterval;
-      testPos.second = lowerLeftCoord.second;
-      if (find (m_validPositions.begin (), m_validPositions.end (), testPos) == m_validPositions.end ())
-        {
-          continue;
-        }
+  while (ifs.good ())
+    {
+      ifs.read (&buffer[0], buffer.size ());
+      std::streamsize count = ifs.gcount ();
 
-      // Upper right corner
-      testPos.second = lowerLeftCoord.second + m_lonInterval;
-      if (find (m_validPositions.begin (), m_validPositions.end (), testPos) == m_validPositions.end ())
+      for (std::streamsize i = 0; i < count; ++i)
         {
-          continue;
+          checksum ^= (uint8_t) buffer[i];
+          checksum *= fnvPrime;
         }
 
-      // Lower right corner
-      testPos.first = lowerLeftCoord.first;
-      if (find (m_validPositions.begin (), m_validPositions.end (), testPos) == m_validPositions.end ())
+      size += count;
+    }
+
+  return ifs.eof ();
+}
+
+bool
+SatAntennaGainPattern::ReadAntennaPatternFromCache (std::string cacheFilePathName, uint64_t sourceSize, uint64_t sourceChecksum)
+{
+  NS_LOG_FUNCTION (this << cacheFilePathName);
+
+  int fd = open (cacheFilePathName.c_str (), O_RDONLY);
+
+  if (fd < 0)
+    {
+      return false;
+    }
+
+  struct stat st;
+
+  if (fstat (fd, &st) != 0 || (uint64_t) st.st_size < sizeof (CacheHeader_s))
+    {
+      close (fd);
+      return false;
+    }
+
+  const uint64_t fileSize = st.st_size;
+  void *data = mmap (NULL, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+  close (fd);
+
+  if (data == MAP_FAILED)
+    {
+      return false;
+    }
+
+  const char *bytes = (const char *) data;
+  CacheHeader_s header;
+  std::memcpy (&header, bytes, sizeof (CacheHeader_s));
+
+  const uint64_t numOfGridPoints = (uint64_t) header.numOfLatitudes * header.numOfLongitudes;
+  const uint64_t numOfDoubles = header.numOfLatitudes + header.numOfLongitudes + numOfGridPoints + 2 * (uint64_t) header.numOfValidPositions;
+
+  bool valid = std::memcmp (header.magic, "SATAGPC", 8) == 0
+    && header.version == CACHE_VERSION
+    && header.sourceSize == sourceSize
+    && header.sourceChecksum == sourceChecksum
+    && header.minAcceptableAntennaGainInDb == m_minAcceptableAntennaGainInDb
+    && header.numOfLatitudes > 0
+    && header.numOfLongitudes > 0
+    && fileSize == sizeof (CacheHeader_s) + numOfDoubles * sizeof (double) + numOfGridPoints;
+
+  if (!valid)
+    {
+      NS_LOG_INFO (this << " cache file " << cacheFilePathName << " is outdated or invalid");
+      munmap (data, fileSize);
+      return false;
+    }
+
+  const double *values = (const double *) (bytes + sizeof (CacheHeader_s));
+
+  // Only the grid axes are copied, the gains, the valid positions and the
+  // validity mask are served directly from the mapping.
+  m_latitudes.assign (values, values + header.numOfLatitudes);
+  values += header.numOfLatitudes;
+
+  m_longitudes.assign (values, values + header.numOfLongitudes);
+  values += header.numOfLongitudes;
+
+  m_gains = values;
+  m_numOfGridPoints = numOfGridPoints;
+  values += numOfGridPoints;
+
+  m_validPositionData = (header.numOfValidPositions > 0) ? values : 0;
+  m_numOfValidPositions = header.numOfValidPositions;
+  values += 2 * (uint64_t) header.numOfValidPositions;
+
+  m_validMask = (const uint8_t *) values;
+
+  // The grid limits and intervals are set as when reading the text file
+  m_minLat = m_latitudes.front ();
+  m_maxLat = m_latitudes.back ();
+  m_minLon = m_longitudes.front ();
+  m_maxLon = m_longitudes.back ();
+  m_latInterval = (m_latitudes.size () > 1) ? m_latitudes.back () - m_latitudes[m_latitudes.size () - 2] : 0.0;
+  m_lonInterval = (m_longitudes.size () > 1) ? m_longitudes.back () - m_longitudes[m_longitudes.size () - 2] : 0.0;
+
+  // The mapping is kept until the pattern is destroyed
+  m_cacheData = data;
+  m_cacheSize = fileSize;
+
+  return true;
+}
+
+void
+SatAntennaGainPattern::WriteAntennaPatternToCache (std::string cacheFilePathName, uint64_t sourceSize, uint64_t sourceChecksum) const
+{
+  NS_LOG_FUNCTION (this << cacheFilePathName);
+
+  CacheHeader_s header;
+  std::memset (&header, 0, sizeof (CacheHeader_s));
+  std::memcpy (header.magic, "SATAGPC", 8);
+  header.version = CACHE_VERSION;
+  header.numOfLatitudes = m_latitudes.size ();
+  header.numOfLongitudes = m_longitudes.size ();
+  header.numOfValidPositions = m_numOfValidPositions;
+  header.sourceSize = sourceSize;
+  header.sourceChecksum = sourceChecksum;
+  header.minAcceptableAntennaGainInDb = m_minAcceptableAntennaGainInDb;
+
+  /**
+   * The cache is written first to a process specific temporary file, which is
+   * then renamed to the cache file. Thus, parallel simulation processes never
+   * read a partially written cache file.
+   */
+  std::ostringstream tmpFilePathName;
+  tmpFilePathName << cacheFilePathName << "." << getpid () << ".tmp";
+
+  std::ofstream ofs (tmpFilePathName.str ().c_str (), std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+
+  if (!ofs.is_open ())
+    {
+      NS_LOG_WARN (this << " cache file " << cacheFilePathName << " cannot be written");
+      return;
+    }
+
+  ofs.write ((const char *) &header, sizeof (CacheHeader_s));
+  ofs.write ((const char *) &m_latitudes[0], m_latitudes.size () * sizeof (double));
+  ofs.write ((const char *) &m_longitudes[0], m_longitudes.size () * sizeof (double));
+  ofs.write ((const char *) m_gains, m_numOfGridPoints * sizeof (double));
+
+  if (m_numOfValidPositions > 0)
+    {
+      ofs.write ((const char *) m_validPositionData, 2 * m_numOfValidPositions * sizeof (double));
+    }
+
+  ofs.write ((const char *) m_validMask, m_numOfGridPoints);
+  ofs.close ();
+
+  if (ofs.fail () || std::rename (tmpFilePathName.str ().c_str (), cacheFilePathName.c_str ()) != 0)
+    {
+      NS_LOG_WARN (this << " cache file " << cacheFilePathName << " cannot be written");
+      std::remove (tmpFilePathName.str ().c_str ());
+    }
+}
+
+
+void
+SatAntennaGainPattern::BuildValidCells ()
+{
+  NS_LOG_FUNCTION (this);
+
+  const uint32_t numOfLatitudes = m_latitudes.size ();
+  const uint32_t numOfLongitudes = m_longitudes.size ();
+
+  // Bitmap of the grid points, which are valid positions
+  std::vector<bool> validGridPositions (numOfLatitudes * numOfLongitudes, false);
+
+  // Grid indices of the valid positions
+  std::vector< std::pair<uint32_t, uint32_t> > validIndices;
+  validIndices.reserve (m_numOfValidPositions);
+
+  for (uint32_t i = 0; i < m_numOfValidPositions; ++i)
+    {
+      double lat = m_validPositionData[2 * i];
+      double lon = m_validPositionData[2 * i + 1];
+      uint32_t latIndex = std::lower_bound (m_latitudes.begin (), m_latitudes.end (), lat) - m_latitudes.begin ();
+      uint32_t lonIndex = std::lower_bound (m_longitudes.begin (), m_longitudes.end (), lon) - m_longitudes.begin ();
+
+      NS_ASSERT (latIndex < numOfLatitudes && m_latitudes[latIndex] == lat);
+      NS_ASSERT (lonIndex < numOfLongitudes && m_longitudes[lonIndex] == lon);
+
+      validGridPositions[latIndex * numOfLongitudes + lonIndex] = true;
+      validIndices.push_back (std::make_pair (latIndex, lonIndex));
+    }
+
+  m_validCells.clear ();
+
+  // A valid position is a valid cell (lower left corner), if also the
+  // upper left, upper right and lower right corners are valid positions
+  for (uint32_t i = 0; i < validIndices.size (); ++i)
+    {
+      uint32_t latIndex = validIndices[i].first;
+      uint32_t lonIndex = validIndices[i].second;
+
+      if (latIndex + 1 < numOfLatitudes
+          && lonIndex + 1 < numOfLongitudes
+          && validGridPositions[(latIndex + 1) * numOfLongitudes + lonIndex]
+          && validGridPositions[(latIndex + 1) * numOfLongitudes + lonIndex + 1]
+          && validGridPositions[latIndex * numOfLongitudes + lonIndex + 1])
         {
-          continue;
+          m_validCells.push_back (i);
         }
+    }
+}
+
+GeoCoordinate SatAntennaGainPattern::GetValidRandomPosition () const
+{
+  NS_LOG_FUNCTION (this);
 
-      // None of the previous checks triggered, thus we have a valid position.
-      break;
+  if (m_validCells.empty ())
+    {
+      NS_FATAL_ERROR (this << " no valid grid cells in the antenna pattern!");
     }
 
+  // Get random valid grid cell, i.e. position (=lower left corner of a grid)
+  // for which all the corners for interpolation are valid.
+  uint32_t ind = m_uniformRandomVariable->GetInteger (0, m_validCells.size () - 1);
+  std::pair<double, double> lowerLeftCoord = std::make_pair (m_validPositionData[2 * m_validCells[ind]],
+                                                             m_validPositionData[2 * m_validCells[ind] + 1]);
+
   // Pick a random position within a grid square
   double latOffset = m_uniformRandomVariable->GetValue (0.0, m_latInterval - 0.001);
   double lonOffset = m_uniformRandomVariable->GetValue (0.0, m_lonInterval - 0.001);
@@ -272,7 +580,8 @@ GeoCoordinate SatAntennaGainPattern::GetValidRandomPosition () const
 }
 
 
-double SatAntennaGainPattern::GetAntennaGain_lin (GeoCoordinate coord) const
+SatAntennaGainPattern::InterpolationPoint_s
+SatAntennaGainPattern::GetInterpolationPoint (GeoCoordinate coord) const
 {
   NS_LOG_FUNCTION (this << coord.GetLatitude () << coord.GetLongitude ());
 
@@ -293,64 +602,65 @@ double SatAntennaGainPattern::GetAntennaGain_lin (GeoCoordinate coord) const
   uint32_t minLatIndex = (uint32_t)(std::floor (std::abs (latitude - m_minLat) / m_latInterval));
   uint32_t minLonIndex = (uint32_t)(std::floor (std::abs (longitude - m_minLon) / m_lonInterval));
 
-  // All the values within the grid box has to be valid! If UT is placed (or
-  // is moving outside) the valid simulation area, the simulation will crash
-  // to a fatal error.
-  if (std::isnan (m_antennaPattern[minLatIndex][minLonIndex])
-      || std::isnan (m_antennaPattern[minLatIndex][minLonIndex + 1])
-      || std::isnan (m_antennaPattern[minLatIndex + 1][minLonIndex])
-      || std::isnan (m_antennaPattern[minLatIndex + 1][minLonIndex + 1]))
-    {
-      NS_FATAL_ERROR (this << ", some value(s) of the interpolated grid point(s) is/are NAN!");
-    }
-
   /**
    * 4-point bilinear interpolation
    * R(x,y1) = (x2 - x)/(x2 - x1) * Q(x1,y1)) + (x - x1)/(x2 - x1) * Q(x2,y1);
    * R(x,y2) = (x2 - x)/(x2 - x1) * Q(x1,y2)) + (x - x1)/(x2 - x1) * Q(x2,y2);
    * R = (y2 - y)/(y2 - y1) * R(x,y1) + (y - y1)/(y2 - y1) * R(x,y2);
    */
+  InterpolationPoint_s point;
+  point.lowerLeftIndex = minLatIndex * m_longitudes.size () + minLonIndex;
+  point.upperLeftIndex = point.lowerLeftIndex + m_longitudes.size ();
 
-  // Longitude direction with latitude minLatIndex
-  double upperLonShare = (m_longitudes[minLonIndex + 1] - longitude) / m_lonInterval;
-  double lowerLonShare = (longitude - m_longitudes[minLonIndex]) / m_lonInterval;
+  // Longitude direction
+  point.upperLonShare = (m_longitudes[minLonIndex + 1] - longitude) / m_lonInterval;
+  point.lowerLonShare = (longitude - m_longitudes[minLonIndex]) / m_lonInterval;
 
-  // Change the gains to linear values , because the interpolation is done in linear domain.
-  double G11 = SatUtils::DbToLinear ( m_antennaPattern[minLatIndex][minLonIndex] );
-  double G12 = SatUtils::DbToLinear ( m_antennaPattern[minLatIndex][minLonIndex + 1] );
-  double G21 = SatUtils::DbToLinear ( m_antennaPattern[minLatIndex + 1][minLonIndex] );
-  double G22 = SatUtils::DbToLinear ( m_antennaPattern[minLatIndex + 1][minLonIndex + 1] );
+  // Latitude direction
+  point.upperLatShare = (m_latitudes[minLatIndex + 1] - latitude) / m_latInterval;
+  point.lowerLatShare = (latitude - m_latitudes[minLatIndex]) / m_latInterval;
+
+  return point;
+}
+
+double SatAntennaGainPattern::GetAntennaGain_lin (GeoCoordinate coord) const
+{
+  NS_LOG_FUNCTION (this << coord.GetLatitude () << coord.GetLongitude ());
+
+  InterpolationPoint_s point = GetInterpolationPoint (coord);
+
+  // All the values within the grid box has to be valid! If UT is placed (or
+  // is moving outside) the valid simulation area, the simulation will crash
+  // to a fatal error.
+  if (!m_validMask[point.lowerLeftIndex]
+      || !m_validMask[point.lowerLeftIndex + 1]
+      || !m_validMask[point.upperLeftIndex]
+      || !m_validMask[point.upperLeftIndex + 1])
+    {
+      NS_FATAL_ERROR (this << ", some value(s) of the interpolated grid point(s) is/are NAN!");
+    }
 
   // Longitude direction with latitude minLatIndex
-  double valLatLower = upperLonShare * G11 + lowerLonShare * G12;
+  double valLatLower = point.upperLonShare * m_gains[point.lowerLeftIndex] +
+    point.lowerLonShare * m_gains[point.lowerLeftIndex + 1];
 
   // Longitude direction with latitude minLatIndex+1
-  double valLatUpper = upperLonShare * G21 + lowerLonShare * G22;
+  double valLatUpper = point.upperLonShare * m_gains[point.upperLeftIndex] +
+    point.lowerLonShare * m_gains[point.upperLeftIndex + 1];
 
   // Latitude direction with longitude "longitude"
-  double gain = ((m_latitudes[minLatIndex + 1] - latitude) / m_latInterval) * valLatLower +
-    ((latitude - m_latitudes[minLatIndex]) / m_latInterval) * valLatUpper;
-
-  /*
-  std::cout << "minLonIndex = " << minLonIndex <<
-      ", minLatIndex = " << minLatIndex <<
-      ", m_lonInterval = " << m_lonInterval <<
-      ", m_LatInterval = " << m_latInterval <<
-      ", x1 = " << m_longitudes[minLonIndex] <<
-      ", y1 = " << m_latitudes[minLatIndex] <<
-      ", x2 = " << m_longitudes[minLonIndex+1] <<
-      ", y2 = " << m_latitudes[minLatIndex+1] <<
-      ", G(x1,y1) = " << m_antennaPattern[minLatIndex][minLonIndex] <<
-      ", G(x1,y2) = " << m_antennaPattern[minLatIndex+1][minLonIndex] <<
-      ", G(x2,y1) = " << m_antennaPattern[minLatIndex][minLonIndex+1] <<
-      ", G(x2,y2) = " << m_antennaPattern[minLatIndex+1][minLonIndex+1] <<
-      ", x = " << longitude <<
-      ", y = " << latitude <<
-      ", interpolated gain: " << gain << std::endl;
-   */
+  double gain = point.upperLatShare * valLatLower + point.lowerLatShare * valLatUpper;
+
   return gain;
 }
 
+bool
+SatAntennaGainPattern::HasSameGrid (Ptr<const SatAntennaGainPattern> other) const
+{
+  NS_LOG_FUNCTION (this << other);
+
+  return (m_latitudes == other->m_latitudes && m_longitudes == other->m_longitudes);
+}
 
 
 } // namespace ns3
@@ -35,8 +35,9 @@ namespace ns3 {
  * for a one single spot-beam. In initialization phase, the gain pattern
  * is read from a file to a container. Current implementation assumes
  * that the antenna pattern is using a constant longitude-latitude grid of
- * samples. This assumption is made to enable fast look-ups from the container
- * (= vector<vector<double>>).
+ * samples. This assumption is made to enable fast look-ups from the container,
+ * which holds the gains converted to linear format in one contiguous vector
+ * (latitude major). Invalid (NaN) grid points are tracked with a validity mask.
  *
  * Antenna gain patter is used also for spot-beam selection. In initialization phase
  * a valid positions list is constructed based on a minimum accepted antenna gain set
@@ -44,6 +45,13 @@ namespace ns3 {
  *
  * Antenna gain value for a given longitude and latitude position is calculated by
  * using 4-point bilinear interpolation.
+ *
+ * Parsing the antenna pattern text files is slow, thus optionally (see
+ * EnableBinaryCache attribute) the parsed antenna pattern is stored to a binary
+ * cache file in the BinaryCacheDirectory. The cache file is memory mapped at the
+ * later loads and used if its version, the source text file checksum and the
+ * minimum acceptable antenna gain match. The gains, the validity mask and the
+ * valid positions are then served directly from the mapping.
  */
 class SatAntennaGainPattern : public Object
 {
@@ -71,9 +79,25 @@ public:
    * \param filePathName 
    */
   SatAntennaGainPattern (std::string filePathName);
-  ~SatAntennaGainPattern ()
+
+  /**
+   * Destructor.
+   */
+  ~SatAntennaGainPattern ();
+
+  /**
+   * \brief Struct for the bilinear interpolation of a {latitude, longitude} point
+   * within the antenna pattern grid.
+   */
+  typedef struct
   {
-  }
+    uint32_t lowerLeftIndex;  ///< Flat grid index of the lower left grid point
+    uint32_t upperLeftIndex;  ///< Flat grid index of the upper left grid point
+    double upperLonShare;     ///< Weight of the left grid points in longitude direction
+    double lowerLonShare;     ///< Weight of the right grid points in longitude direction
+    double upperLatShare;     ///< Weight of the lower grid points in latitude direction
+    double lowerLatShare;     ///< Weight of the upper grid points in latitude direction
+  } InterpolationPoint_s;
 
   /**
    * \brief Calculate the antenna gain value for a certain {latitude, longitude} point
@@ -81,13 +105,88 @@ public:
    */
   double GetAntennaGain_lin (GeoCoordinate coord) const;
 
+  /**
+   * \brief Get the grid points and weights for the bilinear interpolation of
+   * a certain {latitude, longitude} point.
+   * \param coord Geo coordinate
+   * \return Interpolation point
+   */
+  InterpolationPoint_s GetInterpolationPoint (GeoCoordinate coord) const;
+
+  /**
+   * \brief Get the antenna gain grid in linear format. The grid is stored
+   * latitude major, i.e. index = latitudeIndex * GetNumOfLongitudes () + longitudeIndex.
+   * Invalid grid points hold NaN.
+   * \return Antenna gain grid
+   */
+  inline const double* GetAntennaGainGrid_lin () const { return m_gains; }
+
+  /**
+   * \brief Get the number of grid points in the antenna gain grid
+   * \return Number of grid points
+   */
+  inline uint32_t GetNumOfGridPoints () const { return m_numOfGridPoints; }
+
+  /**
+   * \brief Get the number of longitudes in the antenna gain grid
+   * \return Number of longitudes
+   */
+  inline uint32_t GetNumOfLongitudes () const { return m_longitudes.size (); }
+
+  /**
+   * \brief Check whether another antenna pattern uses the same
+   * {latitude, longitude} grid as this one.
+   * \param other Another antenna gain pattern
+   * \return true if the grids are the same
+   */
+  bool HasSameGrid (Ptr<const SatAntennaGainPattern> other) const;
+
   /**
    * \brief Get a valid random position under this spot-beam coverage.
    * \return A valid random GeoCoordinate
    */
   GeoCoordinate GetValidRandomPosition () const;
 
+  /**
+   * \brief Check whether the antenna pattern is served from a memory mapped
+   * binary cache file.
+   * \return true if the antenna pattern was read from the cache file
+   */
+  inline bool IsReadFromCache () const { return m_cacheData != 0; }
+
+  /**
+   * \brief Get the path and file name of the binary cache file of an antenna
+   * pattern file. The name of the cache file contains the name of the antenna
+   * pattern file and a hash of its canonical path.
+   * \param cacheDirectory Directory of the cache files, or empty for TMPDIR
+   * \param filePathName Path and file name of the antenna pattern file
+   * \return Path and file name of the cache file
+   */
+  static std::string GetCacheFilePathName (std::string cacheDirectory, std::string filePathName);
+
 private:
+  /**
+   * \brief Header of the binary antenna pattern cache file. The header is
+   * followed by the latitudes, the longitudes, the linear gains and the valid
+   * positions as doubles and finally by the grid point validity mask as bytes.
+   */
+  typedef struct
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t numOfLatitudes;
+    uint32_t numOfLongitudes;
+    uint32_t numOfValidPositions;
+    uint64_t sourceSize;
+    uint64_t sourceChecksum;
+    double minAcceptableAntennaGainInDb;
+  } CacheHeader_s;
+
+  /**
+   * Version of the binary antenna pattern cache file format
+   */
+  static const uint32_t CACHE_VERSION = 1;
+
   /**
    * \brief Read the antenna gain pattern from a file
    * \param filePathName Path and file name of the antenna pattern file
@@ -95,18 +194,61 @@ private:
   void ReadAntennaPatternFromFile (std::string filePathName);
 
   /**
-   * Container for the antenna pattern from one spot-beam
-   * - Outer vector holds gain values for all latitudes
-   * - Inner vector holds gain values for all longitudes for a certain latitude
+   * \brief Build the container of valid grid cells from the valid positions.
    */
-  std::vector< std::vector <double> > m_antennaPattern;
+  void BuildValidCells ();
 
   /**
-   * Container for valid positions
-   * - Latitude
-   * - Longitude
+   * \brief Calculate the size and the checksum (64-bit FNV-1a) of a file
+   * \param filePathName Path and file name
+   * \param size Size of the file in bytes
+   * \param checksum Checksum of the file
+   * \return true if the file was read successfully
    */
-  std::vector< std::pair<double, double> > m_validPositions;
+  static bool CalculateFileChecksum (std::string filePathName, uint64_t& size, uint64_t& checksum);
+
+  /**
+   * \brief Read the antenna gain pattern from a binary cache file.
+   * \param cacheFilePathName Path and file name of the cache file
+   * \param sourceSize Size of the source text file
+   * \param sourceChecksum Checksum of the source text file
+   * \return true if the cache file was valid and read successfully
+   */
+  bool ReadAntennaPatternFromCache (std::string cacheFilePathName, uint64_t sourceSize, uint64_t sourceChecksum);
+
+  /**
+   * \brief Write the antenna gain pattern to a binary cache file.
+   * \param cacheFilePathName Path and file name of the cache file
+   * \param sourceSize Size of the source text file
+   * \param sourceChecksum Checksum of the source text file
+   */
+  void WriteAntennaPatternToCache (std::string cacheFilePathName, uint64_t sourceSize, uint64_t sourceChecksum) const;
+
+  /**
+   * Container for the antenna pattern from one spot-beam in linear format,
+   * when parsed from the text file. Gain values of all longitudes for a
+   * certain latitude are stored one latitude after another.
+   */
+  std::vector<double> m_antennaPattern;
+
+  /**
+   * Validity mask of the antenna pattern grid points (0 for NaN gains),
+   * when parsed from the text file.
+   */
+  std::vector<uint8_t> m_validGridPoints;
+
+  /**
+   * Container for valid positions as latitude, longitude pairs, when parsed
+   * from the text file.
+   */
+  std::vector<double> m_validPositions;
+
+  /**
+   * Container for valid grid cells, i.e. the indices of the valid positions
+   * (lower left corners) in m_validPositions, for which all the four corners of
+   * the grid cell are valid positions.
+   */
+  std::vector<uint32_t> m_validCells;
 
   /**
    * Minimum acceptable antenna gain for a serving spot-beam. Used
@@ -114,6 +256,54 @@ private:
    */
   double m_minAcceptableAntennaGainInDb;
 
+  /**
+   * Defines whether the binary antenna pattern cache is in use
+   */
+  bool m_enableBinaryCache;
+
+  /**
+   * Directory of the binary antenna pattern cache files
+   */
+  std::string m_binaryCacheDirectory;
+
+  /**
+   * Antenna gains in linear format, served either from m_antennaPattern or
+   * from the memory mapped cache file
+   */
+  const double* m_gains;
+
+  /**
+   * Validity mask of the grid points, served either from m_validGridPoints
+   * or from the memory mapped cache file
+   */
+  const uint8_t* m_validMask;
+
+  /**
+   * Valid positions as latitude, longitude pairs, served either from
+   * m_validPositions or from the memory mapped cache file
+   */
+  const double* m_validPositionData;
+
+  /**
+   * Number of grid points in the antenna gain grid
+   */
+  uint32_t m_numOfGridPoints;
+
+  /**
+   * Number of valid positions
+   */
+  uint32_t m_numOfValidPositions;
+
+  /**
+   * Memory mapped cache file, if the antenna pattern was read from the cache
+   */
+  void* m_cacheData;
+
+  /**
+   * Size of the memory mapped cache file
+   */
+  uint64_t m_cacheSize;
+
   /**
    * Uniform random variable used for beam selection.
    */
@@ -18,6 +18,7 @@
  * Author: Frans Laakso <frans.laakso@magister.fi>
  */
 #include "satellite-base-trace-container.h"
+#include "ns3/boolean.h"
 
 NS_LOG_COMPONENT_DEFINE ("SatBaseTraceContainer");
 
@@ -29,7 +30,17 @@ TypeId
 SatBaseTraceContainer::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::SatBaseTraceContainer")
-    .SetParent<Object> ();
+    .SetParent<Object> ()
+    .AddAttribute ("EnableBinaryOutput",
+                   "Write the output traces of all the keys into a single binary columnar file instead of a text file per key.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&SatBaseTraceContainer::m_enableBinaryOutput),
+                   MakeBooleanChecker ())
+    .AddAttribute ("EnableBinaryInput",
+                   "Read the input trace files as rows of native doubles instead of text.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&SatBaseTraceContainer::m_enableBinaryInput),
+                   MakeBooleanChecker ());
   return tid;
 }
 
@@ -42,8 +53,13 @@ SatBaseTraceContainer::GetInstanceTypeId (void) const
 }
 
 SatBaseTraceContainer::SatBaseTraceContainer ()
+  : m_enableBinaryOutput (false),
+    m_enableBinaryInput (false)
 {
   NS_LOG_FUNCTION (this);
+
+  // trace containers are created as singletons, not with CreateObject
+  ObjectBase::ConstructSelf (AttributeConstructionList ());
 }
 
 SatBaseTraceContainer::~SatBaseTraceContainer ()
@@ -51,4 +67,17 @@ SatBaseTraceContainer::~SatBaseTraceContainer ()
   NS_LOG_FUNCTION (this);
 }
 
+std::ios::openmode
+SatBaseTraceContainer::GetInputFileMode () const
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_enableBinaryInput)
+    {
+      return std::ios::in | std::ios::binary;
+    }
+
+  return std::ios::in;
+}
+
 } // namespace ns3
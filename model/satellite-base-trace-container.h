@@ -20,6 +20,7 @@
 #ifndef SATELLITE_BASE_TRACE_CONTAINER_H
 #define SATELLITE_BASE_TRACE_CONTAINER_H
 
+#include <ios>
 #include "ns3/object.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
@@ -106,6 +107,24 @@ public:
    */
   virtual void Reset () = 0;
 
+protected:
+  /**
+   * \brief Get the file mode for reading the input traces
+   * \return std::ios::in, with std::ios::binary if binary input is enabled
+   */
+  std::ios::openmode GetInputFileMode () const;
+
+  /**
+   * \brief Write the output traces of all the keys into a single binary file
+   * instead of a text file per key
+   */
+  bool m_enableBinaryOutput;
+
+  /**
+   * \brief Read the input traces as rows of native doubles instead of text
+   */
+  bool m_enableBinaryInput;
+
 private:
 };
 
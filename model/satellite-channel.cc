@@ -19,6 +19,9 @@
  */
 
 #include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
 #include "ns3/object.h"
 #include "ns3/simulator.h"
 #include "ns3/log.h"
@@ -34,6 +37,8 @@
 #include "satellite-mac-tag.h"
 #include "ns3/singleton.h"
 #include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
 #include "satellite-rx-power-output-trace-container.h"
 #include "satellite-rx-power-input-trace-container.h"
 #include "satellite-fading-output-trace-container.h"
@@ -50,6 +55,9 @@ NS_OBJECT_ENSURE_REGISTERED (SatChannel);
 SatChannel::SatChannel ()
   : m_fwdMode (SatChannel::ALL_BEAMS),
     m_phyRxContainer (),
+    m_phyRxAddressIndex (),
+    m_phyRxBeamIndex (),
+    m_phyRxIndexDirty (true),
     m_channelType (SatEnums::UNKNOWN_CH),
     m_carrierFreqConverter (),
     m_freqId (),
@@ -65,7 +73,21 @@ SatChannel::SatChannel ()
      */
     m_enableRxPowerOutputTrace (false),
     m_enableFadingOutputTrace (false),
-    m_enableExternalFadingInputTrace (false)
+    m_enableExternalFadingInputTrace (false),
+    m_enableLinkBudgetCache (false),
+    m_linkBudgetCacheSize (65536),
+    m_linkBudgetCache (),
+    m_linkBudgetLru (),
+    m_linkBudgetCacheWarned (false),
+    m_mobilityEpochs (),
+    m_followedMobilities (),
+    m_enableInterferenceCulling (false),
+    m_interferenceCullingThreshold_dB (-30.0),
+    m_couplingMatrix (),
+    m_volatileCouplingRow (),
+    m_culledRxCount (0),
+    m_scheduledRxCount (0),
+    m_maxCulledCoupling (0.0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -79,7 +101,32 @@ void
 SatChannel::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
+
+  if (m_enableInterferenceCulling && (m_culledRxCount > 0))
+    {
+      NS_LOG_INFO ("Channel: " << SatEnums::GetChannelTypeName (m_channelType) <<
+                   ", freqId: " << m_freqId <<
+                   ", scheduled receptions: " << m_scheduledRxCount <<
+                   ", culled receptions: " << m_culledRxCount <<
+                   ", max culled coupling per transmission: " << SatUtils::LinearToDb (m_maxCulledCoupling) << " dB");
+    }
+
   m_phyRxContainer.clear ();
+  m_phyRxAddressIndex.clear ();
+  m_phyRxBeamIndex.clear ();
+  // Stop following the course changes, since the mobility models may outlive the channel
+  for (std::vector<Ptr<MobilityModel> >::iterator it = m_followedMobilities.begin ();
+       it != m_followedMobilities.end (); ++it)
+    {
+      (*it)->TraceDisconnectWithoutContext ("SatCourseChange", MakeCallback (&SatChannel::MobilityCourseChanged, this));
+    }
+
+  m_couplingMatrix.clear ();
+  m_volatileCouplingRow.clear ();
+  m_linkBudgetCache.clear ();
+  m_linkBudgetLru.clear ();
+  m_mobilityEpochs.clear ();
+  m_followedMobilities.clear ();
   m_propagationDelay = 0;
   Channel::DoDispose ();
 }
@@ -118,6 +165,30 @@ SatChannel::GetTypeId (void)
                    MakeEnumChecker (SatChannel::ONLY_DEST_NODE, "OnlyDestNode",
                                     SatChannel::ONLY_DEST_BEAM, "OnlyDestBeam",
                                     SatChannel::ALL_BEAMS, "AllBeams"))
+    .AddAttribute ( "EnableLinkBudgetCache",
+                    "Enable caching of the antenna gains and free space loss per transmitter, receiver and carrier.",
+                    BooleanValue (false),
+                    MakeBooleanAccessor (&SatChannel::m_enableLinkBudgetCache),
+                    MakeBooleanChecker ())
+    .AddAttribute ( "LinkBudgetCacheSize",
+                    "Maximum number of entries in the link budget cache.",
+                    UintegerValue (65536),
+                    MakeUintegerAccessor (&SatChannel::m_linkBudgetCacheSize),
+                    MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ( "EnableInterferenceCulling",
+                    "Enable culling of the receivers with negligible interference coupling in AllBeams forwarding mode.",
+                    BooleanValue (false),
+                    MakeBooleanAccessor (&SatChannel::m_enableInterferenceCulling),
+                    MakeBooleanChecker ())
+    .AddAttribute ( "InterferenceCullingThreshold",
+                    "Antenna gain coupling threshold in dB relative to the wanted signal, below which the receivers are culled.",
+                    DoubleValue (-30.0),
+                    MakeDoubleAccessor (&SatChannel::m_interferenceCullingThreshold_dB),
+                    MakeDoubleChecker<double> ())
+    .AddTraceSource ("InterferenceCulling",
+                     "The trace for receivers culled from a transmission due to negligible interference coupling",
+                     MakeTraceSourceAccessor (&SatChannel::m_interferenceCullingTrace),
+                     "ns3::SatChannel::InterferenceCullingTraceCallback")
   ;
   return tid;
 }
@@ -127,6 +198,10 @@ SatChannel::AddRx (Ptr<SatPhyRx> phyRx)
 {
   NS_LOG_FUNCTION (this << phyRx);
   m_phyRxContainer.push_back (phyRx);
+
+  // The receiver indices and the coupling rows are indexed by the receiver container
+  m_phyRxIndexDirty = true;
+  m_couplingMatrix.clear ();
 }
 
 void
@@ -139,6 +214,8 @@ SatChannel::RemoveRx (Ptr<SatPhyRx> phyRx)
   if (phyIter != m_phyRxContainer.end ()) // == vector.end() means the element was not found
     {
       m_phyRxContainer.erase (phyIter);
+      m_phyRxIndexDirty = true;
+      m_couplingMatrix.clear ();
     }
 }
 
@@ -148,6 +225,13 @@ SatChannel::StartTx (Ptr<SatSignalParameters> txParams)
   NS_LOG_FUNCTION (this << txParams);
   NS_ASSERT_MSG (txParams->m_phyTx, "NULL phyTx");
 
+  /**
+   * The burst is shared by all the receivers of the transmission, since most
+   * of the receivers see it only as interference. Only the receivers decoding
+   * the burst copy its packets.
+   */
+  Ptr<SatSignalBurst> burst = Create<SatSignalBurst> (txParams);
+
   switch (m_fwdMode)
     {
     /**
@@ -158,60 +242,36 @@ SatChannel::StartTx (Ptr<SatSignalParameters> txParams)
     */
     case SatChannel::ONLY_DEST_NODE:
       {
-        // For all receivers
-        for (PhyRxContainer::const_iterator rxPhyIterator = m_phyRxContainer.begin ();
-             rxPhyIterator != m_phyRxContainer.end ();
-             ++rxPhyIterator)
+        switch (m_channelType)
           {
-            // If the same beam
-            if ( (*rxPhyIterator)->GetBeamId () == txParams->m_beamId )
-              {
-                switch (m_channelType)
-                  {
-                  // If the destination is satellite
-                  case SatEnums::FORWARD_FEEDER_CH:
-                  case SatEnums::RETURN_USER_CH:
-                    {
-                      // The packet burst is passed on to the satellite receiver
-                      ScheduleRx (txParams, *rxPhyIterator);
-                      break;
-                    }
-                  // If the destination is terrestrial node
-                  case SatEnums::FORWARD_USER_CH:
-                  case SatEnums::RETURN_FEEDER_CH:
+          // If the destination is satellite
+          case SatEnums::FORWARD_FEEDER_CH:
+          case SatEnums::RETURN_USER_CH:
+            {
+              // The packet burst is passed on to the satellite receivers of the same beam
+              for (PhyRxContainer::const_iterator rxPhyIterator = m_phyRxContainer.begin ();
+                   rxPhyIterator != m_phyRxContainer.end ();
+                   ++rxPhyIterator)
+                {
+                  if ( (*rxPhyIterator)->GetBeamId () == txParams->m_beamId )
                     {
-                      // Go through the packets and check their destination address by peeking the MAC tag
-                      SatSignalParameters::PacketsInBurst_t::const_iterator it = txParams->m_packetsInBurst.begin ();
-                      for (; it != txParams->m_packetsInBurst.end (); ++it )
-                        {
-                          SatMacTag macTag;
-                          bool mSuccess = (*it)->PeekPacketTag (macTag);
-                          if (!mSuccess)
-                            {
-                              NS_FATAL_ERROR ("MAC tag was not found from the packet!");
-                            }
-
-                          Mac48Address dest = macTag.GetDestAddress ();
-
-                          // If the packet destination is the same as the receiver MAC
-                          if (dest == (*rxPhyIterator)->GetAddress () || dest.IsBroadcast () || dest.IsGroup ())
-                            {
-                              ScheduleRx (txParams, *rxPhyIterator);
-
-                              // Remember to break the packet loop, so that the transmission
-                              // is not received several times!
-                              break;
-                            }
-                        }
-                      break;
+                      ScheduleRx (burst, *rxPhyIterator);
                     }
-                  default:
-                    {
-                      NS_FATAL_ERROR ("Unsupported channel type!");
-                      break;
-                    }
-                  }
-              }
+                }
+              break;
+            }
+          // If the destination is terrestrial node
+          case SatEnums::FORWARD_USER_CH:
+          case SatEnums::RETURN_FEEDER_CH:
+            {
+              DoDestNodeTx (burst);
+              break;
+            }
+          default:
+            {
+              NS_FATAL_ERROR ("Unsupported channel type!");
+              break;
+            }
           }
         break;
       }
@@ -229,7 +289,7 @@ SatChannel::StartTx (Ptr<SatSignalParameters> txParams)
             // If the same beam
             if ( (*rxPhyIterator)->GetBeamId () == txParams->m_beamId )
               {
-                ScheduleRx (txParams, *rxPhyIterator);
+                ScheduleRx (burst, *rxPhyIterator);
               }
           }
         break;
@@ -242,11 +302,17 @@ SatChannel::StartTx (Ptr<SatSignalParameters> txParams)
     */
     case SatChannel::ALL_BEAMS:
       {
+        if (m_enableInterferenceCulling)
+          {
+            DoCulledAllBeamsTx (burst);
+            break;
+          }
+
         for (PhyRxContainer::const_iterator rxPhyIterator = m_phyRxContainer.begin ();
              rxPhyIterator != m_phyRxContainer.end ();
              ++rxPhyIterator)
           {
-            ScheduleRx (txParams, *rxPhyIterator);
+            ScheduleRx (burst, *rxPhyIterator);
           }
         break;
       }
@@ -259,18 +325,286 @@ SatChannel::StartTx (Ptr<SatSignalParameters> txParams)
 }
 
 void
-SatChannel::ScheduleRx (Ptr<SatSignalParameters> txParams, Ptr<SatPhyRx> receiver)
+SatChannel::UpdatePhyRxIndex ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_phyRxIndexDirty)
+    {
+      m_phyRxAddressIndex.clear ();
+      m_phyRxBeamIndex.clear ();
+
+      for (uint32_t i = 0; i < m_phyRxContainer.size (); ++i)
+        {
+          m_phyRxAddressIndex[m_phyRxContainer[i]->GetAddress ()].push_back (i);
+          m_phyRxBeamIndex[m_phyRxContainer[i]->GetBeamId ()].push_back (i);
+        }
+
+      m_phyRxIndexDirty = false;
+    }
+}
+
+std::size_t
+SatChannel::Mac48AddressHash::operator() (const Mac48Address& address) const
+{
+  uint8_t buffer[6];
+  address.CopyTo (buffer);
+
+  uint64_t value = 0;
+  for (uint32_t i = 0; i < 6; ++i)
+    {
+      value = (value << 8) | buffer[i];
+    }
+
+  return std::hash<uint64_t> () (value);
+}
+
+void
+SatChannel::DoDestNodeTx (Ptr<const SatSignalBurst> burst)
+{
+  NS_LOG_FUNCTION (this << burst);
+
+  PhyRxContainer receivers = GetDestNodeReceivers (burst->GetTxParams ());
+
+  for (PhyRxContainer::const_iterator rxIt = receivers.begin (); rxIt != receivers.end (); ++rxIt)
+    {
+      ScheduleRx (burst, *rxIt);
+    }
+}
+
+SatChannel::PhyRxContainer
+SatChannel::GetDestNodeReceivers (Ptr<const SatSignalParameters> txParams)
+{
+  NS_LOG_FUNCTION (this << txParams);
+
+  UpdatePhyRxIndex ();
+
+  PhyRxContainer receivers;
+
+  std::unordered_map<uint32_t, std::vector<uint32_t> >::const_iterator beamIt = m_phyRxBeamIndex.find (txParams->m_beamId);
+
+  if (beamIt == m_phyRxBeamIndex.end ())
+    {
+      return receivers;
+    }
+
+  std::vector<uint32_t> indices;
+
+  // Go through the packets and check their destination address by peeking the MAC tag
+  SatSignalParameters::PacketsInBurst_t::const_iterator it = txParams->m_packetsInBurst.begin ();
+  for (; it != txParams->m_packetsInBurst.end (); ++it )
+    {
+      SatMacTag macTag;
+      bool mSuccess = (*it)->PeekPacketTag (macTag);
+      if (!mSuccess)
+        {
+          NS_FATAL_ERROR ("MAC tag was not found from the packet!");
+        }
+
+      Mac48Address dest = macTag.GetDestAddress ();
+
+      // Broadcast and group packets are received by all the receivers of the beam
+      if (dest.IsBroadcast () || dest.IsGroup ())
+        {
+          indices = beamIt->second;
+          break;
+        }
+
+      std::unordered_map<Mac48Address, std::vector<uint32_t>, Mac48AddressHash>::const_iterator addrIt = m_phyRxAddressIndex.find (dest);
+
+      if (addrIt != m_phyRxAddressIndex.end ())
+        {
+          for (std::vector<uint32_t>::const_iterator indexIt = addrIt->second.begin (); indexIt != addrIt->second.end (); ++indexIt)
+            {
+              if (m_phyRxContainer[*indexIt]->GetBeamId () == txParams->m_beamId)
+                {
+                  indices.push_back (*indexIt);
+                }
+            }
+        }
+    }
+
+  /**
+   * Give the receivers in the receiver container order, so that each
+   * receiver gets the transmission only once and the receptions are scheduled
+   * in the same order as when iterating through all the receivers.
+   */
+  std::sort (indices.begin (), indices.end ());
+  indices.erase (std::unique (indices.begin (), indices.end ()), indices.end ());
+
+  for (std::vector<uint32_t>::const_iterator indexIt = indices.begin (); indexIt != indices.end (); ++indexIt)
+    {
+      receivers.push_back (m_phyRxContainer[*indexIt]);
+    }
+
+  return receivers;
+}
+
+void
+SatChannel::DoCulledAllBeamsTx (Ptr<const SatSignalBurst> burst)
 {
-  NS_LOG_FUNCTION (this << txParams << receiver);
+  NS_LOG_FUNCTION (this << burst);
+
+  Ptr<const SatSignalParameters> txParams = burst->GetTxParams ();
+
+  const CouplingRow_t& row = GetCouplingRow (txParams);
+  const double threshold = SatUtils::DbToLinear (m_interferenceCullingThreshold_dB);
+
+  uint32_t culledRxCount (0);
+  double culledCoupling (0.0);
+
+  for (uint32_t i = 0; i < m_phyRxContainer.size (); ++i)
+    {
+      if (IsCulled (row, i, txParams->m_beamId, threshold))
+        {
+          culledRxCount++;
+          culledCoupling += row[i];
+        }
+      else
+        {
+          ScheduleRx (burst, m_phyRxContainer[i]);
+          m_scheduledRxCount++;
+        }
+    }
+
+  if (culledRxCount > 0)
+    {
+      m_culledRxCount += culledRxCount;
+      m_maxCulledCoupling = std::max (m_maxCulledCoupling, culledCoupling);
+      m_interferenceCullingTrace (culledRxCount, SatUtils::LinearToDb (culledCoupling));
+    }
+}
+
+SatChannel::PhyRxContainer
+SatChannel::GetAllBeamsReceivers (Ptr<const SatSignalParameters> txParams)
+{
+  NS_LOG_FUNCTION (this << txParams);
+
+  if (!m_enableInterferenceCulling)
+    {
+      return m_phyRxContainer;
+    }
+
+  const CouplingRow_t& row = GetCouplingRow (txParams);
+  const double threshold = SatUtils::DbToLinear (m_interferenceCullingThreshold_dB);
+  PhyRxContainer receivers;
+
+  for (uint32_t i = 0; i < m_phyRxContainer.size (); ++i)
+    {
+      if (!IsCulled (row, i, txParams->m_beamId, threshold))
+        {
+          receivers.push_back (m_phyRxContainer[i]);
+        }
+    }
+
+  return receivers;
+}
+
+bool
+SatChannel::IsCulled (const CouplingRow_t& row, uint32_t rxIndex, uint32_t beamId, double threshold) const
+{
+  // The receivers of the own beam are never culled
+  return (m_phyRxContainer[rxIndex]->GetBeamId () != beamId) && (row[rxIndex] < threshold);
+}
+
+const SatChannel::CouplingRow_t&
+SatChannel::GetCouplingRow (Ptr<const SatSignalParameters> txParams)
+{
+  NS_LOG_FUNCTION (this << txParams);
+
+  std::map<Ptr<SatPhyTx>, CouplingRow_t>::iterator it = m_couplingMatrix.find (txParams->m_phyTx);
+
+  if (it != m_couplingMatrix.end ())
+    {
+      return it->second;
+    }
+
+  Ptr<MobilityModel> txMobility = txParams->m_phyTx->GetMobility ();
+  CouplingRow_t row (m_phyRxContainer.size (), 0.0);
+  double wantedGain (0.0);
+
+  // The row can be stored only if the course changes of all the positions are followed
+  bool isStatic = (GetMobilityEpoch (txMobility) != UNCACHEABLE_MOBILITY_EPOCH);
+
+  /**
+   * The coupling is estimated from the antenna gains only, since the free space
+   * loss differences between the receivers are marginal compared to the antenna
+   * gain differences. Same as in the Rx power calculation, always the UT's or
+   * GW's position is used when getting the antenna gain.
+   */
+  for (uint32_t i = 0; i < m_phyRxContainer.size (); ++i)
+    {
+      Ptr<SatPhyRx> phyRx = m_phyRxContainer[i];
+      Ptr<MobilityModel> position;
+
+      if (GetMobilityEpoch (phyRx->GetMobility ()) == UNCACHEABLE_MOBILITY_EPOCH)
+        {
+          isStatic = false;
+        }
+
+      switch (m_channelType)
+        {
+        case SatEnums::RETURN_FEEDER_CH:
+        case SatEnums::FORWARD_USER_CH:
+          {
+            position = phyRx->GetMobility ();
+            break;
+          }
+        case SatEnums::RETURN_USER_CH:
+        case SatEnums::FORWARD_FEEDER_CH:
+          {
+            position = txMobility;
+            break;
+          }
+        default:
+          {
+            NS_FATAL_ERROR ("SatChannel::GetCouplingRow - Invalid channel type");
+            break;
+          }
+        }
+
+      double gain = txParams->m_phyTx->GetAntennaGain (position) * phyRx->GetAntennaGain (position);
+
+      // Invalid antenna gain position, the receiver shall never be culled
+      if (std::isnan (gain))
+        {
+          gain = std::numeric_limits<double>::infinity ();
+        }
+      else if (phyRx->GetBeamId () == txParams->m_beamId)
+        {
+          wantedGain = std::max (wantedGain, gain);
+        }
+
+      row[i] = gain;
+    }
+
+  for (uint32_t i = 0; i < row.size (); ++i)
+    {
+      // Without a receiver in the own beam, nothing can be culled
+      row[i] = (wantedGain > 0.0) ? (row[i] / wantedGain) : std::numeric_limits<double>::infinity ();
+    }
+
+  if (!isStatic)
+    {
+      m_volatileCouplingRow = row;
+      return m_volatileCouplingRow;
+    }
+
+  return m_couplingMatrix.insert (std::make_pair (txParams->m_phyTx, row)).first->second;
+}
+
+void
+SatChannel::ScheduleRx (Ptr<const SatSignalBurst> burst, Ptr<SatPhyRx> receiver)
+{
+  NS_LOG_FUNCTION (this << burst << receiver);
+
+  Ptr<const SatSignalParameters> txParams = burst->GetTxParams ();
 
   Time delay = Seconds (0);
 
   Ptr<MobilityModel> senderMobility = txParams->m_phyTx->GetMobility ();
   Ptr<MobilityModel> receiverMobility = receiver->GetMobility ();
 
-  NS_LOG_INFO ("copying signal parameters " << txParams);
-  Ptr<SatSignalParameters> rxParams = txParams->Copy ();
-
   if (m_propagationDelay)
     {
       delay = m_propagationDelay->GetDelay (senderMobility, receiverMobility);
@@ -322,34 +656,35 @@ SatChannel::ScheduleRx (Ptr<SatSignalParameters> txParams, Ptr<SatPhyRx> receive
 
   Ptr<NetDevice> netDev = receiver->GetDevice ();
   uint32_t dstNodeId =  netDev->GetNode ()->GetId ();
-  Simulator::ScheduleWithContext (dstNodeId, delay, &SatChannel::StartRx, this, rxParams, receiver);
+  Simulator::ScheduleWithContext (dstNodeId, delay, &SatChannel::StartRx, this, burst, receiver);
 }
 
 void
-SatChannel::StartRx (Ptr<SatSignalParameters> rxParams, Ptr<SatPhyRx> phyRx)
+SatChannel::StartRx (Ptr<const SatSignalBurst> burst, Ptr<SatPhyRx> phyRx)
 {
-  NS_LOG_FUNCTION (this << rxParams << phyRx);
-
-  rxParams->m_channelType = m_channelType;
+  NS_LOG_FUNCTION (this << burst << phyRx);
 
-  double frequency_hz = m_carrierFreqConverter (m_channelType, m_freqId, rxParams->m_carrierId);
-  rxParams->m_carrierFreq_hz = frequency_hz;
+  SatSignalBurst::rxRecord_s rxRecord;
+  rxRecord.burst = burst;
+  rxRecord.channelType = m_channelType;
+  rxRecord.carrierFreq_hz = m_carrierFreqConverter (m_channelType, m_freqId, burst->GetTxParams ()->m_carrierId);
+  rxRecord.rxPower_W = 0.0;
 
   switch (m_rxPowerCalculationMode)
     {
     case SatEnums::RX_PWR_CALCULATION:
       {
-        DoRxPowerCalculation (rxParams, phyRx);
+        DoRxPowerCalculation (rxRecord, phyRx);
 
         if (m_enableRxPowerOutputTrace)
           {
-            DoRxPowerOutputTrace (rxParams, phyRx);
+            DoRxPowerOutputTrace (rxRecord, phyRx);
           }
         break;
       }
     case SatEnums::RX_PWR_INPUT_TRACE:
       {
-        DoRxPowerInputTrace (rxParams, phyRx);
+        DoRxPowerInputTrace (rxRecord, phyRx);
         break;
       }
     default:
@@ -359,27 +694,29 @@ SatChannel::StartRx (Ptr<SatSignalParameters> rxParams, Ptr<SatPhyRx> phyRx)
       }
     }
 
-  phyRx->StartRx (rxParams);
+  phyRx->StartRx (rxRecord);
 }
 
 void
-SatChannel::DoRxPowerOutputTrace (Ptr<SatSignalParameters> rxParams, Ptr<SatPhyRx> phyRx)
+SatChannel::DoRxPowerOutputTrace (const SatSignalBurst::rxRecord_s& rxRecord, Ptr<SatPhyRx> phyRx)
 {
-  NS_LOG_FUNCTION (this << rxParams << phyRx);
+  NS_LOG_FUNCTION (this << rxRecord.burst << phyRx);
+
+  Ptr<const SatSignalParameters> txParams = rxRecord.burst->GetTxParams ();
 
   // Get the bandwidth of the currently used carrier
-  double carrierBandwidthHz = m_carrierBandwidthConverter (m_channelType, rxParams->m_carrierId, SatEnums::EFFECTIVE_BANDWIDTH );
+  double carrierBandwidthHz = m_carrierBandwidthConverter (m_channelType, txParams->m_carrierId, SatEnums::EFFECTIVE_BANDWIDTH );
 
   NS_LOG_INFO ("SatChannel::DoRxPowerOutputTrace - carrier bw: " << carrierBandwidthHz <<
-                ", rxPower: " << SatUtils::LinearToDb (rxParams->m_rxPower_W) <<
-                ", carrierId: " << rxParams->m_carrierId <<
+                ", rxPower: " << SatUtils::LinearToDb (rxRecord.rxPower_W) <<
+                ", carrierId: " << txParams->m_carrierId <<
                 ", channelType: " << SatEnums::GetChannelTypeName (m_channelType));
 
   std::vector<double> tempVector;
   tempVector.push_back (Now ().GetSeconds ());
 
   // Output the Rx power density (W / Hz)
-  tempVector.push_back (rxParams->m_rxPower_W / carrierBandwidthHz);
+  tempVector.push_back (rxRecord.rxPower_W / carrierBandwidthHz);
 
   switch (m_channelType)
     {
@@ -392,7 +729,7 @@ SatChannel::DoRxPowerOutputTrace (Ptr<SatSignalParameters> rxParams, Ptr<SatPhyR
     case SatEnums::FORWARD_FEEDER_CH:
     case SatEnums::RETURN_USER_CH:
       {
-        Singleton<SatRxPowerOutputTraceContainer>::Get ()->AddToContainer (std::make_pair (GetSourceAddress (rxParams), m_channelType), tempVector);
+        Singleton<SatRxPowerOutputTraceContainer>::Get ()->AddToContainer (std::make_pair (GetSourceAddress (txParams), m_channelType), tempVector);
         break;
       }
     default:
@@ -404,12 +741,14 @@ SatChannel::DoRxPowerOutputTrace (Ptr<SatSignalParameters> rxParams, Ptr<SatPhyR
 }
 
 void
-SatChannel::DoRxPowerInputTrace (Ptr<SatSignalParameters> rxParams, Ptr<SatPhyRx> phyRx)
+SatChannel::DoRxPowerInputTrace (SatSignalBurst::rxRecord_s& rxRecord, Ptr<SatPhyRx> phyRx)
 {
-  NS_LOG_FUNCTION (this << rxParams << phyRx);
+  NS_LOG_FUNCTION (this << rxRecord.burst << phyRx);
+
+  Ptr<const SatSignalParameters> txParams = rxRecord.burst->GetTxParams ();
 
   // Get the bandwidth of the currently used carrier
-  double carrierBandwidthHz = m_carrierBandwidthConverter (m_channelType, rxParams->m_carrierId, SatEnums::EFFECTIVE_BANDWIDTH );
+  double carrierBandwidthHz = m_carrierBandwidthConverter (m_channelType, txParams->m_carrierId, SatEnums::EFFECTIVE_BANDWIDTH );
 
   switch (m_channelType)
     {
@@ -417,7 +756,7 @@ SatChannel::DoRxPowerInputTrace (Ptr<SatSignalParameters> rxParams, Ptr<SatPhyRx
     case SatEnums::FORWARD_USER_CH:
       {
         // Calculate the Rx power from Rx power density
-        rxParams->m_rxPower_W = carrierBandwidthHz * Singleton<SatRxPowerInputTraceContainer>::Get ()->GetRxPowerDensity (std::make_pair (phyRx->GetDevice ()->GetAddress (), m_channelType));
+        rxRecord.rxPower_W = carrierBandwidthHz * Singleton<SatRxPowerInputTraceContainer>::Get ()->GetRxPowerDensity (std::make_pair (phyRx->GetDevice ()->GetAddress (), m_channelType));
 
         break;
       }
@@ -425,7 +764,7 @@ SatChannel::DoRxPowerInputTrace (Ptr<SatSignalParameters> rxParams, Ptr<SatPhyRx
     case SatEnums::RETURN_USER_CH:
       {
         // Calculate the Rx power from Rx power density
-        rxParams->m_rxPower_W = carrierBandwidthHz * Singleton<SatRxPowerInputTraceContainer>::Get ()->GetRxPowerDensity (std::make_pair (GetSourceAddress (rxParams), m_channelType));
+        rxRecord.rxPower_W = carrierBandwidthHz * Singleton<SatRxPowerInputTraceContainer>::Get ()->GetRxPowerDensity (std::make_pair (GetSourceAddress (txParams), m_channelType));
         break;
       }
     default:
@@ -436,21 +775,23 @@ SatChannel::DoRxPowerInputTrace (Ptr<SatSignalParameters> rxParams, Ptr<SatPhyRx
     }
 
   NS_LOG_INFO ("SatChannel::DoRxPowerOutputTrace - carrier bw: " << carrierBandwidthHz <<
-                ", rxPower: " << SatUtils::LinearToDb (rxParams->m_rxPower_W) <<
-                ", carrierId: " << rxParams->m_carrierId <<
+                ", rxPower: " << SatUtils::LinearToDb (rxRecord.rxPower_W) <<
+                ", carrierId: " << txParams->m_carrierId <<
                 ", channelType: " << SatEnums::GetChannelTypeName (m_channelType));
 
   // get external fading input trace
   if (m_enableExternalFadingInputTrace)
     {
-      rxParams->m_rxPower_W /= GetExternalFadingTrace (rxParams, phyRx);
+      rxRecord.rxPower_W /= GetExternalFadingTrace (rxRecord, phyRx);
     }
 }
 
 void
-SatChannel::DoFadingOutputTrace (Ptr<SatSignalParameters> rxParams, Ptr<SatPhyRx> phyRx, double fadingValue)
+SatChannel::DoFadingOutputTrace (const SatSignalBurst::rxRecord_s& rxRecord, Ptr<SatPhyRx> phyRx, double fadingValue)
 {
-  NS_LOG_FUNCTION (this << rxParams << phyRx << fadingValue);
+  NS_LOG_FUNCTION (this << rxRecord.burst << phyRx << fadingValue);
+
+  Ptr<const SatSignalParameters> txParams = rxRecord.burst->GetTxParams ();
 
   std::vector<double> tempVector;
   tempVector.push_back (Now ().GetSeconds ());
@@ -467,7 +808,7 @@ SatChannel::DoFadingOutputTrace (Ptr<SatSignalParameters> rxParams, Ptr<SatPhyRx
     case SatEnums::FORWARD_FEEDER_CH:
     case SatEnums::RETURN_USER_CH:
       {
-        Singleton<SatFadingOutputTraceContainer>::Get ()->AddToContainer (std::make_pair (GetSourceAddress (rxParams), m_channelType), tempVector);
+        Singleton<SatFadingOutputTraceContainer>::Get ()->AddToContainer (std::make_pair (GetSourceAddress (txParams), m_channelType), tempVector);
         break;
       }
     default:
@@ -479,15 +820,16 @@ SatChannel::DoFadingOutputTrace (Ptr<SatSignalParameters> rxParams, Ptr<SatPhyRx
 }
 
 void
-SatChannel::DoRxPowerCalculation (Ptr<SatSignalParameters> rxParams, Ptr<SatPhyRx> phyRx)
+SatChannel::DoRxPowerCalculation (SatSignalBurst::rxRecord_s& rxRecord, Ptr<SatPhyRx> phyRx)
 {
-  NS_LOG_FUNCTION (this << rxParams << phyRx);
+  NS_LOG_FUNCTION (this << rxRecord.burst << phyRx);
+
+  Ptr<const SatSignalParameters> txParams = rxRecord.burst->GetTxParams ();
 
-  Ptr<MobilityModel> txMobility = rxParams->m_phyTx->GetMobility ();
+  Ptr<MobilityModel> txMobility = txParams->m_phyTx->GetMobility ();
   Ptr<MobilityModel> rxMobility = phyRx->GetMobility ();
 
-  double txAntennaGain_W = 0.0;
-  double rxAntennaGain_W = 0.0;
+  LinkBudget_s linkBudget;
   double markovFading = 0.0;
   double extFading = 1.0;
 
@@ -497,17 +839,15 @@ SatChannel::DoRxPowerCalculation (Ptr<SatSignalParameters> rxParams, Ptr<SatPhyR
     case SatEnums::RETURN_FEEDER_CH:
     case SatEnums::FORWARD_USER_CH:
       {
-        txAntennaGain_W = rxParams->m_phyTx->GetAntennaGain (rxMobility);
-        rxAntennaGain_W = phyRx->GetAntennaGain (rxMobility);
+        linkBudget = GetLinkBudget (rxRecord, phyRx, txMobility, rxMobility, rxMobility);
         markovFading = phyRx->GetFadingValue (phyRx->GetDevice ()->GetAddress (), m_channelType);
         break;
       }
     case SatEnums::RETURN_USER_CH:
     case SatEnums::FORWARD_FEEDER_CH:
       {
-        txAntennaGain_W = rxParams->m_phyTx->GetAntennaGain (txMobility);
-        rxAntennaGain_W = phyRx->GetAntennaGain (txMobility);
-        markovFading = rxParams->m_phyTx->GetFadingValue (GetSourceAddress (rxParams), m_channelType);
+        linkBudget = GetLinkBudget (rxRecord, phyRx, txMobility, rxMobility, txMobility);
+        markovFading = txParams->m_phyTx->GetFadingValue (GetSourceAddress (txParams), m_channelType);
         break;
       }
     default:
@@ -525,7 +865,7 @@ SatChannel::DoRxPowerCalculation (Ptr<SatSignalParameters> rxParams, Ptr<SatPhyR
    */
   if (m_enableExternalFadingInputTrace)
     {
-      extFading = GetExternalFadingTrace (rxParams, phyRx);
+      extFading = GetExternalFadingTrace (rxRecord, phyRx);
     }
 
   /**
@@ -535,18 +875,164 @@ SatChannel::DoRxPowerCalculation (Ptr<SatSignalParameters> rxParams, Ptr<SatPhyR
    */
   if (m_enableFadingOutputTrace)
     {
-      DoFadingOutputTrace (rxParams, phyRx, markovFading);
+      DoFadingOutputTrace (rxRecord, phyRx, markovFading);
     }
 
   // get (calculate) free space loss and RX power and set it to RX params
-  double rxPower_W = (rxParams->m_txPower_W * txAntennaGain_W) / m_freeSpaceLoss->GetFsl (txMobility, rxMobility, rxParams->m_carrierFreq_hz);
-  rxParams->m_rxPower_W = rxPower_W * rxAntennaGain_W / phyRx->GetLosses () * markovFading / extFading;
+  double rxPower_W = (txParams->m_txPower_W * linkBudget.txAntennaGain_W) / linkBudget.fsl;
+  rxRecord.rxPower_W = rxPower_W * linkBudget.rxAntennaGain_W / phyRx->GetLosses () * markovFading / extFading;
+}
+
+SatChannel::LinkBudget_s
+SatChannel::GetLinkBudget (const SatSignalBurst::rxRecord_s& rxRecord,
+                           Ptr<SatPhyRx> phyRx,
+                           Ptr<MobilityModel> txMobility,
+                           Ptr<MobilityModel> rxMobility,
+                           Ptr<MobilityModel> gainMobility)
+{
+  NS_LOG_FUNCTION (this << rxRecord.burst << phyRx);
+
+  Ptr<const SatSignalParameters> txParams = rxRecord.burst->GetTxParams ();
+
+  LinkBudget_s linkBudget;
+  linkBudget.txMobilityEpoch = UNCACHEABLE_MOBILITY_EPOCH;
+  linkBudget.rxMobilityEpoch = UNCACHEABLE_MOBILITY_EPOCH;
+
+  LinkBudgetKey_t key = std::make_pair (std::make_pair (txParams->m_phyTx, phyRx), rxRecord.carrierFreq_hz);
+
+  if (m_enableLinkBudgetCache)
+    {
+      linkBudget.txMobilityEpoch = GetMobilityEpoch (txMobility);
+      linkBudget.rxMobilityEpoch = GetMobilityEpoch (rxMobility);
+
+      std::map<LinkBudgetKey_t, LinkBudgetEntry_s>::iterator it = m_linkBudgetCache.find (key);
+
+      if ( (it != m_linkBudgetCache.end ()) &&
+           (it->second.linkBudget.txMobilityEpoch == linkBudget.txMobilityEpoch) &&
+           (it->second.linkBudget.rxMobilityEpoch == linkBudget.rxMobilityEpoch) )
+        {
+          m_linkBudgetLru.splice (m_linkBudgetLru.begin (), m_linkBudgetLru, it->second.lruIt);
+          return it->second.linkBudget;
+        }
+    }
+
+  linkBudget.txAntennaGain_W = txParams->m_phyTx->GetAntennaGain (gainMobility);
+  linkBudget.rxAntennaGain_W = phyRx->GetAntennaGain (gainMobility);
+  linkBudget.fsl = m_freeSpaceLoss->GetFsl (txMobility, rxMobility, rxRecord.carrierFreq_hz);
+
+  if ( (linkBudget.txMobilityEpoch != UNCACHEABLE_MOBILITY_EPOCH) &&
+       (linkBudget.rxMobilityEpoch != UNCACHEABLE_MOBILITY_EPOCH) )
+    {
+      std::map<LinkBudgetKey_t, LinkBudgetEntry_s>::iterator it = m_linkBudgetCache.find (key);
+
+      if (it != m_linkBudgetCache.end ())
+        {
+          // Outdated entry of the same link
+          it->second.linkBudget = linkBudget;
+          m_linkBudgetLru.splice (m_linkBudgetLru.begin (), m_linkBudgetLru, it->second.lruIt);
+        }
+      else
+        {
+          if (m_linkBudgetCache.size () >= m_linkBudgetCacheSize)
+            {
+              EvictLinkBudget ();
+            }
+
+          m_linkBudgetLru.push_front (key);
+
+          LinkBudgetEntry_s entry;
+          entry.linkBudget = linkBudget;
+          entry.lruIt = m_linkBudgetLru.begin ();
+          m_linkBudgetCache.insert (std::make_pair (key, entry));
+        }
+    }
+
+  return linkBudget;
+}
+
+uint32_t
+SatChannel::GetMobilityEpoch (Ptr<MobilityModel> mobility)
+{
+  NS_LOG_FUNCTION (this << mobility);
+
+  std::map<const MobilityModel*, uint32_t>::const_iterator it = m_mobilityEpochs.find (PeekPointer (mobility));
+
+  if (it != m_mobilityEpochs.end ())
+    {
+      return it->second;
+    }
+
+  /**
+   * Only the satellite mobility models notify their position changes
+   * through the SatCourseChange trace source. The link budgets of the
+   * other mobility models are always calculated.
+   */
+  uint32_t epoch = UNCACHEABLE_MOBILITY_EPOCH;
+
+  if (mobility->TraceConnectWithoutContext ("SatCourseChange", MakeCallback (&SatChannel::MobilityCourseChanged, this)))
+    {
+      epoch = 0;
+      m_followedMobilities.push_back (mobility);
+    }
+
+  m_mobilityEpochs.insert (std::make_pair (PeekPointer (mobility), epoch));
+
+  return epoch;
+}
+
+void
+SatChannel::EvictLinkBudget ()
+{
+  NS_LOG_FUNCTION (this);
+
+  NS_ASSERT (!m_linkBudgetLru.empty ());
+
+  std::map<LinkBudgetKey_t, LinkBudgetEntry_s>::iterator it = m_linkBudgetCache.find (m_linkBudgetLru.back ());
+  NS_ASSERT (it != m_linkBudgetCache.end ());
+
+  if (!m_linkBudgetCacheWarned)
+    {
+      std::map<const MobilityModel*, uint32_t>::const_iterator txIt =
+        m_mobilityEpochs.find (PeekPointer (it->first.first.first->GetMobility ()));
+      std::map<const MobilityModel*, uint32_t>::const_iterator rxIt =
+        m_mobilityEpochs.find (PeekPointer (it->first.first.second->GetMobility ()));
+
+      if ( (txIt != m_mobilityEpochs.end ()) && (txIt->second == it->second.linkBudget.txMobilityEpoch) &&
+           (rxIt != m_mobilityEpochs.end ()) && (rxIt->second == it->second.linkBudget.rxMobilityEpoch) )
+        {
+          NS_LOG_WARN ("Link budget cache of " << m_linkBudgetCacheSize << " entries too small for the links of the channel, "
+                       "increase LinkBudgetCacheSize to at least the number of transmitters times receivers times carriers");
+          m_linkBudgetCacheWarned = true;
+        }
+    }
+
+  m_linkBudgetCache.erase (it);
+  m_linkBudgetLru.pop_back ();
+}
+
+void
+SatChannel::MobilityCourseChanged (Ptr<const SatMobilityModel> mobility)
+{
+  NS_LOG_FUNCTION (this << mobility);
+
+  std::map<const MobilityModel*, uint32_t>::iterator it = m_mobilityEpochs.find (PeekPointer (mobility));
+
+  if ( (it != m_mobilityEpochs.end ()) && (it->second != UNCACHEABLE_MOBILITY_EPOCH) )
+    {
+      // Wrap around before the uncacheable epoch value
+      it->second = (it->second + 1) % UNCACHEABLE_MOBILITY_EPOCH;
+
+      // The position of any transmitter or receiver affects all the coupling rows
+      m_couplingMatrix.clear ();
+    }
 }
 
 double
-SatChannel::GetExternalFadingTrace (Ptr<SatSignalParameters> rxParams, Ptr<SatPhyRx> phyRx)
+SatChannel::GetExternalFadingTrace (const SatSignalBurst::rxRecord_s& rxRecord, Ptr<SatPhyRx> phyRx)
 {
-  NS_LOG_FUNCTION (this << rxParams << phyRx);
+  NS_LOG_FUNCTION (this << rxRecord.burst << phyRx);
+
+  Ptr<const SatSignalParameters> txParams = rxRecord.burst->GetTxParams ();
 
   int32_t nodeId;
   Ptr<MobilityModel> mobility;
@@ -567,14 +1053,14 @@ SatChannel::GetExternalFadingTrace (Ptr<SatSignalParameters> rxParams, Ptr<SatPh
       }
     case SatEnums::RETURN_USER_CH:
       {
-        nodeId = Singleton<SatIdMapper>::Get ()->GetUtIdWithMac (GetSourceAddress (rxParams));
-        mobility = rxParams->m_phyTx->GetMobility ();
+        nodeId = Singleton<SatIdMapper>::Get ()->GetUtIdWithMac (GetSourceAddress (txParams));
+        mobility = txParams->m_phyTx->GetMobility ();
         break;
       }
     case SatEnums::FORWARD_FEEDER_CH:
       {
-        nodeId = Singleton<SatIdMapper>::Get ()->GetGwIdWithMac (GetSourceAddress (rxParams));
-        mobility = rxParams->m_phyTx->GetMobility ();
+        nodeId = Singleton<SatIdMapper>::Get ()->GetGwIdWithMac (GetSourceAddress (txParams));
+        mobility = txParams->m_phyTx->GetMobility ();
         break;
       }
     default:
@@ -594,13 +1080,13 @@ SatChannel::GetExternalFadingTrace (Ptr<SatSignalParameters> rxParams, Ptr<SatPh
 
 /// TODO get rid of source MAC address peeking
 Mac48Address
-SatChannel::GetSourceAddress (Ptr<SatSignalParameters> rxParams)
+SatChannel::GetSourceAddress (Ptr<const SatSignalParameters> txParams)
 {
-  NS_LOG_FUNCTION (this << rxParams);
+  NS_LOG_FUNCTION (this << txParams);
 
   SatMacTag tag;
 
-  SatSignalParameters::PacketsInBurst_t::const_iterator i = rxParams->m_packetsInBurst.begin ();
+  SatSignalParameters::PacketsInBurst_t::const_iterator i = txParams->m_packetsInBurst.begin ();
 
   if (*i == NULL)
     {
@@ -27,9 +27,14 @@
 #include "ns3/channel.h"
 #include "ns3/traced-callback.h"
 #include "ns3/propagation-delay-model.h"
+#include <map>
+#include <list>
+#include <unordered_map>
+#include "ns3/mac48-address.h"
 #include "satellite-signal-parameters.h"
 #include "satellite-free-space-loss.h"
 #include "satellite-phy-rx.h"
+#include "satellite-mobility-model.h"
 #include "satellite-phy-rx-carrier-conf.h"
 #include "satellite-enums.h"
 #include "satellite-typedefs.h"
@@ -104,6 +109,17 @@ public:
    */
   typedef Callback<double, SatEnums::ChannelType_t, uint32_t, uint32_t  > CarrierFreqConverter;
 
+  /**
+   * \brief Callback signature for `InterferenceCulling` trace source.
+   * \param culledRxCount number of receivers which did not receive the
+   *        transmission due to negligible interference coupling
+   * \param culledCoupling_dB aggregated antenna gain coupling of the culled
+   *        receivers in dB relative to the wanted signal, i.e. an upper bound
+   *        for the interference error introduced by the culling
+   */
+  typedef void (*InterferenceCullingTraceCallback)
+    (uint32_t culledRxCount, double culledCoupling_dB);
+
   /**
    * \brief Set the  propagation delay model to be used in the SatChannel
    * \param delay Ptr to the propagation delay model to be used.
@@ -186,7 +202,35 @@ public:
    */
   virtual Ptr<NetDevice> GetDevice (std::size_t i) const;
 
+  /**
+   * \brief Get the receivers of a transmission in ALL_BEAMS mode. With
+   * interference culling enabled, the receivers outside the beam of the
+   * transmission with antenna gain coupling below InterferenceCullingThreshold
+   * are left out.
+   * \param txParams the parameters of the transmitted signal
+   * \return the receivers of the transmission in the receiver container order
+   */
+  PhyRxContainer GetAllBeamsReceivers (Ptr<const SatSignalParameters> txParams);
+
+  /**
+   * \brief Get the receivers of a transmission in ONLY_DEST_NODE mode to a
+   * terrestrial node, i.e. the receivers in the beam of the transmission which
+   * are the destination of a packet in the burst. All the receivers of the beam
+   * are destinations of a broadcast or a group packet.
+   * \param txParams the parameters of the transmitted signal
+   * \return the receivers of the transmission in the receiver container order
+   */
+  PhyRxContainer GetDestNodeReceivers (Ptr<const SatSignalParameters> txParams);
+
 private:
+  /**
+   * \brief Hash function of MAC addresses for the receiver address index
+   */
+  struct Mac48AddressHash
+  {
+    std::size_t operator() (const Mac48Address& address) const;
+  };
+
   /**
    * Forwarding mode of the SatChannel:
    * SINGLE_RX = only the proper receiver of the packet shall receive the packet
@@ -199,6 +243,22 @@ private:
    */
   PhyRxContainer m_phyRxContainer;
 
+  /**
+   * \brief Index of the receivers in m_phyRxContainer by their MAC address
+   */
+  std::unordered_map<Mac48Address, std::vector<uint32_t>, Mac48AddressHash> m_phyRxAddressIndex;
+
+  /**
+   * \brief Indices of the receivers in m_phyRxContainer by their beam
+   */
+  std::unordered_map<uint32_t, std::vector<uint32_t> > m_phyRxBeamIndex;
+
+  /**
+   * \brief Flag telling that the receiver indices have to be rebuilt
+   * before the next use, since the receiver container has been changed.
+   */
+  bool m_phyRxIndexDirty;
+
   /**
    * \brief Type of the channel
    */
@@ -249,6 +309,142 @@ private:
    */
   bool m_enableExternalFadingInputTrace;
 
+  /**
+   * \brief Defines whether the static part of the link budget is cached
+   */
+  bool m_enableLinkBudgetCache;
+
+  /**
+   * \brief Maximum number of entries in the link budget cache
+   */
+  uint32_t m_linkBudgetCacheSize;
+
+  /**
+   * \brief Static part of the link budget between a transmitter and a receiver
+   * on a certain carrier frequency, i.e. the antenna gains and the free space loss.
+   * The entry is valid as long as the mobility epochs of the transmitter and the
+   * receiver are the same as when the entry was calculated.
+   */
+  typedef struct
+  {
+    double txAntennaGain_W;
+    double rxAntennaGain_W;
+    double fsl;
+    uint32_t txMobilityEpoch;
+    uint32_t rxMobilityEpoch;
+  } LinkBudget_s;
+
+  /**
+   * \brief Key of the link budget cache: transmitter, receiver and carrier frequency
+   */
+  typedef std::pair<std::pair<Ptr<SatPhyTx>, Ptr<SatPhyRx> >, double> LinkBudgetKey_t;
+
+  /**
+   * \brief Keys of the link budget cache from the most recently to the
+   * least recently used entry
+   */
+  typedef std::list<LinkBudgetKey_t> LinkBudgetLru_t;
+
+  /**
+   * \brief Entry of the link budget cache with its position in the usage order
+   */
+  typedef struct
+  {
+    LinkBudget_s linkBudget;
+    LinkBudgetLru_t::iterator lruIt;
+  } LinkBudgetEntry_s;
+
+  /**
+   * \brief Cache for the static part of the link budgets
+   */
+  std::map<LinkBudgetKey_t, LinkBudgetEntry_s> m_linkBudgetCache;
+
+  /**
+   * \brief Usage order of the link budget cache entries
+   */
+  LinkBudgetLru_t m_linkBudgetLru;
+
+  /**
+   * \brief Flag telling that a warning of a too small link budget cache
+   * has been given
+   */
+  bool m_linkBudgetCacheWarned;
+
+  /**
+   * \brief Position epoch of each mobility model followed by the channel.
+   * The epoch is increased at every course change of the mobility model, which
+   * invalidates the cached link budgets of the mobility model.
+   */
+  std::map<const MobilityModel*, uint32_t> m_mobilityEpochs;
+
+  /**
+   * \brief Mobility models whose SatCourseChange trace source is connected to
+   * the channel. Disconnected when the channel is disposed.
+   */
+  std::vector<Ptr<MobilityModel> > m_followedMobilities;
+
+  /**
+   * \brief Epoch value of the mobility models which do not notify their
+   * course changes, i.e. the link budgets of which cannot be cached.
+   */
+  static const uint32_t UNCACHEABLE_MOBILITY_EPOCH = 0xFFFFFFFF;
+
+  /**
+   * \brief Defines whether the receivers with negligible interference coupling
+   * are culled from the receivers of a transmission in ALL_BEAMS mode.
+   */
+  bool m_enableInterferenceCulling;
+
+  /**
+   * \brief Antenna gain coupling threshold in dB relative to the wanted signal.
+   * Receivers below the threshold are culled, if culling is enabled.
+   */
+  double m_interferenceCullingThreshold_dB;
+
+  /**
+   * \brief Container for the antenna gain coupling from one transmitter to all
+   * the receivers of the channel. The coupling is given in linear relative to the
+   * best coupling towards a receiver in the same beam as the transmitter (i.e.
+   * the wanted signal). Indexing follows m_phyRxContainer.
+   */
+  typedef std::vector<double> CouplingRow_t;
+
+  /**
+   * \brief Interference coupling matrix of the channel, one row per transmitter.
+   * The rows are calculated at the first transmission of each transmitter and
+   * cleared whenever the set of receivers is changed or any of the transmitters
+   * or receivers changes its course. Only the rows of which all the mobility
+   * models notify their course changes are stored.
+   */
+  std::map<Ptr<SatPhyTx>, CouplingRow_t> m_couplingMatrix;
+
+  /**
+   * \brief Latest coupling row which could not be stored in the matrix, since
+   * not all the mobility models of the row notify their course changes.
+   */
+  CouplingRow_t m_volatileCouplingRow;
+
+  /**
+   * \brief Total number of culled receptions.
+   */
+  uint64_t m_culledRxCount;
+
+  /**
+   * \brief Total number of scheduled receptions in ALL_BEAMS mode.
+   */
+  uint64_t m_scheduledRxCount;
+
+  /**
+   * \brief Maximum aggregated coupling (linear, relative to the wanted signal)
+   * culled from a single transmission.
+   */
+  double m_maxCulledCoupling;
+
+  /**
+   * \brief Traced callback for culled receptions.
+   */
+  TracedCallback<uint32_t, double> m_interferenceCullingTrace;
+
   /**
    * Dispose SatChannel.
    */
@@ -256,62 +452,143 @@ private:
 
   /**
    * \brief Used internally to schedule the StartRx method call after the propagation delay.
-   * \param rxParams Parameters of the signal being received
+   * \param burst Burst of the transmission shared by all the receivers
    * \param phyRx The receiver SatPhyRx entity
    */
-  void ScheduleRx (Ptr<SatSignalParameters> txParams, Ptr<SatPhyRx> phyRx);
+  void ScheduleRx (Ptr<const SatSignalBurst> burst, Ptr<SatPhyRx> phyRx);
 
   /**
    * \brief Used internally to start the packet reception of at the phyRx.
    *
-   * \param rxParams Parameters of the signal being received
+   * \param burst Burst of the transmission shared by all the receivers
    * \param phyRx The receiver SatPhyRx entity
    */
-  void StartRx (Ptr<SatSignalParameters> rxParams, Ptr<SatPhyRx> phyRx);
+  void StartRx (Ptr<const SatSignalBurst> burst, Ptr<SatPhyRx> phyRx);
 
   /**
    * \brief Function for Rx power output trace
-   * \param rxParams Rx parameters
+   * \param rxRecord Per-receiver record of the burst
    * \param phyRx The receiver SatPhyRx entity
    */
-  void DoRxPowerOutputTrace (Ptr<SatSignalParameters> rxParams, Ptr<SatPhyRx> phyRx);
+  void DoRxPowerOutputTrace (const SatSignalBurst::rxRecord_s& rxRecord, Ptr<SatPhyRx> phyRx);
 
   /**
    * \brief Function for Rx power input trace
-   * \param rxParams Rx parameters
+   * \param rxRecord Per-receiver record of the burst, Rx power is set to it
    * \param phyRx The receiver SatPhyRx entity
    */
-  void DoRxPowerInputTrace (Ptr<SatSignalParameters> rxParams, Ptr<SatPhyRx> phyRx);
+  void DoRxPowerInputTrace (SatSignalBurst::rxRecord_s& rxRecord, Ptr<SatPhyRx> phyRx);
 
   /**
    * \brief Function for fading output trace
-   * \param rxParams Rx parameters
+   * \param rxRecord Per-receiver record of the burst
    * \param phyRx The receiver SatPhyRx entity
    * \param fadingValue fading value
    */
-  void DoFadingOutputTrace (Ptr<SatSignalParameters> rxParams, Ptr<SatPhyRx> phyRx, double fadingValue);
+  void DoFadingOutputTrace (const SatSignalBurst::rxRecord_s& rxRecord, Ptr<SatPhyRx> phyRx, double fadingValue);
 
   /**
    * \brief Function for calculating the Rx power
-   * \param rxParams Rx parameters
+   * \param rxRecord Per-receiver record of the burst, Rx power is set to it
+   * \param phyRx The receiver SatPhyRx entity
+   */
+  void DoRxPowerCalculation (SatSignalBurst::rxRecord_s& rxRecord, Ptr<SatPhyRx> phyRx);
+
+  /**
+   * \brief Get the static part of the link budget, i.e. the antenna gains and
+   * the free space loss, either from the link budget cache or by calculating it.
+   * \param rxRecord Per-receiver record of the burst
    * \param phyRx The receiver SatPhyRx entity
+   * \param txMobility Mobility of the transmitter
+   * \param rxMobility Mobility of the receiver
+   * \param gainMobility Mobility at which position the antenna gains are taken
+   * \return Link budget
+   */
+  LinkBudget_s GetLinkBudget (const SatSignalBurst::rxRecord_s& rxRecord,
+                              Ptr<SatPhyRx> phyRx,
+                              Ptr<MobilityModel> txMobility,
+                              Ptr<MobilityModel> rxMobility,
+                              Ptr<MobilityModel> gainMobility);
+
+  /**
+   * \brief Get the position epoch of a mobility model. The channel starts
+   * to follow the course changes of the mobility model at the first call.
+   * \param mobility Mobility model
+   * \return Epoch of the mobility model, or UNCACHEABLE_MOBILITY_EPOCH
    */
-  void DoRxPowerCalculation (Ptr<SatSignalParameters> rxParams, Ptr<SatPhyRx> phyRx);
+  uint32_t GetMobilityEpoch (Ptr<MobilityModel> mobility);
+
+  /**
+   * \brief Make room in the full link budget cache by removing the least
+   * recently used entry. The entries outdated by course changes are not used
+   * any more, thus they end up as the least recently used ones. A warning is given once, if a valid
+   * entry has to be removed, since then the cache is too small for the links
+   * of the channel.
+   */
+  void EvictLinkBudget ();
+
+  /**
+   * \brief Callback for the course changes of the followed mobility models.
+   * Invalidates the cached link budgets of the mobility model and the
+   * interference coupling matrix.
+   * \param mobility Mobility model which changed its course
+   */
+  void MobilityCourseChanged (Ptr<const SatMobilityModel> mobility);
 
   /**
    * \brief Function for getting the external source fading value
-   * \param rxParams Rx parameters
+   * \param rxRecord Per-receiver record of the burst
    * \param phyRx The receiver SatPhyRx entity
    * \return fading value
    */
-  double GetExternalFadingTrace (Ptr<SatSignalParameters> rxParams, Ptr<SatPhyRx> phyRx);
+  double GetExternalFadingTrace (const SatSignalBurst::rxRecord_s& rxRecord, Ptr<SatPhyRx> phyRx);
+
+  /**
+   * \brief Pass the transmission only to the receivers to which the packets
+   * of the burst are destined to. The receivers are looked up by the packets'
+   * destination MAC addresses, so that the receivers of the channel need not
+   * to be iterated through.
+   * \param burst Burst of the transmission
+   */
+  void DoDestNodeTx (Ptr<const SatSignalBurst> burst);
+
+  /**
+   * \brief Rebuild the receiver indices, if the receiver container has
+   * been changed since the previous build.
+   */
+  void UpdatePhyRxIndex ();
+
+  /**
+   * \brief Pass the transmission to all the receivers of the channel, except
+   * the ones to which the transmission would cause only negligible interference.
+   * \param burst Burst of the transmission
+   */
+  void DoCulledAllBeamsTx (Ptr<const SatSignalBurst> burst);
+
+  /**
+   * \brief Check whether a receiver is culled from a transmission.
+   * \param row Coupling row of the transmitter
+   * \param rxIndex Index of the receiver in the receiver container
+   * \param beamId Beam id of the transmission
+   * \param threshold Culling threshold in linear
+   * \return true if the receiver is culled
+   */
+  bool IsCulled (const CouplingRow_t& row, uint32_t rxIndex, uint32_t beamId, double threshold) const;
+
+  /**
+   * \brief Get the interference coupling row of a transmitter. The row is
+   * calculated if it does not exist yet.
+   * \param txParams Parameters of the signal being transmitted
+   * \return Coupling from the transmitter to each receiver of the channel
+   */
+  const CouplingRow_t& GetCouplingRow (Ptr<const SatSignalParameters> txParams);
 
   /**
-   * \brief Function for getting the source MAC address from Rx parameters
-   * \param rxParams Rx parameters
+   * \brief Function for getting the source MAC address from Tx parameters
+   * \param txParams Parameters of the signal being transmitted
    * \return source MAC address
    */
-  Mac48Address GetSourceAddress (Ptr<SatSignalParameters> rxParams);
+  Mac48Address GetSourceAddress (Ptr<const SatSignalParameters> txParams);
 
 };
 
@@ -0,0 +1,328 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 Magister Solutions Ltd
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Jani Puttonen <jani.puttonen@magister.fi>
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <utility>
+
+#include "satellite-utils.h"
+#include "satellite-link-results.h"
+#include "satellite-crdsa-frame-decoder.h"
+
+namespace ns3 {
+
+SatCrdsaFrameDecoder::SatCrdsaFrameDecoder ()
+  : m_errorModel (SatPhyRxCarrierConf::EM_NONE),
+    m_constantErrorRate (0.0),
+    m_collisionModel (SatPhyRxCarrierConf::RA_COLLISION_CHECK_AGAINST_SINR),
+    m_error (DECODING_OK)
+{
+}
+
+void
+SatCrdsaFrameDecoder::SetModels (SatPhyRxCarrierConf::ErrorModel errorModel,
+                                 double constantErrorRate,
+                                 SatPhyRxCarrierConf::RandomAccessCollisionModel collisionModel)
+{
+  m_errorModel = errorModel;
+  m_constantErrorRate = constantErrorRate;
+  m_collisionModel = collisionModel;
+}
+
+void
+SatCrdsaFrameDecoder::SetLinkResults (Ptr<const SatLinkResultsDvbRcs2> linkResults)
+{
+  m_linkResults = linkResults;
+}
+
+void
+SatCrdsaFrameDecoder::SetRandomValueCallback (RandomValueCallback cb)
+{
+  m_randomValueCallback = cb;
+}
+
+void
+SatCrdsaFrameDecoder::Clear ()
+{
+  m_packets.clear ();
+  m_states.clear ();
+  m_slots.clear ();
+  m_replicaGroups.clear ();
+  m_readyPackets.clear ();
+  m_decodedPackets.clear ();
+  m_processedPackets.clear ();
+  m_error = DECODING_OK;
+}
+
+void
+SatCrdsaFrameDecoder::AddPacket (const packet_s& packet)
+{
+  packetState_s state;
+  state.slot = 0;
+  state.replicaGroup = 0;
+  state.ifPowerInSatelliteW = packet.ifPowerInSatelliteW;
+  state.cSinr = 0.0;
+  state.phyError = false;
+  state.removed = false;
+
+  m_packets.push_back (packet);
+  m_states.push_back (state);
+}
+
+bool
+SatCrdsaFrameDecoder::BuildFrame ()
+{
+  /// replicas have the same sender and the same set of slots
+  typedef std::pair<Mac48Address, std::vector<uint16_t> > ReplicaGroupKey_t;
+  std::map<ReplicaGroupKey_t, uint32_t> replicaGroupIndices;
+
+  for (uint32_t packetIndex = 0; packetIndex < m_packets.size (); packetIndex++)
+    {
+      const packet_s& packet = m_packets[packetIndex];
+      packetState_s& state = m_states[packetIndex];
+
+      if (packetIndex == 0 || packet.ownSlotId != m_packets[packetIndex - 1].ownSlotId)
+        {
+          m_slots.push_back (slot_s ());
+          m_slots.back ().packetCount = 0;
+        }
+
+      std::pair<std::map<ReplicaGroupKey_t, uint32_t>::iterator, bool> group =
+        replicaGroupIndices.insert (std::make_pair (std::make_pair (packet.sourceAddress, packet.slotIds), m_replicaGroups.size ()));
+
+      if (group.second)
+        {
+          m_replicaGroups.push_back (std::vector<uint32_t> ());
+        }
+
+      state.slot = m_slots.size () - 1;
+      state.replicaGroup = group.first->second;
+
+      m_slots.back ().packets.push_back (packetIndex);
+      m_slots.back ().packetCount++;
+      m_replicaGroups[state.replicaGroup].push_back (packetIndex);
+      m_readyPackets.insert (m_readyPackets.end (), packetIndex);
+    }
+
+  /// each replica group shall have exactly one packet in each of its slots
+  std::map<ReplicaGroupKey_t, uint32_t>::const_iterator groupIter;
+
+  for (groupIter = replicaGroupIndices.begin (); groupIter != replicaGroupIndices.end (); groupIter++)
+    {
+      const std::vector<uint32_t>& members = m_replicaGroups[groupIter->second];
+      std::vector<uint16_t> memberSlotIds;
+
+      for (uint32_t i = 0; i < members.size (); i++)
+        {
+          memberSlotIds.push_back (m_packets[members[i]].ownSlotId);
+        }
+
+      std::sort (memberSlotIds.begin (), memberSlotIds.end ());
+
+      if (memberSlotIds != groupIter->first.second)
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+
+void
+SatCrdsaFrameDecoder::Decode ()
+{
+  if (!BuildFrame ())
+    {
+      m_error = REPLICA_NOT_FOUND;
+      return;
+    }
+
+  while (!m_readyPackets.empty () && m_error == DECODING_OK)
+    {
+      uint32_t packetIndex = *m_readyPackets.begin ();
+      m_readyPackets.erase (m_readyPackets.begin ());
+
+      ProcessPacket (packetIndex);
+
+      /// packet successfully received
+      if (m_error == DECODING_OK && !m_states[packetIndex].phyError)
+        {
+          /// remove the successfully received packet from the slot
+          RemovePacket (packetIndex);
+
+          /// eliminate the interference caused by this packet to other packets in this slot
+          EliminateInterference (packetIndex);
+
+          /// remove replicas of the received packet and their interference
+          RemoveReplicas (packetIndex, true);
+
+          m_decodedPackets.push_back (packetIndex);
+        }
+    }
+
+  /// the rest of the packets are unsuccessfully received, one of each unique payload is passed
+  for (uint32_t packetIndex = 0; packetIndex < m_packets.size () && m_error == DECODING_OK; packetIndex++)
+    {
+      if (m_states[packetIndex].removed)
+        {
+          continue;
+        }
+
+      RemoveReplicas (packetIndex, false);
+      RemovePacket (packetIndex);
+
+      m_decodedPackets.push_back (packetIndex);
+    }
+}
+
+void
+SatCrdsaFrameDecoder::ProcessPacket (uint32_t packetIndex)
+{
+  const packet_s& packet = m_packets[packetIndex];
+  packetState_s& state = m_states[packetIndex];
+
+  m_processedPackets.push_back (packetIndex);
+
+  /// the same arithmetic as in SatPhyRxCarrier::CalculateSinr and CalculateCompositeSinr
+  double sinrSatellite = packet.rxPowerInSatelliteW / (state.ifPowerInSatelliteW
+                                                       + packet.rxNoisePowerInSatelliteW
+                                                       + packet.rxAciIfPowerInSatelliteW
+                                                       + packet.rxExtNoisePowerInSatelliteW);
+
+  sinrSatellite = packet.sinrCalculate (sinrSatellite);
+
+  state.cSinr = 1.0 / ((1.0 / packet.sinr) + (1.0 / sinrSatellite));
+
+  if (m_collisionModel == SatPhyRxCarrierConf::RA_COLLISION_ALWAYS_DROP_ALL_COLLIDING_PACKETS
+      && m_slots[state.slot].packetCount > 1)
+    {
+      /// not possible to have a successful reception
+      state.phyError = true;
+    }
+  else
+    {
+      state.phyError = CheckAgainstLinkResults (packetIndex, state.cSinr);
+    }
+}
+
+bool
+SatCrdsaFrameDecoder::CheckAgainstLinkResults (uint32_t packetIndex, double cSinr)
+{
+  if (m_errorModel == SatPhyRxCarrierConf::EM_NONE)
+    {
+      return false;
+    }
+
+  if (m_errorModel == SatPhyRxCarrierConf::EM_CONSTANT)
+    {
+      double r = m_randomValueCallback ();
+      return (r < m_constantErrorRate);
+    }
+
+  /// link results are in Eb/No format in the return link
+  const packet_s& packet = m_packets[packetIndex];
+  double ebNo = cSinr / packet.bitsPerSymbol;
+  double bler = m_linkResults->GetBler (packet.waveformId, SatUtils::LinearToDb (ebNo));
+  double r = m_randomValueCallback ();
+
+  return (r < bler);
+}
+
+void
+SatCrdsaFrameDecoder::RemovePacket (uint32_t packetIndex)
+{
+  packetState_s& state = m_states[packetIndex];
+
+  state.removed = true;
+  m_slots[state.slot].packetCount--;
+}
+
+void
+SatCrdsaFrameDecoder::RemoveReplicas (uint32_t packetIndex, bool eliminateInterference)
+{
+  const std::vector<uint32_t>& replicas = m_replicaGroups[m_states[packetIndex].replicaGroup];
+
+  for (uint32_t i = 0; i < replicas.size (); i++)
+    {
+      uint32_t replicaIndex = replicas[i];
+
+      if (replicaIndex == packetIndex)
+        {
+          continue;
+        }
+
+      if (m_states[replicaIndex].removed)
+        {
+          m_error = REPLICA_NOT_FOUND;
+          return;
+        }
+
+      RemovePacket (replicaIndex);
+      m_readyPackets.erase (replicaIndex);
+
+      if (eliminateInterference)
+        {
+          EliminateInterference (replicaIndex);
+        }
+    }
+}
+
+void
+SatCrdsaFrameDecoder::EliminateInterference (uint32_t packetIndex)
+{
+  const slot_s& slot = m_slots[m_states[packetIndex].slot];
+
+  if (slot.packetCount == 0)
+    {
+      return;
+    }
+
+  for (uint32_t i = 0; i < slot.packets.size (); i++)
+    {
+      uint32_t otherIndex = slot.packets[i];
+      packetState_s& other = m_states[otherIndex];
+
+      if (other.removed)
+        {
+          continue;
+        }
+
+      /// release packets in this slot for re-processing
+      m_readyPackets.insert (otherIndex);
+
+      /// Interference is eliminated only from the user link interference power at the
+      /// satellite, so that the intra-beam interference is not taken into account twice
+      other.ifPowerInSatelliteW -= m_packets[packetIndex].rxPowerInSatelliteW;
+
+      if (std::abs (other.ifPowerInSatelliteW) < std::numeric_limits<double>::epsilon ())
+        {
+          other.ifPowerInSatelliteW = 0;
+        }
+
+      if (m_packets[otherIndex].ifPowerW < 0 || other.ifPowerInSatelliteW < 0)
+        {
+          m_error = NEGATIVE_INTERFERENCE;
+        }
+    }
+}
+
+} // namespace ns3
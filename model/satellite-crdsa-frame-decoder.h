@@ -0,0 +1,274 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 Magister Solutions Ltd
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Jani Puttonen <jani.puttonen@magister.fi>
+ */
+
+#ifndef SATELLITE_CRDSA_FRAME_DECODER_H
+#define SATELLITE_CRDSA_FRAME_DECODER_H
+
+#include <set>
+#include <vector>
+
+#include <ns3/callback.h>
+#include <ns3/ptr.h>
+#include <ns3/mac48-address.h>
+#include <ns3/satellite-phy-rx-carrier-conf.h>
+
+namespace ns3 {
+
+class SatLinkResultsDvbRcs2;
+
+/**
+ * \ingroup satellite
+ * \brief Successive interference cancellation decoder of a CRDSA frame.
+ *
+ * The decoder works only on per-frame data copied out of the received
+ * packets before the decoding, i.e. it does not touch the packets, logging or
+ * the simulator. The link results of the AVI error model are shared with the
+ * receiver and only read. Frames of different decoders may thus be decoded in
+ * parallel threads. The random values of the error model and the satellite
+ * SINRs are got with callbacks of the receiver when a packet is processed, so
+ * these callbacks shall only use state of their own receiver.
+ *
+ * The packets are processed in slot order. A successfully received packet
+ * releases only the packets in its own slot and in the slots of its replicas
+ * for re-processing, in which case processing continues from the first of
+ * them. This is the same order in which a full scan of the frame restarted
+ * after each successful reception would find the packets, so the random
+ * values are drawn in the same order as well.
+ */
+class SatCrdsaFrameDecoder
+{
+public:
+  /**
+   * \brief Decoding error of the frame
+   */
+  typedef enum
+  {
+    DECODING_OK,            //< frame decoded
+    NEGATIVE_INTERFERENCE,  //< interference elimination resulted in negative interference
+    REPLICA_NOT_FOUND       //< replica of a packet was not received in the frame
+  } DecodingError_t;
+
+  /**
+   * \brief Callback for drawing a random value between 0 and 1 for the error model
+   */
+  typedef Callback<double> RandomValueCallback;
+
+  /**
+   * \brief Received CRDSA packet of the frame
+   */
+  typedef struct
+  {
+    uint16_t ownSlotId;                 // slot ID of the packet
+    std::vector<uint16_t> slotIds;      // slot IDs of the packet and its replicas, sorted
+    Mac48Address sourceAddress;         // sender of the packet
+    double rxPowerInSatelliteW;         // received power at the satellite
+    double ifPowerInSatelliteW;         // interference power at the satellite
+    double rxNoisePowerInSatelliteW;    // noise power at the satellite
+    double rxAciIfPowerInSatelliteW;    // adjacent channel interference power at the satellite
+    double rxExtNoisePowerInSatelliteW; // external noise power at the satellite
+    SatPhyRxCarrierConf::SinrCalculatorCallback sinrCalculate; // SINR calculator of the satellite
+    double ifPowerW;                    // interference power at the receiver
+    double sinr;                        // SINR of the feeder link
+    double bitsPerSymbol;               // coding rate times modulated bits of the waveform
+    uint32_t waveformId;                // waveform of the packet
+  } packet_s;
+
+  /**
+   * \brief Constructor
+   */
+  SatCrdsaFrameDecoder ();
+
+  /**
+   * \brief Set the error model and the collision model of the decoding
+   * \param errorModel Error model
+   * \param constantErrorRate Error rate of the constant error model
+   * \param collisionModel Random access collision model
+   */
+  void SetModels (SatPhyRxCarrierConf::ErrorModel errorModel,
+                  double constantErrorRate,
+                  SatPhyRxCarrierConf::RandomAccessCollisionModel collisionModel);
+
+  /**
+   * \brief Set the link results used by the AVI error model
+   * \param linkResults DVB-RCS2 link results of the receiver
+   */
+  void SetLinkResults (Ptr<const SatLinkResultsDvbRcs2> linkResults);
+
+  /**
+   * \brief Set the callback drawing the random values of the error model.
+   * A value is drawn each time a packet is checked against the error model.
+   * \param cb Callback
+   */
+  void SetRandomValueCallback (RandomValueCallback cb);
+
+  /**
+   * \brief Remove the packets and the results of the previous frame
+   */
+  void Clear ();
+
+  /**
+   * \brief Add a packet to the frame. Packets are added in slot ID order and by
+   * reception order within the slot.
+   * \param packet Received packet
+   */
+  void AddPacket (const packet_s& packet);
+
+  /**
+   * \brief Decode the frame
+   */
+  void Decode ();
+
+  /**
+   * \brief Get the number of packets in the frame
+   * \return Number of packets
+   */
+  inline uint32_t GetNumOfPackets () const { return m_packets.size (); }
+
+  /**
+   * \brief Get the decoding error of the frame
+   * \return Decoding error
+   */
+  inline DecodingError_t GetError () const { return m_error; }
+
+  /**
+   * \brief Get the decoded unique payloads, one packet of each. Successfully
+   * received packets are first in reception order, then the rest in frame order.
+   * \return Packet indices
+   */
+  inline const std::vector<uint32_t>& GetDecodedPackets () const { return m_decodedPackets; }
+
+  /**
+   * \brief Get the processed packets in processing order. A packet is
+   * processed again after interference has been eliminated from its slot.
+   * \return Packet indices
+   */
+  inline const std::vector<uint32_t>& GetProcessedPackets () const { return m_processedPackets; }
+
+  /**
+   * \brief Get the packet error of a decoded packet
+   * \param packetIndex Packet index
+   * \return Has a PHY error occurred
+   */
+  inline bool HasPhyError (uint32_t packetIndex) const { return m_states[packetIndex].phyError; }
+
+  /**
+   * \brief Get the composite SINR of the last processing of a packet
+   * \param packetIndex Packet index
+   * \return Composite SINR
+   */
+  inline double GetCompositeSinr (uint32_t packetIndex) const { return m_states[packetIndex].cSinr; }
+
+  /**
+   * \brief Get the interference power at the satellite of a packet after the interference elimination
+   * \param packetIndex Packet index
+   * \return Interference power in W
+   */
+  inline double GetIfPowerInSatellite (uint32_t packetIndex) const { return m_states[packetIndex].ifPowerInSatelliteW; }
+
+private:
+  /**
+   * \brief Decoding state of a packet
+   */
+  typedef struct
+  {
+    uint32_t slot;              // index of the slot of the packet
+    uint32_t replicaGroup;      // index of the replica group, i.e. unique payload, of the packet
+    double ifPowerInSatelliteW; // interference power at the satellite after the eliminations
+    double cSinr;               // composite SINR of the last processing
+    bool phyError;              // result of the last processing
+    bool removed;               // has the packet been removed from its slot
+  } packetState_s;
+
+  /**
+   * \brief Slot of the frame
+   */
+  typedef struct
+  {
+    std::vector<uint32_t> packets;  // packets received in the slot, in reception order
+    uint32_t packetCount;           // number of packets not yet removed from the slot
+  } slot_s;
+
+  /**
+   * \brief Build the slots and the replica groups of the frame
+   * \return Were all the replicas found
+   */
+  bool BuildFrame ();
+
+  /**
+   * \brief Process a packet
+   * \param packetIndex Packet index
+   */
+  void ProcessPacket (uint32_t packetIndex);
+
+  /**
+   * \brief Check a packet against the error model
+   * \param packetIndex Packet index
+   * \param cSinr Composite SINR of the packet
+   * \return Has a PHY error occurred
+   */
+  bool CheckAgainstLinkResults (uint32_t packetIndex, double cSinr);
+
+  /**
+   * \brief Remove a packet from its slot
+   * \param packetIndex Packet index
+   */
+  void RemovePacket (uint32_t packetIndex);
+
+  /**
+   * \brief Remove the replicas of a packet from their slots
+   * \param packetIndex Packet index
+   * \param eliminateInterference Eliminate the interference of the replicas from the other packets of their slots
+   */
+  void RemoveReplicas (uint32_t packetIndex, bool eliminateInterference);
+
+  /**
+   * \brief Eliminate the interference of a correctly received packet from the other packets of its slot
+   * \param packetIndex Packet index
+   */
+  void EliminateInterference (uint32_t packetIndex);
+
+  SatPhyRxCarrierConf::ErrorModel m_errorModel;
+  double m_constantErrorRate;
+  SatPhyRxCarrierConf::RandomAccessCollisionModel m_collisionModel;
+  RandomValueCallback m_randomValueCallback;
+  Ptr<const SatLinkResultsDvbRcs2> m_linkResults;
+
+  /**
+   * \brief Packets of the frame in the order they were added
+   */
+  std::vector<packet_s> m_packets;
+
+  std::vector<packetState_s> m_states;
+  std::vector<slot_s> m_slots;
+  std::vector<std::vector<uint32_t> > m_replicaGroups;
+
+  /**
+   * \brief Packets waiting for (re-)processing, the lowest index first
+   */
+  std::set<uint32_t> m_readyPackets;
+
+  std::vector<uint32_t> m_decodedPackets;
+  std::vector<uint32_t> m_processedPackets;
+  DecodingError_t m_error;
+};
+
+} // namespace ns3
+
+#endif /* SATELLITE_CRDSA_FRAME_DECODER_H */
@@ -19,6 +19,8 @@
  */
 
 #include <fstream>
+#include <algorithm>
+#include <limits>
 #include "ns3/log.h"
 #include "ns3/enum.h"
 #include "ns3/double.h"
@@ -31,6 +33,40 @@ NS_LOG_COMPONENT_DEFINE ("SatFadingExternalInputTraceContainer");
 
 namespace ns3 {
 
+/**
+ * \brief Get a coordinate of a position by k-d tree axis
+ * \param position Position
+ * \param axis Axis, 0 = x, 1 = y, 2 = z
+ * \return coordinate
+ */
+static double
+GetAxisCoordinate (const Vector& position, uint32_t axis)
+{
+  return (axis == 0) ? position.x : ((axis == 1) ? position.y : position.z);
+}
+
+/**
+ * \brief Comparator ordering trace file container indexes by a coordinate of their positions
+ */
+class SatTracePositionAxisLess
+{
+public:
+  SatTracePositionAxisLess (const std::vector<Vector>& positions, uint32_t axis)
+    : m_positions (positions),
+      m_axis (axis)
+  {
+  }
+
+  bool operator() (uint32_t a, uint32_t b) const
+  {
+    return GetAxisCoordinate (m_positions[a], m_axis) < GetAxisCoordinate (m_positions[b], m_axis);
+  }
+
+private:
+  const std::vector<Vector>& m_positions;
+  uint32_t m_axis;
+};
+
 NS_OBJECT_ENSURE_REGISTERED (SatFadingExternalInputTraceContainer);
 
 TypeId
@@ -96,6 +132,8 @@ SatFadingExternalInputTraceContainer::~SatFadingExternalInputTraceContainer ()
 
   m_utFadingMap.clear ();
   m_gwFadingMap.clear ();
+  m_loadedTraces.clear ();
+  m_positionIndexes.clear ();
 }
 
 void
@@ -217,6 +255,33 @@ SatFadingExternalInputTraceContainer::GetFadingTrace (uint32_t nodeId, SatEnums:
   return ft;
 }
 
+void
+SatFadingExternalInputTraceContainer::CreateFadingTraces (const NodeMobilityMap_t& uts, const NodeMobilityMap_t& gws)
+{
+  NS_LOG_FUNCTION (this << uts.size () << gws.size ());
+
+  if ( !m_indexFilesLoaded )
+    {
+      LoadIndexFiles ();
+    }
+
+  for (NodeMobilityMap_t::const_iterator it = uts.begin (); it != uts.end (); ++it)
+    {
+      if (m_utFadingMap.find (it->first) == m_utFadingMap.end ())
+        {
+          CreateUtFadingTrace (it->first, it->second);
+        }
+    }
+
+  for (NodeMobilityMap_t::const_iterator it = gws.begin (); it != gws.end (); ++it)
+    {
+      if (m_gwFadingMap.find (it->first) == m_gwFadingMap.end ())
+        {
+          CreateGwFadingTrace (it->first, it->second);
+        }
+    }
+}
+
 bool
 SatFadingExternalInputTraceContainer::TestFadingTraces (uint32_t numOfUts, uint32_t numOfGws)
 {
@@ -381,18 +446,20 @@ SatFadingExternalInputTraceContainer::CreateFadingTrace (SatFadingExternalInputT
 
   // find from loaded list
 
-  TraceInputContainer_t::iterator it = m_loadedTraces.find (fileName);
+  uint32_t columns = SatFadingExternalInputTrace::GetColumns (fileType);
+  TraceInputContainer_t::iterator it = m_loadedTraces.find (std::make_pair (fileName, columns));
 
   if ( it == m_loadedTraces.end ())
     {
-      // create if not found
-      trace = Create<SatFadingExternalInputTrace> (fileType, m_dataPath + fileName);
-    }
-  else
-    {
-      trace = it->second;
+      // load the file if not found, the file is mapped only once for each file type
+      Ptr<SatFadingExternalInputTraceFile> traceFile =
+        Create<SatFadingExternalInputTraceFile> (columns, m_dataPath + fileName);
+
+      it = m_loadedTraces.insert (std::make_pair (std::make_pair (fileName, columns), traceFile)).first;
     }
 
+  trace = Create<SatFadingExternalInputTrace> (fileType, it->second);
+
   return trace;
 }
 
@@ -405,17 +472,14 @@ SatFadingExternalInputTraceContainer::FindSourceBasedOnPosition (TraceFileContai
   double currentDistanceToFading = std::numeric_limits<double>::max ();
   Vector position = mobility->GetPosition ();
 
-  for (TraceFileContainer_t::iterator it = container.begin (); it != container.end (); it++)
-    {
-      Vector fadingPosition = it->second.ToVector ();
+  const PositionIndex_t& index = GetPositionIndex (container);
 
-      double distanceToFading = CalculateDistance ( position, fadingPosition );
+  if ( !index.tree.empty () )
+    {
+      uint32_t nearest = FindNearestPosition (index, position);
 
-      if ( distanceToFading < currentDistanceToFading )
-        {
-          currentDistanceToFading = distanceToFading;
-          fileName = it->first;
-        }
+      currentDistanceToFading = CalculateDistance ( position, index.positions[nearest] );
+      fileName = container[nearest].first;
     }
 
   if ( currentDistanceToFading > m_maxDistanceToFading )
@@ -430,4 +494,122 @@ SatFadingExternalInputTraceContainer::FindSourceBasedOnPosition (TraceFileContai
   return fileName;
 }
 
+const SatFadingExternalInputTraceContainer::PositionIndex_t&
+SatFadingExternalInputTraceContainer::GetPositionIndex (const TraceFileContainer_t& container)
+{
+  NS_LOG_FUNCTION (this);
+
+  std::map<const TraceFileContainer_t*, PositionIndex_t>::iterator it = m_positionIndexes.find (&container);
+
+  if ( it == m_positionIndexes.end () || it->second.positions.size () != container.size () )
+    {
+      std::vector<Vector> positions;
+
+      for (uint32_t i = 0; i < container.size (); i++)
+        {
+          positions.push_back (container[i].second.ToVector ());
+        }
+
+      PositionIndex_t& index = m_positionIndexes[&container];
+      BuildPositionIndex (positions, index);
+
+      return index;
+    }
+
+  return it->second;
+}
+
+void
+SatFadingExternalInputTraceContainer::BuildPositionIndex (const std::vector<Vector>& positions, PositionIndex_t& index)
+{
+  index.positions = positions;
+  index.tree.clear ();
+
+  for (uint32_t i = 0; i < positions.size (); i++)
+    {
+      index.tree.push_back (i);
+    }
+
+  BuildPositionTree (index, 0, index.tree.size (), 0);
+}
+
+uint32_t
+SatFadingExternalInputTraceContainer::FindNearestPosition (const PositionIndex_t& index, const Vector& position)
+{
+  NS_ASSERT (!index.tree.empty ());
+
+  uint32_t nearest = 0;
+  double nearestDistanceSquared = std::numeric_limits<double>::max ();
+
+  SearchPositionTree (index, 0, index.tree.size (), 0, position, nearest, nearestDistanceSquared);
+
+  return nearest;
+}
+
+void
+SatFadingExternalInputTraceContainer::BuildPositionTree (PositionIndex_t& index, uint32_t begin, uint32_t end, uint32_t depth)
+{
+  if ( end - begin <= 1 )
+    {
+      return;
+    }
+
+  uint32_t middle = begin + (end - begin) / 2;
+
+  std::nth_element (index.tree.begin () + begin, index.tree.begin () + middle, index.tree.begin () + end,
+                    SatTracePositionAxisLess (index.positions, depth % 3));
+
+  BuildPositionTree (index, begin, middle, depth + 1);
+  BuildPositionTree (index, middle + 1, end, depth + 1);
+}
+
+void
+SatFadingExternalInputTraceContainer::SearchPositionTree (const PositionIndex_t& index, uint32_t begin, uint32_t end, uint32_t depth,
+                                                          const Vector& position, uint32_t& nearest, double& nearestDistanceSquared)
+{
+  if ( begin >= end )
+    {
+      return;
+    }
+
+  uint32_t middle = begin + (end - begin) / 2;
+  uint32_t candidate = index.tree[middle];
+  const Vector& candidatePosition = index.positions[candidate];
+
+  double dx = position.x - candidatePosition.x;
+  double dy = position.y - candidatePosition.y;
+  double dz = position.z - candidatePosition.z;
+  double distanceSquared = dx * dx + dy * dy + dz * dz;
+
+  // equally distant sources are resolved to the first one in the index file
+  if ( distanceSquared < nearestDistanceSquared
+       || (distanceSquared == nearestDistanceSquared && candidate < nearest) )
+    {
+      nearest = candidate;
+      nearestDistanceSquared = distanceSquared;
+    }
+
+  uint32_t axis = depth % 3;
+  double axisDistance = GetAxisCoordinate (position, axis) - GetAxisCoordinate (candidatePosition, axis);
+
+  if ( axisDistance < 0 )
+    {
+      SearchPositionTree (index, begin, middle, depth + 1, position, nearest, nearestDistanceSquared);
+
+      if ( axisDistance * axisDistance <= nearestDistanceSquared )
+        {
+          SearchPositionTree (index, middle + 1, end, depth + 1, position, nearest, nearestDistanceSquared);
+        }
+    }
+  else
+    {
+      SearchPositionTree (index, middle + 1, end, depth + 1, position, nearest, nearestDistanceSquared);
+
+      if ( axisDistance * axisDistance <= nearestDistanceSquared )
+        {
+          SearchPositionTree (index, begin, middle, depth + 1, position, nearest, nearestDistanceSquared);
+        }
+    }
+}
+
 } // namespace ns3
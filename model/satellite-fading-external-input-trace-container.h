@@ -24,6 +24,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 #include "ns3/object.h"
 #include "ns3/mobility-model.h"
 #include "satellite-enums.h"
@@ -55,6 +56,22 @@ public:
    */
   typedef std::pair<Ptr<SatFadingExternalInputTrace>, Ptr<SatFadingExternalInputTrace> >  ChannelTracePair_t;
 
+  /**
+   * Define type NodeMobilityMap_t, GW or UT node id (from SatIdMapper) mapped to its mobility
+   */
+  typedef std::map<uint32_t, Ptr<MobilityModel> > NodeMobilityMap_t;
+
+  /**
+   * Spatial index of the trace file positions of a trace file container.
+   * The positions are stored as an implicit k-d tree: the median of a range
+   * split by the axis of the tree depth is in the middle of the range.
+   */
+  typedef struct
+  {
+    std::vector<Vector> positions;
+    std::vector<uint32_t> tree;
+  } PositionIndex_t;
+
   /**
    * \brief Get the type ID
    * \return the object TypeId
@@ -87,6 +104,16 @@ public:
    */
   Ptr<SatFadingExternalInputTrace> GetFadingTrace (uint32_t nodeId, SatEnums::ChannelType_t channelType, Ptr<MobilityModel> mobility);
 
+  /**
+   * Create the fading traces of the given UTs and GWs at once, so that
+   * the traces are not created during the simulation by GetFadingTrace.
+   * Traces already created are not changed.
+   *
+   * \param uts UT ids (from SatIdMapper) with their mobilities
+   * \param gws GW ids (from SatIdMapper) with their mobilities
+   */
+  void CreateFadingTraces (const NodeMobilityMap_t& uts, const NodeMobilityMap_t& gws);
+
   /**
    * \brief A method to test that the fading traces are according to
    * assumptions.
@@ -96,11 +123,31 @@ public:
    */
   bool TestFadingTraces (uint32_t numOfUts, uint32_t numOfGws);
 
+  /**
+   * Build the spatial index of a set of positions.
+   *
+   * \param positions Positions to index
+   * \param index Spatial index to build
+   */
+  static void BuildPositionIndex (const std::vector<Vector>& positions, PositionIndex_t& index);
+
+  /**
+   * Find the nearest indexed position. Equally distant positions are
+   * resolved to the first one of the indexed positions.
+   *
+   * \param index Spatial index, not empty
+   * \param position Position to search for
+   * \return Index of the nearest position in the indexed positions
+   */
+  static uint32_t FindNearestPosition (const PositionIndex_t& index, const Vector& position);
+
 private:
   typedef std::pair <std::string, GeoCoordinate > TraceFileContainerItem_t;
   typedef std::vector<TraceFileContainerItem_t> TraceFileContainer_t;
 
-  typedef std::map<std::string, Ptr<SatFadingExternalInputTrace> > TraceInputContainer_t;
+  /// loaded files are keyed by the file name and the number of columns of the file type
+  typedef std::pair <std::string, uint32_t> TraceInputKey_t;
+  typedef std::map<TraceInputKey_t, Ptr<SatFadingExternalInputTraceFile> > TraceInputContainer_t;
 
   /**
    * Container of the UT fading traces
@@ -162,10 +209,15 @@ private:
   TraceFileContainer_t  m_gwRtnDownFileNames;
 
   /**
-   * Loaded trace files
+   * Loaded trace files, shared by all the traces using the same file
    */
   TraceInputContainer_t m_loadedTraces;
 
+  /**
+   * Spatial indexes of the trace file containers used in position mode
+   */
+  std::map<const TraceFileContainer_t*, PositionIndex_t> m_positionIndexes;
+
   /// flag telling if index trace files are already loaded
   bool m_indexFilesLoaded;
 
@@ -225,6 +277,38 @@ private:
    * \return The name of the nearest external fading source.
    */
   std::string FindSourceBasedOnPosition (TraceFileContainer_t& container, uint32_t id, Ptr<MobilityModel> mobility);
+
+  /**
+   * Get the spatial index of a trace file container, the index is built on first use.
+   *
+   * \param container Container reference to find out needed trace file info
+   * \return The spatial index of the container
+   */
+  const PositionIndex_t& GetPositionIndex (const TraceFileContainer_t& container);
+
+  /**
+   * Build a k-d tree over a range of the spatial index.
+   *
+   * \param index Spatial index
+   * \param begin First tree position of the range
+   * \param end Tree position after the range
+   * \param depth Depth of the range in the tree
+   */
+  static void BuildPositionTree (PositionIndex_t& index, uint32_t begin, uint32_t end, uint32_t depth);
+
+  /**
+   * Search the nearest trace file position from a range of the spatial index.
+   *
+   * \param index Spatial index
+   * \param begin First tree position of the range
+   * \param end Tree position after the range
+   * \param depth Depth of the range in the tree
+   * \param position Position to search for
+   * \param nearest Container index of the nearest trace file found so far
+   * \param nearestDistanceSquared Squared distance to the nearest trace file found so far
+   */
+  static void SearchPositionTree (const PositionIndex_t& index, uint32_t begin, uint32_t end, uint32_t depth,
+                                  const Vector& position, uint32_t& nearest, double& nearestDistanceSquared);
 };
 
 } // namespace ns3
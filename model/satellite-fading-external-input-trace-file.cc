@@ -0,0 +1,135 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Jani Puttonen <jani.puttonen@magister.fi>
+ */
+
+#include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "ns3/log.h"
+#include "satellite-fading-external-input-trace-file.h"
+
+NS_LOG_COMPONENT_DEFINE ("SatFadingExternalInputTraceFile");
+
+namespace ns3 {
+
+SatFadingExternalInputTraceFile::SatFadingExternalInputTraceFile ()
+  : m_columns (0),
+    m_rows (0),
+    m_data (NULL),
+    m_mapping (NULL),
+    m_mappingLength (0)
+{
+  NS_FATAL_ERROR ("SatFadingExternalInputTraceFile::SatFadingExternalInputTraceFile - Constructor not in use");
+}
+
+SatFadingExternalInputTraceFile::SatFadingExternalInputTraceFile (uint32_t columns, std::string filePathName, bool mapFile)
+  : m_columns (columns),
+    m_rows (0),
+    m_data (NULL),
+    m_mapping (NULL),
+    m_mappingLength (0)
+{
+  NS_LOG_FUNCTION (this << columns << filePathName << mapFile);
+
+  NS_ASSERT (m_columns > 0);
+
+  LoadFile (filePathName, mapFile);
+}
+
+SatFadingExternalInputTraceFile::~SatFadingExternalInputTraceFile ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_mapping != NULL)
+    {
+      munmap (m_mapping, m_mappingLength);
+      m_mapping = NULL;
+    }
+
+  m_data = NULL;
+  m_readData.clear ();
+}
+
+void
+SatFadingExternalInputTraceFile::LoadFile (std::string filePathName, bool mapFile)
+{
+  NS_LOG_FUNCTION (this << filePathName << mapFile);
+
+  int fd = open (filePathName.c_str (), O_RDONLY);
+
+  if (fd < 0)
+    {
+      // script might be launched by test.py, try a different base path
+      filePathName = "../../" + filePathName;
+      fd = open (filePathName.c_str (), O_RDONLY);
+
+      if (fd < 0)
+        {
+          NS_FATAL_ERROR ("The file " << filePathName << " is not found.");
+        }
+    }
+
+  struct stat fileStat;
+  size_t fileSize = 0;
+
+  if (fstat (fd, &fileStat) == 0)
+    {
+      fileSize = fileStat.st_size;
+    }
+
+  // only complete sample rows are used
+  m_rows = fileSize / (m_columns * sizeof (float));
+
+  if (m_rows > 0 && mapFile)
+    {
+      void* mapping = mmap (NULL, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+
+      if (mapping != MAP_FAILED)
+        {
+          m_mapping = mapping;
+          m_mappingLength = fileSize;
+          m_data = static_cast<const float*> (mapping);
+        }
+    }
+
+  close (fd);
+
+  if (m_rows > 0 && m_mapping == NULL)
+    {
+      NS_LOG_INFO ("SatFadingExternalInputTraceFile::LoadFile - File not mapped, reading the file " << filePathName);
+
+      std::ifstream ifs (filePathName.c_str (), std::ios::in | std::ios::binary);
+
+      m_readData.resize (m_rows * m_columns);
+      ifs.read ((char*)&m_readData[0], m_readData.size () * sizeof (float));
+
+      if (!ifs.good ())
+        {
+          NS_FATAL_ERROR ("The file " << filePathName << " could not be read.");
+        }
+
+      m_data = &m_readData[0];
+    }
+
+  NS_LOG_INFO ("SatFadingExternalInputTraceFile::LoadFile - File: " << filePathName << ", rows: " << m_rows);
+}
+
+} // namespace ns3
@@ -0,0 +1,124 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Jani Puttonen <jani.puttonen@magister.fi>
+ */
+
+#ifndef SATELLITE_FADING_EXTERNAL_INPUT_TRACE_FILE_H
+#define SATELLITE_FADING_EXTERNAL_INPUT_TRACE_FILE_H
+
+#include <string>
+#include <vector>
+#include "ns3/simple-ref-count.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup satellite
+ * \brief The class for a loaded satellite fading external input trace file.
+ * The binary file is memory mapped once and its samples are provided as
+ * a flat float array with one row per time sample. The same file object is
+ * shared by all the SatFadingExternalInputTrace objects using the file.
+ */
+class SatFadingExternalInputTraceFile : public SimpleRefCount <SatFadingExternalInputTraceFile>
+{
+public:
+  /**
+   * Default constructor.
+   */
+  SatFadingExternalInputTraceFile ();
+
+  /**
+   * Constructor with initialization parameters.
+   * \param columns Number of columns (floats) in a sample row
+   * \param filePathName Path and file name of the fading file
+   * \param mapFile Map the file to memory, otherwise the file is read
+   */
+  SatFadingExternalInputTraceFile (uint32_t columns, std::string filePathName, bool mapFile = true);
+
+  /**
+   * Destructor for SatFadingExternalInputTraceFile
+   */
+  ~SatFadingExternalInputTraceFile ();
+
+  /**
+   * Get the number of columns in a sample row
+   * \return number of columns
+   */
+  inline uint32_t GetColumns () const
+  {
+    return m_columns;
+  }
+
+  /**
+   * Get the number of complete sample rows
+   * \return number of rows
+   */
+  inline uint32_t GetRows () const
+  {
+    return m_rows;
+  }
+
+  /**
+   * Get a sample value
+   * \param row Row index
+   * \param column Column index
+   * \return sample value
+   */
+  inline float GetValue (uint32_t row, uint32_t column) const
+  {
+    return m_data[row * m_columns + column];
+  }
+
+private:
+  /**
+   * Map the binary file to memory, or read it if mapping is not requested or possible
+   * \param filePathName Path and file name of the fading file
+   * \param mapFile Map the file to memory
+   */
+  void LoadFile (std::string filePathName, bool mapFile);
+
+  /**
+   * Number of columns in a sample row
+   */
+  uint32_t m_columns;
+
+  /**
+   * Number of complete sample rows
+   */
+  uint32_t m_rows;
+
+  /**
+   * Samples of the file as a flat array, row after row
+   */
+  const float* m_data;
+
+  /**
+   * Start address and length of the memory mapping, NULL when not mapped
+   */
+  void* m_mapping;
+  size_t m_mappingLength;
+
+  /**
+   * Samples read to memory when the file could not be mapped
+   */
+  std::vector<float> m_readData;
+};
+
+} // namespace ns3
+
+#endif /* SATELLITE_FADING_EXTERNAL_INPUT_TRACE_FILE_H */
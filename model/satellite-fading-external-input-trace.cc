@@ -18,8 +18,8 @@
  * Author: Jani Puttonen <jani.puttonen@magister.fi>
  */
 
-#include <fstream>
 #include <algorithm>
+#include <cmath>
 #include "ns3/simulator.h"
 #include "ns3/log.h"
 #include "satellite-fading-external-input-trace.h"
@@ -39,13 +39,26 @@ SatFadingExternalInputTrace::SatFadingExternalInputTrace ()
 }
 
 SatFadingExternalInputTrace::SatFadingExternalInputTrace (TraceFileType_e type, std::string fileName)
-  : m_startTime (-1.0),
+  : m_traceFileType (type),
+    m_startTime (-1.0),
     m_timeInterval (-1.0)
 {
   NS_LOG_FUNCTION (this);
 
-  m_traceFileType = type;
-  ReadTrace (fileName);
+  m_traceFile = Create<SatFadingExternalInputTraceFile> (GetColumns (type), fileName);
+  InitializeTimes ();
+}
+
+SatFadingExternalInputTrace::SatFadingExternalInputTrace (TraceFileType_e type, Ptr<SatFadingExternalInputTraceFile> traceFile)
+  : m_traceFileType (type),
+    m_startTime (-1.0),
+    m_timeInterval (-1.0),
+    m_traceFile (traceFile)
+{
+  NS_LOG_FUNCTION (this);
+
+  NS_ASSERT (m_traceFile->GetColumns () == GetColumns (type));
+  InitializeTimes ();
 }
 
 
@@ -54,70 +67,35 @@ SatFadingExternalInputTrace::~SatFadingExternalInputTrace ()
   NS_LOG_FUNCTION (this);
 }
 
-
-void SatFadingExternalInputTrace::ReadTrace (std::string filePathName)
+uint32_t
+SatFadingExternalInputTrace::GetColumns (TraceFileType_e type)
 {
-  NS_LOG_FUNCTION (this << filePathName);
+  // Currently supports two or three column formats
+  return (type == FT_TWO_COLUMN) ? 2 : 3;
+}
 
-  // READ FROM THE SPECIFIED INPUT FILE
-  std::ifstream *ifs = new std::ifstream (filePathName.c_str (), std::ios::in | std::ios::binary);
+void
+SatFadingExternalInputTrace::InitializeTimes ()
+{
+  NS_LOG_FUNCTION (this);
 
-  if (!ifs->is_open ())
+  if (m_traceFile->GetRows () > 0)
     {
-      // script might be launched by test.py, try a different base path
-      delete ifs;
-      filePathName = "../../" + filePathName;
-      ifs = new std::ifstream (filePathName.c_str (), std::ifstream::in);
-
-      if (!ifs->is_open ())
-        {
-          NS_FATAL_ERROR ("The file " << filePathName << " is not found.");
-        }
+      m_startTime = m_traceFile->GetValue (0, TIME_INDEX);
     }
 
-  // Currently supports two or three column formats
-  uint32_t columns = (m_traceFileType == FT_TWO_COLUMN) ? 2 : 3;
-
-  float temp;
-  int32_t count (0);
-  std::vector<float> values;
-  ifs->read ((char*)&temp, sizeof(float));
-  m_startTime = temp;
-
-  // While state is good
-  while (ifs->good ())
+  // Calculate the sampling interval
+  if (m_traceFile->GetRows () > 1)
     {
-      // Store previous value
-      values.push_back (temp);
-
-      // Read the new value
-      ++count;
-      ifs->read ((char*)&temp, sizeof(float));
-
-      // Handle previous value
-      if (count % columns == 0)
-        {
-          NS_ASSERT (values.size () == columns);
-
-          m_traceVector.push_back (values);
-          values.clear ();
-
-          // Calculate the sampling interval
-          if (m_timeInterval < 0.0)
-            {
-              m_timeInterval = temp - m_startTime;
-            }
-        }
+      m_timeInterval = m_traceFile->GetValue (1, TIME_INDEX) - m_startTime;
     }
-  ifs->close ();
-  delete ifs;
 }
 
 double
 SatFadingExternalInputTrace::GetFading () const
 {
   NS_LOG_FUNCTION (this);
-  NS_ASSERT (!m_traceVector.empty ());
+  NS_ASSERT (m_traceFile->GetRows () > 0);
 
   float simTime = Simulator::Now ().GetSeconds ();
 
@@ -129,17 +107,17 @@ SatFadingExternalInputTrace::GetFading () const
   // Calculate the index to the time sample just before current time
   uint32_t lowerIndex = (uint32_t)(std::floor (std::abs (simTime - m_startTime) / m_timeInterval));
 
-  if (lowerIndex >= m_traceVector.size ())
+  if (lowerIndex + 1 >= m_traceFile->GetRows ())
     {
-      NS_LOG_ERROR (this << " calculated index exceeds trace file size!");
+      NS_FATAL_ERROR (this << " calculated index exceeds trace file size!");
     }
 
-  float lowerKey = m_traceVector.at (lowerIndex).at (TIME_INDEX);
-  float upperKey = m_traceVector.at (lowerIndex + 1).at (TIME_INDEX);
+  float lowerKey = m_traceFile->GetValue (lowerIndex, TIME_INDEX);
+  float upperKey = m_traceFile->GetValue (lowerIndex + 1, TIME_INDEX);
 
   // Interpolation in linear domain
-  float lowerVal = SatUtils::DbToLinear (m_traceVector.at (lowerIndex).at (FADING_INDEX));
-  float upperVal = SatUtils::DbToLinear (m_traceVector.at (lowerIndex + 1).at (FADING_INDEX));
+  float lowerVal = SatUtils::DbToLinear (m_traceFile->GetValue (lowerIndex, FADING_INDEX));
+  float upperVal = SatUtils::DbToLinear (m_traceFile->GetValue (lowerIndex + 1, FADING_INDEX));
 
   // y = y0 + (y1 - y0) * (x - x0) / (x1 - x0)
   double fading = lowerVal + (upperVal - lowerVal)
@@ -161,17 +139,16 @@ bool
 SatFadingExternalInputTrace::TestFadingTrace () const
 {
   NS_LOG_FUNCTION (this);
-  NS_ASSERT (!m_traceVector.empty ());
+  NS_ASSERT (m_traceFile->GetRows () > 0);
 
-  std::vector<std::vector<float> >::const_iterator cit;
   float prevTime (-1.0);
   float currTime (-1.0);
 
-  for (cit = m_traceVector.begin (); cit != m_traceVector.end (); ++cit)
+  for (uint32_t i = 0; i < m_traceFile->GetRows (); ++i)
     {
       if (prevTime > 0)
         {
-          currTime = cit->at (TIME_INDEX);
+          currTime = m_traceFile->GetValue (i, TIME_INDEX);
           double diff = std::abs ( std::abs (currTime - prevTime) - m_timeInterval);
 
           // Test that the the time samples are from constant interval and
@@ -181,7 +158,7 @@ SatFadingExternalInputTrace::TestFadingTrace () const
               return false;
             }
         }
-      prevTime = cit->at (TIME_INDEX);
+      prevTime = m_traceFile->GetValue (i, TIME_INDEX);
     }
 
   // Succeeded
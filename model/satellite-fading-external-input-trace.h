@@ -21,16 +21,19 @@
 #ifndef SATELLITE_FADING_EXTERNAL_INPUT_TRACE_H
 #define SATELLITE_FADING_EXTERNAL_INPUT_TRACE_H
 
-#include <vector>
+#include <string>
 #include "ns3/simple-ref-count.h"
+#include "ns3/ptr.h"
+#include "satellite-fading-external-input-trace-file.h"
 
 namespace ns3 {
 
 /**
  * \ingroup satellite
- * \brief The class for satellite fading external input trace. The class reads
- * fading trace input samples from a file and provides the current fading value
- * for this specific fading file.
+ * \brief The class for satellite fading external input trace. The class provides
+ * the current fading value for a specific fading file. The samples are accessed
+ * through a SatFadingExternalInputTraceFile, which may be shared by several
+ * traces using the same file.
  */
 class SatFadingExternalInputTrace : public SimpleRefCount <SatFadingExternalInputTrace>
 {
@@ -53,6 +56,20 @@ public:
    */
   SatFadingExternalInputTrace (TraceFileType_e type, std::string filePathName);
 
+  /**
+   * Constructor with an already loaded fading file.
+   * \param type 
+   * \param traceFile Loaded fading file
+   */
+  SatFadingExternalInputTrace (TraceFileType_e type, Ptr<SatFadingExternalInputTraceFile> traceFile);
+
+  /**
+   * Get the number of columns in the given fading file type
+   * \param type File type
+   * \return number of columns
+   */
+  static uint32_t GetColumns (TraceFileType_e type);
+
   /**
    * Destructor for SatFadingExternalInputTrace
    */
@@ -73,10 +90,9 @@ public:
 
 private:
   /**
-   * Read the fading trace from a binary file
-   * \param filePathName Path and file name of the fading file
+   * Initialize the start time and the time interval from the fading file
    */
-  void ReadTrace (std::string filePathName);
+  void InitializeTimes ();
 
   /**
    * There may be different fading file types.
@@ -107,9 +123,9 @@ private:
   float m_timeInterval;
 
   /**
-   * Container for the fading trace.
+   * Fading file containing the trace samples.
    */
-  std::vector<std::vector<float> > m_traceVector;
+  Ptr<SatFadingExternalInputTraceFile> m_traceFile;
 };
 
 } // namespace ns3
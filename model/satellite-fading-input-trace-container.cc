@@ -105,7 +105,7 @@ SatFadingInputTraceContainer::AddNode (key_t key)
         {
           filename << dataPath << "/fadingtraces/input/BEAM_" << beamId << "_GW_" << gwId << "_channelType_" << SatEnums::GetChannelTypeName (key.second);
         }
-      std::pair <container_t::iterator, bool> result = m_container.insert (std::make_pair (key, CreateObject<SatInputFileStreamTimeDoubleContainer> (filename.str ().c_str (), std::ios::in, SatBaseTraceContainer::FADING_TRACE_DEFAULT_NUMBER_OF_COLUMNS)));
+      std::pair <container_t::iterator, bool> result = m_container.insert (std::make_pair (key, CreateObject<SatInputFileStreamTimeDoubleContainer> (filename.str ().c_str (), GetInputFileMode (), SatBaseTraceContainer::FADING_TRACE_DEFAULT_NUMBER_OF_COLUMNS)));
 
       if (result.second == false)
         {
@@ -141,7 +141,7 @@ SatFadingInputTraceContainer::GetFadingValue (key_t key)
 {
   NS_LOG_FUNCTION (this);
 
-  return FindNode (key)->ProceedToNextClosestTimeSample ().at (SatBaseTraceContainer::FADING_TRACE_DEFAULT_FADING_VALUE_INDEX);
+  return FindNode (key)->ProceedToNextClosestTimeSample (SatBaseTraceContainer::FADING_TRACE_DEFAULT_FADING_VALUE_INDEX);
 }
 
 } // namespace ns3
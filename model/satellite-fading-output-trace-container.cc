@@ -146,6 +146,13 @@ SatFadingOutputTraceContainer::WriteToFile ()
   NS_LOG_FUNCTION (this);
 
   container_t::iterator iter;
+  SatOutputBinaryTraceFile* binaryFile = NULL;
+
+  if (m_enableBinaryOutput)
+    {
+      std::string filename = Singleton<SatEnvVariables>::Get ()->GetOutputPath () + "/fading_output_trace.bin";
+      binaryFile = new SatOutputBinaryTraceFile (filename, SatBaseTraceContainer::FADING_TRACE_DEFAULT_NUMBER_OF_COLUMNS);
+    }
 
   for (iter = m_container.begin (); iter != m_container.end (); iter++)
     {
@@ -158,7 +165,21 @@ SatFadingOutputTraceContainer::WriteToFile ()
                                             SatOutputFileStreamDoubleContainer::DECIBEL_AMPLITUDE,
                                             Gnuplot2dDataset::LINES);
         }
-      iter->second->WriteContainerToFile ();
+
+      if (binaryFile != NULL)
+        {
+          iter->second->WriteContainerToBinaryFile (*binaryFile);
+        }
+      else
+        {
+          iter->second->WriteContainerToFile ();
+        }
+    }
+
+  if (binaryFile != NULL)
+    {
+      binaryFile->Close ();
+      delete binaryFile;
     }
 }
 
@@ -384,7 +384,11 @@ SatFwdLinkScheduler::SortSchedulingObjects (std::vector< Ptr<SatSchedulingObject
       switch (m_additionalSortCriteria)
         {
         case SatFwdLinkScheduler::NO_SORT:
-          std::sort (so.begin (), so.end (), CompareSoFlowId);
+          // LLC gives the objects usually already in flow id order
+          if ( std::is_sorted (so.begin (), so.end (), CompareSoFlowId) == false )
+            {
+              std::sort (so.begin (), so.end (), CompareSoFlowId);
+            }
           break;
 
         case SatFwdLinkScheduler::BUFFERING_DELAY_SORT:
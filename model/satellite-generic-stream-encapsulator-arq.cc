@@ -168,6 +168,8 @@ SatGenericStreamEncapsulatorArq::DoDispose ()
     }
   m_reorderingBuffer.clear ();
 
+  m_txBufferRefilledCallback.Nullify ();
+
   SatGenericStreamEncapsulator::DoDispose ();
 }
 
@@ -312,12 +314,19 @@ SatGenericStreamEncapsulatorArq::ArqReTxTimerExpired (uint8_t seqNo)
           NS_LOG_INFO ("Moving the ARQ context to retransmission buffer");
 
           Ptr<SatArqBufferContext> context = it->second;
+          bool txBufferEmpty = (GetTxBufferSizeInBytes () == 0);
 
           m_txedBuffer.erase (it);
           m_retxBufferSize += context->m_pdu->GetSize ();
 
           // Push to the retransmission buffer
           m_retxBuffer.insert (std::make_pair (seqNo, context));
+
+          // The buffer has data again without an enqueued packet
+          if (txBufferEmpty && !m_txBufferRefilledCallback.IsNull ())
+            {
+              m_txBufferRefilledCallback (m_destAddress, m_flowId);
+            }
         }
       // Maximum retransmissions reached
       else
@@ -587,6 +596,14 @@ SatGenericStreamEncapsulatorArq::RxWaitingTimerExpired (uint32_t seqNo)
 }
 
 
+void
+SatGenericStreamEncapsulatorArq::SetTxBufferRefilledCallback (TxBufferRefilledCallback cb)
+{
+  NS_LOG_FUNCTION (this << &cb);
+
+  m_txBufferRefilledCallback = cb;
+}
+
 uint32_t
 SatGenericStreamEncapsulatorArq::GetTxBufferSizeInBytes () const
 {
@@ -109,6 +109,20 @@ public:
    */
   virtual uint32_t GetTxBufferSizeInBytes () const;
 
+  /**
+   * Callback to notify that a retransmission has refilled the empty Tx buffer.
+   * \param Mac48Address Destination MAC address
+   * \param uint8_t Flow identifier
+   */
+  typedef Callback<void, Mac48Address, uint8_t> TxBufferRefilledCallback;
+
+  /**
+   * \brief Set the callback notifying that a retransmission has refilled the
+   * empty Tx buffer, i.e. the buffer has data without a new enqueued packet.
+   * \param cb callback to invoke when a PDU is moved to the empty Tx buffer
+   */
+  void SetTxBufferRefilledCallback (TxBufferRefilledCallback cb);
+
 private:
   /**
    * \brief ARQ Tx timer has expired. The PDU will be flushed, if the maximum
@@ -198,6 +212,11 @@ private:
    * value = GSE packet
    */
   std::map<uint32_t, Ptr<SatArqBufferContext> > m_reorderingBuffer;
+
+  /**
+   * Callback to notify that a retransmission has refilled the empty Tx buffer
+   */
+  TxBufferRefilledCallback m_txBufferRefilledCallback;
 };
 
 
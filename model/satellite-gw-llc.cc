@@ -62,9 +62,38 @@ SatGwLlc::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
 
+  m_backloggedEncaps.clear ();
+
   SatLlc::DoDispose ();
 }
 
+bool
+SatGwLlc::Enque (Ptr<Packet> packet, Address dest, uint8_t flowId)
+{
+  NS_LOG_FUNCTION (this << packet << dest << (uint32_t) flowId);
+
+  bool result = SatLlc::Enque (packet, dest, flowId);
+
+  AddBackloggedEncap (Mac48Address::ConvertFrom (dest), flowId);
+
+  return result;
+}
+
+void
+SatGwLlc::AddBackloggedEncap (Mac48Address utAddr, uint8_t flowId)
+{
+  NS_LOG_FUNCTION (this << utAddr << (uint32_t) flowId);
+
+  Ptr<EncapKey> key = Create<EncapKey> (m_nodeInfo->GetMacAddress (), utAddr, flowId);
+
+  if (m_backloggedEncaps.find (key) == m_backloggedEncaps.end ())
+    {
+      EncapContainer_t::const_iterator it = m_encaps.find (key);
+      NS_ASSERT (it != m_encaps.end ());
+      m_backloggedEncaps.insert (std::make_pair (it->first, it->second));
+    }
+}
+
 
 Ptr<Packet>
 SatGwLlc::NotifyTxOpportunity (uint32_t bytes, Mac48Address utAddr, uint8_t flowId, uint32_t &bytesLeft, uint32_t &nextMinTxO)
@@ -79,6 +108,13 @@ SatGwLlc::NotifyTxOpportunity (uint32_t bytes, Mac48Address utAddr, uint8_t flow
     {
       packet = it->second->NotifyTxOpportunity (bytes, bytesLeft, nextMinTxO);
 
+      // The encapsulator is no longer backlogged, if its buffer was emptied.
+      // With ARQ, a retransmission adds it back with a refill notification.
+      if (bytesLeft == 0)
+        {
+          m_backloggedEncaps.erase (it->first);
+        }
+
       if (packet)
         {
           SatEnums::SatLinkDir_t ld = SatEnums::LD_FORWARD;
@@ -112,7 +148,10 @@ SatGwLlc::CreateEncap (Ptr<EncapKey> key)
 
   if (m_fwdLinkArqEnabled)
     {
-      gwEncap = CreateObject<SatGenericStreamEncapsulatorArq> (key->m_source, key->m_destination, key->m_flowId);
+      Ptr<SatGenericStreamEncapsulatorArq> arqEncap =
+        CreateObject<SatGenericStreamEncapsulatorArq> (key->m_source, key->m_destination, key->m_flowId);
+      arqEncap->SetTxBufferRefilledCallback (MakeCallback (&SatGwLlc::AddBackloggedEncap, this));
+      gwEncap = arqEncap;
     }
   else
     {
@@ -170,8 +209,8 @@ void SatGwLlc::GetSchedulingContexts (std::vector< Ptr<SatSchedulingObject> > &
   Time holDelay;
 
   // Then the user data
-  for (EncapContainer_t::const_iterator cit = m_encaps.begin ();
-       cit != m_encaps.end ();
+  for (BackloggedContainer_t::const_iterator cit = m_backloggedEncaps.begin ();
+       cit != m_backloggedEncaps.end ();
        ++cit)
     {
       uint32_t buf = cit->second->GetTxBufferSizeInBytes ();
@@ -26,6 +26,29 @@
 
 namespace ns3 {
 
+/**
+ * \ingroup satellite
+ * \brief EncapKeyFlowIdCompare orders the encapsulator keys primarily by the
+ * flow id and secondarily by the destination address. At the GW the source
+ * address of the encapsulators is always the GW itself, thus it is not
+ * compared.
+ */
+class EncapKeyFlowIdCompare
+{
+public:
+  bool operator() (Ptr<EncapKey> key1, Ptr<EncapKey> key2) const
+  {
+    if ( key1->m_flowId == key2->m_flowId )
+      {
+        return key1->m_destination < key2->m_destination;
+      }
+    else
+      {
+        return key1->m_flowId < key2->m_flowId;
+      }
+  }
+};
+
 /**
  * \ingroup satellite
  * \brief SatGwLlc holds the GW implementation of LLC layer. SatGwLlc is inherited from
@@ -54,6 +77,18 @@ public:
    */
   virtual ~SatGwLlc ();
 
+  /**
+   * \brief Called from higher layer (SatNetDevice) to enque packet to LLC.
+   * The encapsulator of the packet is also added to the backlogged
+   * encapsulators.
+   *
+   * \param packet packet sent from higher layer
+   * \param dest Target MAC address
+   * \param flowId Flow identifier
+   * \return True if the packet was enqueued
+   */
+  virtual bool Enque (Ptr<Packet> packet, Address dest, uint8_t flowId);
+
   /**
     *  \brief Called from lower layer (MAC) to inform a tx
     *  opportunity of certain amount of bytes
@@ -70,6 +105,9 @@ public:
   /**
    * \brief Create and fill the scheduling objects based on LLC layer information.
    * Scheduling objects may be used at the MAC layer to assist in scheduling.
+   * Only the backlogged encapsulators are visited, thus the cost depends on
+   * the number of active flows instead of all the flows of the GW. The
+   * scheduling objects are given in ascending order of flow id.
    * \param output reference to an output vector that will be filled with
    *               pointer to scheduling objects
    */
@@ -114,6 +152,31 @@ protected:
    */
   virtual void CreateDecap (Ptr<EncapKey> key);
 
+private:
+
+  /**
+   * \brief Add an encapsulator to the backlogged encapsulators, if not
+   * already there. Called when a packet is enqueued and when an ARQ
+   * retransmission refills an emptied buffer.
+   * \param utAddr MAC address of the UT
+   * \param flowId Flow identifier
+   */
+  void AddBackloggedEncap (Mac48Address utAddr, uint8_t flowId);
+
+  /**
+   * Container of the encapsulators having data to transmit, ordered by
+   * flow id. Key = Pointer to EncapKey, value = Pointer to encapsulator.
+   */
+  typedef std::map<Ptr<EncapKey>, Ptr<SatBaseEncapsulator>, EncapKeyFlowIdCompare > BackloggedContainer_t;
+
+  /**
+   * Encapsulators with data to transmit. An encapsulator is added when a
+   * packet is enqueued to it or, with FWD link ARQ, when a retransmission
+   * refills its buffer. It is removed when its buffer is emptied by a Tx
+   * opportunity.
+   */
+  BackloggedContainer_t m_backloggedEncaps;
+
 };
 
 } // namespace ns3
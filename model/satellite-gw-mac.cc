@@ -290,10 +290,8 @@ SatGwMac::ReceiveSignalingPacket (Ptr<Packet> packet)
              * SatBeamHelper::CtrlMsgStoreTimeInRtnLink attribute may be set to too short value
              * or there are something wrong in the RTN link RRM.
              */
-            std::stringstream msg;
-            msg << "Control message " << ctrlTag.GetMsgType () << " is not found from the RTN link control msg container!";
-            msg << " at: " << Now ().GetSeconds () << "s";
-            Singleton<SatLog>::Get ()->AddToLog (SatLog::LOG_WARNING, "", msg.str ());
+            Singleton<SatLog>::Get ()->AddToLog (SatLog::LOG_WARNING, SatLog::FMT_CTRL_MSG_NOT_FOUND,
+                                                 ctrlTag.GetMsgType (), "RTN", Now ().GetSeconds ());
           }
 
         packet->RemovePacketTag (macTag);
@@ -317,10 +315,8 @@ SatGwMac::ReceiveSignalingPacket (Ptr<Packet> packet)
              * SatBeamHelper::CtrlMsgStoreTimeInRtnLink attribute may be set to too short value
              * or there are something wrong in the RTN link RRM.
              */
-            std::stringstream msg;
-            msg << "Control message " << ctrlTag.GetMsgType () << " is not found from the RTN link control msg container!";
-            msg << " at: " << Now ().GetSeconds () << "s";
-            Singleton<SatLog>::Get ()->AddToLog (SatLog::LOG_WARNING, "", msg.str ());
+            Singleton<SatLog>::Get ()->AddToLog (SatLog::LOG_WARNING, SatLog::FMT_CTRL_MSG_NOT_FOUND,
+                                                 ctrlTag.GetMsgType (), "RTN", Now ().GetSeconds ());
           }
 
         packet->RemovePacketTag (macTag);
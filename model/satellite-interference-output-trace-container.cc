@@ -146,6 +146,13 @@ SatInterferenceOutputTraceContainer::WriteToFile ()
   NS_LOG_FUNCTION (this);
 
   container_t::iterator iter;
+  SatOutputBinaryTraceFile* binaryFile = NULL;
+
+  if (m_enableBinaryOutput)
+    {
+      std::string filename = Singleton<SatEnvVariables>::Get ()->GetOutputPath () + "/interference_output_trace.bin";
+      binaryFile = new SatOutputBinaryTraceFile (filename, SatBaseTraceContainer::INTF_TRACE_DEFAULT_NUMBER_OF_COLUMNS);
+    }
 
   for (iter = m_container.begin (); iter != m_container.end (); iter++)
     {
@@ -158,7 +165,21 @@ SatInterferenceOutputTraceContainer::WriteToFile ()
                                             SatOutputFileStreamDoubleContainer::RAW,
                                             Gnuplot2dDataset::LINES_POINTS);
         }
-      iter->second->WriteContainerToFile ();
+
+      if (binaryFile != NULL)
+        {
+          iter->second->WriteContainerToBinaryFile (*binaryFile);
+        }
+      else
+        {
+          iter->second->WriteContainerToFile ();
+        }
+    }
+
+  if (binaryFile != NULL)
+    {
+      binaryFile->Close ();
+      delete binaryFile;
     }
 }
 
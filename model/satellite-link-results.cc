@@ -90,12 +90,14 @@ SatLinkResultsDvbRcs2::DoInitialize ()
   NS_LOG_FUNCTION (this);
 
   // Waveform ids 2-22 currently supported
+  m_table.resize (23);
+
   for (uint32_t i = 2; i <= 22; ++i)
     {
       std::ostringstream ss;
       ss << i;
       std::string filePathName = m_inputPath + "rcs2_waveformat" + ss.str () + ".txt";
-      m_table.insert (std::make_pair (i, CreateObject<SatLookUpTable> (filePathName)));
+      m_table[i] = CreateObject<SatLookUpTable> (filePathName);
     }
 } // end of void SatLinkResultsDvbRcs2::DoInitialize
 
@@ -109,7 +111,7 @@ SatLinkResultsDvbRcs2::GetBler (uint32_t waveformId, double ebNoDb) const
       NS_FATAL_ERROR ("Error retrieving link results, call Initialize first");
     }
 
-  return m_table.at (waveformId)->GetBler (ebNoDb);
+  return GetTable (waveformId)->GetBler (ebNoDb);
 }
 
 double
@@ -122,7 +124,7 @@ SatLinkResultsDvbRcs2::GetEbNoDb (uint32_t waveformId, double blerTarget) const
       NS_FATAL_ERROR ("Error retrieving link results, call Initialize first");
     }
 
-  return m_table.at (waveformId)->GetEsNoDb (blerTarget);
+  return GetTable (waveformId)->GetEsNoDb (blerTarget);
 }
 
 /*
@@ -157,6 +159,8 @@ SatLinkResultsDvbS2::DoInitialize ()
 {
   NS_LOG_FUNCTION (this);
 
+  m_table.resize (SatEnums::SAT_MODCOD_32APSK_8_TO_9 + 1);
+
   // QPSK
   m_table[SatEnums::SAT_MODCOD_QPSK_1_TO_2] = CreateObject<SatLookUpTable> (m_inputPath + "s2_qpsk_1_to_2.txt");
   m_table[SatEnums::SAT_MODCOD_QPSK_2_TO_3] = CreateObject<SatLookUpTable> (m_inputPath + "s2_qpsk_2_to_3.txt");
@@ -211,7 +215,7 @@ SatLinkResultsDvbS2::GetBler (SatEnums::SatModcod_t modcod, SatEnums::SatBbFrame
       esNoDb -= m_shortFrameOffsetInDb;
     }
 
-  return m_table.at (modcod)->GetBler (esNoDb);
+  return GetTable (modcod)->GetBler (esNoDb);
 }
 
 double
@@ -225,7 +229,7 @@ SatLinkResultsDvbS2::GetEsNoDb (SatEnums::SatModcod_t modcod, SatEnums::SatBbFra
     }
 
   // Get Es/No requirement for normal BB frame
-  double esno = m_table.at (modcod)->GetEsNoDb (blerTarget);
+  double esno = GetTable (modcod)->GetEsNoDb (blerTarget);
 
   /**
    * Short BB frame is assumed to be requiring "m_shortFrameOffsetInDb" dB
@@ -22,7 +22,8 @@
 #ifndef SATELLITE_LINK_RESULTS_H
 #define SATELLITE_LINK_RESULTS_H
 
-#include <map>
+#include <vector>
+#include <ns3/assert.h>
 
 #include <ns3/object.h>
 #include <ns3/ptr.h>
@@ -157,11 +158,22 @@ protected:
 
 private:
   /**
-   * \brief Map of satellite link result look up tables.
-   * - key = uint32_t, i.e. waveform id
-   * - value = Ptr<SatLookUpTable>, i.e. look-up table containing the link results
+   * \brief Get the look up table of a waveform.
+   * \param waveformId Waveform id
+   * \return Look up table containing the link results of the waveform
    */
-  std::map<uint32_t, Ptr<SatLookUpTable> > m_table;
+  inline const Ptr<SatLookUpTable>& GetTable (uint32_t waveformId) const
+  {
+    NS_ASSERT_MSG (waveformId < m_table.size () && m_table[waveformId] != 0,
+                   "No link results for waveform " << waveformId);
+    return m_table[waveformId];
+  }
+
+  /**
+   * \brief Satellite link result look up tables indexed directly by waveform id.
+   * Tables of unsupported waveform ids are null.
+   */
+  std::vector<Ptr<SatLookUpTable> > m_table;
 };
 
 
@@ -227,11 +239,23 @@ protected:
 
 private:
   /**
-   * \brief Map of satellite link result look up tables.
-   * - key = SatModcod_e, i.e. modulation and coding scheme
-   * - value = Ptr<SatLookUpTable>, i.e. look-up table containing the link results
+   * \brief Get the look up table of a MODCOD.
+   * \param modcod Modulation and coding scheme
+   * \return Look up table containing the link results of the MODCOD
+   */
+  inline const Ptr<SatLookUpTable>& GetTable (SatEnums::SatModcod_t modcod) const
+  {
+    NS_ASSERT_MSG ((uint32_t)modcod < m_table.size () && m_table[modcod] != 0,
+                   "No link results for MODCOD " << modcod);
+    return m_table[modcod];
+  }
+
+  /**
+   * \brief Satellite link result look up tables indexed directly by
+   * SatModcod_t, i.e. modulation and coding scheme.
+   * Tables of unsupported MODCODs are null.
    */
-  std::map<SatEnums::SatModcod_t, Ptr<SatLookUpTable> > m_table;
+  std::vector<Ptr<SatLookUpTable> > m_table;
 
   double m_shortFrameOffsetInDb;
 };
@@ -21,6 +21,7 @@
 #include "ns3/satellite-env-variables.h"
 #include "ns3/singleton.h"
 #include "ns3/string.h"
+#include "ns3/uinteger.h"
 
 NS_LOG_COMPONENT_DEFINE ("SatLog");
 
@@ -28,12 +29,60 @@ namespace ns3 {
 
 NS_OBJECT_ENSURE_REGISTERED (SatLog);
 
+/**
+ * \brief Format strings of the structured log entries, indexed by SatLog::LogFormat_t
+ */
+static const char* g_satLogFormats[SatLog::FMT_COUNT] =
+{
+  "{}",
+  "Control message {} is not found from the {} link control msg container! at: {}s",
+  "SatQueue is full: packet dropped! at: {}s MaxPackets: {}"
+};
+
+void
+SatLogArgument::Print (std::ostream &os) const
+{
+  switch (m_type)
+    {
+    case ARG_SIGNED:
+      {
+        os << m_value.s;
+        break;
+      }
+    case ARG_UNSIGNED:
+      {
+        os << m_value.u;
+        break;
+      }
+    case ARG_DOUBLE:
+      {
+        os << m_value.d;
+        break;
+      }
+    case ARG_STRING:
+      {
+        os << m_value.str;
+        break;
+      }
+    default:
+      {
+        NS_FATAL_ERROR ("SatLogArgument::Print - Invalid argument type");
+        break;
+      }
+    }
+}
+
 TypeId
 SatLog::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::SatLog")
     .SetParent<Object> ()
-    .AddConstructor<SatLog> ();
+    .AddConstructor<SatLog> ()
+    .AddAttribute ("EnabledLogTypes",
+                   "Bit mask of the enabled log types, bit n enables the log type with value n",
+                   UintegerValue (0x1F),
+                   MakeUintegerAccessor (&SatLog::m_enabledLogTypes),
+                   MakeUintegerChecker<uint32_t> ());
   return tid;
 }
 
@@ -46,6 +95,7 @@ SatLog::GetInstanceTypeId (void) const
 }
 
 SatLog::SatLog ()
+  : m_enabledLogTypes (0x1F)
 {
   NS_LOG_FUNCTION (this);
 
@@ -72,6 +122,8 @@ SatLog::Reset ()
 {
   NS_LOG_FUNCTION (this);
 
+  FormatEntries ();
+
   if (!m_container.empty ())
     {
       WriteToFile ();
@@ -139,9 +191,21 @@ SatLog::AddToLog (LogType_t logType, std::string fileTag, std::string message)
 {
   NS_LOG_FUNCTION (this);
 
+  if (!IsEnabled (logType))
+    {
+      return;
+    }
+
   if (logType != LOG_CUSTOM)
     {
-      fileTag = GetFileTag (logType);
+      /// stored as an entry to keep the order with the structured entries
+      NS_LOG_INFO ("SatLog::AddToLog - Type: " << logType << ", message: " << message);
+
+      m_messages[logType].push_back (message);
+
+      const SatLogArgument argument ((uint64_t) (m_messages[logType].size () - 1));
+      AddEntry (logType, FMT_MESSAGE, &argument, 1);
+      return;
     }
 
   Ptr<SatOutputFileStreamStringContainer> log = FindLog (logType, fileTag);
@@ -154,6 +218,90 @@ SatLog::AddToLog (LogType_t logType, std::string fileTag, std::string message)
     }
 }
 
+void
+SatLog::AddEntry (LogType_t logType, LogFormat_t format, const SatLogArgument* arguments, uint32_t numOfArguments)
+{
+  NS_LOG_FUNCTION (this << logType << format << numOfArguments);
+
+  if (logType >= LOG_CUSTOM)
+    {
+      NS_FATAL_ERROR ("SatLog::AddEntry - Structured entries are supported only for predefined log types");
+    }
+
+  if (format >= FMT_COUNT)
+    {
+      NS_FATAL_ERROR ("SatLog::AddEntry - Invalid format");
+    }
+
+  logEntry_s entry;
+  entry.format = format;
+  entry.numOfArguments = numOfArguments;
+
+  for (uint32_t i = 0; i < numOfArguments; i++)
+    {
+      entry.arguments[i] = arguments[i];
+    }
+
+  m_entries[logType].push_back (entry);
+}
+
+std::string
+SatLog::FormatEntry (LogType_t logType, const logEntry_s& entry) const
+{
+  if (entry.format == FMT_MESSAGE)
+    {
+      if (entry.numOfArguments != 1 || entry.arguments[0].GetUnsigned () >= m_messages[logType].size ())
+        {
+          NS_FATAL_ERROR ("SatLog::FormatEntry - FMT_MESSAGE is reserved for plain string messages");
+        }
+
+      return m_messages[logType][entry.arguments[0].GetUnsigned ()];
+    }
+
+  std::stringstream message;
+  const char* format = g_satLogFormats[entry.format];
+  uint32_t argument = 0;
+
+  for (const char* c = format; *c != '\0'; c++)
+    {
+      if (c[0] == '{' && c[1] == '}' && argument < entry.numOfArguments)
+        {
+          entry.arguments[argument++].Print (message);
+          c++;
+        }
+      else
+        {
+          message << *c;
+        }
+    }
+
+  return message.str ();
+}
+
+void
+SatLog::FormatEntries ()
+{
+  NS_LOG_FUNCTION (this);
+
+  for (uint32_t i = 0; i < LOG_CUSTOM; i++)
+    {
+      LogType_t logType = (LogType_t) i;
+
+      if (!m_entries[i].empty ())
+        {
+          Ptr<SatOutputFileStreamStringContainer> log = FindLog (logType, GetFileTag (logType));
+
+          for (std::vector<logEntry_s>::const_iterator it = m_entries[i].begin (); it != m_entries[i].end (); ++it)
+            {
+              log->AddToContainer (FormatEntry (logType, *it));
+            }
+        }
+
+      m_entries[i].clear ();
+      m_messages[i].clear ();
+    }
+}
+
 std::string
 SatLog::GetFileTag (LogType_t logType)
 {
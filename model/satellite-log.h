@@ -22,9 +22,96 @@
 
 #include "ns3/satellite-output-fstream-string-container.h"
 #include <map>
+#include <vector>
+#include <stdint.h>
 
 namespace ns3 {
 
+/**
+ * \ingroup satellite
+ *
+ * \brief Typed argument of a structured SatLog entry.
+ */
+class SatLogArgument
+{
+public:
+  /**
+   * \brief Enum for argument types
+   */
+  typedef enum
+  {
+    ARG_SIGNED,
+    ARG_UNSIGNED,
+    ARG_DOUBLE,
+    ARG_STRING
+  } ArgumentType_t;
+
+  /**
+   * \brief Constructors for the supported argument types. Strings are stored as
+   * pointers and must therefore have a static storage duration.
+   */
+  SatLogArgument ()
+    : m_type (ARG_SIGNED)
+  {
+    m_value.s = 0;
+  }
+  SatLogArgument (int32_t value)
+    : m_type (ARG_SIGNED)
+  {
+    m_value.s = value;
+  }
+  SatLogArgument (int64_t value)
+    : m_type (ARG_SIGNED)
+  {
+    m_value.s = value;
+  }
+  SatLogArgument (uint32_t value)
+    : m_type (ARG_UNSIGNED)
+  {
+    m_value.u = value;
+  }
+  SatLogArgument (uint64_t value)
+    : m_type (ARG_UNSIGNED)
+  {
+    m_value.u = value;
+  }
+  SatLogArgument (double value)
+    : m_type (ARG_DOUBLE)
+  {
+    m_value.d = value;
+  }
+  SatLogArgument (const char* value)
+    : m_type (ARG_STRING)
+  {
+    m_value.str = value;
+  }
+
+  /**
+   * \brief Get the value of an unsigned argument
+   * \return value
+   */
+  inline uint64_t GetUnsigned () const
+  {
+    return m_value.u;
+  }
+
+  /**
+   * \brief Write the argument into a stream
+   * \param os output stream
+   */
+  void Print (std::ostream &os) const;
+
+private:
+  ArgumentType_t m_type;
+  union
+  {
+    int64_t s;
+    uint64_t u;
+    double d;
+    const char* str;
+  } m_value;
+};
+
 /**
  * \ingroup satellite
  *
@@ -48,6 +135,12 @@ namespace ns3 {
  * With (LOG_CUSTOM, "_exampleTag", "Example message for custom log") and simulation tag
  * "_ut30_beam1" the file log_exampleTag_ut30_beam1 would contain the message
  * "Example message for custom log".
+ *
+ * Messages of the predefined log types can also be added as a format id with typed
+ * arguments. These entries are stored as such into a per log type buffer and formatted
+ * only when the logs are written into the files, so the caller does not need to build
+ * the message string. Log types disabled with the EnabledLogTypes attribute are dropped
+ * already when adding the message.
  */
 class SatLog : public Object
 {
@@ -64,6 +157,23 @@ public:
     LOG_CUSTOM = 4  //!< LOG_CUSTOM
   } LogType_t;
 
+  /**
+   * \brief Enum for the message formats of the structured log entries. In the
+   * format strings each "{}" is replaced by the next argument.
+   */
+  typedef enum
+  {
+    FMT_MESSAGE = 0,                //!< "{}", reserved for plain string messages
+    FMT_CTRL_MSG_NOT_FOUND = 1,     //!< "Control message {} is not found from the {} link control msg container! at: {}s"
+    FMT_QUEUE_FULL = 2,             //!< "SatQueue is full: packet dropped! at: {}s MaxPackets: {}"
+    FMT_COUNT = 3                   //!< Number of formats
+  } LogFormat_t;
+
+  /**
+   * \brief Maximum number of arguments in a structured log entry
+   */
+  static const uint32_t MAX_ARGUMENTS = 4;
+
   /**
    * \brief typedef for container key
    */
@@ -109,6 +219,48 @@ public:
    */
   void AddToLog (LogType_t logType, std::string fileTag, std::string message);
 
+  /**
+   * \brief Function for adding a structured entry to a predefined log. The entry
+   * is formatted only when the log is written into the file.
+   * \param logType log type, LOG_CUSTOM is not supported
+   * \param format message format id
+   * \param args arguments for the format
+   */
+  template <typename... Args>
+  void AddToLog (LogType_t logType, LogFormat_t format, const Args&... args)
+  {
+    static_assert (sizeof... (Args) <= MAX_ARGUMENTS, "SatLog - Too many arguments for a log entry");
+
+    if (IsEnabled (logType))
+      {
+        const SatLogArgument arguments[] = { SatLogArgument (args)... };
+        AddEntry (logType, format, arguments, sizeof... (Args));
+      }
+  }
+
+  /**
+   * \brief Function for adding a structured entry without arguments to a predefined log.
+   * \param logType log type, LOG_CUSTOM is not supported
+   * \param format message format id
+   */
+  void AddToLog (LogType_t logType, LogFormat_t format)
+  {
+    if (IsEnabled (logType))
+      {
+        AddEntry (logType, format, NULL, 0);
+      }
+  }
+
+  /**
+   * \brief Check whether a log type is enabled
+   * \param logType log type
+   * \return true if messages of the log type are logged
+   */
+  inline bool IsEnabled (LogType_t logType) const
+  {
+    return (m_enabledLogTypes & (1 << logType)) != 0;
+  }
+
   /**
    * \brief Function for resetting the variables
    */
@@ -143,10 +295,58 @@ private:
    */
   void WriteToFile ();
 
+  /**
+   * \brief Struct for a structured log entry
+   */
+  typedef struct
+  {
+    LogFormat_t format;
+    uint32_t numOfArguments;
+    SatLogArgument arguments[MAX_ARGUMENTS];
+  } logEntry_s;
+
+  /**
+   * \brief Function for storing a structured entry into the buffer of the log type
+   * \param logType log type
+   * \param format message format id
+   * \param arguments arguments for the format
+   * \param numOfArguments number of arguments
+   */
+  void AddEntry (LogType_t logType, LogFormat_t format, const SatLogArgument* arguments, uint32_t numOfArguments);
+
+  /**
+   * \brief Function for formatting a structured entry
+   * \param logType log type of the entry
+   * \param entry log entry
+   * \return formatted message
+   */
+  std::string FormatEntry (LogType_t logType, const logEntry_s& entry) const;
+
+  /**
+   * \brief Format the buffered structured entries into the log containers
+   */
+  void FormatEntries ();
+
   /**
    * \brief Map for containers
    */
   container_t m_container;
+
+  /**
+   * \brief Buffers for the structured entries of the predefined log types
+   */
+  std::vector<logEntry_s> m_entries[LOG_CUSTOM];
+
+  /**
+   * \brief Plain string messages of the predefined log types, referred by
+   * index from the FMT_MESSAGE entries
+   */
+  std::vector<std::string> m_messages[LOG_CUSTOM];
+
+  /**
+   * \brief Bit mask of the enabled log types, bit n enables log type n
+   */
+  uint32_t m_enabledLogTypes;
 };
 
 } // namespace ns3
@@ -93,30 +93,10 @@ SatLooModel::Reset ()
   m_normalRandomVariable = NULL;
   m_uniformVariable = NULL;
 
-  if (!m_directSignalOscillators.empty ())
-    {
-      for (uint32_t i = 0; i < m_numOfStates; i++)
-        {
-          if (!m_directSignalOscillators[i].empty ())
-            {
-              m_directSignalOscillators[i].clear ();
-            }
-        }
-      m_directSignalOscillators.clear ();
-    }
-
-  if (!m_multipathOscillators.empty ())
-    {
-      for (uint32_t i = 0; i < m_numOfStates; i++)
-        {
-          if (!m_multipathOscillators[i].empty ())
-            {
-              m_multipathOscillators[i].clear ();
-            }
-        }
-      m_multipathOscillators.clear ();
-    }
+  m_directSignalOscillators.clear ();
+  m_multipathOscillators.clear ();
 
+  m_oscillatorPhases.clear ();
   m_looParameters.clear ();
   m_sigma.clear ();
 }
@@ -128,7 +108,7 @@ SatLooModel::ConstructDirectSignalOscillators ()
 
   for (uint32_t i = 0; i < m_numOfStates; i++)
     {
-      std::vector< Ptr<SatFadingOscillator> > oscillators;
+      oscillatorBank_s oscillators;
 
       /// Initial phase is common for all oscillators:
       double phi = m_uniformVariable->GetValue ();
@@ -153,7 +133,9 @@ SatLooModel::ConstructDirectSignalOscillators ()
           amplitude = pow (10,amplitude / 10) / m_looParameters[i][3];
 
           /// 3. Construct oscillator:
-          oscillators.push_back (CreateObject<SatFadingOscillator> (amplitude, phi, omega));
+          oscillators.amplitudeReal.push_back (amplitude);
+          oscillators.phase.push_back (phi);
+          oscillators.omega.push_back (omega);
         }
       m_directSignalOscillators.push_back (oscillators);
     }
@@ -166,7 +148,7 @@ SatLooModel::ConstructMultipathOscillators ()
 
   for (uint32_t i = 0; i < m_numOfStates; i++)
     {
-      std::vector< Ptr<SatFadingOscillator> > oscillators;
+      oscillatorBank_s oscillators;
 
       /// Initial phase is common for all oscillators:
       double phi = m_uniformVariable->GetValue ();
@@ -184,7 +166,10 @@ SatLooModel::ConstructMultipathOscillators ()
           double psi = m_normalRandomVariable->GetValue ();
           std::complex<double> amplitude = std::complex<double> (std::cos (psi), std::sin (psi)) * 2.0 / std::sqrt (m_looParameters[i][4]);
           /// 3. Construct oscillator:
-          oscillators.push_back (CreateObject<SatFadingOscillator> (amplitude, phi, omega));
+          oscillators.amplitudeReal.push_back (amplitude.real ());
+          oscillators.amplitudeImag.push_back (amplitude.imag ());
+          oscillators.phase.push_back (phi);
+          oscillators.omega.push_back (omega);
         }
       m_multipathOscillators.push_back (oscillators);
     }
@@ -208,10 +193,10 @@ SatLooModel::GetChannelGain ()
   double timeInSeconds = Now ().GetSeconds ();
 
   /// Direct signal
-  std::complex<double> directComplexGain = GetOscillatorCosineWaveSum (m_directSignalOscillators[m_currentState], timeInSeconds);
+  std::complex<double> directComplexGain = GetOscillatorCosineWaveSum (m_directSignalOscillators[m_currentState], timeInSeconds, m_oscillatorPhases);
 
   /// Multipath
-  std::complex<double> multipathComplexGain = GetOscillatorComplexSum (m_multipathOscillators[m_currentState], timeInSeconds);
+  std::complex<double> multipathComplexGain = GetOscillatorComplexSum (m_multipathOscillators[m_currentState], timeInSeconds, m_oscillatorPhases);
   multipathComplexGain = multipathComplexGain * m_sigma[m_currentState];
 
   /// Combining
@@ -219,34 +204,67 @@ SatLooModel::GetChannelGain ()
   return sqrt ((pow (fadingGain.real (), 2) + pow (fadingGain.imag (), 2)));
 }
 
+void
+SatLooModel::CalculateOscillatorPhases (const oscillatorBank_s& oscillators, double timeInSeconds, std::vector<double>& phases)
+{
+  const uint32_t size = oscillators.omega.size ();
+  const double* omega = oscillators.omega.empty () ? NULL : &oscillators.omega[0];
+  const double* phase = oscillators.phase.empty () ? NULL : &oscillators.phase[0];
+
+  phases.resize (size);
+  double* phaseValues = phases.empty () ? NULL : &phases[0];
+
+  /// independent iterations over contiguous arrays, the compiler is able to vectorize this
+  for (uint32_t i = 0; i < size; i++)
+    {
+      phaseValues[i] = timeInSeconds * omega[i] + phase[i];
+    }
+}
+
 std::complex<double>
-SatLooModel::GetOscillatorCosineWaveSum (std::vector< Ptr<SatFadingOscillator> > oscillator, double timeInSeconds)
+SatLooModel::GetOscillatorCosineWaveSum (const oscillatorBank_s& oscillators, double timeInSeconds, std::vector<double>& phases)
 {
-  NS_LOG_FUNCTION (this);
+  NS_LOG_FUNCTION (timeInSeconds);
 
-  std::complex<double> complexSum = std::complex<double> (0, 0);
+  CalculateOscillatorPhases (oscillators, timeInSeconds, phases);
 
-  for (uint32_t i = 0; i < oscillator.size (); i++)
+  const uint32_t size = phases.size ();
+  double sumReal = 0.0;
+  double sumImag = 0.0;
+
+  /// amplitude * exp (cos (x) + i sin (x)) = amplitude * e^cos (x) * (cos (sin (x)) + i sin (sin (x)))
+  for (uint32_t i = 0; i < size; i++)
     {
-      complexSum += oscillator[i]->GetCosineWaveValueAt (timeInSeconds);
+      double magnitude = oscillators.amplitudeReal[i] * std::exp (std::cos (phases[i]));
+      double angle = std::sin (phases[i]);
+
+      sumReal += magnitude * std::cos (angle);
+      sumImag += magnitude * std::sin (angle);
     }
 
-  return complexSum;
+  return std::complex<double> (sumReal, sumImag);
 }
 
 std::complex<double>
-SatLooModel::GetOscillatorComplexSum (std::vector< Ptr<SatFadingOscillator> > oscillator, double timeInSeconds)
+SatLooModel::GetOscillatorComplexSum (const oscillatorBank_s& oscillators, double timeInSeconds, std::vector<double>& phases)
 {
-  NS_LOG_FUNCTION (this);
+  NS_LOG_FUNCTION (timeInSeconds);
+
+  CalculateOscillatorPhases (oscillators, timeInSeconds, phases);
 
-  std::complex<double> complexSum = std::complex<double> (0, 0);
+  const uint32_t size = phases.size ();
+  double sumReal = 0.0;
+  double sumImag = 0.0;
 
-  for (uint32_t i = 0; i < oscillator.size (); i++)
+  for (uint32_t i = 0; i < size; i++)
     {
-      complexSum += oscillator[i]->GetComplexValueAt (timeInSeconds);
+      double value = std::cos (phases[i]);
+
+      sumReal += oscillators.amplitudeReal[i] * value;
+      sumImag += oscillators.amplitudeImag[i] * value;
     }
 
-  return complexSum;
+  return std::complex<double> (sumReal, sumImag);
 }
 
 void
@@ -276,29 +294,8 @@ SatLooModel::ChangeSet (uint32_t newSet, uint32_t newState)
 
   ChangeState (newState);
 
-  if (!m_directSignalOscillators.empty ())
-    {
-      for (uint32_t i = 0; i < m_numOfStates; i++)
-        {
-          if (!m_directSignalOscillators[i].empty ())
-            {
-              m_directSignalOscillators[i].clear ();
-            }
-        }
-      m_directSignalOscillators.clear ();
-    }
-
-  if (!m_multipathOscillators.empty ())
-    {
-      for (uint32_t i = 0; i < m_numOfStates; i++)
-        {
-          if (!m_multipathOscillators[i].empty ())
-            {
-              m_multipathOscillators[i].clear ();
-            }
-        }
-      m_multipathOscillators.clear ();
-    }
+  m_directSignalOscillators.clear ();
+  m_multipathOscillators.clear ();
 
   m_sigma.clear ();
 
@@ -22,9 +22,10 @@
 
 #include "ns3/vector.h"
 #include "satellite-base-fader.h"
-#include "satellite-fading-oscillator.h"
 #include "satellite-loo-conf.h"
 #include "ns3/random-variable-stream.h"
+#include <complex>
+#include <vector>
 
 namespace ns3 {
 
@@ -38,6 +39,18 @@ namespace ns3 {
 class SatLooModel : public SatBaseFader
 {
 public:
+  /**
+   * \brief Oscillators of one state stored as contiguous arrays. Direct signal
+   * oscillators have a real amplitude, thus their amplitudeImag is left empty.
+   */
+  typedef struct
+  {
+    std::vector<double> amplitudeReal;
+    std::vector<double> amplitudeImag;
+    std::vector<double> phase;
+    std::vector<double> omega;
+  } oscillatorBank_s;
+
   /**
    * \brief NS-3 function for type id
    * \return type id
@@ -87,6 +100,24 @@ public:
    */
   void UpdateParameters (uint32_t set, uint32_t state);
 
+  /**
+   * \brief Function for calculating cosine wave oscillator complex sum
+   * \param oscillators oscillator bank
+   * \param timeInSeconds current time in seconds
+   * \param phases buffer for the oscillator phases
+   * \return sum
+   */
+  static std::complex<double> GetOscillatorCosineWaveSum (const oscillatorBank_s& oscillators, double timeInSeconds, std::vector<double>& phases);
+
+  /**
+   * \brief Function for calculating oscillator complex sum
+   * \param oscillators oscillator bank
+   * \param timeInSeconds current time in seconds
+   * \param phases buffer for the oscillator phases
+   * \return sum
+   */
+  static std::complex<double> GetOscillatorComplexSum (const oscillatorBank_s& oscillators, double timeInSeconds, std::vector<double>& phases);
+
 private:
   /**
    * \brief Number of states
@@ -129,14 +160,19 @@ private:
   Ptr<UniformRandomVariable> m_uniformVariable;
 
   /**
-   * \brief Direct signal oscillators
+   * \brief Direct signal oscillators for each state
    */
-  std::vector< std::vector< Ptr<SatFadingOscillator> > > m_directSignalOscillators;
+  std::vector<oscillatorBank_s> m_directSignalOscillators;
 
   /**
-   * \brief Multipath oscillators
+   * \brief Multipath oscillators for each state
    */
-  std::vector< std::vector< Ptr<SatFadingOscillator> > > m_multipathOscillators;
+  std::vector<oscillatorBank_s> m_multipathOscillators;
+
+  /**
+   * \brief Buffer for the oscillator phase values of the current evaluation
+   */
+  std::vector<double> m_oscillatorPhases;
 
   /**
    * \brief Function for constructing direct signal oscillators
@@ -149,20 +185,12 @@ private:
   void ConstructMultipathOscillators ();
 
   /**
-   * \brief Function for calculating cosine wave oscillator complex sum
-   * \param oscillator oscillator
+   * \brief Function for calculating the oscillator phases of a bank at given time
+   * \param oscillators oscillator bank
    * \param timeInSeconds current time in seconds
-   * \return sum
-   */
-  std::complex<double> GetOscillatorCosineWaveSum (std::vector< Ptr<SatFadingOscillator> > oscillator, double timeInSeconds);
-
-  /**
-   * \brief Function for calculating oscillator complex sum
-   * \param oscillator oscillator
-   * \param timeInSeconds current time in seconds
-   * \return sum
+   * \param phases buffer for the phases
    */
-  std::complex<double> GetOscillatorComplexSum (std::vector< Ptr<SatFadingOscillator> > oscillator, double timeInSeconds);
+  static void CalculateOscillatorPhases (const oscillatorBank_s& oscillators, double timeInSeconds, std::vector<double>& phases);
 
   /**
    * \brief Function for setting the state
@@ -19,7 +19,9 @@
  *
  */
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 #include "ns3/log.h"
 #include "ns3/fatal-error.h"
@@ -34,9 +36,12 @@ NS_OBJECT_ENSURE_REGISTERED (SatLookUpTable);
 
 
 SatLookUpTable::SatLookUpTable (std::string linkResultPath)
+  : m_gridInvStepDb (0.0),
+    m_ifs (0)
 {
   NS_LOG_FUNCTION (this << linkResultPath);
   Load (linkResultPath);
+  BuildGrid ();
 }
 
 
@@ -53,6 +58,7 @@ SatLookUpTable::DoDispose ()
 
   m_esNoDb.clear ();
   m_bler.clear ();
+  m_gridIndex.clear ();
 
   if (m_ifs != 0)
     {
@@ -90,6 +96,14 @@ SatLookUpTable::GetBler (double esNoDb) const
   NS_ASSERT (n > 0);
   NS_ASSERT (m_bler.size () == n);
 
+  if (std::isnan (esNoDb))
+    {
+      // edge case: undefined SINR, e.g. zero signal and interference powers,
+      // cannot be mapped to the grid, return maximum BLER (100% error rate)
+      NS_LOG_WARN (this << " SINR is NaN -> BLER = 1.0");
+      return 1.0;
+    }
+
   if (esNoDb < m_esNoDb[0])
     {
       // edge case: very low SINR, return maximum BLER (100% error rate)
@@ -97,7 +111,15 @@ SatLookUpTable::GetBler (double esNoDb) const
       return 1.0;
     }
 
-  uint16_t i = 1;
+  if (esNoDb > m_esNoDb[n - 1])
+    {
+      // edge case: very high SINR, return minimum BLER (100% success rate)
+      NS_LOG_INFO (this << " Very high SINR -> BLER = 0.0");
+      return 0.0;
+    }
+
+  // start from the first row of the grid bin, all the rows before are below esNoDb
+  uint16_t i = m_gridIndex[GetGridBin (esNoDb)];
 
   while ((i < n) && (esNoDb > m_esNoDb[i]))
     {
@@ -234,7 +256,53 @@ SatLookUpTable::Load (std::string linkResultPath)
   // SINR and BLER have same size
   NS_ASSERT (m_esNoDb.size () == m_bler.size ());
 
+  if (m_esNoDb.size () > std::numeric_limits<uint16_t>::max ())
+    {
+      NS_FATAL_ERROR ("The file " << linkResultPath << " has too many rows.");
+    }
+
 } // end of void Load (std::string linkResultPath)
 
 
+void
+SatLookUpTable::BuildGrid ()
+{
+  NS_LOG_FUNCTION (this);
+
+  uint16_t n = m_esNoDb.size ();
+
+  // grid step is the smallest Es/No spacing in the table, so that there is
+  // at most one row within a bin, limited by the maximum number of bins
+  double rangeDb = m_esNoDb[n - 1] - m_esNoDb[0];
+  double stepDb = rangeDb;
+
+  for (uint16_t i = 1; i < n; ++i)
+    {
+      stepDb = std::min (stepDb, m_esNoDb[i] - m_esNoDb[i - 1]);
+    }
+
+  stepDb = std::max (stepDb, rangeDb / (MAX_GRID_BINS - 1));
+
+  m_gridInvStepDb = (stepDb > 0.0) ? (1.0 / stepDb) : 0.0;
+  m_gridIndex.clear ();
+
+  // row index for each bin, bins are mapped with GetGridBin to keep lookups
+  // consistent with the grid also with rounding of the bin computation
+  uint32_t lastBin = GetGridBin (m_esNoDb[n - 1]);
+  uint16_t i = 1;
+
+  for (uint32_t bin = 0; bin <= lastBin; ++bin)
+    {
+      while ((i < n) && (GetGridBin (m_esNoDb[i]) < bin))
+        {
+          i++;
+        }
+
+      m_gridIndex.push_back (i);
+    }
+
+  NS_LOG_INFO (this << " Es/No grid: step = " << stepDb << " dB, bins = " << m_gridIndex.size ());
+}
+
+
 } // end of namespace ns3
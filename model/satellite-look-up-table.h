@@ -34,6 +34,12 @@ namespace ns3 {
  * \ingroup satellite
  *
  * \brief Loads a link result file and provide query service for BLER.
+ *
+ * BLER queries are sped up by a uniform Es/No grid built at load time. Each
+ * grid bin holds the index of the first table row falling into or after the
+ * bin, so a query is a direct index to the grid, typically followed by at
+ * most one step in the table, and the linear interpolation. The results
+ * are identical to a linear search of the table.
  */
 class SatLookUpTable : public Object
 {
@@ -70,6 +76,18 @@ public:
    */
   double GetEsNoDb (double blerTarget) const;
 
+  /**
+   * \brief Get the Es/No values of the table
+   * \return Es/No values in dB in ascending order
+   */
+  inline const std::vector<double>& GetEsNoDbValues () const { return m_esNoDb; }
+
+  /**
+   * \brief Get the BLER values of the table
+   * \return BLER values corresponding to the Es/No values
+   */
+  inline const std::vector<double>& GetBlerValues () const { return m_bler; }
+
 private:
   virtual void DoDispose ();
 
@@ -79,8 +97,40 @@ private:
    */
   void Load (std::string linkResultPath);
 
+  /**
+   * \brief Build the uniform Es/No grid used to index the table
+   */
+  void BuildGrid ();
+
+  /**
+   * \brief Get the grid bin of the given Es/No
+   * \param esNoDb Es/No in dB, within the Es/No range of the table
+   * \return Index of the grid bin
+   */
+  inline uint32_t GetGridBin (double esNoDb) const
+  {
+    return (uint32_t)((esNoDb - m_esNoDb[0]) * m_gridInvStepDb);
+  }
+
+  /**
+   * Maximum number of bins in the Es/No grid
+   */
+  static const uint32_t MAX_GRID_BINS = 65536;
+
   std::vector<double> m_esNoDb;
   std::vector<double> m_bler;
+
+  /**
+   * \brief Index of the first table row (starting from the second row)
+   * at or after each Es/No grid bin
+   */
+  std::vector<uint16_t> m_gridIndex;
+
+  /**
+   * \brief Inverse of the Es/No grid step in 1/dB
+   */
+  double m_gridInvStepDb;
+
   std::ifstream *m_ifs;
 };
 
@@ -23,11 +23,17 @@
 #include "ns3/output-stream-wrapper.h"
 #include "ns3/trace-helper.h"
 #include "ns3/string.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
 #include "ns3/mac48-address.h"
 #include "ns3/singleton.h"
 #include "../utils/satellite-env-variables.h"
 #include "satellite-packet-trace.h"
 
+#include <algorithm>
+#include <cstring>
+#include <stdint.h>
+
 NS_LOG_COMPONENT_DEFINE ("SatPacketTrace");
 
 namespace ns3 {
@@ -35,22 +41,48 @@ namespace ns3 {
 NS_OBJECT_ENSURE_REGISTERED (SatPacketTrace);
 
 SatPacketTrace::SatPacketTrace ()
+  : m_binaryFormat (false),
+    m_binaryBufferSize (0),
+    m_bufferUsed (0)
 {
   ObjectBase::ConstructSelf (AttributeConstructionList ());
 
-  AsciiTraceHelper asciiTraceHelper;
-
   std::stringstream outputPath;
-  outputPath << Singleton<SatEnvVariables>::Get ()->GetOutputPath () << "/" << m_fileName << ".log";
+  outputPath << Singleton<SatEnvVariables>::Get ()->GetOutputPath () << "/" << m_fileName;
+
+  if (m_binaryFormat)
+    {
+      outputPath << ".bin";
+      m_binaryStream.open (outputPath.str ().c_str (), std::ios::out | std::ios::binary);
+
+      if (!m_binaryStream.is_open ())
+        {
+          NS_FATAL_ERROR ("SatPacketTrace::SatPacketTrace - Unable to open " << outputPath.str ());
+        }
 
-  m_packetTraceStream = asciiTraceHelper.CreateFileStream (outputPath.str ());
+      m_buffer.resize (m_binaryBufferSize);
+      WriteBinaryHeader ();
+    }
+  else
+    {
+      outputPath << ".log";
 
-  PrintHeader ();
+      AsciiTraceHelper asciiTraceHelper;
+      m_packetTraceStream = asciiTraceHelper.CreateFileStream (outputPath.str ());
+
+      PrintHeader ();
+    }
 }
 
 SatPacketTrace::~SatPacketTrace ()
 {
   NS_LOG_FUNCTION (this);
+
+  if (m_binaryStream.is_open ())
+    {
+      FlushBuffer ();
+      m_binaryStream.close ();
+    }
 }
 
 TypeId
@@ -70,6 +102,16 @@ SatPacketTrace::GetTypeId ()
                    StringValue ("PacketTrace"),
                    MakeStringAccessor (&SatPacketTrace::m_fileName),
                    MakeStringChecker ())
+    .AddAttribute ("BinaryFormat",
+                   "Write the packet trace as binary records, to be decoded with ext-utils/decodePacketTrace.py",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&SatPacketTrace::m_binaryFormat),
+                   MakeBooleanChecker ())
+    .AddAttribute ("BinaryBufferSize",
+                   "Size of the buffer collecting the binary records before writing them to the file [bytes]",
+                   UintegerValue (1048576),
+                   MakeUintegerAccessor (&SatPacketTrace::m_binaryBufferSize),
+                   MakeUintegerChecker<uint32_t> (1024))
   ;
   return tid;
 }
@@ -78,6 +120,14 @@ void
 SatPacketTrace::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
+
+  if (m_binaryStream.is_open ())
+    {
+      FlushBuffer ();
+      m_binaryStream.close ();
+    }
+  m_buffer.clear ();
+
   Object::DoDispose ();
 }
 
@@ -122,6 +172,26 @@ SatPacketTrace::AddTraceEntry (Time now,
    * - Entries from one simulation direction
    */
 
+  if (m_binaryFormat)
+    {
+      uint8_t mac[6];
+      macAddress.CopyTo (mac);
+
+      /// fixed size record part followed by the packet info
+      uint16_t infoLength = std::min<size_t> (packetInfo.size (), UINT16_MAX);
+
+      AddToBuffer<double> (now.GetSeconds ());
+      AddToBuffer<uint8_t> (packetEvent);
+      AddToBuffer<uint8_t> (nodeType);
+      AddToBuffer<uint32_t> (nodeId);
+      AddToBuffer (mac, sizeof (mac));
+      AddToBuffer<uint8_t> (logLevel);
+      AddToBuffer<uint8_t> (linkDir);
+      AddToBuffer<uint16_t> (infoLength);
+      AddToBuffer (packetInfo.data (), infoLength);
+      return;
+    }
+
   std::ostringstream oss;
   oss << now.GetSeconds () << " "
       << SatEnums::GetPacketEventName (packetEvent) << " "
@@ -132,7 +202,78 @@ SatPacketTrace::AddTraceEntry (Time now,
       << SatEnums::GetLinkDirName (linkDir) << " "
       << packetInfo;
 
-  *m_packetTraceStream->GetStream () << oss.str () << std::endl;
+  *m_packetTraceStream->GetStream () << oss.str () << "\n";
+}
+
+void
+SatPacketTrace::WriteBinaryHeader ()
+{
+  NS_LOG_FUNCTION (this);
+
+  m_binaryStream.write ("SATPKTTR", 8);
+  AddToBuffer<uint32_t> (1);
+
+  AddToBuffer<uint8_t> (SatEnums::PACKET_DROP + 1);
+  for (uint32_t i = 0; i <= SatEnums::PACKET_DROP; i++)
+    {
+      std::string name = SatEnums::GetPacketEventName ((SatEnums::SatPacketEvent_t) i);
+      AddToBuffer<uint8_t> (name.size ());
+      AddToBuffer (name.data (), name.size ());
+    }
+
+  AddToBuffer<uint8_t> (SatEnums::NT_UNDEFINED + 1);
+  for (uint32_t i = 0; i <= SatEnums::NT_UNDEFINED; i++)
+    {
+      std::string name = SatEnums::GetNodeTypeName ((SatEnums::SatNodeType_t) i);
+      AddToBuffer<uint8_t> (name.size ());
+      AddToBuffer (name.data (), name.size ());
+    }
+
+  AddToBuffer<uint8_t> (SatEnums::LL_CH + 1);
+  for (uint32_t i = 0; i <= SatEnums::LL_CH; i++)
+    {
+      std::string name = SatEnums::GetLogLevelName ((SatEnums::SatLogLevel_t) i);
+      AddToBuffer<uint8_t> (name.size ());
+      AddToBuffer (name.data (), name.size ());
+    }
+
+  AddToBuffer<uint8_t> (SatEnums::LD_UNDEFINED + 1);
+  for (uint32_t i = 0; i <= SatEnums::LD_UNDEFINED; i++)
+    {
+      std::string name = SatEnums::GetLinkDirName ((SatEnums::SatLinkDir_t) i);
+      AddToBuffer<uint8_t> (name.size ());
+      AddToBuffer (name.data (), name.size ());
+    }
+}
+
+void
+SatPacketTrace::AddToBuffer (const void* data, uint32_t size)
+{
+  if (m_bufferUsed + size > m_buffer.size ())
+    {
+      FlushBuffer ();
+
+      if (size > m_buffer.size ())
+        {
+          m_binaryStream.write ((const char*) data, size);
+          return;
+        }
+    }
+
+  std::memcpy (&m_buffer[m_bufferUsed], data, size);
+  m_bufferUsed += size;
+}
+
+void
+SatPacketTrace::FlushBuffer ()
+{
+  NS_LOG_FUNCTION (this << m_bufferUsed);
+
+  if (m_bufferUsed > 0)
+    {
+      m_binaryStream.write ((const char*) &m_buffer[0], m_bufferUsed);
+      m_bufferUsed = 0;
+    }
 }
 
 }
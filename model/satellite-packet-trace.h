@@ -21,6 +21,8 @@
 #ifndef SATELLITE_PACKET_TRACE_H_
 #define SATELLITE_PACKET_TRACE_H_
 
+#include <fstream>
+#include <vector>
 #include "ns3/object.h"
 #include "ns3/output-stream-wrapper.h"
 #include "satellite-enums.h"
@@ -33,6 +35,10 @@ namespace ns3 {
  * \brief The SatPacketTrace implements a packet trace functionality.
  * The movement of packet through the satellite stack can be traced
  * in different protocol layers and direction.
+ *
+ * In binary format the entries are collected as binary records into an
+ * in-memory buffer, which is written to the file when full. The binary
+ * file is converted to the text format with ext-utils/decodePacketTrace.py.
  */
 
 class SatPacketTrace : public Object
@@ -88,6 +94,35 @@ private:
    */
   void PrintHeader ();
 
+  /**
+   * \brief Write the header of the binary packet trace, including the
+   * names of the enumeration values used in the records
+   */
+  void WriteBinaryHeader ();
+
+  /**
+   * \brief Add a value to the binary record buffer
+   * \param value value
+   */
+  template <typename T>
+  void AddToBuffer (T value)
+  {
+    AddToBuffer (&value, sizeof (T));
+  }
+
+  /**
+   * \brief Add bytes to the binary record buffer, the buffer is written
+   * to the file first if the bytes do not fit
+   * \param data bytes
+   * \param size number of bytes
+   */
+  void AddToBuffer (const void* data, uint32_t size);
+
+  /**
+   * \brief Write the binary record buffer to the file
+   */
+  void FlushBuffer ();
+
   /**
    * File name of the packet trace log
    */
@@ -98,6 +133,31 @@ private:
    */
   Ptr<OutputStreamWrapper> m_packetTraceStream;
 
+  /**
+   * Write the packet trace in binary format
+   */
+  bool m_binaryFormat;
+
+  /**
+   * Size of the binary record buffer in bytes
+   */
+  uint32_t m_binaryBufferSize;
+
+  /**
+   * Binary record buffer
+   */
+  std::vector<uint8_t> m_buffer;
+
+  /**
+   * Number of bytes used in the binary record buffer
+   */
+  uint32_t m_bufferUsed;
+
+  /**
+   * Stream used for binary packet traces
+   */
+  std::ofstream m_binaryStream;
+
 };
 
 }
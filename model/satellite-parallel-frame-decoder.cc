@@ -0,0 +1,268 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 Magister Solutions Ltd
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Jani Puttonen <jani.puttonen@magister.fi>
+ */
+
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+
+#include "satellite-rtn-link-time.h"
+#include "satellite-const-variables.h"
+#include "satellite-crdsa-frame-decoder.h"
+#include "satellite-phy-rx-carrier-per-frame.h"
+#include "satellite-parallel-frame-decoder.h"
+
+NS_LOG_COMPONENT_DEFINE ("SatParallelFrameDecoder");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (SatParallelFrameDecoder);
+
+TypeId
+SatParallelFrameDecoder::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::SatParallelFrameDecoder")
+    .SetParent<Object> ()
+  ;
+  return tid;
+}
+
+SatParallelFrameDecoder::SatParallelFrameDecoder ()
+  : m_nextFrame (0),
+    m_framesLeft (0),
+    m_stopWorkers (false)
+{
+  NS_LOG_FUNCTION (this);
+  NS_FATAL_ERROR ("Default constructor of SatParallelFrameDecoder not supported.");
+}
+
+SatParallelFrameDecoder::SatParallelFrameDecoder (uint32_t numOfThreads)
+  : m_nextFrame (0),
+    m_framesLeft (0),
+    m_stopWorkers (false)
+{
+  NS_LOG_FUNCTION (this << numOfThreads);
+
+  /// simulator thread is one of the decoding threads
+  if (numOfThreads > 1)
+    {
+      StartWorkers (numOfThreads - 1);
+    }
+}
+
+SatParallelFrameDecoder::~SatParallelFrameDecoder ()
+{
+  NS_LOG_FUNCTION (this);
+
+  StopWorkers ();
+}
+
+void
+SatParallelFrameDecoder::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+
+  Simulator::Cancel (m_frameEndEvent);
+  StopWorkers ();
+  m_carriers.clear ();
+
+  Object::DoDispose ();
+}
+
+void
+SatParallelFrameDecoder::AddCarrier (Ptr<SatPhyRxCarrierPerFrame> carrier)
+{
+  NS_LOG_FUNCTION (this << carrier);
+
+  m_carriers.push_back (carrier);
+}
+
+void
+SatParallelFrameDecoder::BeginFrameEndScheduling (uint32_t nodeId)
+{
+  NS_LOG_FUNCTION (this << nodeId);
+
+  Simulator::ScheduleWithContext (nodeId, GetFrameEndDelay (), &SatParallelFrameDecoder::DoFrameEnd, this);
+}
+
+Time
+SatParallelFrameDecoder::GetFrameEndDelay () const
+{
+  Time nextSuperFrameRxTime = Singleton<SatRtnLinkTime>::Get ()->GetNextSuperFrameStartTime (SatConstVariables::SUPERFRAME_SEQUENCE);
+
+  if (Now () >= nextSuperFrameRxTime)
+    {
+      NS_FATAL_ERROR ("Scheduling next superframe start time to the past!");
+    }
+
+  return nextSuperFrameRxTime - Now ();
+}
+
+void
+SatParallelFrameDecoder::DoFrameEnd ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_carriers.empty ())
+    {
+      return;
+    }
+
+  for (uint32_t i = 0; i < m_carriers.size (); i++)
+    {
+      m_carriers[i]->StartFrameEnd ();
+    }
+
+  std::vector<SatCrdsaFrameDecoder*> frames;
+
+  for (uint32_t i = 0; i < m_carriers.size (); i++)
+    {
+      SatCrdsaFrameDecoder* decoder = m_carriers[i]->GetPendingFrameDecoder ();
+
+      if (decoder != NULL)
+        {
+          frames.push_back (decoder);
+        }
+    }
+
+  NS_LOG_INFO ("SatParallelFrameDecoder::DoFrameEnd - Time: " << Now ().GetSeconds () << ", frames: " << frames.size ());
+
+  DecodeFrames (frames);
+
+  /// results are passed upwards in the carrier order
+  for (uint32_t i = 0; i < m_carriers.size (); i++)
+    {
+      m_carriers[i]->CompleteFrameEnd ();
+    }
+
+  m_frameEndEvent = Simulator::Schedule (GetFrameEndDelay (), &SatParallelFrameDecoder::DoFrameEnd, this);
+}
+
+void
+SatParallelFrameDecoder::DecodeFrames (const std::vector<SatCrdsaFrameDecoder*>& frames)
+{
+  NS_LOG_FUNCTION (this << frames.size ());
+
+  if (m_workers.empty () || frames.size () < 2)
+    {
+      for (uint32_t i = 0; i < frames.size (); i++)
+        {
+          frames[i]->Decode ();
+        }
+
+      return;
+    }
+
+  {
+    std::unique_lock<std::mutex> lock (m_mutex);
+
+    m_batch = frames;
+    m_nextFrame = 0;
+    m_framesLeft = m_batch.size ();
+  }
+
+  m_batchAvailable.notify_all ();
+
+  // simulator thread takes part in the decoding
+  DecodeAvailableFrames ();
+
+  {
+    std::unique_lock<std::mutex> lock (m_mutex);
+
+    while (m_framesLeft > 0)
+      {
+        m_batchDone.wait (lock);
+      }
+
+    m_batch.clear ();
+    m_nextFrame = 0;
+  }
+}
+
+void
+SatParallelFrameDecoder::DecodeAvailableFrames ()
+{
+  std::unique_lock<std::mutex> lock (m_mutex);
+
+  while (m_nextFrame < m_batch.size ())
+    {
+      SatCrdsaFrameDecoder* decoder = m_batch[m_nextFrame++];
+
+      lock.unlock ();
+      decoder->Decode ();
+      lock.lock ();
+
+      if (--m_framesLeft == 0)
+        {
+          m_batchDone.notify_all ();
+        }
+    }
+}
+
+void
+SatParallelFrameDecoder::WorkerLoop ()
+{
+  std::unique_lock<std::mutex> lock (m_mutex);
+
+  while (!m_stopWorkers)
+    {
+      if (m_nextFrame < m_batch.size ())
+        {
+          lock.unlock ();
+          DecodeAvailableFrames ();
+          lock.lock ();
+        }
+      else
+        {
+          m_batchAvailable.wait (lock);
+        }
+    }
+}
+
+void
+SatParallelFrameDecoder::StartWorkers (uint32_t numOfWorkers)
+{
+  NS_LOG_FUNCTION (this << numOfWorkers);
+
+  for (uint32_t i = 0; i < numOfWorkers; i++)
+    {
+      m_workers.push_back (std::thread (&SatParallelFrameDecoder::WorkerLoop, this));
+    }
+
+  NS_LOG_INFO ("SatParallelFrameDecoder::StartWorkers - Worker threads: " << m_workers.size ());
+}
+
+void
+SatParallelFrameDecoder::StopWorkers ()
+{
+  {
+    std::unique_lock<std::mutex> lock (m_mutex);
+    m_stopWorkers = true;
+  }
+
+  m_batchAvailable.notify_all ();
+
+  for (uint32_t i = 0; i < m_workers.size (); i++)
+    {
+      m_workers[i].join ();
+    }
+
+  m_workers.clear ();
+}
+
+} // namespace ns3
@@ -0,0 +1,190 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 Magister Solutions Ltd
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Jani Puttonen <jani.puttonen@magister.fi>
+ */
+
+#ifndef SATELLITE_PARALLEL_FRAME_DECODER_H
+#define SATELLITE_PARALLEL_FRAME_DECODER_H
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <ns3/ptr.h>
+#include <ns3/object.h>
+#include <ns3/event-id.h>
+#include <ns3/nstime.h>
+
+namespace ns3 {
+
+class SatPhyRxCarrierPerFrame;
+class SatCrdsaFrameDecoder;
+
+/**
+ * \ingroup satellite
+ * \brief Decodes the CRDSA frames of the random access carriers of a
+ * receiver in parallel.
+ *
+ * The decoder takes over the frame end scheduling of its carriers. At each
+ * frame end the frames of all the carriers are started, i.e. the received
+ * packets are copied to the plain frame decoders of the carriers, on the
+ * simulator thread. The frame decoders are then run by a pool of worker
+ * threads together with the simulator thread. The worker threads touch only
+ * the frame decoders. Finally the frame ends of the carriers are completed
+ * in the carrier order on the simulator thread, all in the same event.
+ *
+ * The worker threads are started at construction and stopped when the
+ * decoder is disposed.
+ */
+class SatParallelFrameDecoder : public Object
+{
+public:
+  /**
+   * Get the TypeId of the class.
+   * \return TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * \brief Default constructor, not supported
+   */
+  SatParallelFrameDecoder ();
+
+  /**
+   * \brief Constructor
+   * \param numOfThreads Number of decoding threads including the simulator thread
+   */
+  SatParallelFrameDecoder (uint32_t numOfThreads);
+
+  /**
+   * \brief Destructor
+   */
+  virtual ~SatParallelFrameDecoder ();
+
+  /**
+   * \brief Add a carrier whose frame ends are processed by the decoder
+   * \param carrier CRDSA carrier
+   */
+  void AddCarrier (Ptr<SatPhyRxCarrierPerFrame> carrier);
+
+  /**
+   * \brief Begin the frame end scheduling of the carriers
+   * \param nodeId Id of the node of the receiver, used as the context of the frame ends
+   */
+  void BeginFrameEndScheduling (uint32_t nodeId);
+
+  /**
+   * \brief Decode frames in parallel and wait for them to be decoded
+   * \param frames Frame decoders with a frame to decode
+   */
+  void DecodeFrames (const std::vector<SatCrdsaFrameDecoder*>& frames);
+
+protected:
+  /**
+   * \brief Dispose implementation, stops the worker threads
+   */
+  virtual void DoDispose ();
+
+private:
+  /**
+   * \brief Process the frame ends of all the carriers
+   */
+  void DoFrameEnd ();
+
+  /**
+   * \brief Get the delay to the next frame end
+   * \return Delay to the next frame end
+   */
+  Time GetFrameEndDelay () const;
+
+  /**
+   * \brief Decode frames of the current batch until there are none left
+   */
+  void DecodeAvailableFrames ();
+
+  /**
+   * \brief Main loop of a worker thread
+   */
+  void WorkerLoop ();
+
+  /**
+   * \brief Start the worker threads
+   * \param numOfWorkers Number of worker threads
+   */
+  void StartWorkers (uint32_t numOfWorkers);
+
+  /**
+   * \brief Stop the worker threads
+   */
+  void StopWorkers ();
+
+  /**
+   * \brief CRDSA carriers of the receiver
+   */
+  std::vector<Ptr<SatPhyRxCarrierPerFrame> > m_carriers;
+
+  /**
+   * \brief Next frame end event
+   */
+  EventId m_frameEndEvent;
+
+  /**
+   * \brief Frame decoders of the batch under decoding, accessed by the worker threads
+   */
+  std::vector<SatCrdsaFrameDecoder*> m_batch;
+
+  /**
+   * \brief Index of the next frame of the batch to decode
+   */
+  uint32_t m_nextFrame;
+
+  /**
+   * \brief Number of frames of the batch not yet decoded
+   */
+  uint32_t m_framesLeft;
+
+  /**
+   * \brief Flag telling the worker threads to stop
+   */
+  bool m_stopWorkers;
+
+  /**
+   * \brief Worker threads
+   */
+  std::vector<std::thread> m_workers;
+
+  /**
+   * \brief Mutex protecting the batch state
+   */
+  std::mutex m_mutex;
+
+  /**
+   * \brief Signaled when a batch is available for the workers
+   */
+  std::condition_variable m_batchAvailable;
+
+  /**
+   * \brief Signaled when all the frames of the batch are decoded
+   */
+  std::condition_variable m_batchDone;
+};
+
+} // namespace ns3
+
+#endif /* SATELLITE_PARALLEL_FRAME_DECODER_H */
@@ -0,0 +1,590 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Jani Puttonen <jani.puttonen@magister.fi>
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+#include "satellite-per-packet-timeline-interference.h"
+#include "ns3/singleton.h"
+
+NS_LOG_COMPONENT_DEFINE ("SatPerPacketTimelineInterference");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (SatPerPacketTimelineInterference);
+
+const uint32_t SatPerPacketTimelineInterference::INITIAL_TIMELINE_CAPACITY;
+const int32_t SatPerPacketTimelineInterference::NO_NODE;
+
+TypeId
+SatPerPacketTimelineInterference::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::SatPerPacketTimelineInterference")
+    .SetParent<SatInterference> ()
+    .AddConstructor<SatPerPacketTimelineInterference> ();
+
+  return tid;
+}
+
+TypeId
+SatPerPacketTimelineInterference::GetInstanceTypeId (void) const
+{
+  NS_LOG_FUNCTION (this);
+
+  return GetTypeId ();
+}
+
+SatPerPacketTimelineInterference::SatPerPacketTimelineInterference ()
+  : m_timelineHead (0),
+    m_timelineSize (0),
+    m_pendingRoot (NO_NODE),
+    m_pendingCount (0),
+    m_pendingBase (),
+    m_pendingPrioritySeed (2463534242U),
+    m_nextEventId (0),
+    m_enableTraceOutput (false),
+    m_channelType (),
+    m_rxBandwidth_Hz ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+SatPerPacketTimelineInterference::SatPerPacketTimelineInterference (SatEnums::ChannelType_t channelType, double rxBandwidthHz)
+  : m_timelineHead (0),
+    m_timelineSize (0),
+    m_pendingRoot (NO_NODE),
+    m_pendingCount (0),
+    m_pendingBase (),
+    m_pendingPrioritySeed (2463534242U),
+    m_nextEventId (0),
+    m_enableTraceOutput (true),
+    m_channelType (channelType),
+    m_rxBandwidth_Hz (rxBandwidthHz)
+{
+  NS_LOG_FUNCTION (this << channelType << rxBandwidthHz);
+
+  if (m_rxBandwidth_Hz <= std::numeric_limits<double>::epsilon ())
+    {
+      NS_FATAL_ERROR ("SatPerPacketTimelineInterference::SatPerPacketTimelineInterference - Invalid value");
+    }
+}
+
+SatPerPacketTimelineInterference::~SatPerPacketTimelineInterference ()
+{
+  NS_LOG_FUNCTION (this);
+
+  Reset ();
+}
+
+Ptr<SatInterference::InterferenceChangeEvent>
+SatPerPacketTimelineInterference::DoAdd (Time duration, double power, Address rxAddress)
+{
+  NS_LOG_FUNCTION (this << duration << power << rxAddress );
+
+  Ptr<SatInterference::InterferenceChangeEvent> event;
+  event = Create<SatInterference::InterferenceChangeEvent> (m_nextEventId++, duration, power, rxAddress);
+  Time now = event->GetStartTime ();
+
+  NS_LOG_INFO ( "Add change: Duration= " << duration << ", Power= " << power << ", Time: " << now );
+
+  UpdateTimeline (now);
+  TrimTimeline (now);
+
+  AppendChange (now, power);
+
+  AddPendingChange (event->GetEndTime (), -static_cast<long double> (power));
+
+  NS_LOG_INFO ( "Timeline size: " << m_timelineSize << ", pending changes: " << m_pendingCount );
+
+  if ( GetTimelinePoint (m_timelineSize - 1).m_powerW < 0 )
+    {
+      // Aggregate power should never leak negative
+      NS_FATAL_ERROR ("Aggregate power negative!!!");
+    }
+
+  return event;
+}
+
+double
+SatPerPacketTimelineInterference::DoCalculate (Ptr<SatInterference::InterferenceChangeEvent> event)
+{
+  NS_LOG_FUNCTION (this);
+
+  if ( m_rxEventStartTimes.empty () )
+    {
+      NS_FATAL_ERROR ("Receiving is not set on!!!");
+    }
+
+  Time now = Simulator::Now ();
+  UpdateTimeline (now);
+
+  Time startTime = event->GetStartTime ();
+  Time endTime = event->GetEndTime ();
+  long double rxDuration = event->GetDuration ().GetDouble ();
+
+  long double energy = -GetEnergyAt (startTime);
+
+  if (endTime <= now)
+    {
+      energy += GetEnergyAt (endTime);
+    }
+  else
+    {
+      // receiving not yet ended, take the known changes up to the end into account
+      const TimelinePoint_t& last = GetTimelinePoint (m_timelineSize - 1);
+      energy += GetEnergyAt (now) + last.m_powerW * (endTime - now).GetDouble ();
+      energy += GetPendingEnergyBefore (endTime);
+    }
+
+  // own transmission is not interference
+  energy -= event->GetRxPower () * rxDuration;
+
+  double ifPowerW = 0.0;
+
+  if (rxDuration > 0)
+    {
+      ifPowerW = std::max<double> (0.0, energy / rxDuration);
+    }
+
+  NS_LOG_INFO ( "Calculate: IfPower (W)= " << ifPowerW << ", Duration= " << event->GetDuration () <<
+                ", StartTime= " << startTime << ", EndTime= " << endTime );
+
+  if (m_enableTraceOutput)
+    {
+      std::vector<double> tempVector;
+      tempVector.push_back (Now ().GetSeconds ());
+      tempVector.push_back (ifPowerW / m_rxBandwidth_Hz);
+      Singleton<SatInterferenceOutputTraceContainer>::Get ()->AddToContainer (std::make_pair (event->GetSatEarthStationAddress (), m_channelType), tempVector);
+    }
+
+  return ifPowerW;
+}
+
+void
+SatPerPacketTimelineInterference::DoReset (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  m_timelineHead = 0;
+  m_timelineSize = 0;
+  m_pendingNodes.clear ();
+  m_freePendingNodes.clear ();
+  m_pendingRoot = NO_NODE;
+  m_pendingCount = 0;
+  m_rxEventStartTimes.clear ();
+}
+
+void
+SatPerPacketTimelineInterference::DoNotifyRxStart (Ptr<SatInterference::InterferenceChangeEvent> event)
+{
+  NS_LOG_FUNCTION (this);
+
+  std::pair<std::map<uint32_t, Time>::iterator, bool> result =
+    m_rxEventStartTimes.insert (std::make_pair (event->GetId (), event->GetStartTime ()));
+
+  NS_ASSERT (result.second);
+}
+
+void
+SatPerPacketTimelineInterference::DoNotifyRxEnd (Ptr<SatInterference::InterferenceChangeEvent> event)
+{
+  NS_LOG_FUNCTION (this);
+
+  m_rxEventStartTimes.erase (event->GetId ());
+}
+
+void
+SatPerPacketTimelineInterference::UpdateTimeline (Time now)
+{
+  NS_LOG_FUNCTION (this << now);
+
+  while (m_pendingRoot != NO_NODE)
+    {
+      // the earliest pending change is the leftmost node
+      int32_t node = m_pendingRoot;
+
+      while (m_pendingNodes[node].m_left != NO_NODE)
+        {
+          node = m_pendingNodes[node].m_left;
+        }
+
+      if (m_pendingNodes[node].m_time > now)
+        {
+          break;
+        }
+
+      Time time;
+      long double deltaW;
+      RemoveFirstPendingChange (time, deltaW);
+      AppendChange (time, deltaW);
+    }
+}
+
+void
+SatPerPacketTimelineInterference::AppendChange (Time time, long double deltaW)
+{
+  NS_LOG_FUNCTION (this << time << deltaW);
+
+  if (m_timelineSize == 0)
+    {
+      TimelinePoint_t point = { time, deltaW, 0.0 };
+      PushTimelinePoint (point);
+      return;
+    }
+
+  TimelinePoint_t& last = GetTimelinePoint (m_timelineSize - 1);
+
+  NS_ASSERT (time >= last.m_time);
+
+  if (time == last.m_time)
+    {
+      // changes at the same time are merged, energy up to the time is not affected
+      last.m_powerW += deltaW;
+    }
+  else
+    {
+      TimelinePoint_t point = { time,
+                                last.m_powerW + deltaW,
+                                last.m_energy + last.m_powerW * (time - last.m_time).GetDouble ()};
+      PushTimelinePoint (point);
+    }
+}
+
+void
+SatPerPacketTimelineInterference::PushTimelinePoint (const TimelinePoint_t& point)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_timelineSize == m_timeline.size ())
+    {
+      // ring buffer full, double the capacity and unwrap the points to the start
+      std::vector<TimelinePoint_t> timeline (std::max<size_t> (2 * m_timeline.size (), INITIAL_TIMELINE_CAPACITY));
+
+      for (uint32_t i = 0; i < m_timelineSize; ++i)
+        {
+          timeline[i] = GetTimelinePoint (i);
+        }
+
+      m_timeline.swap (timeline);
+      m_timelineHead = 0;
+    }
+
+  m_timeline[(m_timelineHead + m_timelineSize) & (m_timeline.size () - 1)] = point;
+  ++m_timelineSize;
+}
+
+void
+SatPerPacketTimelineInterference::TrimTimeline (Time now)
+{
+  NS_LOG_FUNCTION (this << now);
+
+  // keep the point valid at the start of the earliest ongoing receiving,
+  // event ids grow with the start times, so the first event is the earliest
+  Time keepFrom = now;
+
+  if (!m_rxEventStartTimes.empty ())
+    {
+      keepFrom = std::min (keepFrom, m_rxEventStartTimes.begin ()->second);
+    }
+
+  bool trimmed = false;
+
+  while ( m_timelineSize > 1 && GetTimelinePoint (1).m_time <= keepFrom )
+    {
+      m_timelineHead = (m_timelineHead + 1) & (m_timeline.size () - 1);
+      --m_timelineSize;
+      trimmed = true;
+    }
+
+  if (trimmed)
+    {
+      // only energy differences are used, rebase the sums to the first point
+      // to keep them small while the receptions overlap for a long time
+      const long double frontEnergy = GetTimelinePoint (0).m_energy;
+
+      for (uint32_t i = 0; i < m_timelineSize; ++i)
+        {
+          GetTimelinePoint (i).m_energy -= frontEnergy;
+        }
+    }
+
+  if (m_rxEventStartTimes.empty () && m_timelineSize == 1)
+    {
+      TimelinePoint_t& first = GetTimelinePoint (0);
+
+      // nobody needs the energy history
+      first.m_energy = 0.0;
+
+      if ( (m_pendingRoot == NO_NODE) && ( first.m_powerW != 0 )
+           && std::fabs (first.m_powerW) < std::numeric_limits<long double>::epsilon () )
+        {
+          // reset power (this probably due to rounding problem with very small values)
+          first.m_powerW = 0;
+        }
+    }
+}
+
+long double
+SatPerPacketTimelineInterference::GetEnergyAt (Time time) const
+{
+  NS_LOG_FUNCTION (this << time);
+
+  NS_ASSERT (m_timelineSize > 0 && time >= GetTimelinePoint (0).m_time);
+
+  // find the last point at or before the given time
+  uint32_t index = 1;
+  uint32_t count = m_timelineSize - 1;
+
+  while (count > 0)
+    {
+      uint32_t step = count / 2;
+      uint32_t mid = index + step;
+
+      if (GetTimelinePoint (mid).m_time <= time)
+        {
+          index = mid + 1;
+          count -= step + 1;
+        }
+      else
+        {
+          count = step;
+        }
+    }
+
+  const TimelinePoint_t& point = GetTimelinePoint (index - 1);
+
+  return point.m_energy + point.m_powerW * (time - point.m_time).GetDouble ();
+}
+
+void
+SatPerPacketTimelineInterference::AddPendingChange (Time time, long double deltaW)
+{
+  NS_LOG_FUNCTION (this << time << deltaW);
+
+  if (m_pendingRoot == NO_NODE)
+    {
+      // the sums are counted from the earliest possible pending change
+      m_pendingBase = time;
+    }
+
+  int32_t node;
+
+  if (m_freePendingNodes.empty ())
+    {
+      node = m_pendingNodes.size ();
+      m_pendingNodes.push_back (PendingNode_t ());
+    }
+  else
+    {
+      node = m_freePendingNodes.back ();
+      m_freePendingNodes.pop_back ();
+    }
+
+  // xorshift priorities keep the treap balanced without using the simulation random streams
+  m_pendingPrioritySeed ^= m_pendingPrioritySeed << 13;
+  m_pendingPrioritySeed ^= m_pendingPrioritySeed >> 17;
+  m_pendingPrioritySeed ^= m_pendingPrioritySeed << 5;
+
+  PendingNode_t& pending = m_pendingNodes[node];
+  pending.m_time = time;
+  pending.m_deltaW = deltaW;
+  pending.m_priority = m_pendingPrioritySeed;
+  pending.m_left = NO_NODE;
+  pending.m_right = NO_NODE;
+  UpdatePendingSums (node);
+
+  int32_t left;
+  int32_t right;
+  SplitPendingChanges (m_pendingRoot, time, left, right);
+  m_pendingRoot = MergePendingChanges (MergePendingChanges (left, node), right);
+
+  ++m_pendingCount;
+}
+
+void
+SatPerPacketTimelineInterference::RemoveFirstPendingChange (Time& time, long double& deltaW)
+{
+  NS_LOG_FUNCTION (this);
+
+  NS_ASSERT (m_pendingRoot != NO_NODE);
+
+  // walk down the left spine and update the sums on the way back
+  std::vector<int32_t> path;
+  int32_t node = m_pendingRoot;
+
+  while (m_pendingNodes[node].m_left != NO_NODE)
+    {
+      path.push_back (node);
+      node = m_pendingNodes[node].m_left;
+    }
+
+  time = m_pendingNodes[node].m_time;
+  deltaW = m_pendingNodes[node].m_deltaW;
+
+  int32_t replacement = m_pendingNodes[node].m_right;
+
+  if (path.empty ())
+    {
+      m_pendingRoot = replacement;
+    }
+  else
+    {
+      m_pendingNodes[path.back ()].m_left = replacement;
+
+      for (std::vector<int32_t>::reverse_iterator it = path.rbegin (); it != path.rend (); ++it)
+        {
+          UpdatePendingSums (*it);
+        }
+    }
+
+  m_freePendingNodes.push_back (node);
+  --m_pendingCount;
+}
+
+long double
+SatPerPacketTimelineInterference::GetPendingEnergyBefore (Time time) const
+{
+  NS_LOG_FUNCTION (this << time);
+
+  long double sumDeltaW = 0.0;
+  long double sumEnergy = 0.0;
+  int32_t node = m_pendingRoot;
+
+  while (node != NO_NODE)
+    {
+      const PendingNode_t& pending = m_pendingNodes[node];
+
+      if (pending.m_time < time)
+        {
+          // the node and its left subtree are before the time
+          sumDeltaW += pending.m_deltaW;
+          sumEnergy += pending.m_deltaW * (pending.m_time - m_pendingBase).GetDouble ();
+
+          if (pending.m_left != NO_NODE)
+            {
+              sumDeltaW += m_pendingNodes[pending.m_left].m_sumDeltaW;
+              sumEnergy += m_pendingNodes[pending.m_left].m_sumEnergy;
+            }
+
+          node = pending.m_right;
+        }
+      else
+        {
+          node = pending.m_left;
+        }
+    }
+
+  // sum of deltaW * (time - changeTime) over the changes before the time
+  return sumDeltaW * (time - m_pendingBase).GetDouble () - sumEnergy;
+}
+
+void
+SatPerPacketTimelineInterference::SplitPendingChanges (int32_t node, Time time, int32_t& left, int32_t& right)
+{
+  if (node == NO_NODE)
+    {
+      left = NO_NODE;
+      right = NO_NODE;
+    }
+  else if (m_pendingNodes[node].m_time < time)
+    {
+      SplitPendingChanges (m_pendingNodes[node].m_right, time, m_pendingNodes[node].m_right, right);
+      left = node;
+      UpdatePendingSums (node);
+    }
+  else
+    {
+      SplitPendingChanges (m_pendingNodes[node].m_left, time, left, m_pendingNodes[node].m_left);
+      right = node;
+      UpdatePendingSums (node);
+    }
+}
+
+int32_t
+SatPerPacketTimelineInterference::MergePendingChanges (int32_t left, int32_t right)
+{
+  if (left == NO_NODE)
+    {
+      return right;
+    }
+
+  if (right == NO_NODE)
+    {
+      return left;
+    }
+
+  if (m_pendingNodes[left].m_priority > m_pendingNodes[right].m_priority)
+    {
+      m_pendingNodes[left].m_right = MergePendingChanges (m_pendingNodes[left].m_right, right);
+      UpdatePendingSums (left);
+      return left;
+    }
+
+  m_pendingNodes[right].m_left = MergePendingChanges (left, m_pendingNodes[right].m_left);
+  UpdatePendingSums (right);
+  return right;
+}
+
+void
+SatPerPacketTimelineInterference::UpdatePendingSums (int32_t node)
+{
+  PendingNode_t& pending = m_pendingNodes[node];
+
+  pending.m_sumDeltaW = pending.m_deltaW;
+  pending.m_sumEnergy = pending.m_deltaW * (pending.m_time - m_pendingBase).GetDouble ();
+
+  if (pending.m_left != NO_NODE)
+    {
+      pending.m_sumDeltaW += m_pendingNodes[pending.m_left].m_sumDeltaW;
+      pending.m_sumEnergy += m_pendingNodes[pending.m_left].m_sumEnergy;
+    }
+
+  if (pending.m_right != NO_NODE)
+    {
+      pending.m_sumDeltaW += m_pendingNodes[pending.m_right].m_sumDeltaW;
+      pending.m_sumEnergy += m_pendingNodes[pending.m_right].m_sumEnergy;
+    }
+}
+
+void
+SatPerPacketTimelineInterference::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+
+  SatInterference::DoDispose ();
+}
+
+void
+SatPerPacketTimelineInterference::SetRxBandwidth (double rxBandwidth)
+{
+  NS_LOG_FUNCTION (this << rxBandwidth);
+
+  if (rxBandwidth <= std::numeric_limits<double>::epsilon ())
+    {
+      NS_FATAL_ERROR ("SatPerPacketTimelineInterference::SetRxBandwidth - Invalid value");
+    }
+
+  m_rxBandwidth_Hz = rxBandwidth;
+}
+
+}
+// namespace ns3
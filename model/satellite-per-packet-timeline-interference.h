@@ -0,0 +1,354 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Jani Puttonen <jani.puttonen@magister.fi>
+ */
+
+#ifndef SATELLITE_PER_PACKET_TIMELINE_INTERFERENCE_H
+#define SATELLITE_PER_PACKET_TIMELINE_INTERFERENCE_H
+
+#include <map>
+#include <vector>
+#include "satellite-interference.h"
+#include "satellite-interference-output-trace-container.h"
+#include "satellite-enums.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup satellite
+ * \brief Packet by packet interference using a time ordered timeline of
+ * aggregate power with running energy sums.
+ *
+ * Produces the same interference values as SatPerPacketInterference, i.e. the
+ * average power of all other transmissions over the reception of the
+ * packet, but avoids walking through the whole change list on every
+ * calculation. Start changes are appended to a time ordered timeline of
+ * aggregate power and energy, while end changes wait in a tree ordered by
+ * time until simulation time reaches them. Calculation is a binary search on
+ * the timeline at the start and end of the packet, and a prefix sum over the
+ * pending changes before the end of a packet still being received. Entries
+ * older than the earliest ongoing reception are trimmed from the front. The
+ * timeline is kept in a ring buffer, which grows only when it is full.
+ */
+class SatPerPacketTimelineInterference : public SatInterference
+{
+public:
+  /**
+   * Derived from Object
+   * \return TypeId of the class
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * Derived from Object
+   * \return TypeId of the instance
+   */
+  TypeId GetInstanceTypeId (void) const;
+
+  /**
+   * Default constructor. Interference output trace is disabled.
+   */
+  SatPerPacketTimelineInterference ();
+
+  /**
+   * Constructor enabling interference output trace.
+   * \param channelType Channel type of the receiver
+   * \param rxBandwidthHz Receiver bandwidth in Hertz
+   */
+  SatPerPacketTimelineInterference (SatEnums::ChannelType_t channelType, double rxBandwidthHz);
+
+  /**
+   * Destructor
+   */
+  ~SatPerPacketTimelineInterference ();
+
+  /**
+   * Dispose of this class instance
+   */
+  void DoDispose ();
+
+  /**
+   * Set receiver bandwidth used for the output trace.
+   * \param rxBandwidth Receiver bandwidth in Hertz
+   */
+  void SetRxBandwidth (double rxBandwidth);
+
+private:
+  /**
+   * \brief Point of the aggregate power timeline.
+   */
+  typedef struct
+  {
+    Time m_time;           // time of the power change
+    long double m_powerW;  // aggregate power from m_time onwards
+    long double m_energy;  // aggregate energy (W * time ticks) up to m_time
+  } TimelinePoint_t;
+
+  /**
+   * \brief Node of the pending power changes. The nodes form a treap ordered
+   * by time, in which each node holds the sums of the power changes of its
+   * subtree for the prefix sums.
+   */
+  typedef struct
+  {
+    Time m_time;                // time of the power change
+    long double m_deltaW;       // power change
+    long double m_sumDeltaW;    // sum of the power changes in the subtree
+    long double m_sumEnergy;    // sum of the power changes times their time from m_pendingBase in the subtree
+    uint32_t m_priority;        // heap priority of the treap
+    int32_t m_left;             // left child, or NO_NODE
+    int32_t m_right;            // right child, or NO_NODE
+  } PendingNode_t;
+
+  /**
+   * Index of a missing child or root of the pending change tree
+   */
+  static const int32_t NO_NODE = -1;
+
+  /**
+   * Initial capacity of the timeline ring buffer, a power of two
+   */
+  static const uint32_t INITIAL_TIMELINE_CAPACITY = 64;
+
+  /**
+   * Adds interference power to interference object.
+   *
+   * \param rxDuration Duration of the receiving.
+   * \param rxPower Receiving power.
+   * \param rxAddress Address of the transmitting earth station
+   *
+   * \return the pointer to interference event as a reference of the addition
+   */
+  virtual Ptr<SatInterference::InterferenceChangeEvent> DoAdd (Time rxDuration, double rxPower, Address rxAddress);
+
+  /**
+   * Calculates interference power for the given reference
+   *
+   * \param event Reference event which for interference is calculated.
+   *
+   * \return Average interference power over the receiving
+   */
+  virtual double DoCalculate (Ptr<SatInterference::InterferenceChangeEvent> event);
+
+  /**
+   * Resets current interference.
+   */
+  virtual void DoReset (void);
+
+  /**
+   * Notifies that RX is started by a receiver.
+   *
+   * \param event Interference reference event of receiver
+   */
+  virtual void DoNotifyRxStart (Ptr<SatInterference::InterferenceChangeEvent> event);
+
+  /**
+   * Notifies that RX is ended by a receiver.
+   *
+   * \param event Interference reference event of receiver
+   */
+  virtual void DoNotifyRxEnd (Ptr<SatInterference::InterferenceChangeEvent> event);
+
+  /**
+   * Move pending changes which have been reached by the given time to the timeline.
+   * \param now Current simulation time
+   */
+  void UpdateTimeline (Time now);
+
+  /**
+   * Append power change to the end of the timeline.
+   * \param time Time of the change, not before the last timeline point
+   * \param deltaW Power change in Watts
+   */
+  void AppendChange (Time time, long double deltaW);
+
+  /**
+   * Append point to the end of the timeline ring buffer, growing it when full.
+   * \param point Timeline point
+   */
+  void PushTimelinePoint (const TimelinePoint_t& point);
+
+  /**
+   * Get point of the timeline.
+   * \param index Index of the point from the front of the timeline
+   * \return Timeline point
+   */
+  inline TimelinePoint_t& GetTimelinePoint (uint32_t index)
+  {
+    return m_timeline[(m_timelineHead + index) & (m_timeline.size () - 1)];
+  }
+
+  /**
+   * Get point of the timeline.
+   * \param index Index of the point from the front of the timeline
+   * \return Timeline point
+   */
+  inline const TimelinePoint_t& GetTimelinePoint (uint32_t index) const
+  {
+    return m_timeline[(m_timelineHead + index) & (m_timeline.size () - 1)];
+  }
+
+  /**
+   * Remove timeline points not needed by any ongoing reception and rebase the
+   * energy sums of the remaining points against the first remaining point.
+   * \param now Current simulation time
+   */
+  void TrimTimeline (Time now);
+
+  /**
+   * Add a power change to the pending changes.
+   * \param time Time of the change
+   * \param deltaW Power change in Watts
+   */
+  void AddPendingChange (Time time, long double deltaW);
+
+  /**
+   * Remove the earliest pending change.
+   * \param time Time of the removed change
+   * \param deltaW Removed power change in Watts
+   */
+  void RemoveFirstPendingChange (Time& time, long double& deltaW);
+
+  /**
+   * Get the energy of the pending changes before the given time up to the time.
+   * \param time Time of interest
+   * \return Aggregate energy in W * time ticks
+   */
+  long double GetPendingEnergyBefore (Time time) const;
+
+  /**
+   * Split a pending change subtree by time.
+   * \param node Root of the subtree
+   * \param time Time of the split
+   * \param left Root of the changes before the time
+   * \param right Root of the changes at or after the time
+   */
+  void SplitPendingChanges (int32_t node, Time time, int32_t& left, int32_t& right);
+
+  /**
+   * Merge two pending change subtrees.
+   * \param left Root of the earlier changes
+   * \param right Root of the later changes
+   * \return Root of the merged subtree
+   */
+  int32_t MergePendingChanges (int32_t left, int32_t right);
+
+  /**
+   * Update the sums of a pending change node from its children.
+   * \param node Pending change node
+   */
+  void UpdatePendingSums (int32_t node);
+
+  /**
+   * Get aggregate energy up to the given time. Time shall be within the timeline.
+   * \param time Time of interest
+   * \return Aggregate energy in W * time ticks
+   */
+  long double GetEnergyAt (Time time) const;
+
+  /**
+   * Copy constructor (not used)
+   * \param o Object to copy
+   */
+  SatPerPacketTimelineInterference (const SatPerPacketTimelineInterference &o);
+
+  /**
+   * Assignment operator (not used)
+   * \param o Object to assign
+   * \return Assigned object
+   */
+  SatPerPacketTimelineInterference &operator = (const SatPerPacketTimelineInterference &o);
+
+  /**
+   * \brief Aggregate power timeline in time order, up to current time. Ring
+   * buffer with a power of two capacity.
+   */
+  std::vector<TimelinePoint_t> m_timeline;
+
+  /**
+   * \brief Index of the first timeline point in the ring buffer
+   */
+  uint32_t m_timelineHead;
+
+  /**
+   * \brief Number of points in the timeline
+   */
+  uint32_t m_timelineSize;
+
+  /**
+   * \brief Nodes of the power changes in the future
+   */
+  std::vector<PendingNode_t> m_pendingNodes;
+
+  /**
+   * \brief Free nodes in m_pendingNodes
+   */
+  std::vector<int32_t> m_freePendingNodes;
+
+  /**
+   * \brief Root of the pending change tree
+   */
+  int32_t m_pendingRoot;
+
+  /**
+   * \brief Number of the pending changes
+   */
+  uint32_t m_pendingCount;
+
+  /**
+   * \brief Time from which the energy sums of the pending changes are
+   * counted, rebased whenever there are no pending changes
+   */
+  Time m_pendingBase;
+
+  /**
+   * \brief State of the generator of the treap priorities
+   */
+  uint32_t m_pendingPrioritySeed;
+
+  /**
+   * \brief Start times of the notified interference events by event ID. Event
+   * IDs are given in the order of the start times, thus the first entry holds
+   * the earliest start time.
+   */
+  std::map<uint32_t, Time> m_rxEventStartTimes;
+
+  /**
+   * \brief event id for Events
+   */
+  uint32_t m_nextEventId;
+
+  /**
+   * \brief Flag to indicate whether the interference output trace is enabled
+   */
+  bool m_enableTraceOutput;
+
+  /**
+   * \brief Channel type of the receiver
+   */
+  SatEnums::ChannelType_t m_channelType;
+
+  /**
+   * \brief RX Bandwidth in Hz
+   */
+  double m_rxBandwidth_Hz;
+};
+
+} // namespace ns3
+
+#endif /* SATELLITE_PER_PACKET_TIMELINE_INTERFERENCE_H */
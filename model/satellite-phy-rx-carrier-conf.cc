@@ -215,7 +215,7 @@ SatPhyRxCarrierConf::GetChannelEstimatorErrorContainer () const
 SatPhyRxCarrierConf::RandomAccessCollisionModel
 SatPhyRxCarrierConf::GetRandomAccessCollisionModel () const
 {
-  if (m_raIfModel == IF_PER_PACKET)
+  if (m_raIfModel == IF_PER_PACKET || m_raIfModel == IF_PER_PACKET_TIMELINE || m_raIfModel == IF_SLOT_SYNCHRONOUS)
     {
       return m_raCollisionModel;
     }
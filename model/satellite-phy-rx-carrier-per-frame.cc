@@ -21,12 +21,15 @@
 #include <ns3/log.h>
 #include <ns3/simulator.h>
 #include <ns3/boolean.h>
+#include <ns3/uinteger.h>
 
 #include "satellite-phy-rx-carrier-per-frame.h"
 
 #include <algorithm>
+#include <cmath>
 #include <ostream>
 #include <limits>
+#include <map>
 #include <utility>
 
 NS_LOG_COMPONENT_DEFINE ("SatPhyRxCarrierPerFrame");
@@ -39,7 +42,10 @@ SatPhyRxCarrierPerFrame::SatPhyRxCarrierPerFrame (uint32_t carrierId,
 																									Ptr<SatPhyRxCarrierConf> carrierConf,
 																									bool randomAccessEnabled)
 : SatPhyRxCarrierPerSlot (carrierId, carrierConf, randomAccessEnabled),
-	m_frameEndSchedulingInitialized (false)
+	m_frameEndSchedulingInitialized (false),
+	m_enableParallelFrameDecoding (false),
+	m_parallelFrameDecodingThreads (0),
+	m_frameDecodingPending (false)
 {
 	NS_LOG_FUNCTION (this);
 
@@ -84,6 +90,16 @@ SatPhyRxCarrierPerFrame::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::SatPhyRxCarrierPerFrame")
 	.SetParent<SatPhyRxCarrierPerSlot> ()
+  .AddAttribute ("EnableParallelFrameDecoding",
+                 "Decode the CRDSA frames of the carriers ending at the same time in parallel threads.",
+                 BooleanValue (false),
+                 MakeBooleanAccessor (&SatPhyRxCarrierPerFrame::m_enableParallelFrameDecoding),
+                 MakeBooleanChecker ())
+  .AddAttribute ("ParallelFrameDecodingThreads",
+                 "Number of threads for parallel CRDSA frame decoding, 0 for the number of hardware threads.",
+                 UintegerValue (0),
+                 MakeUintegerAccessor (&SatPhyRxCarrierPerFrame::m_parallelFrameDecodingThreads),
+                 MakeUintegerChecker<uint32_t> ())
   .AddTraceSource ("CrdsaReplicaRx",
                    "Received a CRDSA packet replica through Random Access",
                    MakeTraceSourceAccessor (&SatPhyRxCarrierPerFrame::m_crdsaReplicaRxTrace),
@@ -114,6 +130,9 @@ SatPhyRxCarrierPerFrame::DoDispose ()
       iter->second.clear ();
     }
   m_crdsaPacketContainer.clear ();
+  m_frameRxParams.clear ();
+  m_frameLinkSinrs.clear ();
+  m_frameDecoder.Clear ();
 }
 
 void
@@ -159,26 +178,120 @@ SatPhyRxCarrierPerFrame::DoFrameEnd ()
 
   NS_LOG_INFO ("SatPhyRxCarrier::DoFrameEnd - Time: " << Now ().GetSeconds ());
 
+  StartFrameEnd ();
+
+  SatCrdsaFrameDecoder* decoder = GetPendingFrameDecoder ();
+
+  if (decoder != NULL)
+    {
+      decoder->Decode ();
+    }
+
+  CompleteFrameEnd ();
+  ScheduleFrameEnd ();
+}
+
+void
+SatPhyRxCarrierPerFrame::StartFrameEnd ()
+{
+  NS_LOG_FUNCTION (this);
+
   if (!m_crdsaPacketContainer.empty ())
     {
       // Update the CRDSA random access load for unique payloads!
       UpdateRandomAccessLoad ();
 
-      NS_LOG_INFO ("SatPhyRxCarrier::DoFrameEnd - Packets in container, will process the frame");
+      NS_LOG_INFO ("SatPhyRxCarrier::StartFrameEnd - Packets in container, will process the frame");
+
+      BuildFrame ();
+      m_crdsaPacketContainer.clear ();
+      m_frameDecodingPending = true;
+    }
+}
 
-      std::vector<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> results = ProcessFrame ();
+SatCrdsaFrameDecoder*
+SatPhyRxCarrierPerFrame::GetPendingFrameDecoder ()
+{
+  if (m_frameDecodingPending)
+    {
+      return &m_frameDecoder;
+    }
 
-      if (!m_crdsaPacketContainer.empty ())
+  return NULL;
+}
+
+void
+SatPhyRxCarrierPerFrame::CompleteFrameEnd ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_frameDecodingPending)
+    {
+      m_frameDecodingPending = false;
+
+      switch (m_frameDecoder.GetError ())
+        {
+        case SatCrdsaFrameDecoder::DECODING_OK:
+          {
+            break;
+          }
+        case SatCrdsaFrameDecoder::NEGATIVE_INTERFERENCE:
+          {
+            NS_FATAL_ERROR ("SatPhyRxCarrierPerFrame::CompleteFrameEnd - Negative interference");
+            break;
+          }
+        case SatCrdsaFrameDecoder::REPLICA_NOT_FOUND:
+          {
+            NS_FATAL_ERROR ("SatPhyRxCarrierPerFrame::CompleteFrameEnd - Replica not found");
+            break;
+          }
+        default:
+          {
+            NS_FATAL_ERROR ("SatPhyRxCarrierPerFrame::CompleteFrameEnd - Frame decoding failed");
+            break;
+          }
+        }
+
+      /*
+       * Update link specific SINR trace for the RETURN_FEEDER link for each
+       * processing of a packet. The RETURN_USER link SINR is already updated
+       * at the SatPhyRxCarrier::EndRxDataTransparent () method!
+       */
+      const std::vector<uint32_t>& processedPackets = m_frameDecoder.GetProcessedPackets ();
+
+      for (uint32_t i = 0; i < processedPackets.size (); i++)
+        {
+          m_linkSinrTrace (SatUtils::LinearToDb (m_frameLinkSinrs[processedPackets[i]]));
+        }
+
+      for (uint32_t i = 0; i < m_frameRxParams.size (); i++)
+        {
+          m_frameRxParams[i].rxParams->m_ifPowerInSatellite_W = m_frameDecoder.GetIfPowerInSatellite (i);
+        }
+
+      std::vector<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> results;
+      const std::vector<uint32_t>& decodedPackets = m_frameDecoder.GetDecodedPackets ();
+
+      for (uint32_t i = 0; i < decodedPackets.size (); i++)
         {
-          NS_FATAL_ERROR ("SatPhyRxCarrier::DoFrameEnd - All CRDSA packets in the frame were not processed");
+          SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s packet = m_frameRxParams[decodedPackets[i]];
+          packet.cSinr = m_frameDecoder.GetCompositeSinr (decodedPackets[i]);
+          packet.ifPower = packet.rxParams->m_ifPower_W;
+          packet.phyError = m_frameDecoder.HasPhyError (decodedPackets[i]);
+          packet.packetHasBeenProcessed = true;
+          results.push_back (packet);
         }
 
+      m_frameRxParams.clear ();
+      m_frameLinkSinrs.clear ();
+      m_frameDecoder.Clear ();
+
       /// sort the results based on CRDSA packet IDs to make sure the packets are processed in correct order
       std::sort (results.begin (), results.end (), CompareCrdsaPacketId);
 
       for (uint32_t i = 0; i < results.size (); i++)
         {
-          NS_LOG_INFO ("SatPhyRxCarrier::DoFrameEnd - Sending a packet to the next layer, slot: " << results[i].ownSlotId
+          NS_LOG_INFO ("SatPhyRxCarrier::CompleteFrameEnd - Sending a packet to the next layer, slot: " << results[i].ownSlotId
                        << ", UT: " << results[i].sourceAddress
                        << ", unique CRDSA packet ID: " << results[i].rxParams->m_txInfo.crdsaUniquePacketId
                        << ", destination address: " << results[i].destAddress
@@ -187,7 +300,7 @@ SatPhyRxCarrierPerFrame::DoFrameEnd ()
 
           for (uint32_t j = 0; j < results[i].rxParams->m_packetsInBurst.size (); j++)
             {
-              NS_LOG_INFO ("SatPhyRxCarrier::DoFrameEnd - Fragment (HL packet) UID: " << results[i].rxParams->m_packetsInBurst.at (j)->GetUid ());
+              NS_LOG_INFO ("SatPhyRxCarrier::CompleteFrameEnd - Fragment (HL packet) UID: " << results[i].rxParams->m_packetsInBurst.at (j)->GetUid ());
             }
 
           /// uses composite sinr
@@ -223,9 +336,15 @@ SatPhyRxCarrierPerFrame::DoFrameEnd ()
     {
       if (!m_crdsaPacketContainer.empty ())
         {
-          NS_FATAL_ERROR ("SatPhyRxCarrier::DoFrameEnd - CRDSA packets received by carrier which has random access disabled");
+          NS_FATAL_ERROR ("SatPhyRxCarrier::CompleteFrameEnd - CRDSA packets received by carrier which has random access disabled");
         }
     }
+}
+
+void
+SatPhyRxCarrierPerFrame::ScheduleFrameEnd ()
+{
+  NS_LOG_FUNCTION (this);
 
   Time nextSuperFrameRxTime = Singleton<SatRtnLinkTime>::Get ()->GetNextSuperFrameStartTime (SatConstVariables::SUPERFRAME_SEQUENCE);
 
@@ -399,424 +518,101 @@ SatPhyRxCarrierPerFrame::AddCrdsaPacket (SatPhyRxCarrierPerFrame::crdsaPacketRxP
     }
 }
 
-std::vector<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>
-SatPhyRxCarrierPerFrame::ProcessFrame ()
+void
+SatPhyRxCarrierPerFrame::BuildFrame ()
 {
   NS_LOG_FUNCTION (this);
 
-  NS_LOG_INFO ("SatPhyRxCarrier::ProcessFrame - Time: " << Now ().GetSeconds ());
-
-  std::map<uint32_t,std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> >::iterator iter;
-  std::vector<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> combinedPacketsForFrame;
-  SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s processedPacket;
-
-  bool nothingToProcess = true;
-
-  NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Packets to process: " << m_crdsaPacketContainer.size ());
+  m_frameRxParams.clear ();
+  m_frameLinkSinrs.clear ();
+  m_frameDecoder.Clear ();
 
-  do
+  if (GetRandomAccessCollisionModel () != SatPhyRxCarrierConf::RA_COLLISION_ALWAYS_DROP_ALL_COLLIDING_PACKETS
+      && GetRandomAccessCollisionModel () != SatPhyRxCarrierConf::RA_COLLISION_CHECK_AGAINST_SINR)
     {
-      NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Searching for the next successfully received packet");
-
-      /// reset the flag
-      nothingToProcess = true;
-
-      /// go through the packets
-      for (iter = m_crdsaPacketContainer.begin (); iter != m_crdsaPacketContainer.end (); iter++)
-        {
-          NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Iterating slot: " << iter->first);
-
-          if (iter->second.size () < 1)
-            {
-              NS_FATAL_ERROR ("SatPhyRxCarrierPerFrame::ProcessFrame - This should not happen");
-            }
-
-          std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>::iterator iterList;
-
-          for (iterList = iter->second.begin (); iterList != iter->second.end (); iterList++)
-            {
-              NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Iterating packet in slot: " << iterList->ownSlotId);
-
-              if (!iterList->packetHasBeenProcessed)
-                {
-                  NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Found a packet ready for processing");
-
-                  /// process the received packet
-                  *iterList = ProcessReceivedCrdsaPacket (*iterList, iter->second.size ());
-
-                  NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Packet error: " << iterList->phyError);
-
-                  /// packet successfully received
-                  if (!iterList->phyError)
-                    {
-                      NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Packet successfully received, breaking the slot iteration");
-
-                      nothingToProcess = false;
-
-                      /// save packet for processing outside the loop
-                      processedPacket = *iterList;
-
-                      /// remove the successfully received packet from the container
-                      iter->second.erase (iterList);
-
-                      /// eliminate the interference caused by this packet to other packets in this slot
-                      EliminateInterference (iter,processedPacket);
-
-                      /// break the cycle
-                      break;
-                    }
-                }
-              else
-                {
-                  NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - This packet has already been processed");
-                }
-            }
-
-          /// successfully received packet found
-          if (!nothingToProcess)
-            {
-              NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Packet successfully received, breaking the container iteration");
-              break;
-            }
-        }
-
-      if (!nothingToProcess)
-        {
-          NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Packet successfully received, processing the replicas");
-
-          /// find and remove replicas of the received packet
-          FindAndRemoveReplicas (processedPacket);
-
-          /// save the the received packet
-          combinedPacketsForFrame.push_back (processedPacket);
-        }
+      NS_FATAL_ERROR ("SatPhyRxCarrierPerFrame::BuildFrame - Random access collision model not defined");
     }
-  while (!nothingToProcess);
-
-  NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - All successfully received packets processed, packets left in container: " << m_crdsaPacketContainer.size ());
 
-  do
+  if (GetErrorModel () == SatPhyRxCarrierConf::EM_AVI && GetChannelType () != SatEnums::RETURN_FEEDER_CH)
     {
-      /// go through the packets
-      iter = m_crdsaPacketContainer.begin ();
-
-      if (iter != m_crdsaPacketContainer.end ())
-        {
-          std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>::iterator iterList = iter->second.begin ();
-
-          if (iterList != iter->second.end ())
-            {
-              NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Processing unsuccessfully received packet in slot: " << iterList->ownSlotId
-                           << " packet phy error: " << iterList->phyError
-                           << " packet has been processed: " << iterList->packetHasBeenProcessed);
-
-              if (!iterList->packetHasBeenProcessed || !iterList->phyError)
-                {
-                  NS_FATAL_ERROR ("SatPhyRxCarrierPerFrame::ProcessFrame - All successfully received packets should have been processed by now");
-                }
-
-              /// find and remove replicas of the received packet
-              FindAndRemoveReplicas (*iterList);
-
-              /// save the the received packet
-              combinedPacketsForFrame.push_back (*iterList);
-
-              /// remove the packet from the container
-              iter->second.erase (iterList);
-
-              /// remove the empty slot container
-              if (iter->second.empty ())
-                {
-                  m_crdsaPacketContainer.erase (iter);
-                }
-            }
-          else
-            {
-              /// remove the empty slot container
-              m_crdsaPacketContainer.erase (iter);
-            }
-        }
+      NS_FATAL_ERROR ("SatPhyRxCarrierPerFrame::BuildFrame - Invalid channel type!");
     }
-  while (!m_crdsaPacketContainer.empty ());
 
-  NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Container processed, packets left: " << m_crdsaPacketContainer.size ());
-
-  return combinedPacketsForFrame;
-}
-
-SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s
-SatPhyRxCarrierPerFrame::ProcessReceivedCrdsaPacket (SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s packet,
-																							 uint32_t numOfPacketsForThisSlot)
-{
-  NS_LOG_FUNCTION (this);
+  m_frameDecoder.SetModels (GetErrorModel (), GetConstantErrorRate (), GetRandomAccessCollisionModel ());
+  m_frameDecoder.SetRandomValueCallback (MakeCallback (&SatPhyRxCarrierPerFrame::GetFrameDecoderRandomValue, this));
 
-  NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessSuccessfullyReceivedCrdsaPacket - Time: " << Now ().GetSeconds ());
-
-  NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessReceivedCrdsaPacket - Processing a packet in slot: " << packet.ownSlotId <<
-               " number of packets in this slot: " << numOfPacketsForThisSlot);
-
-  for (uint32_t i = 0; i < packet.slotIdsForOtherReplicas.size (); i++)
-    {
-      NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessReceivedCrdsaPacket - Replica in slot: " << packet.slotIdsForOtherReplicas[i]);
-    }
-
-  NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessReceivedCrdsaPacket - SINR CALCULATION, RX sat: " << packet.rxParams->m_rxPowerInSatellite_W <<
-               " IF sat: " << packet.rxParams->m_ifPowerInSatellite_W <<
-               " RX gnd: " << packet.rxParams->m_rxPower_W <<
-               " IF gnd: " << packet.rxParams->m_ifPower_W);
-
-  double sinrSatellite = CalculateSinr ( packet.rxParams->m_rxPowerInSatellite_W,
-                                         packet.rxParams->m_ifPowerInSatellite_W,
-                                         packet.rxParams->m_rxNoisePowerInSatellite_W,
-                                         packet.rxParams->m_rxAciIfPowerInSatellite_W,
-                                         packet.rxParams->m_rxExtNoisePowerInSatellite_W,
-                                         packet.rxParams->m_sinrCalculate);
-
-  double sinr = CalculateSinr ( packet.rxParams->m_rxPower_W,
-                                packet.rxParams->m_ifPower_W,
-                                m_rxNoisePowerW,
-                                m_rxAciIfPowerW,
-                                m_rxExtNoisePowerW,
-                                m_sinrCalculate);
-
-  /*
-   * Update link specific SINR trace for the RETURN_FEEDER link. The RETURN_USER
-   * link SINR is already updated at the SatPhyRxCarrier::EndRxDataTransparent ()
-   * method!
-   */
-  m_linkSinrTrace (SatUtils::LinearToDb (sinr));
-
-  double cSinr = CalculateCompositeSinr (sinr, sinrSatellite);
-
-  packet.cSinr = cSinr;
-  packet.ifPower = packet.rxParams->m_ifPower_W;
-
-  if (GetRandomAccessCollisionModel () == SatPhyRxCarrierConf::RA_COLLISION_ALWAYS_DROP_ALL_COLLIDING_PACKETS)
+  if (GetErrorModel () == SatPhyRxCarrierConf::EM_AVI)
     {
-      NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessReceivedCrdsaPacket - Strict collision detection is ENABLED");
-
-      /// there is a collision
-      if (numOfPacketsForThisSlot > 1)
+      if (GetLinkResultsDvbRcs2 () == NULL)
         {
-          NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessReceivedCrdsaPacket - Multiple packets in this slot, successful reception is not possible");
-          /// not possible to have a successful reception
-          packet.phyError = true;
+          NS_FATAL_ERROR ("SatPhyRxCarrierPerFrame::BuildFrame - DVB-RCS2 link results not available");
         }
-      else
-        {
-          NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessReceivedCrdsaPacket - Only packet in this slot, checking against link results");
-          /// check against link results
-          packet.phyError = CheckAgainstLinkResults (packet.cSinr,packet.rxParams);
-        }
-      NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessReceivedCrdsaPacket - Strict collision detection, phy error: " << packet.phyError);
-    }
-  else if (GetRandomAccessCollisionModel () == SatPhyRxCarrierConf::RA_COLLISION_CHECK_AGAINST_SINR)
-    {
-      /// check against link results
-      packet.phyError = CheckAgainstLinkResults (packet.cSinr,packet.rxParams);
-      NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessReceivedCrdsaPacket - Check against link results, phy error: " << packet.phyError);
-    }
-  else
-    {
-      NS_FATAL_ERROR ("SatPhyRxCarrierPerFrame::ProcessReceivedCrdsaPacket - Random access collision model not defined");
-    }
-
-  /// mark the packet as processed
-  packet.packetHasBeenProcessed = true;
 
-  return packet;
-}
+      m_frameDecoder.SetLinkResults (GetLinkResultsDvbRcs2 ());
+    }
 
-void
-SatPhyRxCarrierPerFrame::FindAndRemoveReplicas (SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s packet)
-{
-  NS_LOG_FUNCTION (this);
-  NS_LOG_INFO ("SatPhyRxCarrier::FindAndRemoveReplicas - Time: " << Now ().GetSeconds ());
+  std::map<uint32_t,std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> >::iterator iter;
 
-  for (uint32_t i = 0; i < packet.slotIdsForOtherReplicas.size (); i++)
+  for (iter = m_crdsaPacketContainer.begin (); iter != m_crdsaPacketContainer.end (); iter++)
     {
-      NS_LOG_INFO ("SatPhyRxCarrier::FindAndRemoveReplicas - Processing replica in slot: " << packet.slotIdsForOtherReplicas[i]);
-
-      /// get the vector of packets for processing
-      std::map<uint32_t,std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> >::iterator iter;
-      iter = m_crdsaPacketContainer.find (packet.slotIdsForOtherReplicas[i]);
-
-      if (iter == m_crdsaPacketContainer.end ())
+      if (iter->second.size () < 1)
         {
-          NS_FATAL_ERROR ("SatPhyRxCarrier::FindAndRemoveReplicas - This should not happen");
+          NS_FATAL_ERROR ("SatPhyRxCarrierPerFrame::BuildFrame - This should not happen");
         }
 
       std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>::iterator iterList;
-      SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s removedPacket;
-
-      bool replicaFound = false;
-
-      for (iterList = iter->second.begin (); iterList != iter->second.end (); )
-        {
-          /// check for the same UT & same slots
-          if (IsReplica (packet, iterList))
-            {
-              /// replica found for removal
-              replicaFound = true;
-              removedPacket = *iterList;
-              iter->second.erase (iterList++);
-            }
-          else
-            {
-              ++iterList;
-            }
-        }
-
-      if (!replicaFound)
-        {
-          NS_FATAL_ERROR ("SatPhyRxCarrier::FindAndRemoveReplicas - Replica not found");
-        }
-
-      if (!packet.phyError)
-        {
-          EliminateInterference (iter, removedPacket);
-        }
-    }
-}
-
-void
-SatPhyRxCarrierPerFrame::EliminateInterference (
-		std::map<uint32_t,std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> >::iterator iter,
-		SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s processedPacket)
-{
-  NS_LOG_FUNCTION (this);
-  NS_LOG_INFO ("SatPhyRxCarrierPerFrame::EliminateInterference");
-
-  if (iter->second.empty ())
-    {
-      NS_LOG_INFO ("SatPhyRxCarrierPerFrame::EliminateInterference - No other packets in this slot, erasing the slot container");
-      m_crdsaPacketContainer.erase (iter);
-    }
-  else
-    {
-      std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>::iterator iterList;
 
       for (iterList = iter->second.begin (); iterList != iter->second.end (); iterList++)
         {
-          /// release packets in this slot for re-processing
-          iterList->packetHasBeenProcessed = false;
-
-          NS_LOG_INFO ("SatPhyRxCarrierPerFrame::EliminateInterference- BEFORE INTERFERENCE ELIMINATION, RX sat: " << iterList->rxParams->m_rxPowerInSatellite_W <<
-                       " IF sat: " << iterList->rxParams->m_ifPowerInSatellite_W <<
-                       " RX gnd: " << iterList->rxParams->m_rxPower_W <<
-                       " IF gnd: " << iterList->rxParams->m_ifPower_W);
-
-          /// Reduce interference power for the colliding packets. Note, that the interference is
-          /// eliminated only from the user link interference power at the satellite! The intra-beam
-          /// interference is not handled in the return feeder link so that the intra-beam interference
-          /// is not taken into account twice!
-          /// TODO A more novel way to eliminate partially overlapping interference should be considered!
-          /// In addition, as the interference values are extremely small, the use of long double (instead
-          /// of double) should be considered to improve the accuracy.
-
-          iterList->rxParams->m_ifPowerInSatellite_W -= processedPacket.rxParams->m_rxPowerInSatellite_W;
-
-          if (std::abs (iterList->rxParams->m_ifPowerInSatellite_W) < std::numeric_limits<double>::epsilon ())
-            {
-              iterList->rxParams->m_ifPowerInSatellite_W = 0;
-            }
-
-          if (iterList->rxParams->m_ifPower_W < 0 || iterList->rxParams->m_ifPowerInSatellite_W < 0)
+          Ptr<SatSignalParameters> rxParams = iterList->rxParams;
+          SatCrdsaFrameDecoder::packet_s packet;
+
+          packet.ownSlotId = iterList->ownSlotId;
+          packet.slotIds = iterList->slotIdsForOtherReplicas;
+          packet.slotIds.push_back (iterList->ownSlotId);
+          std::sort (packet.slotIds.begin (), packet.slotIds.end ());
+          packet.sourceAddress = iterList->sourceAddress;
+          packet.rxPowerInSatelliteW = rxParams->m_rxPowerInSatellite_W;
+          packet.ifPowerInSatelliteW = rxParams->m_ifPowerInSatellite_W;
+          packet.rxNoisePowerInSatelliteW = rxParams->m_rxNoisePowerInSatellite_W;
+          packet.rxAciIfPowerInSatelliteW = rxParams->m_rxAciIfPowerInSatellite_W;
+          packet.rxExtNoisePowerInSatelliteW = rxParams->m_rxExtNoisePowerInSatellite_W;
+          packet.sinrCalculate = rxParams->m_sinrCalculate;
+          packet.ifPowerW = rxParams->m_ifPower_W;
+
+          if (rxParams->m_rxNoisePowerInSatellite_W <= 0.0)
             {
-              NS_FATAL_ERROR ("SatPhyRxCarrierPerFrame::EliminateInterference - Negative interference");
+              NS_FATAL_ERROR ("Noise power must be greater than zero!!!");
             }
 
-          NS_LOG_INFO ("SatPhyRxCarrierPerFrame::EliminateInterference- AFTER INTERFERENCE ELIMINATION, RX sat: " <<
-          							iterList->rxParams->m_rxPowerInSatellite_W <<
-                       " IF sat: " << iterList->rxParams->m_ifPowerInSatellite_W <<
-                       " RX gnd: " << iterList->rxParams->m_rxPower_W <<
-                       " IF gnd: " << iterList->rxParams->m_ifPower_W);
-        }
-    }
-}
-
-bool
-SatPhyRxCarrierPerFrame::IsReplica (SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s packet,
-																std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>::iterator iter)
-{
-  NS_LOG_FUNCTION (this);
-  NS_LOG_INFO ("SatPhyRxCarrier::IsReplica - Time: " << Now ().GetSeconds ());
-
-  NS_LOG_INFO ("SatPhyRxCarrier::IsReplica - Checking the source addresses");
+          /// the feeder link SINR does not change in the interference elimination
+          packet.sinr = CalculateSinr (rxParams->m_rxPower_W,
+                                       rxParams->m_ifPower_W,
+                                       m_rxNoisePowerW,
+                                       m_rxAciIfPowerW,
+                                       m_rxExtNoisePowerW,
+                                       m_sinrCalculate);
 
-  bool isReplica = false;
+          packet.bitsPerSymbol = SatUtils::GetCodingRate (rxParams->m_txInfo.modCod) *
+                                 SatUtils::GetModulatedBits (rxParams->m_txInfo.modCod);
+          packet.waveformId = rxParams->m_txInfo.waveformId;
 
-  if (iter->sourceAddress == packet.sourceAddress)
-    {
-      NS_LOG_INFO ("SatPhyRxCarrier::IsReplica - Same source addresses, checking slot IDs");
+          m_frameDecoder.AddPacket (packet);
 
-      if (HaveSameSlotIds (packet, iter))
-        {
-          NS_LOG_INFO ("SatPhyRxCarrier::IsReplica - Same slot IDs, replica found");
-          isReplica = true;
+          m_frameRxParams.push_back (*iterList);
+          m_frameLinkSinrs.push_back (packet.sinr);
         }
     }
-  return isReplica;
+
+  NS_LOG_INFO ("SatPhyRxCarrierPerFrame::BuildFrame - Packets: " << m_frameRxParams.size ()
+               << ", slots: " << m_crdsaPacketContainer.size ());
 }
 
-bool
-SatPhyRxCarrierPerFrame::HaveSameSlotIds (SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s packet,
-                                          std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>::iterator iter)
+double
+SatPhyRxCarrierPerFrame::GetFrameDecoderRandomValue ()
 {
-  NS_LOG_FUNCTION (this);
-  NS_LOG_INFO ("SatPhyRxCarrierUt::HaveSameSlotIds - Time: " << Now ().GetSeconds ());
-
-  std::set<uint16_t> firstSet;
-  std::set<uint16_t> secondSet;
-  std::set<uint16_t>::iterator firstSetIterator;
-  std::set<uint16_t>::iterator secondSetIterator;
-  bool haveSameSlotIds = true;
-
-  firstSet.insert (packet.ownSlotId);
-  secondSet.insert (iter->ownSlotId);
-
-  /// sanity check
-  if (iter->slotIdsForOtherReplicas.size () != packet.slotIdsForOtherReplicas.size ())
-    {
-      NS_FATAL_ERROR ("SatPhyRxCarrierUt::HaveSameSlotIds - The amount of replicas does not match");
-    }
-
-  NS_LOG_INFO ("SatPhyRxCarrierUt::HaveSameSlotIds - Comparing slot IDs");
-
-  /// form sets
-  for (uint32_t i = 0; i < iter->slotIdsForOtherReplicas.size (); i++)
-    {
-      firstSet.insert (packet.slotIdsForOtherReplicas[i]);
-      secondSet.insert (iter->slotIdsForOtherReplicas[i]);
-    }
-
-  uint32_t numOfMatchingSlots = 0;
-
-  /// compare sets
-  for (firstSetIterator = firstSet.begin (); firstSetIterator != firstSet.end (); firstSetIterator++)
-    {
-      secondSetIterator = secondSet.find (*firstSetIterator);
-
-      if (secondSetIterator == secondSet.end ())
-        {
-          haveSameSlotIds = false;
-        }
-      else
-        {
-          numOfMatchingSlots++;
-        }
-    }
-
-  NS_LOG_INFO ("SatPhyRxCarrier::HaveSameSlotIds - Are slot IDs identical: " << haveSameSlotIds
-               << ", number of matching slots: " << numOfMatchingSlots);
-
-  /// sanity check
-  if (!haveSameSlotIds && numOfMatchingSlots > 0)
-    {
-      NS_FATAL_ERROR ("SatPhyRxCarrier::HaveSameSlotIds - Partially overlapping CRDSA slots");
-    }
-
-  return haveSameSlotIds;
+  /// called by the frame decoder, possibly in a parallel decoding thread, thus no logging
+  return GetUniformRandomValue (0, 1);
 }
 
 bool
@@ -21,11 +21,15 @@
 #ifndef SATELLITE_PHY_RX_CARRIER_PER_FRAME_H
 #define SATELLITE_PHY_RX_CARRIER_PER_FRAME_H
 
+#include <map>
+#include <vector>
+
 #include <ns3/singleton.h>
 #include <ns3/satellite-rtn-link-time.h>
 #include <ns3/satellite-crdsa-replica-tag.h>
 #include <ns3/satellite-phy-rx-carrier.h>
 #include <ns3/satellite-phy-rx-carrier-per-slot.h>
+#include <ns3/satellite-crdsa-frame-decoder.h>
 
 namespace ns3 {
 
@@ -96,6 +100,25 @@ public:
    */
   void BeginFrameEndScheduling ();
 
+  /**
+   * \brief Check if the frames of the carrier are decoded in parallel with
+   * the other carriers of the same receiver
+   * \return Is parallel frame decoding enabled
+   */
+  inline bool IsParallelFrameDecodingEnabled () const
+  {
+    return m_enableParallelFrameDecoding;
+  }
+
+  /**
+   * \brief Get the number of threads for parallel frame decoding
+   * \return Number of threads, zero for the number of hardware threads
+   */
+  inline uint32_t GetParallelFrameDecodingThreads () const
+  {
+    return m_parallelFrameDecodingThreads;
+  }
+
   /**
    * \brief Method for querying the type of the carrier
    */
@@ -119,12 +142,16 @@ protected:
 private:
 
   /**
-   * \brief Function for eliminating the interference to other packets in the slot from the correctly received packet
-   * \param iter Packets in the slot
-   * \param processedPacket Correctly received processed packet
+   * \brief Function for building the frame decoder input from the CRDSA packet container
+   */
+  void BuildFrame ();
+
+  /**
+   * \brief Function for drawing a random value of the error model for the
+   * frame decoder, when it processes a packet
+   * \return Random value between 0 and 1
    */
-  void EliminateInterference (std::map<uint32_t,std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> >::iterator iter,
-  		SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s processedPacket);
+  double GetFrameDecoderRandomValue ();
 
   /**
    * \brief Function for storing the received CRDSA packets
@@ -158,45 +185,40 @@ private:
   TracedCallback<uint32_t, const Address &, bool> m_crdsaUniquePayloadRxTrace;
 
   /**
-   * \brief Function for processing the CRDSA frame
-   * \return Processed packets
+   * \brief Function for calculating the normalized offered random access load
+   * \return Normalized offered load
    */
-  std::vector<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> ProcessFrame ();
+  double CalculateNormalizedOfferedRandomAccessLoad ();
 
   /**
-   * \brief Function for finding and removing the replicas of the CRDSA packet
-   * \param packet CRDSA packet
+   * \brief Function for processing the frame interval operations
    */
-  void FindAndRemoveReplicas (SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s packet);
+  void DoFrameEnd ();
 
   /**
-   * \brief Function for identifying whether the packet is a replica of another packet
-   * \param packet Packet
-   * \param iter A packet in certain slot
-   * \return Is the packet a replica
+   * \brief Function for starting the frame end. Copies the received CRDSA
+   * packets to the frame decoder.
    */
-  bool IsReplica (SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s packet,
-  		std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>::iterator iter);
+  void StartFrameEnd ();
 
   /**
-   * \brief Function for checking do the packets have identical slots
-   * \param packet Packet
-   * \param iter A packet in certain slot
-   * \return Have the packets identical slots
+   * \brief Function for getting the frame decoder of a frame started at the
+   * frame end and not yet completed. The decoder uses only plain data, so
+   * frames of different carriers may be decoded in parallel.
+   * \return Frame decoder, or NULL if there is no frame to decode
    */
-  bool HaveSameSlotIds (SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s packet,
-  		std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>::iterator iter);
+  SatCrdsaFrameDecoder* GetPendingFrameDecoder ();
 
   /**
-   * \brief Function for calculating the normalized offered random access load
-   * \return Normalized offered load
+   * \brief Function for completing the frame end. Passes the decoded packets
+   * upwards. Called in the same event as StartFrameEnd.
    */
-  double CalculateNormalizedOfferedRandomAccessLoad ();
+  void CompleteFrameEnd ();
 
   /**
-   * \brief Function for processing the frame interval operations
+   * \brief Function for scheduling the next frame end
    */
-  void DoFrameEnd ();
+  void ScheduleFrameEnd ();
 
   /**
    * \brief Function for measuring the random access load
@@ -209,14 +231,6 @@ private:
    */
   void UpdateRandomAccessLoad ();
 
-  /**
-   * Process received CRDSA packet.
-   */
-  SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s
-	ProcessReceivedCrdsaPacket (SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s packet,
-                              uint32_t numOfPacketsForThisSlot);
-
-
   /**
    * \brief CRDSA packet container
    */
@@ -226,6 +240,38 @@ private:
    * \brief Has the frame end scheduling been initialized
    */
   bool m_frameEndSchedulingInitialized;
+
+  /**
+   * \brief Decode frames of the carriers with the same frame end time in parallel
+   */
+  bool m_enableParallelFrameDecoding;
+
+  /**
+   * \brief Number of threads for parallel frame decoding, zero for the number of hardware threads
+   */
+  uint32_t m_parallelFrameDecodingThreads;
+
+  /**
+   * \brief Has a frame been started at the frame end and not yet completed
+   */
+  bool m_frameDecodingPending;
+
+  /**
+   * \brief Decoder of the frame
+   */
+  SatCrdsaFrameDecoder m_frameDecoder;
+
+  /**
+   * \brief Rx parameters of the packets of the frame in the packet order of the frame decoder
+   */
+  std::vector<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> m_frameRxParams;
+
+  /**
+   * \brief Feeder link SINRs of the packets of the frame, traced for each processing of a packet
+   */
+  std::vector<double> m_frameLinkSinrs;
+
+  friend class SatParallelFrameDecoder;
 };
 
 
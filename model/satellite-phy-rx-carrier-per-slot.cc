@@ -92,8 +92,9 @@ SatPhyRxCarrierPerSlot::DoDispose ()
 }
 
 Ptr<SatInterference::InterferenceChangeEvent>
-SatPhyRxCarrierPerSlot::CreateInterference (Ptr<SatSignalParameters> rxParams, Address senderAddress)
+SatPhyRxCarrierPerSlot::CreateInterference (const SatSignalBurst::rxRecord_s& rxRecord, Address senderAddress)
 {
+	Ptr<const SatSignalParameters> txParams = rxRecord.burst->GetTxParams ();
 	SatEnums::ChannelType_t ct = GetChannelType ();
 	if (ct == SatEnums::RETURN_FEEDER_CH)
 	  {
@@ -112,19 +113,19 @@ SatPhyRxCarrierPerSlot::CreateInterference (Ptr<SatSignalParameters> rxParams, A
 
 	    double rxPower (0.0);
 
-	    if (rxParams->m_beamId != GetBeamId ())
+	    if (txParams->m_beamId != GetBeamId ())
 	      {
-	        rxPower = rxParams->m_rxPower_W * (1 + 1/rxParams->m_sinr);
+	        rxPower = rxRecord.rxPower_W * (1 + 1/txParams->m_sinr);
 	      }
 
 	    // Add the interference even regardless.
-	    return GetInterferenceModel()->Add (rxParams->m_duration,
+	    return GetInterferenceModel()->Add (txParams->m_duration,
 	                                        rxPower,
 	                                        GetOwnAddress ());
 	  }
 	else if (ct == SatEnums::FORWARD_USER_CH)
 	  {
-	    return GetInterferenceModel()->Add (rxParams->m_duration, rxParams->m_rxPower_W, GetOwnAddress ());
+	    return GetInterferenceModel()->Add (txParams->m_duration, rxRecord.rxPower_W, GetOwnAddress ());
 	  }
 
 	NS_FATAL_ERROR ("SatSatellitePhyRxCarrier::CreateInterference - Invalid channel type!");
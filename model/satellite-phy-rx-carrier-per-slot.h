@@ -132,7 +132,7 @@ protected:
    * \return Pointer to the interference event.
    */
 	virtual Ptr<SatInterference::InterferenceChangeEvent>
-	  CreateInterference (Ptr<SatSignalParameters> rxParams, Address rxAddress);
+	  CreateInterference (const SatSignalBurst::rxRecord_s& rxRecord, Address rxAddress);
 
 	/**
 	 * \brief The number of random access bits in current frame.
@@ -52,9 +52,9 @@ SatPhyRxCarrierUplink::GetTypeId (void)
 }
 
 Ptr<SatInterference::InterferenceChangeEvent>
-SatPhyRxCarrierUplink::CreateInterference (Ptr<SatSignalParameters> rxParams, Address senderAddress)
+SatPhyRxCarrierUplink::CreateInterference (const SatSignalBurst::rxRecord_s& rxRecord, Address senderAddress)
 {
-	return GetInterferenceModel()->Add (rxParams->m_duration, rxParams->m_rxPower_W, senderAddress);
+	return GetInterferenceModel()->Add (rxRecord.burst->GetTxParams ()->m_duration, rxRecord.rxPower_W, senderAddress);
 }
 
 void
@@ -85,7 +85,7 @@ protected:
    *
    * \return Pointer to the interference event.
    */
-	virtual Ptr<SatInterference::InterferenceChangeEvent> CreateInterference (Ptr<SatSignalParameters> rxParams, Address rxAddress);
+	virtual Ptr<SatInterference::InterferenceChangeEvent> CreateInterference (const SatSignalBurst::rxRecord_s& rxRecord, Address rxAddress);
 };
 
 }
@@ -24,6 +24,8 @@
 #include <ns3/satellite-utils.h>
 #include <ns3/satellite-constant-interference.h>
 #include <ns3/satellite-per-packet-interference.h>
+#include <ns3/satellite-per-packet-timeline-interference.h>
+#include <ns3/satellite-slot-synchronous-interference.h>
 #include <ns3/satellite-traced-interference.h>
 #include <ns3/satellite-mac-tag.h>
 #include <ns3/singleton.h>
@@ -77,6 +79,8 @@ SatPhyRxCarrier::SatPhyRxCarrier (uint32_t carrierId, Ptr<SatPhyRxCarrierConf> c
     {
       NS_LOG_INFO (this << " link results in use in carrier: " << carrierId);
       m_linkResults = carrierConf->GetLinkResults ();
+      m_linkResultsDvbS2 = m_linkResults->GetObject <SatLinkResultsDvbS2> ();
+      m_linkResultsDvbRcs2 = m_linkResults->GetObject <SatLinkResultsDvbRcs2> ();
     }
 
   m_rxTemperatureK = carrierConf->GetRxTemperatureK ();
@@ -132,6 +136,40 @@ SatPhyRxCarrier::DoCreateInterferenceModel (Ptr<SatPhyRxCarrierConf> carrierConf
           }
         break;
       }
+    case SatPhyRxCarrierConf::IF_PER_PACKET_TIMELINE:
+      {
+        NS_LOG_INFO (this << " Per packet timeline interference model created for carrier: " << carrierId);
+        if (carrierConf->IsIntfOutputTraceEnabled ())
+          {
+            m_satInterference = CreateObject<SatPerPacketTimelineInterference> (GetChannelType (), rxBandwidthHz);
+          }
+        else
+          {
+            m_satInterference = CreateObject<SatPerPacketTimelineInterference> ();
+          }
+        break;
+      }
+    case SatPhyRxCarrierConf::IF_SLOT_SYNCHRONOUS:
+      {
+        NS_LOG_INFO (this << " Slot synchronous interference model created for carrier: " << carrierId);
+        if (carrierConf->IsIntfOutputTraceEnabled ())
+          {
+            m_satInterference = CreateObject<SatSlotSynchronousInterference> (GetChannelType (), rxBandwidthHz);
+          }
+        else
+          {
+            m_satInterference = CreateObject<SatSlotSynchronousInterference> ();
+          }
+
+        Ptr<SatSuperframeSeq> superframeSeq = Singleton<SatRtnLinkTime>::Get ()->GetSuperframeSeq ();
+
+        if ( superframeSeq
+             && (GetChannelType () == SatEnums::RETURN_USER_CH || GetChannelType () == SatEnums::RETURN_FEEDER_CH) )
+          {
+            DynamicCast<SatSlotSynchronousInterference> (m_satInterference)->SetSuperframeConf (superframeSeq->GetSuperframeConf (SatConstVariables::SUPERFRAME_SEQUENCE), carrierId);
+          }
+        break;
+      }
     case SatPhyRxCarrierConf::IF_TRACE:
       {
         NS_LOG_INFO (this << " Traced interference model created for carrier: " << carrierId);
@@ -245,16 +283,15 @@ SatPhyRxCarrier::ChangeState (State newState)
 
 
 std::pair<bool, SatPhyRxCarrier::rxParams_s>
-SatPhyRxCarrier::GetReceiveParams (Ptr<SatSignalParameters> rxParams)
+SatPhyRxCarrier::GetReceiveParams (Ptr<const SatSignalParameters> txParams)
 {
 	SatPhyRxCarrier::rxParams_s params;
-	params.rxParams = rxParams;
 	// Receive packet by default in satellite, discard in UT
   bool receivePacket = GetDefaultReceiveMode ();
   bool ownAddressFound = false;
 
-  for (SatSignalParameters::PacketsInBurst_t::const_iterator i = rxParams->m_packetsInBurst.begin ();
-       ((i != rxParams->m_packetsInBurst.end ()) && (ownAddressFound == false) ); i++)
+  for (SatSignalParameters::PacketsInBurst_t::const_iterator i = txParams->m_packetsInBurst.begin ();
+       ((i != txParams->m_packetsInBurst.end ()) && (ownAddressFound == false) ); i++)
     {
       SatMacTag tag;
       (*i)->PeekPacketTag (tag);
@@ -285,43 +322,50 @@ SatPhyRxCarrier::GetReceiveParams (Ptr<SatSignalParameters> rxParams)
 
 
 void
-SatPhyRxCarrier::StartRx (Ptr<SatSignalParameters> rxParams)
+SatPhyRxCarrier::StartRx (const SatSignalBurst::rxRecord_s& rxRecord)
 {
-  NS_LOG_FUNCTION (this << rxParams);
+  NS_LOG_FUNCTION (this << rxRecord.burst);
   NS_LOG_INFO (this << " state: " << m_state);
-  NS_ASSERT (rxParams->m_carrierId == m_carrierId);
+
+  Ptr<const SatSignalParameters> txParams = rxRecord.burst->GetTxParams ();
+  NS_ASSERT (txParams->m_carrierId == m_carrierId);
 
   uint32_t key;
 
   NS_LOG_INFO ("Node: " << m_nodeInfo->GetMacAddress ()
 								<< " starts receiving packet at: " << Simulator::Now ().GetSeconds ()
-								<< " in carrier: " << rxParams->m_carrierId);
-  NS_LOG_INFO ("Sender: " << rxParams->m_phyTx);
+								<< " in carrier: " << txParams->m_carrierId);
+  NS_LOG_INFO ("Sender: " << txParams->m_phyTx);
 
   switch (m_state)
     {
     case IDLE:
     case RX:
       {
-      	auto receiveParamTuple = GetReceiveParams (rxParams);
+      	auto receiveParamTuple = GetReceiveParams (txParams);
 
         bool receivePacket = receiveParamTuple.first;
         rxParams_s rxParamsStruct = receiveParamTuple.second;
 
         // add interference in any case
-        rxParamsStruct.interferenceEvent = CreateInterference (rxParams, rxParamsStruct.sourceAddress);
+        rxParamsStruct.interferenceEvent = CreateInterference (rxRecord, rxParamsStruct.sourceAddress);
 
         // Check whether the packet is sent to our beam.
         // In case that RX mode is something else than transparent
         // additionally check that whether the packet was intended for this specific receiver
 
-        if ( receivePacket && ( rxParams->m_beamId == GetBeamId () ) )
+        if ( receivePacket && ( txParams->m_beamId == GetBeamId () ) )
           {
-            if (IsReceivingDedicatedAccess () && rxParams->m_txInfo.packetType == SatEnums::PACKET_TYPE_DEDICATED_ACCESS)
+            if (IsReceivingDedicatedAccess () && txParams->m_txInfo.packetType == SatEnums::PACKET_TYPE_DEDICATED_ACCESS)
               {
                 NS_FATAL_ERROR ("Starting reception of a packet when receiving DA transmission!");
               }
 
+            // The burst is received by this receiver, thus take own copies of the
+            // packets shared by the channel with the other receivers
+            Ptr<SatSignalParameters> rxParams = rxRecord.burst->CreateRxParams (rxRecord);
+            rxParamsStruct.rxParams = rxParams;
+
             GetInterferenceModel ()->NotifyRxStart (rxParamsStruct.interferenceEvent);
 
             key = m_rxPacketCounter;
@@ -427,9 +471,9 @@ SatPhyRxCarrier::CheckAgainstLinkResultsErrorModelAvi (double cSinr, Ptr<SatSign
 			 * fs = symbol rate in baud
 			*/
 
-			double ber = (GetLinkResults ()->GetObject <SatLinkResultsDvbS2> ())->GetBler (rxParams->m_txInfo.modCod,
-																																								 rxParams->m_txInfo.frameType,
-																																								 SatUtils::LinearToDb (cSinr));
+			double ber = m_linkResultsDvbS2->GetBler (rxParams->m_txInfo.modCod,
+			                                          rxParams->m_txInfo.frameType,
+			                                          SatUtils::LinearToDb (cSinr));
 			double r = GetUniformRandomValue (0, 1);
 
 			if ( r < ber )
@@ -466,8 +510,8 @@ SatPhyRxCarrier::CheckAgainstLinkResultsErrorModelAvi (double cSinr, Ptr<SatSign
 			double ebNo = cSinr / (SatUtils::GetCodingRate (rxParams->m_txInfo.modCod) *
 														 SatUtils::GetModulatedBits (rxParams->m_txInfo.modCod));
 
-			double ber = (GetLinkResults ()->GetObject <SatLinkResultsDvbRcs2> ())->GetBler (rxParams->m_txInfo.waveformId,
-																																									 SatUtils::LinearToDb (ebNo));
+			double ber = m_linkResultsDvbRcs2->GetBler (rxParams->m_txInfo.waveformId,
+			                                            SatUtils::LinearToDb (ebNo));
 			double r = GetUniformRandomValue (0, 1);
 
 			if ( r < ber )
@@ -512,7 +556,7 @@ SatPhyRxCarrier::CalculateSinr (double rxPowerW,
                                 double rxNoisePowerW,
                                 double rxAciIfPowerW,
                                 double rxExtNoisePowerW,
-                                SatPhyRxCarrierConf::SinrCalculatorCallback sinrCalculate)
+                                const SatPhyRxCarrierConf::SinrCalculatorCallback& sinrCalculate)
 {
   NS_LOG_FUNCTION (this << rxPowerW <<  ifPowerW);
 
@@ -32,6 +32,7 @@
 #include <ns3/satellite-phy.h>
 #include <ns3/satellite-phy-rx.h>
 #include <ns3/satellite-phy-rx-carrier-conf.h>
+#include <ns3/satellite-signal-parameters.h>
 #include <vector>
 #include <map>
 #include <list>
@@ -43,6 +44,8 @@ class Address;
 class SatPhy;
 class SatSignalParameters;
 class SatLinkResults;
+class SatLinkResultsDvbS2;
+class SatLinkResultsDvbRcs2;
 class SatChannelEstimationErrorContainer;
 class SatNodeInfo;
 
@@ -173,10 +176,12 @@ public:
   void SetNodeInfo (const Ptr<SatNodeInfo> nodeInfo);
 
   /**
-   * \brief Function for starting packet reception from the SatChannel
-   * \param rxParams The needed parameters for the received signal
+   * \brief Function for starting packet reception from the SatChannel. The
+   * packets of the burst are copied only if the burst is received by this
+   * receiver, i.e. not if it is seen only as interference.
+   * \param rxRecord Per-receiver record of the received burst
    */
-  void StartRx (Ptr<SatSignalParameters> rxParams);
+  void StartRx (const SatSignalBurst::rxRecord_s& rxRecord);
 
   /**
    * \brief Method for querying the type of the carrier
@@ -225,25 +230,25 @@ protected:
   inline Ptr<SatInterference> GetInterferenceModel () { return m_satInterference; };
 
   /**
-   * \brief Create an interference event based on Rx parameters and address.
-   * 				Implemented by child classes.
+   * \brief Create an interference event based on the per-receiver record of
+   * a burst and address. Implemented by child classes.
    *
    * \return Pointer to the interference event.
    */
 	virtual Ptr<SatInterference::InterferenceChangeEvent>
-	  CreateInterference (Ptr<SatSignalParameters> rxParams, Address rxAddress) = 0;
+	  CreateInterference (const SatSignalBurst::rxRecord_s& rxRecord, Address rxAddress) = 0;
 
 	/**
 	 * Rx parameter storage methods
 	 */
 
 	/**
-	 * Get receive parameters from signal parameters.
-	 * \param rxParams SatSignalParameters
+	 * Get receive parameters from the transmission parameters of a burst.
+	 * \param txParams Transmission parameters of the burst
 	 * \return A pair of boolean and rxParams_s struct. Boolean tells if we are about to receive a packet
-	 * 				 and struct contains all receiveing info.
+	 * 				 and struct contains all receiveing info, except the signal parameters of the receiver.
 	 */
-	std::pair<bool, SatPhyRxCarrier::rxParams_s> GetReceiveParams (Ptr<SatSignalParameters> rxParams);
+	std::pair<bool, SatPhyRxCarrier::rxParams_s> GetReceiveParams (Ptr<const SatSignalParameters> txParams);
 
 	/// Get stored rxParams under a key
   inline rxParams_s GetStoredRxParams (uint32_t key) { return m_rxParamsMap[key]; }
@@ -345,7 +350,7 @@ protected:
                         double rxNoisePowerW,
                         double rxAciIfPowerW,
                         double rxExtNoisePowerW,
-                        SatPhyRxCarrierConf::SinrCalculatorCallback sinrCalculate);
+                        const SatPhyRxCarrierConf::SinrCalculatorCallback& sinrCalculate);
 
   /**
    * \brief Function for calculating the composite SINR
@@ -407,6 +412,24 @@ protected:
    */
   inline double GetUniformRandomValue (double min, double max) { return m_uniformVariable->GetValue (min, max); };
 
+  /**
+   * \brief Get the error model of the carrier
+   * \return Error model
+   */
+  inline SatPhyRxCarrierConf::ErrorModel GetErrorModel () const { return m_errorModel; };
+
+  /**
+   * \brief Get the error rate of the constant error model
+   * \return Constant error rate
+   */
+  inline double GetConstantErrorRate () const { return m_constantErrorRate; };
+
+  /**
+   * \brief Get the DVB-RCS2 link results of the AVI error model
+   * \return Link results, or NULL if the carrier does not use DVB-RCS2 link results
+   */
+  inline Ptr<SatLinkResultsDvbRcs2> GetLinkResultsDvbRcs2 () { return m_linkResultsDvbRcs2; };
+
   ///// CALCULATION VARIABLES //////////
   /**
    * \brief RX noise temperature in K.
@@ -534,6 +557,8 @@ private:
   Ptr<SatNodeInfo> m_nodeInfo; 									//< NodeInfo of the node where carrier is attached
   SatEnums::ChannelType_t m_channelType;				//< Channel type
   Ptr<SatLinkResults> m_linkResults; 						//< Link results from the carrier configuration
+  Ptr<SatLinkResultsDvbS2> m_linkResultsDvbS2;	//< DVB-S2 link results, if m_linkResults is of that type
+  Ptr<SatLinkResultsDvbRcs2> m_linkResultsDvbRcs2;	//< DVB-RCS2 link results, if m_linkResults is of that type
   Ptr<UniformRandomVariable> m_uniformVariable;	//< Uniform helper random variable
   SatPhyRxCarrierConf::ErrorModel m_errorModel;	//< Error model
   double m_constantErrorRate;										//< Error rate for constant error model
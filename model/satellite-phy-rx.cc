@@ -18,6 +18,9 @@
  * Author: Jani Puttonen <jani.puttonen@magister.fi>
  */
 
+#include <algorithm>
+#include <thread>
+
 #include "ns3/log.h"
 #include "ns3/object-vector.h"
 #include "ns3/antenna-model.h"
@@ -31,6 +34,7 @@
 #include "satellite-phy-rx-carrier-per-slot.h"
 #include "satellite-phy-rx-carrier-uplink.h"
 #include "satellite-phy-rx-carrier-conf.h"
+#include "satellite-parallel-frame-decoder.h"
 #include "satellite-signal-parameters.h"
 #include "satellite-antenna-gain-pattern.h"
 
@@ -45,7 +49,8 @@ SatPhyRx::SatPhyRx ()
   : m_beamId (),
     m_maxAntennaGain (),
     m_antennaLoss (),
-    m_defaultFadingValue ()
+    m_defaultFadingValue (),
+    m_nodeId (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -61,6 +66,13 @@ void SatPhyRx::DoDispose ()
   m_mobility = 0;
   m_device = 0;
   m_fadingContainer = 0;
+
+  if (m_parallelFrameDecoder != 0)
+    {
+      m_parallelFrameDecoder->Dispose ();
+      m_parallelFrameDecoder = 0;
+    }
+
   m_rxCarriers.clear ();
   Object::DoDispose ();
 }
@@ -188,6 +200,7 @@ SatPhyRx::SetNodeInfo (const Ptr<SatNodeInfo> nodeInfo)
   NS_LOG_FUNCTION (this << nodeInfo->GetNodeId ());
 
   m_macAddress = nodeInfo->GetMacAddress ();
+  m_nodeId = nodeInfo->GetNodeId ();
 
   for (std::vector< Ptr<SatPhyRxCarrier> >::iterator it = m_rxCarriers.begin ();
        it != m_rxCarriers.end ();
@@ -202,12 +215,49 @@ SatPhyRx::BeginFrameEndScheduling ()
 {
   NS_LOG_FUNCTION (this);
 
+  std::vector<Ptr<SatPhyRxCarrierPerFrame> > parallelCarriers;
+
   for (std::vector< Ptr<SatPhyRxCarrier> >::iterator it = m_rxCarriers.begin ();
        it != m_rxCarriers.end ();
        ++it)
     {
   		Ptr<SatPhyRxCarrierPerFrame> crdsaPrxc = (*it)->GetObject<SatPhyRxCarrierPerFrame> ();
-      if (crdsaPrxc != 0) crdsaPrxc->BeginFrameEndScheduling ();
+      if (crdsaPrxc == 0)
+        {
+          continue;
+        }
+
+      /// frame ends of the carriers decoded in parallel are scheduled by the parallel decoder
+      if (crdsaPrxc->IsParallelFrameDecodingEnabled ())
+        {
+          parallelCarriers.push_back (crdsaPrxc);
+        }
+      else
+        {
+          crdsaPrxc->BeginFrameEndScheduling ();
+        }
+    }
+
+  if (!parallelCarriers.empty () && m_parallelFrameDecoder == 0)
+    {
+      uint32_t numOfThreads = parallelCarriers.front ()->GetParallelFrameDecodingThreads ();
+
+      if (numOfThreads == 0)
+        {
+          numOfThreads = std::max (std::thread::hardware_concurrency (), 1u);
+        }
+
+      /// there are no more frames to decode at a time than carriers
+      numOfThreads = std::min (numOfThreads, (uint32_t) parallelCarriers.size ());
+
+      m_parallelFrameDecoder = CreateObject<SatParallelFrameDecoder> (numOfThreads);
+
+      for (uint32_t i = 0; i < parallelCarriers.size (); i++)
+        {
+          m_parallelFrameDecoder->AddCarrier (parallelCarriers[i]);
+        }
+
+      m_parallelFrameDecoder->BeginFrameEndScheduling (m_nodeId);
     }
 }
 
@@ -377,18 +427,18 @@ SatPhyRx::GetBeamId () const
 }
 
 void
-SatPhyRx::StartRx (Ptr<SatSignalParameters> rxParams)
+SatPhyRx::StartRx (const SatSignalBurst::rxRecord_s& rxRecord)
 {
-  NS_LOG_FUNCTION (this << rxParams);
+  NS_LOG_FUNCTION (this << rxRecord.burst);
 
-  uint32_t cId = rxParams->m_carrierId;
+  uint32_t cId = rxRecord.burst->GetTxParams ()->m_carrierId;
 
   if (cId >= m_rxCarriers.size ())
     {
       NS_FATAL_ERROR ("SatPhyRx::StartRx - unvalid carrier id: " << cId);
     }
 
-  m_rxCarriers[cId]->StartRx (rxParams);
+  m_rxCarriers[cId]->StartRx (rxRecord);
 }
 
 } // namespace ns3
@@ -38,6 +38,7 @@ class SatPhyRxCarrier;
 class SatPhyRxCarrierPerSlot;
 class SatPhyRxCarrierPerFrame;
 class SatPhyRxCarrierUplink;
+class SatParallelFrameDecoder;
 
 /**
  * \ingroup satellite
@@ -151,9 +152,9 @@ public:
 
   /**
    * Start packet reception from the SatChannel
-   * \param rxParams The needed parameters for the received signal
+   * \param rxRecord Per-receiver record of the received burst
    */
-  void StartRx (Ptr<SatSignalParameters> rxParams);
+  void StartRx (const SatSignalBurst::rxRecord_s& rxRecord);
 
   /**
    * \param SatSignalParameters containing e.g. the received packet
@@ -247,6 +248,16 @@ private:
    * \brief Default fading value
    */
   double m_defaultFadingValue;
+
+  /**
+   * \brief Decoder of the CRDSA frames of the carriers decoded in parallel
+   */
+  Ptr<SatParallelFrameDecoder> m_parallelFrameDecoder;
+
+  /**
+   * \brief Id of the node of the receiver
+   */
+  uint32_t m_nodeId;
 };
 
 
@@ -144,11 +144,8 @@ SatQueue::Enqueue (Ptr<Packet> p)
     {
       NS_LOG_INFO ("Queue full (at max packets) -- dropping pkt");
 
-      std::stringstream msg;
-      msg << "SatQueue is full: packet dropped!";
-      msg << " at: " << Now ().GetSeconds () << "s";
-      msg << " MaxPackets: " << m_maxPackets;
-      Singleton<SatLog>::Get ()->AddToLog (SatLog::LOG_WARNING, "", msg.str ());
+      Singleton<SatLog>::Get ()->AddToLog (SatLog::LOG_WARNING, SatLog::FMT_QUEUE_FULL,
+                                           Now ().GetSeconds (), m_maxPackets);
 
       Drop (p);
       return false;
@@ -51,6 +51,15 @@ public:
    */
   void Initialize (Ptr<SatSuperframeSeq> seq);
 
+  /**
+   * \brief Get the superframe sequence
+   * \return Superframe sequence, NULL if not initialized
+   */
+  inline Ptr<SatSuperframeSeq> GetSuperframeSeq () const
+  {
+    return m_superframeSeq;
+  }
+
   /**
    * \brief Get superframe duration of a superframe sequence
    * \param superFrameSeqId Superframe sequence id
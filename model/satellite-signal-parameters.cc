@@ -81,7 +81,7 @@ SatSignalParameters::SatSignalParameters ( const SatSignalParameters& p )
 }
 
 Ptr<SatSignalParameters>
-SatSignalParameters::Copy ()
+SatSignalParameters::Copy () const
 {
   NS_LOG_FUNCTION (this);
 
@@ -98,5 +98,27 @@ SatSignalParameters::GetTypeId (void)
   return tid;
 }
 
+SatSignalBurst::SatSignalBurst (Ptr<SatSignalParameters> txParams)
+  : m_txParams (txParams->Copy ()),
+    m_numOfRxCopies (0)
+{
+  NS_LOG_FUNCTION (this << txParams);
+}
+
+Ptr<SatSignalParameters>
+SatSignalBurst::CreateRxParams (const rxRecord_s& rxRecord) const
+{
+  NS_LOG_FUNCTION (this);
+
+  Ptr<SatSignalParameters> rxParams = m_txParams->Copy ();
+  rxParams->m_channelType = rxRecord.channelType;
+  rxParams->m_carrierFreq_hz = rxRecord.carrierFreq_hz;
+  rxParams->m_rxPower_W = rxRecord.rxPower_W;
+
+  m_numOfRxCopies++;
+
+  return rxParams;
+}
+
 
 } // namespace ns3
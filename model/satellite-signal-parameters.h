@@ -25,6 +25,7 @@
 #include "ns3/packet.h"
 #include "ns3/nstime.h"
 #include "ns3/object.h"
+#include "ns3/simple-ref-count.h"
 #include "satellite-enums.h"
 
 namespace ns3 {
@@ -70,7 +71,12 @@ public:
    */
   SatSignalParameters (const SatSignalParameters& p);
 
-  Ptr<SatSignalParameters> Copy ();
+  /**
+   * \brief Create a copy of the signal parameters. The packets in burst
+   * are deep copied.
+   * \return Copy of the signal parameters
+   */
+  Ptr<SatSignalParameters> Copy () const;
 
   /**
    * \brief Get the type ID
@@ -175,6 +181,76 @@ public:
   Callback<double, double> m_sinrCalculate;
 };
 
+/**
+* \ingroup satellite
+* \brief Burst of a transmission, shared by all the receivers of the transmission
+* in SatChannel. The burst is created once per transmission from a copy of the signal
+* parameters of the transmitter, so the transmitter may modify its own packets right
+* after the transmission, and it is never modified afterwards. Most of the receivers
+* see the burst only as interference and need only the small per-receiver record
+* rxRecord_s. Only the receivers decoding the burst create their own signal
+* parameters, with their own copies of the packets, with CreateRxParams.
+*/
+class SatSignalBurst : public SimpleRefCount<SatSignalBurst>
+{
+public:
+  /**
+   * \brief Struct for storing the per-receiver values of a burst calculated
+   * by the channel
+   */
+  typedef struct
+  {
+    Ptr<const SatSignalBurst> burst;
+    SatEnums::ChannelType_t channelType;
+    double carrierFreq_hz;
+    double rxPower_W;
+  } rxRecord_s;
+
+  /**
+   * Constructor
+   * \param txParams Signal parameters of the transmitter
+   */
+  SatSignalBurst (Ptr<SatSignalParameters> txParams);
+
+  /**
+   * \brief Get the transmission parameters of the burst.
+   * \return Immutable transmission parameters including the packets in burst
+   */
+  inline Ptr<const SatSignalParameters> GetTxParams () const
+  {
+    return m_txParams;
+  }
+
+  /**
+   * \brief Create the signal parameters of a receiver decoding the burst. The
+   * packets in burst are deep copied, so that the receiver may modify them.
+   * \param rxRecord Per-receiver record of the burst
+   * \return Signal parameters of the receiver
+   */
+  Ptr<SatSignalParameters> CreateRxParams (const rxRecord_s& rxRecord) const;
+
+  /**
+   * \brief Get the number of receivers which have copied the packets in burst
+   * \return Number of receivers decoding the burst
+   */
+  inline uint32_t GetNumOfRxCopies () const
+  {
+    return m_numOfRxCopies;
+  }
+
+private:
+  /**
+   * Transmission parameters of the burst, never modified after the construction
+   */
+  Ptr<const SatSignalParameters> m_txParams;
+
+  /**
+   * Number of receivers which have copied the packets in burst, only for
+   * bookkeeping and thus not part of the immutable burst
+   */
+  mutable uint32_t m_numOfRxCopies;
+};
+
 
 }  // namespace ns3
 
@@ -0,0 +1,450 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Jani Puttonen <jani.puttonen@magister.fi>
+ */
+
+#include <algorithm>
+#include <limits>
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+#include "ns3/nstime.h"
+#include "satellite-slot-synchronous-interference.h"
+#include "ns3/singleton.h"
+
+NS_LOG_COMPONENT_DEFINE ("SatSlotSynchronousInterference");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (SatSlotSynchronousInterference);
+
+TypeId
+SatSlotSynchronousInterference::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::SatSlotSynchronousInterference")
+    .SetParent<SatInterference> ()
+    .AddConstructor<SatSlotSynchronousInterference> ()
+    .AddAttribute ("SlotTimingTolerance",
+                   "Maximum difference between the start of a burst and the start of its time slot.",
+                   TimeValue (MicroSeconds (1)),
+                   MakeTimeAccessor (&SatSlotSynchronousInterference::m_slotTimingTolerance),
+                   MakeTimeChecker ());
+
+  return tid;
+}
+
+TypeId
+SatSlotSynchronousInterference::GetInstanceTypeId (void) const
+{
+  NS_LOG_FUNCTION (this);
+
+  return GetTypeId ();
+}
+
+SatSlotSynchronousInterference::SatSlotSynchronousInterference ()
+  : m_slotConfs (),
+    m_superframeDuration (),
+    m_slotTimingTolerance (MicroSeconds (1)),
+    m_nextEventId (0),
+    m_enableTraceOutput (false),
+    m_channelType (),
+    m_rxBandwidth_Hz ()
+{
+  NS_LOG_FUNCTION (this);
+
+  m_exactInterference = CreateObject<SatPerPacketTimelineInterference> ();
+}
+
+SatSlotSynchronousInterference::SatSlotSynchronousInterference (SatEnums::ChannelType_t channelType, double rxBandwidthHz)
+  : m_slotConfs (),
+    m_superframeDuration (),
+    m_slotTimingTolerance (MicroSeconds (1)),
+    m_nextEventId (0),
+    m_enableTraceOutput (true),
+    m_channelType (channelType),
+    m_rxBandwidth_Hz (rxBandwidthHz)
+{
+  NS_LOG_FUNCTION (this << channelType << rxBandwidthHz);
+
+  m_exactInterference = CreateObject<SatPerPacketTimelineInterference> ();
+
+  if (m_rxBandwidth_Hz <= std::numeric_limits<double>::epsilon ())
+    {
+      NS_FATAL_ERROR ("SatSlotSynchronousInterference::SatSlotSynchronousInterference - Invalid value");
+    }
+}
+
+SatSlotSynchronousInterference::~SatSlotSynchronousInterference ()
+{
+  NS_LOG_FUNCTION (this);
+
+  Reset ();
+}
+
+void
+SatSlotSynchronousInterference::SetSuperframeConf (Ptr<SatSuperframeConf> superframeConf, uint32_t carrierId)
+{
+  NS_LOG_FUNCTION (this << superframeConf << carrierId);
+
+  // find the frame of the carrier
+  uint32_t frameCarrierId = carrierId;
+  uint8_t frameId = 0;
+
+  while ( frameId < superframeConf->GetFrameCount ()
+          && frameCarrierId >= superframeConf->GetFrameConf (frameId)->GetCarrierCount () )
+    {
+      frameCarrierId -= superframeConf->GetFrameConf (frameId)->GetCarrierCount ();
+      frameId++;
+    }
+
+  if ( frameId >= superframeConf->GetFrameCount () )
+    {
+      NS_FATAL_ERROR ("Carrier " << carrierId << " not found from superframe configuration!!!");
+    }
+
+  Ptr<SatFrameConf> frameConf = superframeConf->GetFrameConf (frameId);
+  SatFrameConf::SatTimeSlotConfContainer_t timeSlotConfs = frameConf->GetTimeSlotConfs (frameCarrierId);
+
+  std::vector< std::pair<Time, Time> > slots;
+
+  for (SatFrameConf::SatTimeSlotConfContainer_t::const_iterator it = timeSlotConfs.begin (); it != timeSlotConfs.end (); ++it)
+    {
+      Ptr<SatWaveform> waveform = frameConf->GetWaveformConf ()->GetWaveform ((*it)->GetWaveFormId ());
+      Time duration = waveform->GetBurstDuration (frameConf->GetBtuConf ()->GetSymbolRateInBauds ());
+
+      slots.push_back (std::make_pair ((*it)->GetStartTime (), duration));
+    }
+
+  SetSlots (superframeConf->GetDuration (), slots);
+}
+
+void
+SatSlotSynchronousInterference::SetSlots (Time superframeDuration, const std::vector< std::pair<Time, Time> >& slots)
+{
+  NS_LOG_FUNCTION (this << superframeDuration << slots.size ());
+
+  if ( !superframeDuration.IsStrictlyPositive () )
+    {
+      NS_FATAL_ERROR ("SatSlotSynchronousInterference::SetSlots - Invalid superframe duration");
+    }
+
+  m_superframeDuration = superframeDuration;
+  m_slotConfs.clear ();
+
+  for (uint32_t i = 0; i < slots.size (); ++i)
+    {
+      SlotConf_t slotConf;
+      slotConf.m_startTime = slots[i].first;
+      slotConf.m_duration = slots[i].second;
+      slotConf.m_index = i;
+
+      m_slotConfs.push_back (slotConf);
+    }
+
+  // slots are searched by start time
+  std::sort (m_slotConfs.begin (), m_slotConfs.end (), SlotConfStartsBefore);
+}
+
+bool
+SatSlotSynchronousInterference::GetSlotKey (Time startTime, Time duration, SlotKey_t& key, Time& endTime) const
+{
+  NS_LOG_FUNCTION (this << startTime << duration);
+
+  if (m_slotConfs.empty ())
+    {
+      return false;
+    }
+
+  // a burst starting just before the superframe belongs to its first slot
+  int64_t superframeCount = (startTime + m_slotTimingTolerance).GetTimeStep () / m_superframeDuration.GetTimeStep ();
+  Time superframeStart = TimeStep (superframeCount * m_superframeDuration.GetTimeStep ());
+  Time offset = startTime - superframeStart;
+
+  // the first slot starting after the earliest matching start time
+  SlotConf_t earliest;
+  earliest.m_startTime = offset - m_slotTimingTolerance;
+
+  std::vector<SlotConf_t>::const_iterator it = std::lower_bound (m_slotConfs.begin (), m_slotConfs.end (), earliest, SlotConfStartsBefore);
+
+  if ( it == m_slotConfs.end ()
+       || it->m_startTime > offset + m_slotTimingTolerance
+       || duration > it->m_duration + m_slotTimingTolerance )
+    {
+      return false;
+    }
+
+  key = std::make_pair (static_cast<uint32_t> (superframeCount), it->m_index);
+  endTime = superframeStart + it->m_startTime + it->m_duration;
+
+  return true;
+}
+
+bool
+SatSlotSynchronousInterference::SlotConfStartsBefore (const SlotConf_t& a, const SlotConf_t& b)
+{
+  return a.m_startTime < b.m_startTime;
+}
+
+Ptr<SatInterference::InterferenceChangeEvent>
+SatSlotSynchronousInterference::DoAdd (Time duration, double power, Address rxAddress)
+{
+  NS_LOG_FUNCTION (this << duration << power << rxAddress );
+
+  Ptr<SatInterference::InterferenceChangeEvent> event;
+  event = Create<SatInterference::InterferenceChangeEvent> (m_nextEventId++, duration, power, rxAddress);
+  Time now = event->GetStartTime ();
+
+  RemoveEndedSlots (now);
+
+  // the bursts outside the slots are interfered by all the bursts
+  Ptr<SatInterference::InterferenceChangeEvent> exactEvent = m_exactInterference->Add (duration, power, rxAddress);
+
+  SlotKey_t key;
+  Time endTime;
+
+  if ( !GetSlotKey (now, duration, key, endTime) )
+    {
+      NS_LOG_INFO ( "Add burst outside slots: Duration= " << duration << ", Power= " << power << ", Time: " << now );
+
+      ExactBurst_t exactBurst;
+      exactBurst.m_exactEvent = exactEvent;
+      exactBurst.m_rxOngoing = false;
+
+      m_exactBursts.insert (std::make_pair (event->GetId (), exactBurst));
+
+      return event;
+    }
+
+  SlotContainer_t::iterator slot = m_slots.find (key);
+
+  if (slot == m_slots.end ())
+    {
+      SlotBursts_t newSlot;
+      newSlot.m_endTime = endTime;
+      newSlot.m_calculated = false;
+      newSlot.m_rxOngoing = 0;
+
+      slot = m_slots.insert (std::make_pair (key, newSlot)).first;
+    }
+
+  NS_LOG_INFO ( "Add burst: Duration= " << duration << ", Power= " << power << ", Time: " << now <<
+                ", Superframe: " << key.first << ", Slot: " << key.second << ", Bursts in slot: " << slot->second.m_eventIds.size () );
+
+  m_eventSlots.insert (std::make_pair (event->GetId (), std::make_pair (key, slot->second.m_eventIds.size ())));
+
+  slot->second.m_eventIds.push_back (event->GetId ());
+  slot->second.m_rxPowersW.push_back (power);
+  slot->second.m_calculated = false;
+
+  return event;
+}
+
+double
+SatSlotSynchronousInterference::DoCalculate (Ptr<SatInterference::InterferenceChangeEvent> event)
+{
+  NS_LOG_FUNCTION (this);
+
+  double ifPowerW = 0.0;
+
+  std::map<uint32_t, ExactBurst_t>::const_iterator exactBurst = m_exactBursts.find (event->GetId ());
+
+  if ( exactBurst != m_exactBursts.end () )
+    {
+      ifPowerW = m_exactInterference->Calculate (exactBurst->second.m_exactEvent);
+
+      NS_LOG_INFO ( "Calculate: IfPower (W)= " << ifPowerW << ", burst outside slots" );
+    }
+  else
+    {
+      std::map<uint32_t, std::pair<SlotKey_t, uint32_t> >::const_iterator eventSlot = m_eventSlots.find (event->GetId ());
+
+      if ( eventSlot == m_eventSlots.end () )
+        {
+          NS_FATAL_ERROR ("Event not found from slots!!!");
+        }
+
+      SlotContainer_t::iterator slotIt = m_slots.find (eventSlot->second.first);
+      NS_ASSERT (slotIt != m_slots.end ());
+      SlotBursts_t& slot = slotIt->second;
+
+      if (!slot.m_calculated)
+        {
+          CalculateSlot (slot);
+        }
+
+      ifPowerW = slot.m_ifPowersW[eventSlot->second.second];
+
+      NS_LOG_INFO ( "Calculate: IfPower (W)= " << ifPowerW << ", Superframe: " << eventSlot->second.first.first <<
+                    ", Slot: " << eventSlot->second.first.second << ", Bursts in slot: " << slot.m_eventIds.size () );
+    }
+
+  if (m_enableTraceOutput)
+    {
+      std::vector<double> tempVector;
+      tempVector.push_back (Now ().GetSeconds ());
+      tempVector.push_back (ifPowerW / m_rxBandwidth_Hz);
+      Singleton<SatInterferenceOutputTraceContainer>::Get ()->AddToContainer (std::make_pair (event->GetSatEarthStationAddress (), m_channelType), tempVector);
+    }
+
+  return ifPowerW;
+}
+
+void
+SatSlotSynchronousInterference::CalculateSlot (SlotBursts_t& slot) const
+{
+  NS_LOG_FUNCTION (this);
+
+  long double totalPowerW = 0.0;
+
+  for (std::vector<double>::const_iterator it = slot.m_rxPowersW.begin (); it != slot.m_rxPowersW.end (); ++it)
+    {
+      totalPowerW += *it;
+    }
+
+  slot.m_ifPowersW.resize (slot.m_rxPowersW.size ());
+
+  for (uint32_t i = 0; i < slot.m_rxPowersW.size (); i++)
+    {
+      slot.m_ifPowersW[i] = std::max<double> (0.0, totalPowerW - slot.m_rxPowersW[i]);
+    }
+
+  slot.m_calculated = true;
+}
+
+void
+SatSlotSynchronousInterference::RemoveEndedSlots (Time now)
+{
+  NS_LOG_FUNCTION (this << now);
+
+  SlotContainer_t::iterator slot = m_slots.begin ();
+
+  while ( slot != m_slots.end ()
+          && slot->second.m_endTime < now
+          && slot->second.m_rxOngoing == 0 )
+    {
+      for (std::vector<uint32_t>::const_iterator it = slot->second.m_eventIds.begin (); it != slot->second.m_eventIds.end (); ++it)
+        {
+          m_eventSlots.erase (*it);
+        }
+
+      m_slots.erase (slot++);
+    }
+
+  // event IDs grow with the start times, thus the first bursts end first for the most part
+  std::map<uint32_t, ExactBurst_t>::iterator exactBurst = m_exactBursts.begin ();
+
+  while ( exactBurst != m_exactBursts.end ()
+          && exactBurst->second.m_exactEvent->GetEndTime () < now
+          && !exactBurst->second.m_rxOngoing )
+    {
+      m_exactBursts.erase (exactBurst++);
+    }
+}
+
+SatSlotSynchronousInterference::SlotContainer_t::iterator
+SatSlotSynchronousInterference::GetSlot (Ptr<SatInterference::InterferenceChangeEvent> event)
+{
+  NS_LOG_FUNCTION (this);
+
+  std::map<uint32_t, std::pair<SlotKey_t, uint32_t> >::const_iterator eventSlot = m_eventSlots.find (event->GetId ());
+
+  if ( eventSlot == m_eventSlots.end () )
+    {
+      NS_FATAL_ERROR ("Event not found from slots!!!");
+    }
+
+  return m_slots.find (eventSlot->second.first);
+}
+
+void
+SatSlotSynchronousInterference::DoReset (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  m_slots.clear ();
+  m_eventSlots.clear ();
+  m_exactBursts.clear ();
+
+  if (m_exactInterference)
+    {
+      m_exactInterference->Reset ();
+    }
+}
+
+void
+SatSlotSynchronousInterference::DoNotifyRxStart (Ptr<SatInterference::InterferenceChangeEvent> event)
+{
+  NS_LOG_FUNCTION (this);
+
+  std::map<uint32_t, ExactBurst_t>::iterator exactBurst = m_exactBursts.find (event->GetId ());
+
+  if ( exactBurst != m_exactBursts.end () )
+    {
+      exactBurst->second.m_rxOngoing = true;
+      m_exactInterference->NotifyRxStart (exactBurst->second.m_exactEvent);
+      return;
+    }
+
+  GetSlot (event)->second.m_rxOngoing++;
+}
+
+void
+SatSlotSynchronousInterference::DoNotifyRxEnd (Ptr<SatInterference::InterferenceChangeEvent> event)
+{
+  NS_LOG_FUNCTION (this);
+
+  std::map<uint32_t, ExactBurst_t>::iterator exactBurst = m_exactBursts.find (event->GetId ());
+
+  if ( exactBurst != m_exactBursts.end () )
+    {
+      exactBurst->second.m_rxOngoing = false;
+      m_exactInterference->NotifyRxEnd (exactBurst->second.m_exactEvent);
+      return;
+    }
+
+  SlotContainer_t::iterator slot = GetSlot (event);
+
+  NS_ASSERT (slot->second.m_rxOngoing > 0);
+  slot->second.m_rxOngoing--;
+}
+
+void
+SatSlotSynchronousInterference::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+
+  m_exactInterference->Dispose ();
+  m_exactInterference = 0;
+
+  SatInterference::DoDispose ();
+}
+
+void
+SatSlotSynchronousInterference::SetRxBandwidth (double rxBandwidth)
+{
+  NS_LOG_FUNCTION (this << rxBandwidth);
+
+  if (rxBandwidth <= std::numeric_limits<double>::epsilon ())
+    {
+      NS_FATAL_ERROR ("SatSlotSynchronousInterference::SetRxBandwidth - Invalid value");
+    }
+
+  m_rxBandwidth_Hz = rxBandwidth;
+}
+
+}
+// namespace ns3
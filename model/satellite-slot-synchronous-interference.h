@@ -0,0 +1,309 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Jani Puttonen <jani.puttonen@magister.fi>
+ */
+
+#ifndef SATELLITE_SLOT_SYNCHRONOUS_INTERFERENCE_H
+#define SATELLITE_SLOT_SYNCHRONOUS_INTERFERENCE_H
+
+#include <map>
+#include <vector>
+#include "ns3/nstime.h"
+#include "satellite-interference.h"
+#include "satellite-interference-output-trace-container.h"
+#include "satellite-per-packet-timeline-interference.h"
+#include "satellite-frame-conf.h"
+#include "satellite-enums.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup satellite
+ * \brief Slot synchronous interference for slot aligned MF-TDMA return link.
+ *
+ * Bursts received on the carrier are collected into the time slots of the
+ * configured superframe. A burst belongs to a slot, if it starts at the
+ * start of the slot within the slot timing tolerance and fits into the slot.
+ * The slots are identified by the superframe count and the index of the
+ * time slot in the carrier of the superframe configuration. All bursts of a
+ * slot are considered fully overlapping, so interference of each burst is
+ * the sum of the power of the other bursts in the same slot. Interference is
+ * calculated once for the whole slot, when the first burst of the slot is
+ * calculated.
+ *
+ * The bursts, which do not fit into a slot, e.g. when no superframe is
+ * configured or the bursts are received with a propagation delay different
+ * from the one of the superframe timing, get their interference from the
+ * exact SatPerPacketTimelineInterference model over all the bursts.
+ *
+ * The model is an approximation of SatPerPacketInterference, which is exact
+ * when the bursts of the co-channel beams are aligned to the same time
+ * slots. Partial overlap of the bursts outside the slots with the bursts
+ * of a slot is neglected for the bursts of the slot.
+ */
+class SatSlotSynchronousInterference : public SatInterference
+{
+public:
+  /**
+   * Derived from Object
+   * \return TypeId of the class
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * Derived from Object
+   * \return TypeId of the instance
+   */
+  TypeId GetInstanceTypeId (void) const;
+
+  /**
+   * Default constructor. Interference output trace is disabled.
+   */
+  SatSlotSynchronousInterference ();
+
+  /**
+   * Constructor enabling interference output trace.
+   * \param channelType Channel type of the receiver
+   * \param rxBandwidthHz Receiver bandwidth in Hertz
+   */
+  SatSlotSynchronousInterference (SatEnums::ChannelType_t channelType, double rxBandwidthHz);
+
+  /**
+   * Destructor
+   */
+  ~SatSlotSynchronousInterference ();
+
+  /**
+   * Dispose of this class instance
+   */
+  void DoDispose ();
+
+  /**
+   * Set receiver bandwidth used for the output trace.
+   * \param rxBandwidth Receiver bandwidth in Hertz
+   */
+  void SetRxBandwidth (double rxBandwidth);
+
+  /**
+   * Set the time slots of the model from a superframe configuration.
+   * \param superframeConf Superframe configuration
+   * \param carrierId Id of the carrier within the superframe
+   */
+  void SetSuperframeConf (Ptr<SatSuperframeConf> superframeConf, uint32_t carrierId);
+
+  /**
+   * Set the time slots of the model.
+   * \param superframeDuration Duration of the superframe
+   * \param slots Start times within the superframe and durations of the time
+   * slots in the order of the time slot indices
+   */
+  void SetSlots (Time superframeDuration, const std::vector< std::pair<Time, Time> >& slots);
+
+private:
+  /**
+   * \brief Bursts received within one slot.
+   */
+  typedef struct
+  {
+    Time m_endTime;                   // end time of the slot
+    std::vector<uint32_t> m_eventIds; // interference event IDs of the bursts
+    std::vector<double> m_rxPowersW;  // receive powers of the bursts
+    std::vector<double> m_ifPowersW;  // calculated interference of the bursts
+    bool m_calculated;                // flag telling whether m_ifPowersW is up to date
+    uint32_t m_rxOngoing;             // number of bursts being received
+  } SlotBursts_t;
+
+  /**
+   * \brief Key of a slot: superframe count and time slot index.
+   */
+  typedef std::pair<uint32_t, uint32_t> SlotKey_t;
+
+  /**
+   * \brief Container of slots by superframe count and time slot index.
+   */
+  typedef std::map<SlotKey_t, SlotBursts_t> SlotContainer_t;
+
+  /**
+   * \brief Time slot of the superframe.
+   */
+  typedef struct
+  {
+    Time m_startTime;  // start time within the superframe
+    Time m_duration;   // duration of the slot
+    uint32_t m_index;  // index of the time slot
+  } SlotConf_t;
+
+  /**
+   * \brief Burst outside the slots with its event of the exact model.
+   */
+  typedef struct
+  {
+    Ptr<SatInterference::InterferenceChangeEvent> m_exactEvent; // event of the exact model
+    bool m_rxOngoing;                                           // flag telling whether the burst is being received
+  } ExactBurst_t;
+
+  /**
+   * Adds interference power to interference object.
+   *
+   * \param rxDuration Duration of the receiving.
+   * \param rxPower Receiving power.
+   * \param rxAddress Address of the transmitting earth station
+   *
+   * \return the pointer to interference event as a reference of the addition
+   */
+  virtual Ptr<SatInterference::InterferenceChangeEvent> DoAdd (Time rxDuration, double rxPower, Address rxAddress);
+
+  /**
+   * Calculates interference power for the given reference
+   *
+   * \param event Reference event which for interference is calculated.
+   *
+   * \return Interference power of the slot of the event
+   */
+  virtual double DoCalculate (Ptr<SatInterference::InterferenceChangeEvent> event);
+
+  /**
+   * Resets current interference.
+   */
+  virtual void DoReset (void);
+
+  /**
+   * Notifies that RX is started by a receiver.
+   *
+   * \param event Interference reference event of receiver
+   */
+  virtual void DoNotifyRxStart (Ptr<SatInterference::InterferenceChangeEvent> event);
+
+  /**
+   * Notifies that RX is ended by a receiver.
+   *
+   * \param event Interference reference event of receiver
+   */
+  virtual void DoNotifyRxEnd (Ptr<SatInterference::InterferenceChangeEvent> event);
+
+  /**
+   * Calculate interference for all the bursts of the slot.
+   * \param slot Slot to calculate
+   */
+  void CalculateSlot (SlotBursts_t& slot) const;
+
+  /**
+   * Remove ended slots and bursts outside the slots, which have no bursts
+   * being received.
+   * \param now Current simulation time
+   */
+  void RemoveEndedSlots (Time now);
+
+  /**
+   * Get the slot of a burst.
+   * \param startTime Start time of the burst
+   * \param duration Duration of the burst
+   * \param key Key of the slot
+   * \param endTime End time of the slot
+   * \return true if the burst fits into a slot
+   */
+  bool GetSlotKey (Time startTime, Time duration, SlotKey_t& key, Time& endTime) const;
+
+  /**
+   * Compare the start times of two time slots.
+   * \param a First time slot
+   * \param b Second time slot
+   * \return true if the first time slot starts before the second one
+   */
+  static bool SlotConfStartsBefore (const SlotConf_t& a, const SlotConf_t& b);
+
+  /**
+   * Get the slot of the given interference event.
+   * \param event Interference event
+   * \return Iterator to the slot of the event
+   */
+  SlotContainer_t::iterator GetSlot (Ptr<SatInterference::InterferenceChangeEvent> event);
+
+  /**
+   * Copy constructor (not used)
+   * \param o Object to copy
+   */
+  SatSlotSynchronousInterference (const SatSlotSynchronousInterference &o);
+
+  /**
+   * Assignment operator (not used)
+   * \param o Object to assign
+   * \return Assigned object
+   */
+  SatSlotSynchronousInterference &operator = (const SatSlotSynchronousInterference &o);
+
+  /**
+   * \brief Slots in start time order
+   */
+  SlotContainer_t m_slots;
+
+  /**
+   * \brief Slot key and index within the slot by event ID
+   */
+  std::map<uint32_t, std::pair<SlotKey_t, uint32_t> > m_eventSlots;
+
+  /**
+   * \brief Time slots of the superframe in start time order
+   */
+  std::vector<SlotConf_t> m_slotConfs;
+
+  /**
+   * \brief Duration of the superframe, zero if no slots are set
+   */
+  Time m_superframeDuration;
+
+  /**
+   * \brief Maximum difference between the start of a burst and the start of
+   * its slot
+   */
+  Time m_slotTimingTolerance;
+
+  /**
+   * \brief Exact interference model for the bursts outside the slots
+   */
+  Ptr<SatPerPacketTimelineInterference> m_exactInterference;
+
+  /**
+   * \brief Bursts outside the slots by event ID
+   */
+  std::map<uint32_t, ExactBurst_t> m_exactBursts;
+
+  /**
+   * \brief event id for Events
+   */
+  uint32_t m_nextEventId;
+
+  /**
+   * \brief Flag to indicate whether the interference output trace is enabled
+   */
+  bool m_enableTraceOutput;
+
+  /**
+   * \brief Channel type of the receiver
+   */
+  SatEnums::ChannelType_t m_channelType;
+
+  /**
+   * \brief RX Bandwidth in Hz
+   */
+  double m_rxBandwidth_Hz;
+};
+
+} // namespace ns3
+
+#endif /* SATELLITE_SLOT_SYNCHRONOUS_INTERFERENCE_H */
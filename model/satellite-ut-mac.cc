@@ -614,10 +614,8 @@ SatUtMac::ReceiveSignalingPacket (Ptr<Packet> packet)
              * SatBeamHelper::CtrlMsgStoreTimeInFwdLink attribute may be set to too short value
              * or there are something wrong in the FWD link RRM.
              */
-            std::stringstream msg;
-            msg << "Control message " << ctrlTag.GetMsgType () << " is not found from the FWD link control msg container!";
-            msg << " at: " << Now ().GetSeconds () << "s";
-            Singleton<SatLog>::Get ()->AddToLog (SatLog::LOG_WARNING, "", msg.str ());
+            Singleton<SatLog>::Get ()->AddToLog (SatLog::LOG_WARNING, SatLog::FMT_CTRL_MSG_NOT_FOUND,
+                                                 ctrlTag.GetMsgType (), "FWD", Now ().GetSeconds ());
           }
 
         break;
@@ -0,0 +1,495 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Budiarto Herman <budiarto.herman@magister.fi>
+ *
+ */
+
+#include <ns3/log.h>
+#include <ns3/double.h>
+#include <ns3/uinteger.h>
+#include <ns3/simulator.h>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include "satellite-stats-accumulator.h"
+
+NS_LOG_COMPONENT_DEFINE ("SatStatsAccumulator");
+
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (SatStatsAccumulator);
+
+const uint32_t SatStatsAccumulator::INVALID_SLOT;
+
+/// Percentiles written in the quantile output.
+static const double g_satStatsQuantiles[] = { 0.5, 0.95, 0.99, 0.999 };
+static const uint32_t g_satStatsNumOfQuantiles = sizeof (g_satStatsQuantiles) / sizeof (double);
+
+SatStatsAccumulator::SatStatsAccumulator ()
+  : m_outputType (SatStatsAccumulator::OUTPUT_AVERAGE),
+    m_averagingMode (false),
+    m_averagePerSecond (false),
+    m_startTime (Seconds (0.0)),
+    m_isWritten (false),
+    m_minValue (0.0),
+    m_maxValue (1.0),
+    m_binLength (0.02),
+    m_numOfBins (0),
+    m_relativeAccuracy (0.01),
+    m_maxBuckets (2048),
+    m_windowLength (Seconds (60.0)),
+    m_windowStart (Seconds (0.0))
+{
+  NS_LOG_FUNCTION (this);
+}
+
+
+SatStatsAccumulator::~SatStatsAccumulator ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+
+TypeId // static
+SatStatsAccumulator::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::SatStatsAccumulator")
+    .SetParent<Object> ()
+    .AddConstructor<SatStatsAccumulator> ()
+    .AddAttribute ("MinValue",
+                   "Lower bound of the first histogram bin.",
+                   DoubleValue (0.0),
+                   MakeDoubleAccessor (&SatStatsAccumulator::m_minValue),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("MaxValue",
+                   "Upper bound of the last histogram bin.",
+                   DoubleValue (1.0),
+                   MakeDoubleAccessor (&SatStatsAccumulator::m_maxValue),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("BinLength",
+                   "Width of each histogram bin.",
+                   DoubleValue (0.02),
+                   MakeDoubleAccessor (&SatStatsAccumulator::m_binLength),
+                   MakeDoubleChecker<double> (0.0))
+    .AddAttribute ("QuantileRelativeAccuracy",
+                   "Relative accuracy of the quantile sketches.",
+                   DoubleValue (0.01),
+                   MakeDoubleAccessor (&SatStatsAccumulator::m_relativeAccuracy),
+                   MakeDoubleChecker<double> (0.0, 1.0))
+    .AddAttribute ("QuantileMaxBuckets",
+                   "Maximum number of buckets per sign in each quantile sketch.",
+                   UintegerValue (2048),
+                   MakeUintegerAccessor (&SatStatsAccumulator::m_maxBuckets),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("WindowLength",
+                   "Interval between the snapshots of the windowed output.",
+                   TimeValue (Seconds (60.0)),
+                   MakeTimeAccessor (&SatStatsAccumulator::m_windowLength),
+                   MakeTimeChecker ())
+  ;
+  return tid;
+}
+
+
+void
+SatStatsAccumulator::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+  Simulator::Cancel (m_windowEvent);
+  Object::DoDispose ();
+}
+
+
+void
+SatStatsAccumulator::Configure (OutputType_t outputType,
+                                bool averagingMode,
+                                bool averagePerSecond,
+                                std::string outputFileName,
+                                std::string heading)
+{
+  NS_LOG_FUNCTION (this << outputType << averagingMode << averagePerSecond << outputFileName);
+  NS_ASSERT_MSG (m_identifiers.empty (),
+                 "The accumulator has to be configured before adding identifiers");
+  NS_ASSERT_MSG (m_maxValue > m_minValue && m_binLength > 0.0,
+                 "Invalid histogram bins");
+
+  NS_ASSERT_MSG (!averagePerSecond || averagingMode
+                 || outputType == OUTPUT_AVERAGE || outputType == OUTPUT_WINDOWED,
+                 "Averages per second require the average or windowed output or averaging mode");
+
+  m_outputType = outputType;
+  m_averagingMode = averagingMode;
+  m_averagePerSecond = averagePerSecond;
+  m_startTime = Simulator::Now ();
+  m_outputFileName = outputFileName;
+  m_heading = heading;
+  m_numOfBins = (outputType == OUTPUT_AVERAGE || outputType == OUTPUT_QUANTILE
+                 || outputType == OUTPUT_WINDOWED) ? 0
+    : static_cast<uint32_t> (std::ceil ((m_maxValue - m_minValue) / m_binLength));
+
+  if (m_averagingMode)
+    {
+      NS_ASSERT_MSG (m_numOfBins > 0,
+                     "Averaging mode requires a histogram, PDF, or CDF output");
+      m_bins.assign (m_numOfBins, 0);
+    }
+
+  if (m_outputType == OUTPUT_WINDOWED)
+    {
+      NS_ASSERT_MSG (!m_averagingMode,
+                     "Averaging mode is not supported by the windowed output");
+      NS_ASSERT_MSG (m_windowLength.IsStrictlyPositive (),
+                     "Invalid window length " << m_windowLength.GetSeconds ());
+      m_windowStream.open ((m_outputFileName + ".txt").c_str ());
+      m_windowStream << m_heading << std::endl;
+      m_windowStart = m_startTime;
+    }
+
+  // The output is written when Simulator::Destroy() is invoked.
+  Simulator::ScheduleDestroy (&SatStatsAccumulator::WriteToFile,
+                              Ptr<SatStatsAccumulator> (this));
+}
+
+
+void
+SatStatsAccumulator::AddIdentifier (uint32_t identifier)
+{
+  NS_LOG_FUNCTION (this << identifier);
+
+  if (identifier >= m_slots.size ())
+    {
+      m_slots.resize (identifier + 1, INVALID_SLOT);
+    }
+
+  if (m_slots[identifier] == INVALID_SLOT)
+    {
+      m_slots[identifier] = m_identifiers.size ();
+      m_identifiers.push_back (identifier);
+      m_counts.push_back (0);
+      m_sums.push_back (0.0);
+
+      if (m_outputType == OUTPUT_QUANTILE
+          || (m_outputType == OUTPUT_WINDOWED && !m_averagePerSecond))
+        {
+          m_sketches.push_back (SatStatsQuantileSketch (m_relativeAccuracy, m_maxBuckets));
+        }
+
+      if (m_outputType == OUTPUT_WINDOWED)
+        {
+          if (!m_averagePerSecond)
+            {
+              m_minimums.push_back (std::numeric_limits<double>::infinity ());
+              m_maximums.push_back (-std::numeric_limits<double>::infinity ());
+            }
+        }
+      else if (!m_averagingMode)
+        {
+          m_bins.resize (m_bins.size () + m_numOfBins, 0);
+        }
+    }
+}
+
+
+uint32_t
+SatStatsAccumulator::GetNIdentifiers () const
+{
+  return m_identifiers.size ();
+}
+
+
+void // static
+SatStatsAccumulator::TraceSinkDouble (Ptr<SatStatsAccumulator> accumulator,
+                                      uint32_t identifier,
+                                      double oldValue,
+                                      double newValue)
+{
+  accumulator->AddSample (identifier, newValue);
+}
+
+
+void // static
+SatStatsAccumulator::TraceSinkUinteger32 (Ptr<SatStatsAccumulator> accumulator,
+                                          uint32_t identifier,
+                                          uint32_t oldValue,
+                                          uint32_t newValue)
+{
+  accumulator->AddSample (identifier, newValue);
+}
+
+
+void
+SatStatsAccumulator::WriteToFile ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_isWritten)
+    {
+      return;
+    }
+
+  m_isWritten = true;
+
+  // Output the identifiers in ascending order, as the collector map does.
+  m_identifiers.sort ();
+
+  if (m_outputType == OUTPUT_WINDOWED)
+    {
+      // The last, possibly incomplete window.
+      Simulator::Cancel (m_windowEvent);
+      WriteWindow ((Simulator::Now () - m_windowStart).GetSeconds ());
+      m_windowStream.close ();
+    }
+  else if (m_outputType == OUTPUT_AVERAGE)
+    {
+      std::ofstream ofs ((m_outputFileName + ".txt").c_str ());
+      ofs << m_heading << std::endl;
+
+      for (std::list<uint32_t>::const_iterator it = m_identifiers.begin ();
+           it != m_identifiers.end (); ++it)
+        {
+          ofs << *it << " " << GetAverage (m_slots[*it]) << std::endl;
+        }
+    }
+  else if (m_outputType == OUTPUT_QUANTILE)
+    {
+      std::ofstream ofs ((m_outputFileName + ".txt").c_str ());
+      std::ofstream sketchOfs ((m_outputFileName + "-sketch.txt").c_str ());
+      ofs << m_heading << std::endl;
+      sketchOfs << m_heading << std::endl;
+
+      for (std::list<uint32_t>::const_iterator it = m_identifiers.begin ();
+           it != m_identifiers.end (); ++it)
+        {
+          const SatStatsQuantileSketch &sketch = m_sketches[m_slots[*it]];
+          ofs << *it << " " << sketch.GetCount ();
+
+          for (uint32_t i = 0; i < g_satStatsNumOfQuantiles; i++)
+            {
+              ofs << " " << sketch.GetQuantile (g_satStatsQuantiles[i]);
+            }
+
+          ofs << std::endl;
+
+          sketchOfs << *it << " ";
+          sketch.Print (sketchOfs);
+          sketchOfs << std::endl;
+        }
+    }
+  else if (m_averagingMode)
+    {
+      // The average of each identifier is a sample of a single distribution.
+      for (uint32_t slot = 0; slot < m_counts.size (); slot++)
+        {
+          m_bins[GetBin (GetAverage (slot))]++;
+        }
+
+      WriteDistribution (m_outputFileName + ".txt", &m_bins[0], m_counts.size ());
+    }
+  else
+    {
+      for (std::list<uint32_t>::const_iterator it = m_identifiers.begin ();
+           it != m_identifiers.end (); ++it)
+        {
+          const uint32_t slot = m_slots[*it];
+          std::ostringstream fileName;
+          fileName << m_outputFileName << "-" << *it << ".txt";
+          WriteDistribution (fileName.str (), &m_bins[slot * m_numOfBins], m_counts[slot]);
+        }
+    }
+
+} // end of `void WriteToFile ()`
+
+
+std::string // static
+SatStatsAccumulator::GetQuantileHeading (std::string dataLabel)
+{
+  std::ostringstream heading;
+  heading << "samples";
+
+  for (uint32_t i = 0; i < g_satStatsNumOfQuantiles; i++)
+    {
+      heading << " " << dataLabel << "_p" << g_satStatsQuantiles[i] * 100.0;
+    }
+
+  return heading.str ();
+}
+
+
+std::string // static
+SatStatsAccumulator::GetWindowedHeading (std::string dataLabel,
+                                         bool averagePerSecond)
+{
+  std::ostringstream heading;
+  heading << "time_sec samples " << dataLabel;
+
+  if (averagePerSecond)
+    {
+      return heading.str ();
+    }
+
+  heading << "_mean " << dataLabel << "_min " << dataLabel << "_max";
+
+  for (uint32_t i = 0; i < g_satStatsNumOfQuantiles; i++)
+    {
+      heading << " " << dataLabel << "_p" << g_satStatsQuantiles[i] * 100.0;
+    }
+
+  return heading.str ();
+}
+
+
+void
+SatStatsAccumulator::ScheduleWindowEnd ()
+{
+  NS_LOG_FUNCTION (this);
+
+  // The windows are aligned to the configuration time, also after windows
+  // without any samples.
+  const int64_t windowIndex = (Simulator::Now () - m_startTime).GetTimeStep ()
+    / m_windowLength.GetTimeStep ();
+  m_windowStart = m_startTime + TimeStep (windowIndex * m_windowLength.GetTimeStep ());
+  m_windowEvent = Simulator::Schedule (m_windowStart + m_windowLength - Simulator::Now (),
+                                       &SatStatsAccumulator::EndWindow,
+                                       Ptr<SatStatsAccumulator> (this));
+}
+
+
+void
+SatStatsAccumulator::EndWindow ()
+{
+  NS_LOG_FUNCTION (this);
+
+  // The end of the next window is scheduled by its first sample.
+  WriteWindow (m_windowLength.GetSeconds ());
+}
+
+
+void
+SatStatsAccumulator::WriteWindow (double duration)
+{
+  NS_LOG_FUNCTION (this << duration);
+
+  const double now = Simulator::Now ().GetSeconds ();
+  m_identifiers.sort ();
+
+  for (std::list<uint32_t>::const_iterator it = m_identifiers.begin ();
+       it != m_identifiers.end (); ++it)
+    {
+      const uint32_t slot = m_slots[*it];
+
+      if (m_counts[slot] == 0)
+        {
+          continue;
+        }
+
+      m_windowStream << *it << " " << now << " " << m_counts[slot];
+
+      if (m_averagePerSecond)
+        {
+          m_windowStream << " " << ((duration > 0.0) ? m_sums[slot] / duration : 0.0)
+                         << std::endl;
+          m_counts[slot] = 0;
+          m_sums[slot] = 0.0;
+          continue;
+        }
+
+      const SatStatsQuantileSketch &sketch = m_sketches[slot];
+      m_windowStream << " " << m_sums[slot] / m_counts[slot]
+                     << " " << m_minimums[slot] << " " << m_maximums[slot];
+
+      for (uint32_t i = 0; i < g_satStatsNumOfQuantiles; i++)
+        {
+          m_windowStream << " " << sketch.GetQuantile (g_satStatsQuantiles[i]);
+        }
+
+      m_windowStream << std::endl;
+      ResetWindow (slot);
+    }
+
+} // end of `void WriteWindow (double)`
+
+
+void
+SatStatsAccumulator::ResetWindow (uint32_t slot)
+{
+  m_counts[slot] = 0;
+  m_sums[slot] = 0.0;
+  m_sketches[slot] = SatStatsQuantileSketch (m_relativeAccuracy, m_maxBuckets);
+  m_minimums[slot] = std::numeric_limits<double>::infinity ();
+  m_maximums[slot] = -std::numeric_limits<double>::infinity ();
+}
+
+
+double
+SatStatsAccumulator::GetAverage (uint32_t slot) const
+{
+  if (m_averagePerSecond)
+    {
+      const double duration = (Simulator::Now () - m_startTime).GetSeconds ();
+      return (duration > 0.0) ? m_sums[slot] / duration : 0.0;
+    }
+
+  return (m_counts[slot] > 0) ? m_sums[slot] / m_counts[slot] : 0.0;
+}
+
+
+void
+SatStatsAccumulator::WriteDistribution (std::string fileName,
+                                        const uint64_t *bins,
+                                        uint64_t count) const
+{
+  NS_LOG_FUNCTION (this << fileName << count);
+
+  std::ofstream ofs (fileName.c_str ());
+  ofs << m_heading << std::endl;
+
+  uint64_t cumulative = 0;
+
+  for (uint32_t i = 0; i < m_numOfBins; i++)
+    {
+      const double binCenter = m_minValue + (i + 0.5) * m_binLength;
+      cumulative += bins[i];
+
+      switch (m_outputType)
+        {
+        case OUTPUT_HISTOGRAM:
+          ofs << binCenter << " " << bins[i] << std::endl;
+          break;
+
+        case OUTPUT_PROBABILITY:
+          ofs << binCenter << " "
+              << ((count > 0) ? static_cast<double> (bins[i]) / count : 0.0) << std::endl;
+          break;
+
+        case OUTPUT_CUMULATIVE:
+          ofs << binCenter << " "
+              << ((count > 0) ? static_cast<double> (cumulative) / count : 0.0) << std::endl;
+          break;
+
+        default:
+          NS_FATAL_ERROR ("SatStatsAccumulator - Invalid output type");
+          break;
+        }
+    }
+
+} // end of `void WriteDistribution (std::string, const uint64_t *, uint64_t)`
+
+
+} // end of namespace ns3
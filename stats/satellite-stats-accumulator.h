@@ -0,0 +1,326 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Budiarto Herman <budiarto.herman@magister.fi>
+ *
+ */
+
+#ifndef SATELLITE_STATS_ACCUMULATOR_H
+#define SATELLITE_STATS_ACCUMULATOR_H
+
+#include <ns3/object.h>
+#include <ns3/ptr.h>
+#include <ns3/nstime.h>
+#include <ns3/event-id.h>
+#include <ns3/satellite-stats-quantile-sketch.h>
+#include <fstream>
+#include <list>
+#include <string>
+#include <vector>
+
+
+namespace ns3 {
+
+
+/**
+ * \ingroup satstats
+ * \brief Lightweight per-identifier accumulator of statistics samples.
+ *
+ * Replaces the chain of per-identifier collectors and a file aggregator when
+ * only the final values are needed, i.e. with the scalar, histogram, PDF, and
+ * CDF file output types. Each identifier occupies a slot in flat arrays of
+ * sample counts, sums, and histogram bins, which are updated directly by
+ * AddSample(). The accumulated values are written into the output files when
+ * the simulation is destroyed.
+ *
+ * The histogram bins are configured with the `MinValue`, `MaxValue`, and
+ * `BinLength` attributes. Samples outside the range are counted into the
+ * first or the last bin.
+ *
+ * With the quantile output, each identifier has a SatStatsQuantileSketch
+ * instead of histogram bins. The output file has the number of samples and
+ * the 50th, 95th, 99th, and 99.9th percentiles of each identifier. The state
+ * of the sketches is written into a separate `-sketch.txt` file, so that the
+ * sketches of several simulation replications can be merged afterwards with
+ * ext-utils/mergeQuantileSketches.py.
+ *
+ * With the windowed output, a snapshot of each identifier is written into the
+ * output file at the end of every window of `WindowLength`, after which the
+ * accumulated values are reset. A snapshot has the number of samples, their
+ * mean, minimum, maximum, and the same percentiles as in the quantile output.
+ * With averages per second, a snapshot has the number of samples and their
+ * sum divided by the length of the window instead. Identifiers without
+ * samples in the window are omitted. The memory usage and the size of the
+ * output file thus do not depend on the number of samples, which suits long
+ * simulations.
+ *
+ * The windows are aligned to the configuration time. The end of a window is
+ * scheduled only when the first sample of the window arrives, so the
+ * accumulator does not keep the simulator event queue busy after the samples
+ * have stopped.
+ */
+class SatStatsAccumulator : public Object
+{
+public:
+  /**
+   * \enum OutputType_t
+   * \brief Output produced from the accumulated samples.
+   */
+  typedef enum
+  {
+    OUTPUT_AVERAGE = 0,     ///< average of samples, one line per identifier
+    OUTPUT_HISTOGRAM,       ///< number of samples per bin, one file per identifier
+    OUTPUT_PROBABILITY,     ///< probability per bin, one file per identifier
+    OUTPUT_CUMULATIVE,      ///< cumulative probability per bin, one file per identifier
+    OUTPUT_QUANTILE,        ///< percentiles of samples, one line per identifier
+    OUTPUT_WINDOWED         ///< periodic snapshots, one line per identifier and window
+  } OutputType_t;
+
+  /**
+   * \brief Creates a new accumulator instance.
+   */
+  SatStatsAccumulator ();
+
+  /**
+   * / Destructor.
+   */
+  virtual ~SatStatsAccumulator ();
+
+  /**
+   * inherited from ObjectBase base class
+   */
+  static TypeId GetTypeId ();
+
+  /**
+   * \brief Configure the accumulator. Has to be invoked before adding the
+   *        identifiers.
+   * \param outputType the output produced from the samples.
+   * \param averagingMode if true, the averages of the identifiers are used as
+   *                      the samples of a single distribution output.
+   * \param averagePerSecond if true, the average of an identifier is the sum
+   *                         of its samples divided by the simulation time
+   *                         elapsed since the configuration, or by the length
+   *                         of the window with the windowed output, instead
+   *                         of the number of samples.
+   * \param outputFileName path and file name of the output, without extension.
+   * \param heading the first line of each output file.
+   */
+  void Configure (OutputType_t outputType,
+                  bool averagingMode,
+                  bool averagePerSecond,
+                  std::string outputFileName,
+                  std::string heading);
+
+  /**
+   * \brief Reserve a slot for an identifier.
+   * \param identifier the identifier.
+   */
+  void AddIdentifier (uint32_t identifier);
+
+  /**
+   * \return number of identifiers added to the accumulator.
+   */
+  uint32_t GetNIdentifiers () const;
+
+  /**
+   * \brief Accumulate a sample to the slot of an identifier. Samples of
+   *        unknown identifiers are discarded.
+   * \param identifier the identifier.
+   * \param value the sample value.
+   */
+  inline void AddSample (uint32_t identifier, double value)
+  {
+    if (identifier < m_slots.size () && m_slots[identifier] != INVALID_SLOT)
+      {
+        const uint32_t slot = m_slots[identifier];
+        m_counts[slot]++;
+        m_sums[slot] += value;
+
+        if (!m_bins.empty () && !m_averagingMode)
+          {
+            m_bins[slot * m_numOfBins + GetBin (value)]++;
+          }
+        else if (!m_sketches.empty ())
+          {
+            m_sketches[slot].Add (value);
+
+            if (!m_minimums.empty ())
+              {
+                if (value < m_minimums[slot])
+                  {
+                    m_minimums[slot] = value;
+                  }
+                if (value > m_maximums[slot])
+                  {
+                    m_maximums[slot] = value;
+                  }
+              }
+          }
+
+        if (m_outputType == OUTPUT_WINDOWED && !m_windowEvent.IsRunning ())
+          {
+            ScheduleWindowEnd ();
+          }
+      }
+  }
+
+  /**
+   * \brief Trace sink for probes with a double-typed output.
+   * \param accumulator the accumulator.
+   * \param identifier the identifier of the probe.
+   * \param oldValue unused.
+   * \param newValue the sample value.
+   */
+  static void TraceSinkDouble (Ptr<SatStatsAccumulator> accumulator,
+                               uint32_t identifier,
+                               double oldValue,
+                               double newValue);
+
+  /**
+   * \brief Trace sink for probes with an unsigned integer-typed output.
+   * \param accumulator the accumulator.
+   * \param identifier the identifier of the probe.
+   * \param oldValue unused.
+   * \param newValue the sample value.
+   */
+  static void TraceSinkUinteger32 (Ptr<SatStatsAccumulator> accumulator,
+                                   uint32_t identifier,
+                                   uint32_t oldValue,
+                                   uint32_t newValue);
+
+  /**
+   * \brief Write the accumulated values into the output files. Invoked
+   *        automatically when the simulation is destroyed.
+   */
+  void WriteToFile ();
+
+  /**
+   * \param dataLabel the short name of the main data of the statistics.
+   * \return the labels of the columns of the quantile output.
+   */
+  static std::string GetQuantileHeading (std::string dataLabel);
+
+  /**
+   * \param dataLabel the short name of the main data of the statistics.
+   * \param averagePerSecond if true, the windowed output has averages per
+   *                         second instead of sample statistics.
+   * \return the labels of the columns of the windowed output, following the
+   *         identifier column.
+   */
+  static std::string GetWindowedHeading (std::string dataLabel,
+                                         bool averagePerSecond);
+
+protected:
+  // inherited from Object base class
+  virtual void DoDispose ();
+
+private:
+  /**
+   * \brief Schedule the end of the window of the current simulation time.
+   */
+  void ScheduleWindowEnd ();
+
+  /**
+   * \brief Write the snapshots of the window which has just ended.
+   */
+  void EndWindow ();
+
+  /**
+   * \brief Write a snapshot of every identifier with samples into the windowed
+   *        output and reset the accumulated values.
+   * \param duration the length of the window in seconds, used by the
+   *                 averages per second.
+   */
+  void WriteWindow (double duration);
+
+  /**
+   * \brief Reset the accumulated values of a slot of the windowed output.
+   * \param slot the slot.
+   */
+  void ResetWindow (uint32_t slot);
+
+  /**
+   * \param slot the slot.
+   * \return the average of the samples of the slot, or zero without samples.
+   */
+  double GetAverage (uint32_t slot) const;
+
+  /**
+   * \param value the sample value.
+   * \return index of the histogram bin of the value.
+   */
+  inline uint32_t GetBin (double value) const
+  {
+    if (value <= m_minValue)
+      {
+        return 0;
+      }
+
+    const uint32_t bin = static_cast<uint32_t> ((value - m_minValue) / m_binLength);
+    return (bin < m_numOfBins) ? bin : m_numOfBins - 1;
+  }
+
+  /**
+   * \brief Write the bins of one distribution into a file.
+   * \param fileName path and file name of the output file.
+   * \param bins the first histogram bin of the distribution.
+   * \param count the total number of samples in the distribution.
+   */
+  void WriteDistribution (std::string fileName,
+                          const uint64_t *bins,
+                          uint64_t count) const;
+
+  /// Slot value of identifiers without a slot.
+  static const uint32_t INVALID_SLOT = 0xFFFFFFFF;
+
+  OutputType_t           m_outputType;      ///< Output produced from the samples.
+  bool                   m_averagingMode;   ///< Distribution of the averages of the identifiers.
+  bool                   m_averagePerSecond; ///< Averages are sums per second.
+  Time                   m_startTime;       ///< Start time of the averages per second.
+  std::string            m_outputFileName;  ///< Path and file name without extension.
+  std::string            m_heading;         ///< The first line of each output file.
+  bool                   m_isWritten;       ///< True after the output has been written.
+
+  double                 m_minValue;        ///< Lower bound of the first bin.
+  double                 m_maxValue;        ///< Upper bound of the last bin.
+  double                 m_binLength;       ///< Width of a bin.
+  uint32_t               m_numOfBins;       ///< Number of bins per distribution.
+
+  double                 m_relativeAccuracy; ///< Relative accuracy of the quantile sketches.
+  uint32_t               m_maxBuckets;      ///< Maximum number of buckets per quantile sketch.
+
+  Time                   m_windowLength;    ///< Length of a window of the windowed output.
+  std::ofstream          m_windowStream;    ///< Output file of the windowed output.
+  Time                   m_windowStart;     ///< Start time of the current window.
+  EventId                m_windowEvent;     ///< End of the current window.
+
+  std::vector<uint32_t>  m_slots;           ///< Slot of each identifier, indexed by identifier.
+  std::list<uint32_t>    m_identifiers;     ///< Identifiers in the order they were added.
+  std::vector<uint64_t>  m_counts;          ///< Number of samples per slot.
+  std::vector<double>    m_sums;            ///< Sum of samples per slot.
+  std::vector<uint64_t>  m_bins;            ///< Histogram bins, m_numOfBins per slot.
+  std::vector<SatStatsQuantileSketch> m_sketches; ///< Quantile sketch per slot.
+  std::vector<double>    m_minimums;        ///< Smallest sample per slot in the window.
+  std::vector<double>    m_maximums;        ///< Largest sample per slot in the window.
+
+}; // end of class SatStatsAccumulator
+
+
+} // end of namespace ns3
+
+
+#endif /* SATELLITE_STATS_ACCUMULATOR_H */
@@ -46,6 +46,7 @@
 #include <ns3/scalar-collector.h>
 #include <ns3/multi-file-aggregator.h>
 #include <ns3/magister-gnuplot-aggregator.h>
+#include <ns3/satellite-stats-accumulator.h>
 
 #include <sstream>
 #include "satellite-stats-composite-sinr-helper.h"
@@ -85,6 +86,15 @@ SatStatsCompositeSinrHelper::DoInstall ()
 {
   NS_LOG_FUNCTION (this);
 
+  // Accumulate the samples natively instead of collectors, when possible.
+  m_accumulator = CreateAccumulator ("sinr_db", false, false);
+
+  if (m_accumulator != 0)
+    {
+      InstallProbes ();
+      return;
+    }
+
   switch (GetOutputType ())
     {
     case SatStatsHelper::OUTPUT_NONE:
@@ -330,41 +340,52 @@ SatStatsFwdCompositeSinrHelper::DoInstallProbes ()
             {
               // Connect the probe to the right collector.
               bool ret = false;
-              switch (GetOutputType ())
+
+              if (m_accumulator != 0)
                 {
-                case SatStatsHelper::OUTPUT_SCALAR_FILE:
-                case SatStatsHelper::OUTPUT_SCALAR_PLOT:
-                  ret = m_terminalCollectors.ConnectWithProbe (probe->GetObject<Probe> (),
-                                                               "OutputSinr",
-                                                               identifier,
-                                                               &ScalarCollector::TraceSinkDouble);
-                  break;
-
-                case SatStatsHelper::OUTPUT_SCATTER_FILE:
-                case SatStatsHelper::OUTPUT_SCATTER_PLOT:
-                  ret = m_terminalCollectors.ConnectWithProbe (probe->GetObject<Probe> (),
-                                                               "OutputSinr",
-                                                               identifier,
-                                                               &UnitConversionCollector::TraceSinkDouble);
-                  break;
-
-                case SatStatsHelper::OUTPUT_HISTOGRAM_FILE:
-                case SatStatsHelper::OUTPUT_HISTOGRAM_PLOT:
-                case SatStatsHelper::OUTPUT_PDF_FILE:
-                case SatStatsHelper::OUTPUT_PDF_PLOT:
-                case SatStatsHelper::OUTPUT_CDF_FILE:
-                case SatStatsHelper::OUTPUT_CDF_PLOT:
-                  ret = m_terminalCollectors.ConnectWithProbe (probe->GetObject<Probe> (),
-                                                               "OutputSinr",
-                                                               identifier,
-                                                               &DistributionCollector::TraceSinkDouble);
-                  break;
-
-                default:
-                  NS_FATAL_ERROR (GetOutputTypeName (GetOutputType ()) << " is not a valid output type for this statistics.");
-                  break;
-
-                } // end of `switch (GetOutputType ())`
+                  ret = probe->TraceConnectWithoutContext ("OutputSinr",
+                                                           MakeBoundCallback (&SatStatsAccumulator::TraceSinkDouble,
+                                                                              m_accumulator,
+                                                                              identifier));
+                }
+              else
+                {
+                  switch (GetOutputType ())
+                    {
+                    case SatStatsHelper::OUTPUT_SCALAR_FILE:
+                    case SatStatsHelper::OUTPUT_SCALAR_PLOT:
+                      ret = m_terminalCollectors.ConnectWithProbe (probe->GetObject<Probe> (),
+                                                                   "OutputSinr",
+                                                                   identifier,
+                                                                   &ScalarCollector::TraceSinkDouble);
+                      break;
+
+                    case SatStatsHelper::OUTPUT_SCATTER_FILE:
+                    case SatStatsHelper::OUTPUT_SCATTER_PLOT:
+                      ret = m_terminalCollectors.ConnectWithProbe (probe->GetObject<Probe> (),
+                                                                   "OutputSinr",
+                                                                   identifier,
+                                                                   &UnitConversionCollector::TraceSinkDouble);
+                      break;
+
+                    case SatStatsHelper::OUTPUT_HISTOGRAM_FILE:
+                    case SatStatsHelper::OUTPUT_HISTOGRAM_PLOT:
+                    case SatStatsHelper::OUTPUT_PDF_FILE:
+                    case SatStatsHelper::OUTPUT_PDF_PLOT:
+                    case SatStatsHelper::OUTPUT_CDF_FILE:
+                    case SatStatsHelper::OUTPUT_CDF_PLOT:
+                      ret = m_terminalCollectors.ConnectWithProbe (probe->GetObject<Probe> (),
+                                                                   "OutputSinr",
+                                                                   identifier,
+                                                                   &DistributionCollector::TraceSinkDouble);
+                      break;
+
+                    default:
+                      NS_FATAL_ERROR (GetOutputTypeName (GetOutputType ()) << " is not a valid output type for this statistics.");
+                      break;
+
+                    } // end of `switch (GetOutputType ())`
+                }
 
               if (ret)
                 {
@@ -502,20 +523,24 @@ SatStatsRtnCompositeSinrHelper::SinrCallback (double sinrDb, const Address &from
   else
     {
       // Determine the identifier associated with the sender address.
-      std::map<const Address, uint32_t>::const_iterator it = m_identifierMap.find (from);
+      uint32_t identifier;
 
-      if (it == m_identifierMap.end ())
+      if (!m_identifierMap.Find (from, identifier))
         {
           NS_LOG_WARN (this << " discarding a SINR trace of " << sinrDb << " dB"
                             << " from statistics collection because of"
                             << " unknown sender address " << from);
         }
+      else if (m_accumulator != 0)
+        {
+          m_accumulator->AddSample (identifier, sinrDb);
+        }
       else
         {
           // Find the collector with the right identifier.
-          Ptr<DataCollectionObject> collector = m_terminalCollectors.Get (it->second);
+          Ptr<DataCollectionObject> collector = m_terminalCollectors.Get (identifier);
           NS_ASSERT_MSG (collector != 0,
-                         "Unable to find collector with identifier " << it->second);
+                         "Unable to find collector with identifier " << identifier);
 
           switch (GetOutputType ())
             {
@@ -556,7 +581,7 @@ SatStatsRtnCompositeSinrHelper::SinrCallback (double sinrDb, const Address &from
 
             } // end of `switch (GetOutputType ())`
 
-        } // end of `if (it == m_identifierMap.end ())`
+        } // end of `if (!m_identifierMap.Find (from, identifier))`
 
     } // end of else of `if (from.IsInvalid ())`
 
@@ -579,7 +604,7 @@ SatStatsRtnCompositeSinrHelper::SaveAddressAndIdentifier (Ptr<Node> utNode)
   else
     {
       const uint32_t identifier = GetIdentifierForUt (utNode);
-      m_identifierMap[addr] = identifier;
+      m_identifierMap.Insert (addr, identifier);
       NS_LOG_INFO (this << " associated address " << addr
                         << " with identifier " << identifier);
     }
@@ -23,6 +23,7 @@
 #define SATELLITE_STATS_COMPOSITE_SINR_HELPER_H
 
 #include <ns3/satellite-stats-helper.h>
+#include <ns3/satellite-stats-identifier-map.h>
 #include <ns3/ptr.h>
 #include <ns3/address.h>
 #include <ns3/collector-map.h>
@@ -38,6 +39,7 @@ namespace ns3 {
 class SatHelper;
 class Node;
 class DataCollectionObject;
+class SatStatsAccumulator;
 
 /**
  * \ingroup satstats
@@ -82,6 +84,9 @@ protected:
   /// The aggregator created by this helper.
   Ptr<DataCollectionObject> m_aggregator;
 
+  /// The native accumulator used instead of collectors and the aggregator.
+  Ptr<SatStatsAccumulator> m_accumulator;
+
 }; // end of class SatStatsCompositeSinrHelper
 
 
@@ -198,7 +203,7 @@ private:
   void SaveAddressAndIdentifier (Ptr<Node> utNode);
 
   /// Map of address and the identifier associated with it (for return link).
-  std::map<const Address, uint32_t> m_identifierMap;
+  SatStatsIdentifierMap m_identifierMap;
 
 }; // end of class SatStatsRtnCompositeSinrHelper
 
@@ -50,6 +50,7 @@
 #include <ns3/multi-file-aggregator.h>
 #include <ns3/magister-gnuplot-aggregator.h>
 #include <ns3/traffic-time-tag.h>
+#include <ns3/satellite-stats-accumulator.h>
 
 #include <sstream>
 #include "satellite-stats-delay-helper.h"
@@ -112,6 +113,15 @@ SatStatsDelayHelper::DoInstall ()
 {
   NS_LOG_FUNCTION (this);
 
+  // Accumulate the samples natively instead of collectors, when possible.
+  m_accumulator = CreateAccumulator ("delay_sec", m_averagingMode, false);
+
+  if (m_accumulator != 0)
+    {
+      InstallProbes ();
+      return;
+    }
+
   switch (GetOutputType ())
     {
     case SatStatsHelper::OUTPUT_NONE:
@@ -415,11 +425,11 @@ SatStatsDelayHelper::RxDelayCallback (const Time &delay, const Address &from)
   else
     {
       // Determine the identifier associated with the sender address.
-      std::map<const Address, uint32_t>::const_iterator it = m_identifierMap.find (from);
+      uint32_t identifier;
 
-      if (it != m_identifierMap.end ())
+      if (m_identifierMap.Find (from, identifier))
         {
-          PassSampleToCollector (delay, it->second);
+          PassSampleToCollector (delay, identifier);
         }
       else
         {
@@ -447,7 +457,7 @@ SatStatsDelayHelper::SaveAddressAndIdentifier (Ptr<Node> utNode)
   else
     {
       const uint32_t identifier = GetIdentifierForUt (utNode);
-      m_identifierMap[addr] = identifier;
+      m_identifierMap.Insert (addr, identifier);
       NS_LOG_INFO (this << " associated address " << addr
                         << " with identifier " << identifier);
 
@@ -462,49 +472,60 @@ SatStatsDelayHelper::ConnectProbeToCollector (Ptr<Probe> probe,
   NS_LOG_FUNCTION (this << probe << probe->GetName () << identifier);
 
   bool ret = false;
-  switch (GetOutputType ())
-    {
-    case SatStatsHelper::OUTPUT_SCALAR_FILE:
-    case SatStatsHelper::OUTPUT_SCALAR_PLOT:
-      ret = m_terminalCollectors.ConnectWithProbe (probe,
-                                                   "OutputSeconds",
-                                                   identifier,
-                                                   &ScalarCollector::TraceSinkDouble);
-      break;
 
-    case SatStatsHelper::OUTPUT_SCATTER_FILE:
-    case SatStatsHelper::OUTPUT_SCATTER_PLOT:
-      ret = m_terminalCollectors.ConnectWithProbe (probe,
-                                                   "OutputSeconds",
-                                                   identifier,
-                                                   &UnitConversionCollector::TraceSinkDouble);
-      break;
-
-    case SatStatsHelper::OUTPUT_HISTOGRAM_FILE:
-    case SatStatsHelper::OUTPUT_HISTOGRAM_PLOT:
-    case SatStatsHelper::OUTPUT_PDF_FILE:
-    case SatStatsHelper::OUTPUT_PDF_PLOT:
-    case SatStatsHelper::OUTPUT_CDF_FILE:
-    case SatStatsHelper::OUTPUT_CDF_PLOT:
-      if (m_averagingMode)
+  if (m_accumulator != 0)
+    {
+      ret = probe->TraceConnectWithoutContext ("OutputSeconds",
+                                               MakeBoundCallback (&SatStatsAccumulator::TraceSinkDouble,
+                                                                  m_accumulator,
+                                                                  identifier));
+    }
+  else
+    {
+      switch (GetOutputType ())
         {
+        case SatStatsHelper::OUTPUT_SCALAR_FILE:
+        case SatStatsHelper::OUTPUT_SCALAR_PLOT:
           ret = m_terminalCollectors.ConnectWithProbe (probe,
                                                        "OutputSeconds",
                                                        identifier,
                                                        &ScalarCollector::TraceSinkDouble);
-        }
-      else
-        {
+          break;
+
+        case SatStatsHelper::OUTPUT_SCATTER_FILE:
+        case SatStatsHelper::OUTPUT_SCATTER_PLOT:
           ret = m_terminalCollectors.ConnectWithProbe (probe,
                                                        "OutputSeconds",
                                                        identifier,
-                                                       &DistributionCollector::TraceSinkDouble);
-        }
-      break;
+                                                       &UnitConversionCollector::TraceSinkDouble);
+          break;
+
+        case SatStatsHelper::OUTPUT_HISTOGRAM_FILE:
+        case SatStatsHelper::OUTPUT_HISTOGRAM_PLOT:
+        case SatStatsHelper::OUTPUT_PDF_FILE:
+        case SatStatsHelper::OUTPUT_PDF_PLOT:
+        case SatStatsHelper::OUTPUT_CDF_FILE:
+        case SatStatsHelper::OUTPUT_CDF_PLOT:
+          if (m_averagingMode)
+            {
+              ret = m_terminalCollectors.ConnectWithProbe (probe,
+                                                           "OutputSeconds",
+                                                           identifier,
+                                                           &ScalarCollector::TraceSinkDouble);
+            }
+          else
+            {
+              ret = m_terminalCollectors.ConnectWithProbe (probe,
+                                                           "OutputSeconds",
+                                                           identifier,
+                                                           &DistributionCollector::TraceSinkDouble);
+            }
+          break;
 
-    default:
-      NS_FATAL_ERROR (GetOutputTypeName (GetOutputType ()) << " is not a valid output type for this statistics.");
-      break;
+        default:
+          NS_FATAL_ERROR (GetOutputTypeName (GetOutputType ()) << " is not a valid output type for this statistics.");
+          break;
+        }
     }
 
   if (ret)
@@ -527,6 +548,12 @@ SatStatsDelayHelper::PassSampleToCollector (const Time &delay, uint32_t identifi
 {
   //NS_LOG_FUNCTION (this << delay.GetSeconds () << identifier);
 
+  if (m_accumulator != 0)
+    {
+      m_accumulator->AddSample (identifier, delay.GetSeconds ());
+      return;
+    }
+
   Ptr<DataCollectionObject> collector = m_terminalCollectors.Get (identifier);
   NS_ASSERT_MSG (collector != 0,
                  "Unable to find collector with identifier " << identifier);
@@ -1202,9 +1229,9 @@ SatStatsRtnAppDelayHelper::Ipv4Callback (const Time &delay, const Address &from)
     {
       // Determine the identifier associated with the sender address.
       const Address ipv4Addr = InetSocketAddress::ConvertFrom (from).GetIpv4 ();
-      std::map<const Address, uint32_t>::const_iterator it1 = m_identifierMap.find (ipv4Addr);
+      uint32_t identifier;
 
-      if (it1 == m_identifierMap.end ())
+      if (!m_identifierMap.Find (ipv4Addr, identifier))
         {
           NS_LOG_WARN (this << " discarding a packet delay of " << delay.GetSeconds ()
                             << " from statistics collection because of"
@@ -1212,7 +1239,7 @@ SatStatsRtnAppDelayHelper::Ipv4Callback (const Time &delay, const Address &from)
         }
       else
         {
-          PassSampleToCollector (delay, it1->second);
+          PassSampleToCollector (delay, identifier);
         }
     }
   else
@@ -1248,7 +1275,7 @@ SatStatsRtnAppDelayHelper::SaveIpv4AddressAndIdentifier (Ptr<Node> utUserNode)
       for (uint32_t i = 0; i < ipv4->GetNAddresses (1); i++)
         {
           const Address addr = ipv4->GetAddress (1, i).GetLocal ();
-          m_identifierMap[addr] = identifier;
+          m_identifierMap.Insert (addr, identifier);
           NS_LOG_INFO (this << " associated address " << addr
                             << " with identifier " << identifier);
         }
@@ -23,6 +23,7 @@
 #define SATELLITE_STATS_DELAY_HELPER_H
 
 #include <ns3/satellite-stats-helper.h>
+#include <ns3/satellite-stats-identifier-map.h>
 #include <ns3/ptr.h>
 #include <ns3/address.h>
 #include <ns3/collector-map.h>
@@ -40,6 +41,7 @@ class Node;
 class Time;
 class DataCollectionObject;
 class DistributionCollector;
+class SatStatsAccumulator;
 
 /**
  * \ingroup satstats
@@ -135,8 +137,11 @@ protected:
   /// The aggregator created by this helper.
   Ptr<DataCollectionObject> m_aggregator;
 
+  /// The native accumulator used instead of collectors and the aggregator.
+  Ptr<SatStatsAccumulator> m_accumulator;
+
   /// Map of address and the identifier associated with it (for return link).
-  std::map<const Address, uint32_t> m_identifierMap;
+  SatStatsIdentifierMap m_identifierMap;
 
 private:
   bool m_averagingMode;  ///< `AveragingMode` attribute.
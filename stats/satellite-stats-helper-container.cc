@@ -23,6 +23,7 @@
 #include <ns3/log.h>
 #include <ns3/enum.h>
 #include <ns3/string.h>
+#include <ns3/boolean.h>
 #include <ns3/satellite-helper.h>
 #include <ns3/satellite-stats-backlogged-request-helper.h>
 #include <ns3/satellite-stats-capacity-request-helper.h>
@@ -51,7 +52,8 @@ NS_OBJECT_ENSURE_REGISTERED (SatStatsHelperContainer);
 
 
 SatStatsHelperContainer::SatStatsHelperContainer (Ptr<const SatHelper> satHelper)
-  : m_satHelper (satHelper)
+  : m_satHelper (satHelper),
+    m_nativeAccumulators (false)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -100,6 +102,13 @@ SatStatsHelperContainer::DoDispose ()
                    SatStatsHelper::OUTPUT_SCATTER_FILE,   "SCATTER_FILE",     \
                    SatStatsHelper::OUTPUT_SCATTER_PLOT,   "SCATTER_PLOT"))
 
+#define ADD_SAT_STATS_WINDOWED_OUTPUT_CHECKER                                 \
+  MakeEnumChecker (SatStatsHelper::OUTPUT_NONE,           "NONE",             \
+                   SatStatsHelper::OUTPUT_SCALAR_FILE,    "SCALAR_FILE",      \
+                   SatStatsHelper::OUTPUT_SCATTER_FILE,   "SCATTER_FILE",     \
+                   SatStatsHelper::OUTPUT_WINDOWED_FILE,  "WINDOWED_FILE",    \
+                   SatStatsHelper::OUTPUT_SCATTER_PLOT,   "SCATTER_PLOT"))
+
 #define ADD_SAT_STATS_DISTRIBUTION_OUTPUT_CHECKER                             \
   MakeEnumChecker (SatStatsHelper::OUTPUT_NONE,           "NONE",             \
                    SatStatsHelper::OUTPUT_SCALAR_FILE,    "SCALAR_FILE",      \
@@ -112,6 +121,20 @@ SatStatsHelperContainer::DoDispose ()
                    SatStatsHelper::OUTPUT_PDF_PLOT,       "PDF_PLOT",         \
                    SatStatsHelper::OUTPUT_CDF_PLOT,       "CDF_PLOT"))
 
+#define ADD_SAT_STATS_QUANTILE_OUTPUT_CHECKER                                 \
+  MakeEnumChecker (SatStatsHelper::OUTPUT_NONE,           "NONE",             \
+                   SatStatsHelper::OUTPUT_SCALAR_FILE,    "SCALAR_FILE",      \
+                   SatStatsHelper::OUTPUT_SCATTER_FILE,   "SCATTER_FILE",     \
+                   SatStatsHelper::OUTPUT_HISTOGRAM_FILE, "HISTOGRAM_FILE",   \
+                   SatStatsHelper::OUTPUT_PDF_FILE,       "PDF_FILE",         \
+                   SatStatsHelper::OUTPUT_CDF_FILE,       "CDF_FILE",         \
+                   SatStatsHelper::OUTPUT_QUANTILE_FILE,  "QUANTILE_FILE",    \
+                   SatStatsHelper::OUTPUT_WINDOWED_FILE,  "WINDOWED_FILE",    \
+                   SatStatsHelper::OUTPUT_SCATTER_PLOT,   "SCATTER_PLOT",     \
+                   SatStatsHelper::OUTPUT_HISTOGRAM_PLOT, "HISTOGRAM_PLOT",   \
+                   SatStatsHelper::OUTPUT_PDF_PLOT,       "PDF_PLOT",         \
+                   SatStatsHelper::OUTPUT_CDF_PLOT,       "CDF_PLOT"))
+
 #define ADD_SAT_STATS_AVERAGED_DISTRIBUTION_OUTPUT_CHECKER                    \
   MakeEnumChecker (SatStatsHelper::OUTPUT_NONE,           "NONE",             \
                    SatStatsHelper::OUTPUT_HISTOGRAM_FILE, "HISTOGRAM_FILE",   \
@@ -141,6 +164,20 @@ SatStatsHelperContainer::DoDispose ()
                                 std::string ("per UT ") + desc)               \
   ADD_SAT_STATS_BASIC_OUTPUT_CHECKER
 
+#define ADD_SAT_STATS_ATTRIBUTES_WINDOWED_SET(id, desc)                       \
+  ADD_SAT_STATS_ATTRIBUTE_HEAD (Global ## id,                                 \
+                                std::string ("global ") + desc)               \
+  ADD_SAT_STATS_WINDOWED_OUTPUT_CHECKER                                       \
+  ADD_SAT_STATS_ATTRIBUTE_HEAD (PerGw ## id,                                  \
+                                std::string ("per GW ") + desc)               \
+  ADD_SAT_STATS_WINDOWED_OUTPUT_CHECKER                                       \
+  ADD_SAT_STATS_ATTRIBUTE_HEAD (PerBeam ## id,                                \
+                                std::string ("per beam ") + desc)             \
+  ADD_SAT_STATS_WINDOWED_OUTPUT_CHECKER                                       \
+  ADD_SAT_STATS_ATTRIBUTE_HEAD (PerUt ## id,                                  \
+                                std::string ("per UT ") + desc)               \
+  ADD_SAT_STATS_WINDOWED_OUTPUT_CHECKER
+
 #define ADD_SAT_STATS_ATTRIBUTES_DISTRIBUTION_SET(id, desc)                   \
   ADD_SAT_STATS_ATTRIBUTE_HEAD (Global ## id,                                 \
                                 std::string ("global ") + desc)               \
@@ -155,6 +192,20 @@ SatStatsHelperContainer::DoDispose ()
                                 std::string ("per UT ") + desc)               \
   ADD_SAT_STATS_DISTRIBUTION_OUTPUT_CHECKER
 
+#define ADD_SAT_STATS_ATTRIBUTES_QUANTILE_SET(id, desc)                       \
+  ADD_SAT_STATS_ATTRIBUTE_HEAD (Global ## id,                                 \
+                                std::string ("global ") + desc)               \
+  ADD_SAT_STATS_QUANTILE_OUTPUT_CHECKER                                       \
+  ADD_SAT_STATS_ATTRIBUTE_HEAD (PerGw ## id,                                  \
+                                std::string ("per GW ") + desc)               \
+  ADD_SAT_STATS_QUANTILE_OUTPUT_CHECKER                                       \
+  ADD_SAT_STATS_ATTRIBUTE_HEAD (PerBeam ## id,                                \
+                                std::string ("per beam ") + desc)             \
+  ADD_SAT_STATS_QUANTILE_OUTPUT_CHECKER                                       \
+  ADD_SAT_STATS_ATTRIBUTE_HEAD (PerUt ## id,                                  \
+                                std::string ("per UT ") + desc)               \
+  ADD_SAT_STATS_QUANTILE_OUTPUT_CHECKER
+
 #define ADD_SAT_STATS_ATTRIBUTES_AVERAGED_DISTRIBUTION_SET(id, desc)          \
   ADD_SAT_STATS_ATTRIBUTE_HEAD (AverageBeam ## id,                            \
                                 std::string ("average beam ") + desc)         \
@@ -175,13 +226,21 @@ SatStatsHelperContainer::GetTypeId ()
                    MakeStringAccessor (&SatStatsHelperContainer::SetName,
                                        &SatStatsHelperContainer::GetName),
                    MakeStringChecker ())
+    .AddAttribute ("EnableNativeAccumulators",
+                   "Accumulate the statistics directly into flat per-identifier "
+                   "arrays instead of a collector per identifier and an aggregator. "
+                   "Applies to the scalar, histogram, PDF, and CDF file outputs "
+                   "of the statistics supporting it; other outputs use collectors.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&SatStatsHelperContainer::m_nativeAccumulators),
+                   MakeBooleanChecker ())
 
     // Forward link application-level packet delay statistics.
-    ADD_SAT_STATS_ATTRIBUTES_DISTRIBUTION_SET (FwdAppDelay,
-                                               "forward link application-level delay statistics")
+    ADD_SAT_STATS_ATTRIBUTES_QUANTILE_SET (FwdAppDelay,
+                                           "forward link application-level delay statistics")
     ADD_SAT_STATS_ATTRIBUTE_HEAD (PerUtUserFwdAppDelay,
                                   "per UT user forward link application-level delay statistics")
-    ADD_SAT_STATS_DISTRIBUTION_OUTPUT_CHECKER
+    ADD_SAT_STATS_QUANTILE_OUTPUT_CHECKER
     ADD_SAT_STATS_ATTRIBUTES_AVERAGED_DISTRIBUTION_SET (FwdAppDelay,
                                                         "forward link application-level delay statistics")
     ADD_SAT_STATS_ATTRIBUTE_HEAD (AverageUtUserFwdAppDelay,
@@ -189,45 +248,45 @@ SatStatsHelperContainer::GetTypeId ()
     ADD_SAT_STATS_AVERAGED_DISTRIBUTION_OUTPUT_CHECKER
 
     // Forward link device-level packet delay statistics.
-    ADD_SAT_STATS_ATTRIBUTES_DISTRIBUTION_SET (FwdDevDelay,
-                                               "forward link device-level delay statistics")
+    ADD_SAT_STATS_ATTRIBUTES_QUANTILE_SET (FwdDevDelay,
+                                           "forward link device-level delay statistics")
     ADD_SAT_STATS_ATTRIBUTES_AVERAGED_DISTRIBUTION_SET (FwdDevDelay,
                                                         "forward link device-level delay statistics")
 
     // Forward link MAC-level packet delay statistics.
-    ADD_SAT_STATS_ATTRIBUTES_DISTRIBUTION_SET (FwdMacDelay,
-                                               "forward link MAC-level delay statistics")
+    ADD_SAT_STATS_ATTRIBUTES_QUANTILE_SET (FwdMacDelay,
+                                           "forward link MAC-level delay statistics")
     ADD_SAT_STATS_ATTRIBUTES_AVERAGED_DISTRIBUTION_SET (FwdMacDelay,
                                                         "forward link MAC-level delay statistics")
 
     // Forward link PHY-level packet delay statistics.
-    ADD_SAT_STATS_ATTRIBUTES_DISTRIBUTION_SET (FwdPhyDelay,
-                                               "forward link PHY-level delay statistics")
+    ADD_SAT_STATS_ATTRIBUTES_QUANTILE_SET (FwdPhyDelay,
+                                           "forward link PHY-level delay statistics")
     ADD_SAT_STATS_ATTRIBUTES_AVERAGED_DISTRIBUTION_SET (FwdPhyDelay,
                                                         "forward link PHY-level delay statistics")
 
     // Forward link queue size (in bytes) statistics.
-    ADD_SAT_STATS_ATTRIBUTES_DISTRIBUTION_SET (FwdQueueBytes,
-                                               "forward link queue size (in bytes) statistics")
+    ADD_SAT_STATS_ATTRIBUTES_QUANTILE_SET (FwdQueueBytes,
+                                           "forward link queue size (in bytes) statistics")
 
     // Forward link queue size (in number of packets) statistics.
-    ADD_SAT_STATS_ATTRIBUTES_DISTRIBUTION_SET (FwdQueuePackets,
-                                               "forward link queue size (in number of packets) statistics")
+    ADD_SAT_STATS_ATTRIBUTES_QUANTILE_SET (FwdQueuePackets,
+                                           "forward link queue size (in number of packets) statistics")
 
     // Forward link signalling load statistics.
     ADD_SAT_STATS_ATTRIBUTES_BASIC_SET (FwdSignallingLoad,
                                         "forward link signalling load statistics")
 
     // Forward link composite SINR statistics.
-    ADD_SAT_STATS_ATTRIBUTES_DISTRIBUTION_SET (FwdCompositeSinr,
-                                               "forward link composite SINR statistics")
+    ADD_SAT_STATS_ATTRIBUTES_QUANTILE_SET (FwdCompositeSinr,
+                                           "forward link composite SINR statistics")
 
     // Forward link application-level throughput statistics.
-    ADD_SAT_STATS_ATTRIBUTES_BASIC_SET (FwdAppThroughput,
-                                        "forward link application-level throughput statistics")
+    ADD_SAT_STATS_ATTRIBUTES_WINDOWED_SET (FwdAppThroughput,
+                                           "forward link application-level throughput statistics")
     ADD_SAT_STATS_ATTRIBUTE_HEAD (PerUtUserFwdAppThroughput,
                                   "per UT user forward link application-level throughput statistics")
-    ADD_SAT_STATS_BASIC_OUTPUT_CHECKER
+    ADD_SAT_STATS_WINDOWED_OUTPUT_CHECKER
     ADD_SAT_STATS_ATTRIBUTES_AVERAGED_DISTRIBUTION_SET (FwdAppThroughput,
                                                         "forward link application-level throughput statistics")
     ADD_SAT_STATS_ATTRIBUTE_HEAD (AverageUtUserFwdAppThroughput,
@@ -235,29 +294,29 @@ SatStatsHelperContainer::GetTypeId ()
     ADD_SAT_STATS_AVERAGED_DISTRIBUTION_OUTPUT_CHECKER
 
     // Forward link device-level throughput statistics.
-    ADD_SAT_STATS_ATTRIBUTES_BASIC_SET (FwdDevThroughput,
-                                        "forward link device-level throughput statistics")
+    ADD_SAT_STATS_ATTRIBUTES_WINDOWED_SET (FwdDevThroughput,
+                                           "forward link device-level throughput statistics")
     ADD_SAT_STATS_ATTRIBUTES_AVERAGED_DISTRIBUTION_SET (FwdDevThroughput,
                                                         "forward link device-level throughput statistics")
 
     // Forward link MAC-level throughput statistics.
-    ADD_SAT_STATS_ATTRIBUTES_BASIC_SET (FwdMacThroughput,
-                                        "forward link MAC-level throughput statistics")
+    ADD_SAT_STATS_ATTRIBUTES_WINDOWED_SET (FwdMacThroughput,
+                                           "forward link MAC-level throughput statistics")
     ADD_SAT_STATS_ATTRIBUTES_AVERAGED_DISTRIBUTION_SET (FwdMacThroughput,
                                                         "forward link MAC-level throughput statistics")
 
     // Forward link PHY-level throughput statistics.
-    ADD_SAT_STATS_ATTRIBUTES_BASIC_SET (FwdPhyThroughput,
-                                        "forward link PHY-level throughput statistics")
+    ADD_SAT_STATS_ATTRIBUTES_WINDOWED_SET (FwdPhyThroughput,
+                                           "forward link PHY-level throughput statistics")
     ADD_SAT_STATS_ATTRIBUTES_AVERAGED_DISTRIBUTION_SET (FwdPhyThroughput,
                                                         "forward link PHY-level throughput statistics")
 
     // Return link application-level packet delay statistics.
-    ADD_SAT_STATS_ATTRIBUTES_DISTRIBUTION_SET (RtnAppDelay,
-                                               "return link application-level delay statistics")
+    ADD_SAT_STATS_ATTRIBUTES_QUANTILE_SET (RtnAppDelay,
+                                           "return link application-level delay statistics")
     ADD_SAT_STATS_ATTRIBUTE_HEAD (PerUtUserRtnAppDelay,
                                   "per UT user return link application-level delay statistics")
-    ADD_SAT_STATS_DISTRIBUTION_OUTPUT_CHECKER
+    ADD_SAT_STATS_QUANTILE_OUTPUT_CHECKER
     ADD_SAT_STATS_ATTRIBUTES_AVERAGED_DISTRIBUTION_SET (RtnAppDelay,
                                                         "return link application-level delay statistics")
     ADD_SAT_STATS_ATTRIBUTE_HEAD (AverageUtUserRtnAppDelay,
@@ -265,45 +324,45 @@ SatStatsHelperContainer::GetTypeId ()
     ADD_SAT_STATS_AVERAGED_DISTRIBUTION_OUTPUT_CHECKER
 
     // Return link device-level packet delay statistics.
-    ADD_SAT_STATS_ATTRIBUTES_DISTRIBUTION_SET (RtnDevDelay,
-                                               "return link device-level delay statistics")
+    ADD_SAT_STATS_ATTRIBUTES_QUANTILE_SET (RtnDevDelay,
+                                           "return link device-level delay statistics")
     ADD_SAT_STATS_ATTRIBUTES_AVERAGED_DISTRIBUTION_SET (RtnDevDelay,
                                                         "return link device-level delay statistics")
 
     // Return link MAC-level packet delay statistics.
-    ADD_SAT_STATS_ATTRIBUTES_DISTRIBUTION_SET (RtnMacDelay,
-                                               "return link MAC-level delay statistics")
+    ADD_SAT_STATS_ATTRIBUTES_QUANTILE_SET (RtnMacDelay,
+                                           "return link MAC-level delay statistics")
     ADD_SAT_STATS_ATTRIBUTES_AVERAGED_DISTRIBUTION_SET (RtnMacDelay,
                                                         "return link MAC-level delay statistics")
 
     // Return link PHY-level packet delay statistics.
-    ADD_SAT_STATS_ATTRIBUTES_DISTRIBUTION_SET (RtnPhyDelay,
-                                               "return link PHY-level delay statistics")
+    ADD_SAT_STATS_ATTRIBUTES_QUANTILE_SET (RtnPhyDelay,
+                                           "return link PHY-level delay statistics")
     ADD_SAT_STATS_ATTRIBUTES_AVERAGED_DISTRIBUTION_SET (RtnPhyDelay,
                                                         "return link PHY-level delay statistics")
 
     // Return link queue size (in bytes) statistics.
-    ADD_SAT_STATS_ATTRIBUTES_DISTRIBUTION_SET (RtnQueueBytes,
-                                               "return link queue size (in bytes) statistics")
+    ADD_SAT_STATS_ATTRIBUTES_QUANTILE_SET (RtnQueueBytes,
+                                           "return link queue size (in bytes) statistics")
 
     // Return link queue size (in number of packets) statistics.
-    ADD_SAT_STATS_ATTRIBUTES_DISTRIBUTION_SET (RtnQueuePackets,
-                                               "return link queue size (in number of packets) statistics")
+    ADD_SAT_STATS_ATTRIBUTES_QUANTILE_SET (RtnQueuePackets,
+                                           "return link queue size (in number of packets) statistics")
 
     // Return link signalling load statistics.
     ADD_SAT_STATS_ATTRIBUTES_BASIC_SET (RtnSignallingLoad,
                                         "return link signalling load statistics")
 
     // Return link composite SINR statistics.
-    ADD_SAT_STATS_ATTRIBUTES_DISTRIBUTION_SET (RtnCompositeSinr,
-                                               "return link composite SINR statistics")
+    ADD_SAT_STATS_ATTRIBUTES_QUANTILE_SET (RtnCompositeSinr,
+                                           "return link composite SINR statistics")
 
     // Return link application-level throughput statistics.
-    ADD_SAT_STATS_ATTRIBUTES_BASIC_SET (RtnAppThroughput,
-                                        "return link application-level throughput statistics")
+    ADD_SAT_STATS_ATTRIBUTES_WINDOWED_SET (RtnAppThroughput,
+                                           "return link application-level throughput statistics")
     ADD_SAT_STATS_ATTRIBUTE_HEAD (PerUtUserRtnAppThroughput,
                                   "per UT user return link application-level throughput statistics")
-    ADD_SAT_STATS_BASIC_OUTPUT_CHECKER
+    ADD_SAT_STATS_WINDOWED_OUTPUT_CHECKER
     ADD_SAT_STATS_ATTRIBUTES_AVERAGED_DISTRIBUTION_SET (RtnAppThroughput,
                                                         "return link application-level throughput statistics")
     ADD_SAT_STATS_ATTRIBUTE_HEAD (AverageUtUserRtnAppThroughput,
@@ -311,20 +370,20 @@ SatStatsHelperContainer::GetTypeId ()
     ADD_SAT_STATS_AVERAGED_DISTRIBUTION_OUTPUT_CHECKER
 
     // Return link device-level throughput statistics.
-    ADD_SAT_STATS_ATTRIBUTES_BASIC_SET (RtnDevThroughput,
-                                        "return link device-level throughput statistics")
+    ADD_SAT_STATS_ATTRIBUTES_WINDOWED_SET (RtnDevThroughput,
+                                           "return link device-level throughput statistics")
     ADD_SAT_STATS_ATTRIBUTES_AVERAGED_DISTRIBUTION_SET (RtnDevThroughput,
                                                         "return link device-level throughput statistics")
 
     // Return link MAC-level throughput statistics.
-    ADD_SAT_STATS_ATTRIBUTES_BASIC_SET (RtnMacThroughput,
-                                        "return link MAC-level throughput statistics")
+    ADD_SAT_STATS_ATTRIBUTES_WINDOWED_SET (RtnMacThroughput,
+                                           "return link MAC-level throughput statistics")
     ADD_SAT_STATS_ATTRIBUTES_AVERAGED_DISTRIBUTION_SET (RtnMacThroughput,
                                                         "return link MAC-level throughput statistics")
 
     // Return link PHY-level throughput statistics.
-    ADD_SAT_STATS_ATTRIBUTES_BASIC_SET (RtnPhyThroughput,
-                                        "return link PHY-level throughput statistics")
+    ADD_SAT_STATS_ATTRIBUTES_WINDOWED_SET (RtnPhyThroughput,
+                                           "return link PHY-level throughput statistics")
     ADD_SAT_STATS_ATTRIBUTES_AVERAGED_DISTRIBUTION_SET (RtnPhyThroughput,
                                                         "return link PHY-level throughput statistics")
 
@@ -371,8 +430,8 @@ SatStatsHelperContainer::GetTypeId ()
                      SatStatsHelper::OUTPUT_SCATTER_FILE, "SCATTER_FILE"))
 
     // Resources granted statistics.
-    ADD_SAT_STATS_ATTRIBUTES_DISTRIBUTION_SET (ResourcesGranted,
-                                               "resources granted statistics")
+    ADD_SAT_STATS_ATTRIBUTES_QUANTILE_SET (ResourcesGranted,
+                                           "resources granted statistics")
 
     // Backlogged request statistics.
     ADD_SAT_STATS_ATTRIBUTE_HEAD (GlobalBackloggedRequest,
@@ -431,30 +490,30 @@ SatStatsHelperContainer::GetTypeId ()
     // Link SINR statistics.
     ADD_SAT_STATS_ATTRIBUTE_HEAD (GlobalFwdFeederLinkSinr,
                                   "global forward feeder link SINR statistics")
-    ADD_SAT_STATS_DISTRIBUTION_OUTPUT_CHECKER
+    ADD_SAT_STATS_QUANTILE_OUTPUT_CHECKER
     ADD_SAT_STATS_ATTRIBUTE_HEAD (GlobalFwdUserLinkSinr,
                                   "global forward user link SINR statistics")
-    ADD_SAT_STATS_DISTRIBUTION_OUTPUT_CHECKER
+    ADD_SAT_STATS_QUANTILE_OUTPUT_CHECKER
     ADD_SAT_STATS_ATTRIBUTE_HEAD (GlobalRtnFeederLinkSinr,
                                   "global return feeder link SINR statistics")
-    ADD_SAT_STATS_DISTRIBUTION_OUTPUT_CHECKER
+    ADD_SAT_STATS_QUANTILE_OUTPUT_CHECKER
     ADD_SAT_STATS_ATTRIBUTE_HEAD (GlobalRtnUserLinkSinr,
                                   "global return user link SINR statistics")
-    ADD_SAT_STATS_DISTRIBUTION_OUTPUT_CHECKER
+    ADD_SAT_STATS_QUANTILE_OUTPUT_CHECKER
 
     // Link Rx power statistics.
     ADD_SAT_STATS_ATTRIBUTE_HEAD (GlobalFwdFeederLinkRxPower,
                                   "global forward feeder link Rx power statistics")
-    ADD_SAT_STATS_DISTRIBUTION_OUTPUT_CHECKER
+    ADD_SAT_STATS_QUANTILE_OUTPUT_CHECKER
     ADD_SAT_STATS_ATTRIBUTE_HEAD (GlobalFwdUserLinkRxPower,
                                   "global forward user link Rx power statistics")
-    ADD_SAT_STATS_DISTRIBUTION_OUTPUT_CHECKER
+    ADD_SAT_STATS_QUANTILE_OUTPUT_CHECKER
     ADD_SAT_STATS_ATTRIBUTE_HEAD (GlobalRtnFeederLinkRxPower,
                                   "global return feeder link Rx power statistics")
-    ADD_SAT_STATS_DISTRIBUTION_OUTPUT_CHECKER
+    ADD_SAT_STATS_QUANTILE_OUTPUT_CHECKER
     ADD_SAT_STATS_ATTRIBUTE_HEAD (GlobalRtnUserLinkRxPower,
                                   "global return user link Rx power statistics")
-    ADD_SAT_STATS_DISTRIBUTION_OUTPUT_CHECKER
+    ADD_SAT_STATS_QUANTILE_OUTPUT_CHECKER
 
     // Frame type usage statistics.
     ADD_SAT_STATS_ATTRIBUTE_HEAD (GlobalFrameTypeUsage,
@@ -546,6 +605,7 @@ SatStatsHelperContainer::GetName () const
                      + GetOutputTypeSuffix (type));                    \
       stat->SetIdentifierType (SatStatsHelper::IDENTIFIER_GLOBAL);            \
       stat->SetOutputType (type);                                             \
+      stat->SetNativeAccumulators (m_nativeAccumulators);                     \
       stat->Install ();                                                       \
       m_stats.push_back (stat);                                               \
     }                                                                         \
@@ -564,6 +624,7 @@ SatStatsHelperContainer::GetName () const
                      + GetOutputTypeSuffix (type));                    \
       stat->SetIdentifierType (SatStatsHelper::IDENTIFIER_GW);                \
       stat->SetOutputType (type);                                             \
+      stat->SetNativeAccumulators (m_nativeAccumulators);                     \
       stat->Install ();                                                       \
       m_stats.push_back (stat);                                               \
     }                                                                         \
@@ -582,6 +643,7 @@ SatStatsHelperContainer::GetName () const
                      + GetOutputTypeSuffix (type));                    \
       stat->SetIdentifierType (SatStatsHelper::IDENTIFIER_BEAM);              \
       stat->SetOutputType (type);                                             \
+      stat->SetNativeAccumulators (m_nativeAccumulators);                     \
       stat->Install ();                                                       \
       m_stats.push_back (stat);                                               \
     }                                                                         \
@@ -600,6 +662,7 @@ SatStatsHelperContainer::GetName () const
                      + GetOutputTypeSuffix (type));                    \
       stat->SetIdentifierType (SatStatsHelper::IDENTIFIER_UT);                \
       stat->SetOutputType (type);                                             \
+      stat->SetNativeAccumulators (m_nativeAccumulators);                     \
       stat->Install ();                                                       \
       m_stats.push_back (stat);                                               \
     }                                                                         \
@@ -618,6 +681,7 @@ SatStatsHelperContainer::GetName () const
                      + GetOutputTypeSuffix (type));                    \
       stat->SetIdentifierType (SatStatsHelper::IDENTIFIER_UT_USER);           \
       stat->SetOutputType (type);                                             \
+      stat->SetNativeAccumulators (m_nativeAccumulators);                     \
       stat->Install ();                                                       \
       m_stats.push_back (stat);                                               \
     }                                                                         \
@@ -636,6 +700,7 @@ SatStatsHelperContainer::GetName () const
                      + GetOutputTypeSuffix (type));                    \
       stat->SetIdentifierType (SatStatsHelper::IDENTIFIER_BEAM);              \
       stat->SetOutputType (type);                                             \
+      stat->SetNativeAccumulators (m_nativeAccumulators);                     \
       stat->SetAveragingMode (true);                                          \
       stat->Install ();                                                       \
       m_stats.push_back (stat);                                               \
@@ -655,6 +720,7 @@ SatStatsHelperContainer::GetName () const
                      + GetOutputTypeSuffix (type));                    \
       stat->SetIdentifierType (SatStatsHelper::IDENTIFIER_UT);                \
       stat->SetOutputType (type);                                             \
+      stat->SetNativeAccumulators (m_nativeAccumulators);                     \
       stat->SetAveragingMode (true);                                          \
       stat->Install ();                                                       \
       m_stats.push_back (stat);                                               \
@@ -674,6 +740,7 @@ SatStatsHelperContainer::GetName () const
                      + GetOutputTypeSuffix (type));                    \
       stat->SetIdentifierType (SatStatsHelper::IDENTIFIER_UT_USER);           \
       stat->SetOutputType (type);                                             \
+      stat->SetNativeAccumulators (m_nativeAccumulators);                     \
       stat->SetAveragingMode (true);                                          \
       stat->Install ();                                                       \
       m_stats.push_back (stat);                                               \
@@ -979,6 +1046,12 @@ SatStatsHelperContainer::GetOutputTypeSuffix (SatStatsHelper::OutputType_t outpu
   case SatStatsHelper::OUTPUT_CDF_PLOT:
     return "-cdf";
 
+  case SatStatsHelper::OUTPUT_QUANTILE_FILE:
+    return "-quantile";
+
+  case SatStatsHelper::OUTPUT_WINDOWED_FILE:
+    return "-windowed";
+
   default:
     NS_FATAL_ERROR ("SatStatsHelperContainer - Invalid output type");
     break;
@@ -100,6 +100,27 @@ class SatHelper;
  * which will produce output files with the names such as
  * `stat-per-ut-fwd-app-delay-scalar.txt`,
  * `stat-per-ut-fwd-app-delay-cdf-ut-1.txt`, etc.
+ *
+ * With the `EnableNativeAccumulators` attribute, the statistics supporting it
+ * are accumulated into a SatStatsAccumulator, i.e., flat per-identifier arrays
+ * updated directly from the trace sinks, instead of creating a collector per
+ * identifier and an aggregator. This applies to the scalar, histogram, PDF,
+ * and CDF file outputs, and is currently supported by the delay, composite
+ * SINR, link SINR, link Rx power, queue, resources granted, and throughput
+ * statistics.
+ *
+ * The delay, composite SINR, link SINR, link Rx power, queue, and resources
+ * granted statistics also support the `QUANTILE_FILE` output type, which writes the 50th, 95th, 99th, and 99.9th percentiles of
+ * each identifier, estimated with a SatStatsQuantileSketch in constant memory.
+ * The sketches are also written into a `-sketch.txt` file, which can be
+ * merged over simulation replications with ext-utils/mergeQuantileSketches.py.
+ *
+ * For long simulations, the same statistics support the `WINDOWED_FILE`
+ * output type, which writes a snapshot of the number of samples, mean,
+ * minimum, maximum, and the same percentiles of each identifier at the end of
+ * every window and then starts the window afresh. The throughput statistics
+ * support it too, with the throughput of each window instead. The window
+ * length is set with the `ns3::SatStatsAccumulator::WindowLength` attribute.
  */
 class SatStatsHelperContainer : public Object
 {
@@ -307,6 +328,9 @@ private:
   /// Prefix of every SatStatsHelper instance names and every output file.
   std::string m_name;
 
+  /// Use native accumulators instead of collectors in the created helpers.
+  bool m_nativeAccumulators;
+
   /// Maintains the active SatStatsHelper instances which have created.
   std::list<Ptr<const SatStatsHelper> > m_stats;
 
@@ -31,6 +31,7 @@
 #include <ns3/node-container.h>
 #include <ns3/collector-map.h>
 #include <ns3/data-collection-object.h>
+#include <ns3/satellite-stats-accumulator.h>
 #include <ns3/log.h>
 #include <ns3/type-id.h>
 #include <ns3/object-factory.h>
@@ -97,6 +98,10 @@ SatStatsHelper::GetOutputTypeName (SatStatsHelper::OutputType_t outputType)
       return "OUTPUT_PDF_PLOT";
     case SatStatsHelper::OUTPUT_CDF_PLOT:
       return "OUTPUT_CDF_PLOT";
+    case SatStatsHelper::OUTPUT_QUANTILE_FILE:
+      return "OUTPUT_QUANTILE_FILE";
+    case SatStatsHelper::OUTPUT_WINDOWED_FILE:
+      return "OUTPUT_WINDOWED_FILE";
     default:
       NS_FATAL_ERROR ("SatStatsHelper - Invalid output type");
       break;
@@ -112,6 +117,7 @@ SatStatsHelper::SatStatsHelper (Ptr<const SatHelper> satHelper)
     m_identifierType (SatStatsHelper::IDENTIFIER_GLOBAL),
     m_outputType (SatStatsHelper::OUTPUT_SCATTER_FILE),
     m_isInstalled (false),
+    m_nativeAccumulators (false),
     m_satHelper (satHelper)
 {
   NS_LOG_FUNCTION (this << satHelper);
@@ -159,7 +165,9 @@ SatStatsHelper::GetTypeId ()
                                     SatStatsHelper::OUTPUT_SCATTER_PLOT,   "SCATTER_PLOT",
                                     SatStatsHelper::OUTPUT_HISTOGRAM_PLOT, "HISTOGRAM_PLOT",
                                     SatStatsHelper::OUTPUT_PDF_PLOT,       "PDF_PLOT",
-                                    SatStatsHelper::OUTPUT_CDF_PLOT,       "CDF_PLOT"))
+                                    SatStatsHelper::OUTPUT_CDF_PLOT,       "CDF_PLOT",
+                                    SatStatsHelper::OUTPUT_QUANTILE_FILE,  "QUANTILE_FILE",
+                                    SatStatsHelper::OUTPUT_WINDOWED_FILE,  "WINDOWED_FILE"))
   ;
   return tid;
 }
@@ -264,6 +272,30 @@ SatStatsHelper::IsInstalled () const
 }
 
 
+void
+SatStatsHelper::SetNativeAccumulators (bool nativeAccumulators)
+{
+  NS_LOG_FUNCTION (this << nativeAccumulators);
+
+  if (m_isInstalled && (m_nativeAccumulators != nativeAccumulators))
+    {
+      NS_LOG_WARN (this << " cannot modify the accumulator backend"
+                        << " because this instance have already been installed");
+    }
+  else
+    {
+      m_nativeAccumulators = nativeAccumulators;
+    }
+}
+
+
+bool
+SatStatsHelper::GetNativeAccumulators () const
+{
+  return m_nativeAccumulators;
+}
+
+
 Ptr<const SatHelper>
 SatStatsHelper::GetSatHelper () const
 {
@@ -297,60 +329,161 @@ uint32_t
 SatStatsHelper::CreateCollectorPerIdentifier (CollectorMap &collectorMap) const
 {
   NS_LOG_FUNCTION (this);
-  uint32_t n = 0;
+  const std::list<uint32_t> identifiers = GetIdentifiers ();
+
+  for (std::list<uint32_t>::const_iterator it = identifiers.begin ();
+       it != identifiers.end (); ++it)
+    {
+      std::ostringstream name;
+      name << *it;
+      collectorMap.SetAttribute ("Name", StringValue (name.str ()));
+      collectorMap.Create (*it);
+    }
+
+  NS_LOG_INFO (this << " created " << identifiers.size () << " instance(s)"
+                    << " of " << collectorMap.GetType ().GetName ()
+                    << " for " << GetIdentifierTypeName (GetIdentifierType ()));
+
+  return identifiers.size ();
+
+} // end of `uint32_t CreateCollectorPerIdentifier (CollectorMap &);`
+
+
+Ptr<SatStatsAccumulator>
+SatStatsHelper::CreateAccumulator (std::string dataLabel,
+                                   bool averagingMode,
+                                   bool averagePerSecond) const
+{
+  NS_LOG_FUNCTION (this << dataLabel << averagingMode << averagePerSecond);
+
+  if (!m_nativeAccumulators
+      && (GetOutputType () != SatStatsHelper::OUTPUT_QUANTILE_FILE)
+      && (GetOutputType () != SatStatsHelper::OUTPUT_WINDOWED_FILE))
+    {
+      return 0;
+    }
+
+  if (averagePerSecond && !averagingMode
+      && (GetOutputType () != SatStatsHelper::OUTPUT_SCALAR_FILE)
+      && (GetOutputType () != SatStatsHelper::OUTPUT_WINDOWED_FILE))
+    {
+      NS_LOG_INFO (this << " native accumulators do not support averages per second with "
+                        << GetOutputTypeName (GetOutputType ())
+                        << ", using collectors instead");
+      return 0;
+    }
+
+  Ptr<SatStatsAccumulator> accumulator = CreateObject<SatStatsAccumulator> ();
+
+  switch (GetOutputType ())
+    {
+    case SatStatsHelper::OUTPUT_SCALAR_FILE:
+      if (averagingMode)
+        {
+          return 0;
+        }
+      accumulator->Configure (SatStatsAccumulator::OUTPUT_AVERAGE, false, averagePerSecond,
+                              GetOutputFileName (), GetIdentifierHeading (dataLabel));
+      break;
+
+    case SatStatsHelper::OUTPUT_HISTOGRAM_FILE:
+      accumulator->Configure (SatStatsAccumulator::OUTPUT_HISTOGRAM, averagingMode, averagePerSecond,
+                              GetOutputFileName (), GetDistributionHeading (dataLabel));
+      break;
+
+    case SatStatsHelper::OUTPUT_PDF_FILE:
+      accumulator->Configure (SatStatsAccumulator::OUTPUT_PROBABILITY, averagingMode, averagePerSecond,
+                              GetOutputFileName (), GetDistributionHeading (dataLabel));
+      break;
+
+    case SatStatsHelper::OUTPUT_CDF_FILE:
+      accumulator->Configure (SatStatsAccumulator::OUTPUT_CUMULATIVE, averagingMode, averagePerSecond,
+                              GetOutputFileName (), GetDistributionHeading (dataLabel));
+      break;
+
+    case SatStatsHelper::OUTPUT_QUANTILE_FILE:
+      if (averagingMode)
+        {
+          NS_FATAL_ERROR (GetOutputTypeName (GetOutputType ()) << " is not a valid output type for averaged statistics.");
+        }
+      accumulator->Configure (SatStatsAccumulator::OUTPUT_QUANTILE, false, false,
+                              GetOutputFileName (),
+                              GetIdentifierHeading (SatStatsAccumulator::GetQuantileHeading (dataLabel)));
+      break;
+
+    case SatStatsHelper::OUTPUT_WINDOWED_FILE:
+      if (averagingMode)
+        {
+          NS_FATAL_ERROR (GetOutputTypeName (GetOutputType ()) << " is not a valid output type for averaged statistics.");
+        }
+      accumulator->Configure (SatStatsAccumulator::OUTPUT_WINDOWED, false, averagePerSecond,
+                              GetOutputFileName (),
+                              GetIdentifierHeading (SatStatsAccumulator::GetWindowedHeading (dataLabel,
+                                                                                             averagePerSecond)));
+      break;
+
+    default:
+      NS_LOG_INFO (this << " native accumulators do not support "
+                        << GetOutputTypeName (GetOutputType ())
+                        << ", using collectors instead");
+      return 0;
+    }
+
+  CreateAccumulatorPerIdentifier (accumulator);
+  return accumulator;
+}
+
+
+uint32_t
+SatStatsHelper::CreateAccumulatorPerIdentifier (Ptr<SatStatsAccumulator> accumulator) const
+{
+  NS_LOG_FUNCTION (this << accumulator);
+  const std::list<uint32_t> identifiers = GetIdentifiers ();
+
+  for (std::list<uint32_t>::const_iterator it = identifiers.begin ();
+       it != identifiers.end (); ++it)
+    {
+      accumulator->AddIdentifier (*it);
+    }
+
+  NS_LOG_INFO (this << " created " << identifiers.size () << " accumulator slot(s)"
+                    << " for " << GetIdentifierTypeName (GetIdentifierType ()));
+
+  return identifiers.size ();
+}
+
+
+std::list<uint32_t>
+SatStatsHelper::GetIdentifiers () const
+{
+  std::list<uint32_t> identifiers;
 
   switch (GetIdentifierType ())
     {
     case SatStatsHelper::IDENTIFIER_GLOBAL:
-      {
-        collectorMap.SetAttribute ("Name", StringValue ("0"));
-        collectorMap.Create (0);
-        n++;
-        break;
-      }
+      identifiers.push_back (0);
+      break;
 
     case SatStatsHelper::IDENTIFIER_GW:
       {
         NodeContainer gws = m_satHelper->GetBeamHelper ()->GetGwNodes ();
         for (NodeContainer::Iterator it = gws.Begin (); it != gws.End (); ++it)
           {
-            const uint32_t gwId = GetGwId (*it);
-            std::ostringstream name;
-            name << gwId;
-            collectorMap.SetAttribute ("Name", StringValue (name.str ()));
-            collectorMap.Create (gwId);
-            n++;
+            identifiers.push_back (GetGwId (*it));
           }
         break;
       }
 
     case SatStatsHelper::IDENTIFIER_BEAM:
-      {
-        std::list<uint32_t> beams = m_satHelper->GetBeamHelper ()->GetBeams ();
-        for (std::list<uint32_t>::const_iterator it = beams.begin ();
-             it != beams.end (); ++it)
-          {
-            const uint32_t beamId = (*it);
-            std::ostringstream name;
-            name << beamId;
-            collectorMap.SetAttribute ("Name", StringValue (name.str ()));
-            collectorMap.Create (beamId);
-            n++;
-          }
-        break;
-      }
+      identifiers = m_satHelper->GetBeamHelper ()->GetBeams ();
+      break;
 
     case SatStatsHelper::IDENTIFIER_UT:
       {
         NodeContainer uts = m_satHelper->GetBeamHelper ()->GetUtNodes ();
         for (NodeContainer::Iterator it = uts.Begin (); it != uts.End (); ++it)
           {
-            const uint32_t utId = GetUtId (*it);
-            std::ostringstream name;
-            name << utId;
-            collectorMap.SetAttribute ("Name", StringValue (name.str ()));
-            collectorMap.Create (utId);
-            n++;
+            identifiers.push_back (GetUtId (*it));
           }
         break;
       }
@@ -361,12 +494,7 @@ SatStatsHelper::CreateCollectorPerIdentifier (CollectorMap &collectorMap) const
         for (NodeContainer::Iterator it = utUsers.Begin ();
              it != utUsers.End (); ++it)
           {
-            const uint32_t utUserId = GetUtUserId (*it);
-            std::ostringstream name;
-            name << utUserId;
-            collectorMap.SetAttribute ("Name", StringValue (name.str ()));
-            collectorMap.Create (utUserId);
-            n++;
+            identifiers.push_back (GetUtUserId (*it));
           }
         break;
       }
@@ -376,13 +504,9 @@ SatStatsHelper::CreateCollectorPerIdentifier (CollectorMap &collectorMap) const
       break;
     }
 
-  NS_LOG_INFO (this << " created " << n << " instance(s)"
-                    << " of " << collectorMap.GetType ().GetName ()
-                    << " for " << GetIdentifierTypeName (GetIdentifierType ()));
+  return identifiers;
 
-  return n;
-
-} // end of `uint32_t CreateCollectorPerIdentifier (CollectorMap &);`
+} // end of `std::list<uint32_t> GetIdentifiers () const`
 
 
 std::string
@@ -26,6 +26,7 @@
 #include <ns3/object.h>
 #include <ns3/attribute.h>
 #include <ns3/net-device-container.h>
+#include <list>
 #include <map>
 
 
@@ -33,6 +34,7 @@ namespace ns3 {
 
 
 class SatHelper;
+class SatStatsAccumulator;
 class Node;
 class CollectorMap;
 class DataCollectionObject;
@@ -125,6 +127,8 @@ public:
     OUTPUT_HISTOGRAM_PLOT,
     OUTPUT_PDF_PLOT,        // probability distribution function
     OUTPUT_CDF_PLOT,        // cumulative distribution function
+    OUTPUT_QUANTILE_FILE,   // percentiles from a mergeable quantile sketch
+    OUTPUT_WINDOWED_FILE,   // periodic snapshots of count, mean, min, max, and percentiles
   } OutputType_t;
 
   /**
@@ -203,6 +207,20 @@ public:
    */
   bool IsInstalled () const;
 
+  /**
+   * \param nativeAccumulators if true, the statistics are accumulated into a
+   *                           SatStatsAccumulator instead of per-identifier
+   *                           collectors and an aggregator, when supported by
+   *                           the helper and the output type.
+   * \warning Does not have any effect if invoked after Install().
+   */
+  void SetNativeAccumulators (bool nativeAccumulators);
+
+  /**
+   * \return true if native accumulators are preferred over collectors.
+   */
+  bool GetNativeAccumulators () const;
+
   /**
    * \return a pointer to the the SatHelper instance used as a reference by
    *         this helper instance.
@@ -298,6 +316,45 @@ protected:
    */
   uint32_t CreateCollectorPerIdentifier (CollectorMap &collectorMap) const;
 
+  /**
+   * \brief Create a native accumulator according to the output type.
+   * \param dataLabel the short name of the main data of this statistics.
+   * \param averagingMode if true, the averages of the identifiers are used as
+   *                      the samples of a single distribution output.
+   * \param averagePerSecond if true, the average of an identifier is the sum
+   *                         of its samples per second of simulation time,
+   *                         as with ScalarCollector::OUTPUT_TYPE_AVERAGE_PER_SECOND.
+   * \return a pointer to the created accumulator with a slot for each
+   *         identifier, or a null pointer if native accumulators are not
+   *         enabled or do not support the output type.
+   *
+   * Native accumulators support the scalar, histogram, PDF, and CDF file
+   * output types. The quantile and windowed file output types are supported
+   * only by native accumulators, so for them an accumulator is always created.
+   * Averages per second are supported only by the scalar, windowed, and the
+   * averaged distribution outputs.
+   */
+  Ptr<SatStatsAccumulator> CreateAccumulator (std::string dataLabel,
+                                              bool averagingMode,
+                                              bool averagePerSecond) const;
+
+  /**
+   * \brief Reserve a slot in the given accumulator for each identifier in the
+   *        simulation.
+   * \param accumulator the accumulator where the slots will be reserved.
+   * \return number of slots reserved.
+   *
+   * The identifiers are determined in the same way as in
+   * CreateCollectorPerIdentifier().
+   */
+  uint32_t CreateAccumulatorPerIdentifier (Ptr<SatStatsAccumulator> accumulator) const;
+
+  /**
+   * \return the identifiers in the simulation according to the currently
+   *         active identifier type.
+   */
+  std::list<uint32_t> GetIdentifiers () const;
+
   // IDENTIFIER RELATED METHODS ///////////////////////////////////////////////
 
   /**
@@ -365,6 +422,7 @@ private:
   IdentifierType_t      m_identifierType;  ///<
   OutputType_t          m_outputType;      ///<
   bool                  m_isInstalled;     ///<
+  bool                  m_nativeAccumulators; ///<
   Ptr<const SatHelper>  m_satHelper;       ///<
 
 }; // end of class SatStatsHelper
@@ -0,0 +1,147 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Budiarto Herman <budiarto.herman@magister.fi>
+ *
+ */
+
+#include "satellite-stats-identifier-map.h"
+
+
+namespace ns3 {
+
+
+/// Initial number of slots, must be a power of two.
+static const uint32_t INITIAL_SLOTS = 16;
+
+
+SatStatsIdentifierMap::SatStatsIdentifierMap ()
+  : m_slots (INITIAL_SLOTS),
+    m_mask (INITIAL_SLOTS - 1),
+    m_size (0)
+{
+  for (std::vector<Slot_t>::iterator it = m_slots.begin ();
+       it != m_slots.end (); ++it)
+    {
+      it->isUsed = false;
+    }
+}
+
+
+void
+SatStatsIdentifierMap::Insert (const Address &address, uint32_t identifier)
+{
+  // Keep the load factor at most one half, so the probe sequences stay short.
+  if (2 * (m_size + 1) > m_slots.size ())
+    {
+      Grow ();
+    }
+
+  uint32_t i = Hash (address) & m_mask;
+
+  while (m_slots[i].isUsed)
+    {
+      if (m_slots[i].address == address)
+        {
+          m_slots[i].identifier = identifier;
+          return;
+        }
+
+      i = (i + 1) & m_mask;
+    }
+
+  m_slots[i].address = address;
+  m_slots[i].identifier = identifier;
+  m_slots[i].isUsed = true;
+  m_size++;
+}
+
+
+bool
+SatStatsIdentifierMap::Find (const Address &address, uint32_t &identifier) const
+{
+  uint32_t i = Hash (address) & m_mask;
+
+  // The table is never full, so an unused slot always ends the probing.
+  while (m_slots[i].isUsed)
+    {
+      if (m_slots[i].address == address)
+        {
+          identifier = m_slots[i].identifier;
+          return true;
+        }
+
+      i = (i + 1) & m_mask;
+    }
+
+  return false;
+}
+
+
+uint32_t
+SatStatsIdentifierMap::GetSize () const
+{
+  return m_size;
+}
+
+
+uint32_t
+SatStatsIdentifierMap::Hash (const Address &address)
+{
+  uint8_t buffer[Address::MAX_SIZE + 2];
+  const uint32_t length = address.CopyAllTo (buffer, Address::MAX_SIZE + 2);
+
+  uint32_t hash = 2166136261U;
+
+  for (uint32_t i = 0; i < length; i++)
+    {
+      hash ^= buffer[i];
+      hash *= 16777619U;
+    }
+
+  return hash;
+}
+
+
+void
+SatStatsIdentifierMap::Grow ()
+{
+  std::vector<Slot_t> oldSlots;
+  oldSlots.swap (m_slots);
+
+  m_slots.resize (2 * oldSlots.size ());
+  m_mask = m_slots.size () - 1;
+  m_size = 0;
+
+  for (std::vector<Slot_t>::iterator it = m_slots.begin ();
+       it != m_slots.end (); ++it)
+    {
+      it->isUsed = false;
+    }
+
+  for (std::vector<Slot_t>::const_iterator it = oldSlots.begin ();
+       it != oldSlots.end (); ++it)
+    {
+      if (it->isUsed)
+        {
+          Insert (it->address, it->identifier);
+        }
+    }
+}
+
+
+} // end of namespace ns3
@@ -0,0 +1,112 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Budiarto Herman <budiarto.herman@magister.fi>
+ *
+ */
+
+#ifndef SATELLITE_STATS_IDENTIFIER_MAP_H
+#define SATELLITE_STATS_IDENTIFIER_MAP_H
+
+#include <ns3/address.h>
+#include <stdint.h>
+#include <vector>
+
+
+namespace ns3 {
+
+
+/**
+ * \ingroup satstats
+ * \brief Lookup table from a sender address to the identifier of the
+ *        statistics collector associated with it.
+ *
+ * The table is filled once while the statistics are installed and then
+ * queried for every received packet. It uses open addressing with linear
+ * probing in a flat power-of-two sized array, so a lookup hashes the address
+ * once and usually inspects only one slot, instead of the series of address
+ * comparisons done by a tree based map. The table is enlarged on insertion
+ * so that at most half of the slots are in use.
+ */
+class SatStatsIdentifierMap
+{
+public:
+  /**
+   * \brief Creates an empty table.
+   */
+  SatStatsIdentifierMap ();
+
+  /**
+   * \brief Associates an identifier with an address.
+   * \param address the address of the sender.
+   * \param identifier the identifier associated with the address.
+   *
+   * The identifier replaces any identifier previously associated with the
+   * same address.
+   */
+  void Insert (const Address &address, uint32_t identifier);
+
+  /**
+   * \brief Looks up the identifier associated with an address.
+   * \param address the address of the sender.
+   * \param identifier set to the identifier associated with the address
+   *                   if one is found, otherwise left untouched.
+   * \return true if the address is found in the table.
+   */
+  bool Find (const Address &address, uint32_t &identifier) const;
+
+  /**
+   * \return the number of addresses in the table.
+   */
+  uint32_t GetSize () const;
+
+private:
+  /**
+   * \brief Computes the hash of an address.
+   * \param address the address.
+   * \return FNV-1a hash of the serialized address, i.e., its type, length,
+   *         and content.
+   */
+  static uint32_t Hash (const Address &address);
+
+  /**
+   * \brief Doubles the number of slots and re-inserts the existing entries.
+   */
+  void Grow ();
+
+  /// A single slot of the table.
+  struct Slot_t
+  {
+    Address address;      ///< Address of the sender.
+    uint32_t identifier;  ///< Identifier associated with the address.
+    bool isUsed;          ///< Whether the slot holds an entry.
+  };
+
+  /// Slots of the table, the size is always a power of two.
+  std::vector<Slot_t> m_slots;
+  /// Number of slots minus one, used to wrap the slot index.
+  uint32_t m_mask;
+  /// Number of entries in the table.
+  uint32_t m_size;
+
+}; // end of class SatStatsIdentifierMap
+
+
+} // end of namespace ns3
+
+
+#endif /* SATELLITE_STATS_IDENTIFIER_MAP_H */
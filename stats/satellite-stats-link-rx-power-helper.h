@@ -35,6 +35,7 @@ namespace ns3 {
 class SatHelper;
 class Node;
 class DataCollectionObject;
+class SatStatsAccumulator;
 
 /**
  * \ingroup satstats
@@ -91,6 +92,9 @@ protected:
   /// The aggregator created by this helper.
   Ptr<DataCollectionObject> m_aggregator;
 
+  /// The native accumulator used instead of the collector and the aggregator.
+  Ptr<SatStatsAccumulator> m_accumulator;
+
 private:
   ///
   Callback<void, double> m_traceSinkCallback;
@@ -39,6 +39,7 @@
 #include <ns3/scalar-collector.h>
 #include <ns3/multi-file-aggregator.h>
 #include <ns3/magister-gnuplot-aggregator.h>
+#include <ns3/satellite-stats-accumulator.h>
 
 #include <sstream>
 #include "satellite-stats-link-sinr-helper.h"
@@ -79,6 +80,12 @@ SatStatsLinkSinrHelper::SinrCallback (double sinrDb)
 {
   NS_LOG_FUNCTION (this << sinrDb);
 
+  if (m_accumulator != 0)
+    {
+      m_accumulator->AddSample (0, sinrDb);
+      return;
+    }
+
   switch (GetOutputType ())
     {
     case SatStatsHelper::OUTPUT_SCALAR_FILE:
@@ -133,6 +140,15 @@ SatStatsLinkSinrHelper::DoInstall ()
 {
   NS_LOG_FUNCTION (this);
 
+  // Accumulate the samples natively instead of collectors, when possible.
+  m_accumulator = CreateAccumulator ("sinr_db", false, false);
+
+  if (m_accumulator != 0)
+    {
+      InstallProbes ();
+      return;
+    }
+
   switch (GetOutputType ())
     {
     case SatStatsHelper::OUTPUT_NONE:
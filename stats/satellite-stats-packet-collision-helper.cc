@@ -288,9 +288,9 @@ SatStatsPacketCollisionHelper::CollisionRxCallback (uint32_t nPackets,
   else
     {
       // Determine the identifier associated with the sender address.
-      std::map<const Address, uint32_t>::const_iterator it = m_identifierMap.find (from);
+      uint32_t identifier;
 
-      if (it == m_identifierMap.end ())
+      if (!m_identifierMap.Find (from, identifier))
         {
           NS_LOG_WARN (this << " discarding " << nPackets << " packets"
                             << " from statistics collection because of"
@@ -299,9 +299,9 @@ SatStatsPacketCollisionHelper::CollisionRxCallback (uint32_t nPackets,
       else
         {
           // Find the first-level collector with the right identifier.
-          Ptr<DataCollectionObject> collector = m_terminalCollectors.Get (it->second);
+          Ptr<DataCollectionObject> collector = m_terminalCollectors.Get (identifier);
           NS_ASSERT_MSG (collector != 0,
-                         "Unable to find collector with identifier " << it->second);
+                         "Unable to find collector with identifier " << identifier);
 
           switch (GetOutputType ())
             {
@@ -329,7 +329,7 @@ SatStatsPacketCollisionHelper::CollisionRxCallback (uint32_t nPackets,
 
             } // end of `switch (GetOutputType ())`
 
-        } // end of else of `if (it == m_identifierMap.end ())`
+        } // end of else of `if (!m_identifierMap.Find (from, identifier))`
 
     } // end of else of `if (from.IsInvalid ())`
 
@@ -352,7 +352,7 @@ SatStatsPacketCollisionHelper::SaveAddressAndIdentifier (Ptr<Node> utNode)
   else
     {
       const uint32_t identifier = GetIdentifierForUt (utNode);
-      m_identifierMap[addr] = identifier;
+      m_identifierMap.Insert (addr, identifier);
       NS_LOG_INFO (this << " associated address " << addr
                         << " with identifier " << identifier);
 
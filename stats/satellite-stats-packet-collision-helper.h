@@ -23,6 +23,7 @@
 #define SATELLITE_STATS_PACKET_COLLISION_HELPER_H
 
 #include <ns3/satellite-stats-helper.h>
+#include <ns3/satellite-stats-identifier-map.h>
 #include <ns3/satellite-phy-rx-carrier.h>
 #include <ns3/ptr.h>
 #include <ns3/address.h>
@@ -115,7 +116,7 @@ private:
   Ptr<DataCollectionObject> m_aggregator;
 
   /// Map of address and the identifier associated with it (for forward link).
-  std::map<const Address, uint32_t> m_identifierMap;
+  SatStatsIdentifierMap m_identifierMap;
 
   std::string m_traceSourceName;
 
@@ -23,6 +23,7 @@
 #define SATELLITE_STATS_PACKET_ERROR_HELPER_H
 
 #include <ns3/satellite-stats-helper.h>
+#include <ns3/satellite-stats-identifier-map.h>
 #include <ns3/satellite-enums.h>
 #include <ns3/satellite-phy-rx-carrier.h>
 #include <ns3/ptr.h>
@@ -144,7 +145,7 @@ private:
   Ptr<DataCollectionObject> m_aggregator;
 
   /// Map of address and the identifier associated with it (for return link).
-  std::map<const Address, uint32_t> m_identifierMap;
+  SatStatsIdentifierMap m_identifierMap;
 
   /// Name of trace source of PHY RX carrier to listen to.
   std::string m_traceSourceName;
@@ -0,0 +1,253 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Budiarto Herman <budiarto.herman@magister.fi>
+ *
+ */
+
+#include <ns3/log.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "satellite-stats-quantile-sketch.h"
+
+NS_LOG_COMPONENT_DEFINE ("SatStatsQuantileSketch");
+
+
+namespace ns3 {
+
+/// Magnitude below which the samples are counted into the zero bucket.
+static const double SAT_SKETCH_MIN_MAGNITUDE = 1e-12;
+
+
+SatStatsQuantileSketch::Store::Store ()
+  : m_offset (0)
+{
+}
+
+
+void
+SatStatsQuantileSketch::Store::Add (int32_t index, uint64_t count, uint32_t maxBuckets)
+{
+  if (m_buckets.empty ())
+    {
+      m_offset = index;
+      m_buckets.push_back (0);
+    }
+  else if (index < m_offset)
+    {
+      m_buckets.insert (m_buckets.begin (), m_offset - index, 0);
+      m_offset = index;
+    }
+  else if (index >= m_offset + static_cast<int32_t> (m_buckets.size ()))
+    {
+      m_buckets.resize (index - m_offset + 1, 0);
+    }
+
+  m_buckets[index - m_offset] += count;
+
+  if (m_buckets.size () > maxBuckets)
+    {
+      // Collapse the buckets of the smallest magnitudes into one.
+      const uint32_t excess = m_buckets.size () - maxBuckets;
+      uint64_t collapsed = 0;
+
+      for (uint32_t i = 0; i < excess; i++)
+        {
+          collapsed += m_buckets[i];
+        }
+
+      m_buckets.erase (m_buckets.begin (), m_buckets.begin () + excess);
+      m_buckets[0] += collapsed;
+      m_offset += excess;
+    }
+}
+
+
+SatStatsQuantileSketch::SatStatsQuantileSketch (double relativeAccuracy,
+                                                uint32_t maxBuckets)
+  : m_relativeAccuracy (relativeAccuracy),
+    m_maxBuckets (maxBuckets),
+    m_gamma ((1.0 + relativeAccuracy) / (1.0 - relativeAccuracy)),
+    m_logGamma (std::log (m_gamma)),
+    m_count (0),
+    m_zeroCount (0),
+    m_min (std::numeric_limits<double>::max ()),
+    m_max (-std::numeric_limits<double>::max ())
+{
+  NS_ASSERT_MSG (relativeAccuracy > 0.0 && relativeAccuracy < 1.0,
+                 "Relative accuracy must be between 0 and 1");
+  NS_ASSERT_MSG (maxBuckets > 0, "At least one bucket is required");
+}
+
+
+int32_t
+SatStatsQuantileSketch::GetBucketIndex (double magnitude) const
+{
+  return static_cast<int32_t> (std::ceil (std::log (magnitude) / m_logGamma));
+}
+
+
+double
+SatStatsQuantileSketch::GetBucketValue (int32_t index) const
+{
+  // The point of the bucket (gamma^(i-1), gamma^i] with the same relative
+  // error to both of its bounds.
+  return 2.0 * std::pow (m_gamma, index) / (m_gamma + 1.0);
+}
+
+
+void
+SatStatsQuantileSketch::Add (double value)
+{
+  if (value > SAT_SKETCH_MIN_MAGNITUDE)
+    {
+      m_positive.Add (GetBucketIndex (value), 1, m_maxBuckets);
+    }
+  else if (value < -SAT_SKETCH_MIN_MAGNITUDE)
+    {
+      m_negative.Add (GetBucketIndex (-value), 1, m_maxBuckets);
+    }
+  else
+    {
+      m_zeroCount++;
+    }
+
+  m_count++;
+  m_min = std::min (m_min, value);
+  m_max = std::max (m_max, value);
+}
+
+
+void
+SatStatsQuantileSketch::Merge (const SatStatsQuantileSketch &other)
+{
+  if (m_relativeAccuracy != other.m_relativeAccuracy)
+    {
+      NS_FATAL_ERROR ("SatStatsQuantileSketch::Merge - Only sketches with the same relative accuracy can be merged");
+    }
+
+  for (uint32_t i = 0; i < other.m_positive.m_buckets.size (); i++)
+    {
+      if (other.m_positive.m_buckets[i] > 0)
+        {
+          m_positive.Add (other.m_positive.m_offset + i, other.m_positive.m_buckets[i], m_maxBuckets);
+        }
+    }
+
+  for (uint32_t i = 0; i < other.m_negative.m_buckets.size (); i++)
+    {
+      if (other.m_negative.m_buckets[i] > 0)
+        {
+          m_negative.Add (other.m_negative.m_offset + i, other.m_negative.m_buckets[i], m_maxBuckets);
+        }
+    }
+
+  m_zeroCount += other.m_zeroCount;
+  m_count += other.m_count;
+  m_min = std::min (m_min, other.m_min);
+  m_max = std::max (m_max, other.m_max);
+}
+
+
+double
+SatStatsQuantileSketch::GetQuantile (double quantile) const
+{
+  NS_ASSERT_MSG (quantile >= 0.0 && quantile <= 1.0,
+                 "Quantile must be between 0 and 1");
+
+  if (m_count == 0)
+    {
+      return 0.0;
+    }
+
+  const uint64_t rank = static_cast<uint64_t> (quantile * (m_count - 1));
+  uint64_t n = 0;
+  double value = 0.0;
+  bool found = false;
+
+  // Negative values from the largest magnitude, then zero, then positive.
+  for (int32_t i = m_negative.m_buckets.size () - 1; i >= 0 && !found; i--)
+    {
+      n += m_negative.m_buckets[i];
+      if (n > rank)
+        {
+          value = -GetBucketValue (m_negative.m_offset + i);
+          found = true;
+        }
+    }
+
+  if (!found)
+    {
+      n += m_zeroCount;
+      found = (n > rank);
+    }
+
+  for (uint32_t i = 0; i < m_positive.m_buckets.size () && !found; i++)
+    {
+      n += m_positive.m_buckets[i];
+      if (n > rank)
+        {
+          value = GetBucketValue (m_positive.m_offset + i);
+          found = true;
+        }
+    }
+
+  return std::max (m_min, std::min (m_max, value));
+}
+
+
+uint64_t
+SatStatsQuantileSketch::GetCount () const
+{
+  return m_count;
+}
+
+
+double
+SatStatsQuantileSketch::GetRelativeAccuracy () const
+{
+  return m_relativeAccuracy;
+}
+
+
+void
+SatStatsQuantileSketch::Print (std::ostream &os) const
+{
+  const std::streamsize precision = os.precision (17);
+
+  os << m_relativeAccuracy << " " << m_count << " "
+     << (m_count > 0 ? m_min : 0.0) << " " << (m_count > 0 ? m_max : 0.0) << " "
+     << m_zeroCount;
+
+  os << " " << m_positive.m_offset << " " << m_positive.m_buckets.size ();
+  for (uint32_t i = 0; i < m_positive.m_buckets.size (); i++)
+    {
+      os << " " << m_positive.m_buckets[i];
+    }
+
+  os << " " << m_negative.m_offset << " " << m_negative.m_buckets.size ();
+  for (uint32_t i = 0; i < m_negative.m_buckets.size (); i++)
+    {
+      os << " " << m_negative.m_buckets[i];
+    }
+
+  os.precision (precision);
+}
+
+
+} // end of namespace ns3
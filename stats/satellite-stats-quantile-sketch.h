@@ -0,0 +1,154 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Budiarto Herman <budiarto.herman@magister.fi>
+ *
+ */
+
+#ifndef SATELLITE_STATS_QUANTILE_SKETCH_H
+#define SATELLITE_STATS_QUANTILE_SKETCH_H
+
+#include <stdint.h>
+#include <ostream>
+#include <vector>
+
+
+namespace ns3 {
+
+
+/**
+ * \ingroup satstats
+ * \brief Mergeable streaming sketch for estimating quantiles of samples.
+ *
+ * The sketch counts the samples in logarithmically sized buckets, where the
+ * bucket of a value v > 0 is ceil (log (v) / log (gamma)) with
+ * gamma = (1 + a) / (1 - a) and a is the relative accuracy. Any quantile is
+ * then estimated within the relative accuracy of the true sample value.
+ * Negative values are counted in a separate mirrored set of buckets, and
+ * values very close to zero in a zero bucket.
+ *
+ * The number of buckets per sign is limited, so the memory is constant
+ * regardless of the number of samples. When the limit is exceeded, the
+ * buckets of the smallest magnitudes are collapsed together, which affects
+ * only the accuracy of the quantiles closest to zero.
+ *
+ * Two sketches with the same relative accuracy are merged by adding the
+ * bucket counts together, e.g. to combine parallel simulation replications.
+ */
+class SatStatsQuantileSketch
+{
+public:
+  /**
+   * \brief Creates an empty sketch.
+   * \param relativeAccuracy relative accuracy of the quantile estimates.
+   * \param maxBuckets maximum number of buckets per sign.
+   */
+  SatStatsQuantileSketch (double relativeAccuracy = 0.01,
+                          uint32_t maxBuckets = 2048);
+
+  /**
+   * \param value the sample to add.
+   */
+  void Add (double value);
+
+  /**
+   * \brief Add the samples of another sketch into this one.
+   * \param other a sketch with the same relative accuracy.
+   */
+  void Merge (const SatStatsQuantileSketch &other);
+
+  /**
+   * \param quantile the quantile between 0 and 1, e.g. 0.99.
+   * \return the estimated sample value at the quantile, or zero if the
+   *         sketch is empty.
+   */
+  double GetQuantile (double quantile) const;
+
+  /**
+   * \return number of samples added to the sketch.
+   */
+  uint64_t GetCount () const;
+
+  /**
+   * \return relative accuracy of the sketch.
+   */
+  double GetRelativeAccuracy () const;
+
+  /**
+   * \brief Write the state of the sketch as a single line of text, from
+   *        which it can be merged later on, e.g. with
+   *        ext-utils/mergeQuantileSketches.py.
+   * \param os the output stream.
+   *
+   * The format is `accuracy count min max zero_count`, followed by
+   * `offset n bucket_1 ... bucket_n` for the positive and the negative
+   * buckets.
+   */
+  void Print (std::ostream &os) const;
+
+private:
+  /**
+   * \brief Dense set of bucket counts for consecutive bucket indices.
+   */
+  class Store
+  {
+public:
+    Store ();
+
+    /**
+     * \brief Add to the count of a bucket, collapsing the lowest buckets if
+     *        the number of buckets would exceed the limit.
+     * \param index the bucket index.
+     * \param count the count to add.
+     * \param maxBuckets maximum number of buckets.
+     */
+    void Add (int32_t index, uint64_t count, uint32_t maxBuckets);
+
+    int32_t m_offset;                  ///< Bucket index of the first count.
+    std::vector<uint64_t> m_buckets;   ///< Bucket counts.
+  };
+
+  /**
+   * \param index a bucket index.
+   * \return the representative magnitude of the bucket.
+   */
+  double GetBucketValue (int32_t index) const;
+
+  /**
+   * \param magnitude a positive value.
+   * \return the bucket index of the value.
+   */
+  int32_t GetBucketIndex (double magnitude) const;
+
+  double    m_relativeAccuracy;   ///< Relative accuracy of the estimates.
+  uint32_t  m_maxBuckets;         ///< Maximum number of buckets per sign.
+  double    m_gamma;              ///< Ratio of consecutive bucket bounds.
+  double    m_logGamma;           ///< Natural logarithm of gamma.
+  uint64_t  m_count;              ///< Number of samples.
+  uint64_t  m_zeroCount;          ///< Number of samples close to zero.
+  double    m_min;                ///< Smallest sample.
+  double    m_max;                ///< Largest sample.
+  Store     m_positive;           ///< Buckets of positive samples.
+  Store     m_negative;           ///< Buckets of negative samples by magnitude.
+
+}; // end of class SatStatsQuantileSketch
+
+
+} // end of namespace ns3
+
+
+#endif /* SATELLITE_STATS_QUANTILE_SKETCH_H */
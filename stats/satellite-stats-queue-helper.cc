@@ -45,6 +45,7 @@
 #include <ns3/interval-rate-collector.h>
 #include <ns3/multi-file-aggregator.h>
 #include <ns3/magister-gnuplot-aggregator.h>
+#include <ns3/satellite-stats-accumulator.h>
 
 #include "satellite-stats-queue-helper.h"
 
@@ -161,6 +162,16 @@ SatStatsQueueHelper::DoInstall ()
 {
   NS_LOG_FUNCTION (this);
 
+  // Accumulate the samples natively instead of collectors, when possible.
+  m_accumulator = CreateAccumulator (m_shortLabel, false, false);
+
+  if (m_accumulator != 0)
+    {
+      EnlistSource ();
+      Simulator::Schedule (m_pollInterval, &SatStatsQueueHelper::Poll, this);
+      return;
+    }
+
   switch (GetOutputType ())
     {
     case SatStatsHelper::OUTPUT_NONE:
@@ -366,6 +377,12 @@ SatStatsQueueHelper::PushToCollector (uint32_t identifier, uint32_t value)
 {
   //NS_LOG_FUNCTION (this << identifier << value);
 
+  if (m_accumulator != 0)
+    {
+      m_accumulator->AddSample (identifier, value);
+      return;
+    }
+
   // Find the collector with the right identifier.
   Ptr<DataCollectionObject> collector = m_terminalCollectors.Get (identifier);
   NS_ASSERT_MSG (collector != 0,
@@ -38,6 +38,7 @@ namespace ns3 {
 class SatHelper;
 class Mac48Address;
 class DataCollectionObject;
+class SatStatsAccumulator;
 
 /**
  * \ingroup satstats
@@ -135,6 +136,9 @@ protected:
   /// The aggregator created by this helper.
   Ptr<DataCollectionObject> m_aggregator;
 
+  /// The native accumulator used instead of collectors and the aggregator.
+  Ptr<SatStatsAccumulator> m_accumulator;
+
 private:
   Time         m_pollInterval;  ///< `PollInterval` attribute.
   UnitType_t   m_unitType;      ///<
@@ -25,6 +25,7 @@
 #include <ns3/enum.h>
 #include <ns3/string.h>
 #include <ns3/boolean.h>
+#include <ns3/callback.h>
 
 #include <ns3/node-container.h>
 #include <ns3/satellite-net-device.h>
@@ -39,6 +40,7 @@
 #include <ns3/scalar-collector.h>
 #include <ns3/multi-file-aggregator.h>
 #include <ns3/magister-gnuplot-aggregator.h>
+#include <ns3/satellite-stats-accumulator.h>
 
 #include "satellite-stats-resources-granted-helper.h"
 
@@ -77,6 +79,21 @@ SatStatsResourcesGrantedHelper::DoInstall ()
 {
   NS_LOG_FUNCTION (this);
 
+  // Accumulate the samples natively instead of collectors, when possible.
+  m_accumulator = CreateAccumulator ("resources_bytes", false, false);
+
+  if (m_accumulator != 0)
+    {
+      // Setup a probe in each UT MAC.
+      NodeContainer uts = GetSatHelper ()->GetBeamHelper ()->GetUtNodes ();
+      for (NodeContainer::Iterator it = uts.Begin (); it != uts.End (); ++it)
+        {
+          InstallProbe (*it, &ScalarCollector::TraceSinkUinteger32);
+        }
+
+      return;
+    }
+
   switch (GetOutputType ())
     {
     case SatStatsHelper::OUTPUT_NONE:
@@ -313,11 +330,25 @@ SatStatsResourcesGrantedHelper::InstallProbe (Ptr<Node> utNode,
   // Connect the object to the probe.
   if (probe->ConnectByObject ("DaResourcesTrace", satUtMac))
     {
+      bool ret = false;
+
       // Connect the probe to the right collector.
-      if (m_terminalCollectors.ConnectWithProbe (probe->GetObject<Probe> (),
-                                                 "Output",
-                                                 identifier,
-                                                 collectorTraceSink))
+      if (m_accumulator != 0)
+        {
+          ret = probe->TraceConnectWithoutContext ("Output",
+                                                   MakeBoundCallback (&SatStatsAccumulator::TraceSinkUinteger32,
+                                                                      m_accumulator,
+                                                                      identifier));
+        }
+      else
+        {
+          ret = m_terminalCollectors.ConnectWithProbe (probe->GetObject<Probe> (),
+                                                       "Output",
+                                                       identifier,
+                                                       collectorTraceSink);
+        }
+
+      if (ret)
         {
           NS_LOG_INFO (this << " created probe " << probeName.str ()
                             << ", connected to collector " << identifier);
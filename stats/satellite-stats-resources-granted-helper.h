@@ -33,6 +33,7 @@ namespace ns3 {
 
 class SatHelper;
 class DataCollectionObject;
+class SatStatsAccumulator;
 
 /**
  * \ingroup satstats
@@ -63,7 +64,8 @@ protected:
 private:
   /**
    * \param utNode
-   * \param collectorTraceSink
+   * \param collectorTraceSink not used when the samples are accumulated
+   *                           natively.
    */
   template<typename R, typename C, typename P>
   void InstallProbe (Ptr<Node> utNode,
@@ -78,6 +80,9 @@ private:
   /// The aggregator created by this helper.
   Ptr<DataCollectionObject> m_aggregator;
 
+  /// The native accumulator used instead of collectors and the aggregator.
+  Ptr<SatStatsAccumulator> m_accumulator;
+
 }; // end of class SatStatsResourcesGrantedHelper
 
 
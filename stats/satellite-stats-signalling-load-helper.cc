@@ -260,9 +260,9 @@ SatStatsSignallingLoadHelper::SignallingTxCallback (Ptr<const Packet> packet,
       else
         {
           // Determine the identifier associated with the sender address.
-          std::map<const Address, uint32_t>::const_iterator it = m_identifierMap.find (addr);
+          uint32_t identifier;
 
-          if (it == m_identifierMap.end ())
+          if (!m_identifierMap.Find (addr, identifier))
             {
               NS_LOG_WARN (this << " discarding packet " << packet
                                 << " (" << packet->GetSize () << " bytes)"
@@ -272,9 +272,9 @@ SatStatsSignallingLoadHelper::SignallingTxCallback (Ptr<const Packet> packet,
           else
             {
               // Find the first-level collector with the right identifier.
-              Ptr<DataCollectionObject> collector = m_conversionCollectors.Get (it->second);
+              Ptr<DataCollectionObject> collector = m_conversionCollectors.Get (identifier);
               NS_ASSERT_MSG (collector != 0,
-                             "Unable to find collector with identifier " << it->second);
+                             "Unable to find collector with identifier " << identifier);
               Ptr<UnitConversionCollector> c = collector->GetObject<UnitConversionCollector> ();
               NS_ASSERT (c != 0);
 
@@ -303,7 +303,7 @@ SatStatsSignallingLoadHelper::SaveAddressAndIdentifier (Ptr<Node> utNode)
   else
     {
       const uint32_t identifier = GetIdentifierForUt (utNode);
-      m_identifierMap[addr] = identifier;
+      m_identifierMap.Insert (addr, identifier);
       NS_LOG_INFO (this << " associated address " << addr
                         << " with identifier " << identifier);
 
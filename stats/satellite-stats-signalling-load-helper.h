@@ -23,6 +23,7 @@
 #define SATELLITE_STATS_SIGNALLING_LOAD_HELPER_H
 
 #include <ns3/satellite-stats-helper.h>
+#include <ns3/satellite-stats-identifier-map.h>
 #include <ns3/ptr.h>
 #include <ns3/address.h>
 #include <ns3/collector-map.h>
@@ -110,7 +111,7 @@ protected:
   Ptr<DataCollectionObject> m_aggregator;
 
   /// Map of address and the identifier associated with it (for forward link).
-  std::map<const Address, uint32_t> m_identifierMap;
+  SatStatsIdentifierMap m_identifierMap;
 
 }; // end of class SatStatsSignallingLoadHelper
 
@@ -49,6 +49,7 @@
 #include <ns3/scalar-collector.h>
 #include <ns3/multi-file-aggregator.h>
 #include <ns3/magister-gnuplot-aggregator.h>
+#include <ns3/satellite-stats-accumulator.h>
 
 #include <sstream>
 #include "satellite-stats-throughput-helper.h"
@@ -112,6 +113,15 @@ SatStatsThroughputHelper::DoInstall ()
 {
   NS_LOG_FUNCTION (this);
 
+  // Accumulate the samples natively instead of collectors, when possible.
+  m_accumulator = CreateAccumulator ("throughput_kbps", m_averagingMode, true);
+
+  if (m_accumulator != 0)
+    {
+      InstallProbes ();
+      return;
+    }
+
   switch (GetOutputType ())
     {
     case SatStatsHelper::OUTPUT_NONE:
@@ -400,9 +410,9 @@ SatStatsThroughputHelper::RxCallback (Ptr<const Packet> packet,
   else
     {
       // Determine the identifier associated with the sender address.
-      std::map<const Address, uint32_t>::const_iterator it = m_identifierMap.find (from);
+      uint32_t identifier;
 
-      if (it == m_identifierMap.end ())
+      if (!m_identifierMap.Find (from, identifier))
         {
           NS_LOG_WARN (this << " discarding packet " << packet
                             << " (" << packet->GetSize () << " bytes)"
@@ -411,21 +421,68 @@ SatStatsThroughputHelper::RxCallback (Ptr<const Packet> packet,
         }
       else
         {
-          // Find the first-level collector with the right identifier.
-          Ptr<DataCollectionObject> collector = m_conversionCollectors.Get (it->second);
-          NS_ASSERT_MSG (collector != 0,
-                         "Unable to find collector with identifier " << it->second);
-          Ptr<UnitConversionCollector> c = collector->GetObject<UnitConversionCollector> ();
-          NS_ASSERT (c != 0);
-
-          // Pass the sample to the collector.
-          c->TraceSinkUinteger32 (0, packet->GetSize ());
+          PassSampleToCollector (packet->GetSize (), identifier);
         }
     }
 
 } // end of `void RxCallback (Ptr<const Packet>, const Address);`
 
 
+bool
+SatStatsThroughputHelper::ConnectProbeToCollector (Ptr<Probe> probe,
+                                                   uint32_t identifier)
+{
+  NS_LOG_FUNCTION (this << probe << probe->GetName () << identifier);
+
+  if (m_accumulator != 0)
+    {
+      return probe->TraceConnectWithoutContext ("OutputBytes",
+                                                MakeBoundCallback (&SatStatsThroughputHelper::AccumulateBytes,
+                                                                   m_accumulator,
+                                                                   identifier));
+    }
+
+  return m_conversionCollectors.ConnectWithProbe (probe,
+                                                  "OutputBytes",
+                                                  identifier,
+                                                  &UnitConversionCollector::TraceSinkUinteger32);
+}
+
+
+void
+SatStatsThroughputHelper::PassSampleToCollector (uint32_t bytes, uint32_t identifier)
+{
+  //NS_LOG_FUNCTION (this << bytes << identifier);
+
+  if (m_accumulator != 0)
+    {
+      AccumulateBytes (m_accumulator, identifier, 0, bytes);
+      return;
+    }
+
+  // Find the first-level collector with the right identifier.
+  Ptr<DataCollectionObject> collector = m_conversionCollectors.Get (identifier);
+  NS_ASSERT_MSG (collector != 0,
+                 "Unable to find collector with identifier " << identifier);
+  Ptr<UnitConversionCollector> c = collector->GetObject<UnitConversionCollector> ();
+  NS_ASSERT (c != 0);
+
+  // Pass the sample to the collector.
+  c->TraceSinkUinteger32 (0, bytes);
+}
+
+
+void // static
+SatStatsThroughputHelper::AccumulateBytes (Ptr<SatStatsAccumulator> accumulator,
+                                           uint32_t identifier,
+                                           uint32_t oldValue,
+                                           uint32_t newValue)
+{
+  // The same conversion as UnitConversionCollector::FROM_BYTES_TO_KBIT.
+  accumulator->AddSample (identifier, newValue * 0.008);
+}
+
+
 void
 SatStatsThroughputHelper::SaveAddressAndIdentifier (Ptr<Node> utNode)
 {
@@ -442,7 +499,7 @@ SatStatsThroughputHelper::SaveAddressAndIdentifier (Ptr<Node> utNode)
   else
     {
       const uint32_t identifier = GetIdentifierForUt (utNode);
-      m_identifierMap[addr] = identifier;
+      m_identifierMap.Insert (addr, identifier);
       NS_LOG_INFO (this << " associated address " << addr
                         << " with identifier " << identifier);
 
@@ -502,10 +559,7 @@ SatStatsFwdAppThroughputHelper::DoInstallProbes ()
           if (probe->ConnectByObject ("Rx", (*it)->GetApplication (i)))
             {
               // Connect the probe to the right collector.
-              if (m_conversionCollectors.ConnectWithProbe (probe->GetObject<Probe> (),
-                                                           "OutputBytes",
-                                                           identifier,
-                                                           &UnitConversionCollector::TraceSinkUinteger32))
+              if (ConnectProbeToCollector (probe->GetObject<Probe> (), identifier))
                 {
                   NS_LOG_INFO (this << " created probe " << probeName.str ()
                                     << ", connected to collector " << identifier);
@@ -588,10 +642,7 @@ SatStatsFwdDevThroughputHelper::DoInstallProbes ()
       if (probe->ConnectByObject ("Rx", dev))
         {
           // Connect the probe to the right collector.
-          if (m_conversionCollectors.ConnectWithProbe (probe->GetObject<Probe> (),
-                                                       "OutputBytes",
-                                                       identifier,
-                                                       &UnitConversionCollector::TraceSinkUinteger32))
+          if (ConnectProbeToCollector (probe->GetObject<Probe> (), identifier))
             {
               NS_LOG_INFO (this << " created probe " << probeName.str ()
                                 << ", connected to collector " << identifier);
@@ -688,10 +739,7 @@ SatStatsFwdMacThroughputHelper::DoInstallProbes ()
       if (probe->ConnectByObject ("Rx", satMac))
         {
           // Connect the probe to the right collector.
-          if (m_conversionCollectors.ConnectWithProbe (probe->GetObject<Probe> (),
-                                                       "OutputBytes",
-                                                       identifier,
-                                                       &UnitConversionCollector::TraceSinkUinteger32))
+          if (ConnectProbeToCollector (probe->GetObject<Probe> (), identifier))
             {
               NS_LOG_INFO (this << " created probe " << probeName.str ()
                                 << ", connected to collector " << identifier);
@@ -794,10 +842,7 @@ SatStatsFwdPhyThroughputHelper::DoInstallProbes ()
       if (probe->ConnectByObject ("Rx", satPhy))
         {
           // Connect the probe to the right collector.
-          if (m_conversionCollectors.ConnectWithProbe (probe->GetObject<Probe> (),
-                                                       "OutputBytes",
-                                                       identifier,
-                                                       &UnitConversionCollector::TraceSinkUinteger32))
+          if (ConnectProbeToCollector (probe->GetObject<Probe> (), identifier))
             {
               NS_LOG_INFO (this << " created probe " << probeName.str ()
                                 << ", connected to collector " << identifier);
@@ -928,9 +973,9 @@ SatStatsRtnAppThroughputHelper::Ipv4Callback (Ptr<const Packet> packet,
     {
       // Determine the identifier associated with the sender address.
       const Address ipv4Addr = InetSocketAddress::ConvertFrom (from).GetIpv4 ();
-      std::map<const Address, uint32_t>::const_iterator it1 = m_identifierMap.find (ipv4Addr);
+      uint32_t identifier;
 
-      if (it1 == m_identifierMap.end ())
+      if (!m_identifierMap.Find (ipv4Addr, identifier))
         {
           NS_LOG_WARN (this << " discarding packet " << packet
                             << " (" << packet->GetSize () << " bytes)"
@@ -939,15 +984,7 @@ SatStatsRtnAppThroughputHelper::Ipv4Callback (Ptr<const Packet> packet,
         }
       else
         {
-          // Find the collector with the right identifier.
-          Ptr<DataCollectionObject> collector = m_conversionCollectors.Get (it1->second);
-          NS_ASSERT_MSG (collector != 0,
-                         "Unable to find collector with identifier " << it1->second);
-          Ptr<UnitConversionCollector> c = collector->GetObject<UnitConversionCollector> ();
-          NS_ASSERT (c != 0);
-
-          // Pass the sample to the collector.
-          c->TraceSinkUinteger32 (0, packet->GetSize ());
+          PassSampleToCollector (packet->GetSize (), identifier);
         }
     }
   else
@@ -985,7 +1022,7 @@ SatStatsRtnAppThroughputHelper::SaveIpv4AddressAndIdentifier (Ptr<Node> utUserNo
       for (uint32_t i = 0; i < ipv4->GetNAddresses (1); i++)
         {
           const Address addr = ipv4->GetAddress (1, i).GetLocal ();
-          m_identifierMap[addr] = identifier;
+          m_identifierMap.Insert (addr, identifier);
           NS_LOG_INFO (this << " associated address " << addr
                             << " with identifier " << identifier);
         }
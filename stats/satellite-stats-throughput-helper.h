@@ -23,6 +23,7 @@
 #define SATELLITE_STATS_THROUGHPUT_HELPER_H
 
 #include <ns3/satellite-stats-helper.h>
+#include <ns3/satellite-stats-identifier-map.h>
 #include <ns3/ptr.h>
 #include <ns3/address.h>
 #include <ns3/collector-map.h>
@@ -38,8 +39,10 @@ namespace ns3 {
 class SatHelper;
 class Node;
 class Packet;
+class Probe;
 class DataCollectionObject;
 class DistributionCollector;
+class SatStatsAccumulator;
 
 /**
  * \ingroup satstats
@@ -111,6 +114,21 @@ protected:
    */
   void SaveAddressAndIdentifier (Ptr<Node> utNode);
 
+  /**
+   * \brief Connect the probe to the right collector.
+   * \param probe
+   * \param identifier
+   */
+  bool ConnectProbeToCollector (Ptr<Probe> probe, uint32_t identifier);
+
+  /**
+   * \brief Find a collector with the right identifier and pass a sample data
+   *        to it.
+   * \param bytes
+   * \param identifier
+   */
+  void PassSampleToCollector (uint32_t bytes, uint32_t identifier);
+
   /// Maintains a list of first-level collectors created by this helper.
   CollectorMap m_conversionCollectors;
 
@@ -123,10 +141,26 @@ protected:
   /// The aggregator created by this helper.
   Ptr<DataCollectionObject> m_aggregator;
 
+  /// The native accumulator used instead of collectors and the aggregator.
+  Ptr<SatStatsAccumulator> m_accumulator;
+
   /// Map of address and the identifier associated with it (for return link).
-  std::map<const Address, uint32_t> m_identifierMap;
+  SatStatsIdentifierMap m_identifierMap;
 
 private:
+  /**
+   * \brief Trace sink of the probes, passing the received bytes in kilobits
+   *        to the accumulator.
+   * \param accumulator the accumulator.
+   * \param identifier the identifier of the probe.
+   * \param oldValue unused.
+   * \param newValue number of received bytes.
+   */
+  static void AccumulateBytes (Ptr<SatStatsAccumulator> accumulator,
+                               uint32_t identifier,
+                               uint32_t oldValue,
+                               uint32_t newValue);
+
   bool m_averagingMode;  ///< `AveragingMode` attribute.
 
 }; // end of class SatStatsThroughputHelper
@@ -18,11 +18,21 @@
  * Author: Jani Puttonen <jani.puttonen@magister.fi>
  */
 
+#include <cstdio>
+#include <cmath>
+#include <fstream>
+#include <set>
+#include <vector>
 #include "ns3/log.h"
 #include "ns3/test.h"
 #include "ns3/simulator.h"
+#include "ns3/config.h"
+#include "ns3/boolean.h"
+#include "ns3/string.h"
+#include "ns3/double.h"
 #include "../model/satellite-antenna-gain-pattern.h"
 #include "../model/satellite-antenna-gain-pattern-container.h"
+#include "../model/satellite-utils.h"
 #include "ns3/singleton.h"
 #include "../utils/satellite-env-variables.h"
 
@@ -115,8 +125,253 @@ SatAntennaPatternTestCase::DoRun (void)
 
       NS_TEST_ASSERT_MSG_EQ_TOL ( gain_dB, expectedGains[i], 0.001, "Expected gain not within tolerance");
       NS_TEST_ASSERT_MSG_EQ ( bestBeamId, expectedBeamIds[i], "Not expected best spot-beam id");
+
+      // Gains of all the beams at once have to match the beam specific gains
+      std::vector<double> gains;
+      gpContainer.GetAntennaGains_lin (coordinates[i], gains);
+
+      NS_TEST_ASSERT_MSG_EQ ( gains.size (), gpContainer.GetNumOfBeams (), "Not expected number of gains");
+      NS_TEST_ASSERT_MSG_EQ ( gains[bestBeamId - 1], gain, "Multi-beam gain differs from the beam specific gain");
+    }
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Satellite antenna pattern binary cache test case implementation.
+ *
+ * This case reads an antenna gain pattern with the binary cache enabled twice:
+ * first from the text file, which writes the cache file into the configured
+ * cache directory, and then from the memory mapped cache file. The gain grids
+ * and the interpolated gains of both patterns are compared. Finally a copy of
+ * the antenna pattern file in another directory is read, which must not use
+ * the cache file of the original file.
+ */
+class SatAntennaPatternCacheTestCase : public TestCase
+{
+public:
+  SatAntennaPatternCacheTestCase ();
+  virtual ~SatAntennaPatternCacheTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SatAntennaPatternCacheTestCase::SatAntennaPatternCacheTestCase ()
+  : TestCase ("Test satellite antenna gain pattern binary cache.")
+{
+}
+
+SatAntennaPatternCacheTestCase::~SatAntennaPatternCacheTestCase ()
+{
+}
+
+void
+SatAntennaPatternCacheTestCase::DoRun (void)
+{
+  // Set simulation output details
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-antenna-gain-pattern", "cache", true);
+
+  std::string dataPath = Singleton<SatEnvVariables>::Get ()->LocateDataDirectory ();
+  std::string filePathName = dataPath + "/antennapatterns/SatAntennaGain72Beams_12.txt";
+  std::string cacheDirectory = Singleton<SatEnvVariables>::Get ()->GetOutputPath ();
+  std::string cacheFilePathName = SatAntennaGainPattern::GetCacheFilePathName (cacheDirectory, filePathName);
+
+  // A copy of the antenna pattern file with the same name in another directory
+  std::string copyFilePathName = cacheDirectory + "/SatAntennaGain72Beams_12.txt";
+  std::string copyCacheFilePathName = SatAntennaGainPattern::GetCacheFilePathName (cacheDirectory, copyFilePathName);
+
+  NS_TEST_ASSERT_MSG_EQ (cacheFilePathName.find (cacheDirectory + "/SatAntennaGain72Beams_12.txt."), 0, "Cache file not named after antenna pattern file");
+  NS_TEST_ASSERT_MSG_NE (cacheFilePathName, copyCacheFilePathName, "Same cache file for antenna pattern files in different directories");
+
+  // Start without cache files
+  std::remove (cacheFilePathName.c_str ());
+  std::remove (copyCacheFilePathName.c_str ());
+
+  std::ifstream source (filePathName.c_str (), std::ifstream::binary);
+  std::ofstream copy (copyFilePathName.c_str (), std::ofstream::binary);
+  copy << source.rdbuf ();
+  copy.close ();
+
+  Config::SetDefault ("ns3::SatAntennaGainPattern::EnableBinaryCache", BooleanValue (true));
+  Config::SetDefault ("ns3::SatAntennaGainPattern::BinaryCacheDirectory", StringValue (cacheDirectory));
+
+  Ptr<SatAntennaGainPattern> parsedPattern = CreateObject<SatAntennaGainPattern> (filePathName);
+  Ptr<SatAntennaGainPattern> cachedPattern = CreateObject<SatAntennaGainPattern> (filePathName);
+  Ptr<SatAntennaGainPattern> copiedPattern = CreateObject<SatAntennaGainPattern> (copyFilePathName);
+
+  Config::SetDefault ("ns3::SatAntennaGainPattern::EnableBinaryCache", BooleanValue (false));
+  Config::SetDefault ("ns3::SatAntennaGainPattern::BinaryCacheDirectory", StringValue (""));
+
+  NS_TEST_ASSERT_MSG_EQ (parsedPattern->IsReadFromCache (), false, "Antenna pattern without cache file read from cache");
+  NS_TEST_ASSERT_MSG_EQ (cachedPattern->IsReadFromCache (), true, "Antenna pattern not read from cache file");
+  NS_TEST_ASSERT_MSG_EQ (Singleton<SatEnvVariables>::Get ()->IsValidFile (cacheFilePathName), true, "Cache file not written to cache directory");
+  NS_TEST_ASSERT_MSG_EQ (Singleton<SatEnvVariables>::Get ()->IsValidFile (filePathName + ".cache"), false, "Cache file written next to antenna pattern file");
+  NS_TEST_ASSERT_MSG_EQ (copiedPattern->IsReadFromCache (), false, "Copied antenna pattern read from cache file of original file");
+  NS_TEST_ASSERT_MSG_EQ (Singleton<SatEnvVariables>::Get ()->IsValidFile (copyCacheFilePathName), true, "Cache file of copied antenna pattern not written");
+  NS_TEST_ASSERT_MSG_EQ (copiedPattern->HasSameGrid (parsedPattern), true, "Not the same antenna pattern grid in copy");
+
+  NS_TEST_ASSERT_MSG_EQ (parsedPattern->HasSameGrid (cachedPattern), true, "Not the same antenna pattern grid");
+  NS_TEST_ASSERT_MSG_EQ (cachedPattern->GetNumOfGridPoints (), parsedPattern->GetNumOfGridPoints (), "Not the same number of grid points");
+
+  const double* parsedGains = parsedPattern->GetAntennaGainGrid_lin ();
+  const double* cachedGains = cachedPattern->GetAntennaGainGrid_lin ();
+
+  for (uint32_t i = 0; i < parsedPattern->GetNumOfGridPoints (); ++i)
+    {
+      if (std::isnan (parsedGains[i]))
+        {
+          NS_TEST_ASSERT_MSG_EQ (std::isnan (cachedGains[i]), true, "Valid gain in cache for invalid grid point " << i);
+        }
+      else
+        {
+          NS_TEST_ASSERT_MSG_EQ (cachedGains[i], parsedGains[i], "Different gain in cache for grid point " << i);
+        }
     }
 
+  // Test position (= GW position of beam 12 in 72 spot-beam reference system)
+  GeoCoordinate coordinate = GeoCoordinate (50.25, 3.75, 0.0);
+
+  NS_TEST_ASSERT_MSG_EQ (cachedPattern->GetAntennaGain_lin (coordinate), parsedPattern->GetAntennaGain_lin (coordinate), "Different interpolated gain from cache");
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Satellite antenna pattern valid random position test case implementation.
+ *
+ * This case draws valid random positions from an antenna pattern file written
+ * by the test, with a row of invalid (NaN) grid points and a column of grid
+ * points below the minimum acceptable antenna gain, and from a shipped antenna
+ * pattern file.
+ *
+ * Expected results:
+ * - All the four corner grid points of the grid cell of every drawn position
+ *   are valid positions, i.e. they have a gain above the minimum acceptable gain
+ * - No position is drawn from the grid cells next to the invalid row and column
+ * - All the valid grid cells of the written antenna pattern are drawn
+ */
+class SatAntennaPatternValidPositionTestCase : public TestCase
+{
+public:
+  SatAntennaPatternValidPositionTestCase ();
+  virtual ~SatAntennaPatternValidPositionTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Draw valid random positions and check the corners of their grid cells.
+   * \param pattern Antenna gain pattern
+   * \param numOfPositions Number of positions to draw
+   * \param positions Drawn positions
+   */
+  void DrawPositions (Ptr<SatAntennaGainPattern> pattern, uint32_t numOfPositions, std::vector<GeoCoordinate>& positions);
+};
+
+SatAntennaPatternValidPositionTestCase::SatAntennaPatternValidPositionTestCase ()
+  : TestCase ("Test satellite antenna gain pattern valid random positions.")
+{
+}
+
+SatAntennaPatternValidPositionTestCase::~SatAntennaPatternValidPositionTestCase ()
+{
+}
+
+void
+SatAntennaPatternValidPositionTestCase::DrawPositions (Ptr<SatAntennaGainPattern> pattern, uint32_t numOfPositions, std::vector<GeoCoordinate>& positions)
+{
+  DoubleValue minGain_dB;
+  pattern->GetAttribute ("MinAcceptableAntennaGainDb", minGain_dB);
+
+  const double* gains = pattern->GetAntennaGainGrid_lin ();
+
+  for (uint32_t i = 0; i < numOfPositions; ++i)
+    {
+      GeoCoordinate position = pattern->GetValidRandomPosition ();
+      SatAntennaGainPattern::InterpolationPoint_s point = pattern->GetInterpolationPoint (position);
+
+      uint32_t corners[4] = { point.lowerLeftIndex, point.lowerLeftIndex + 1, point.upperLeftIndex, point.upperLeftIndex + 1 };
+
+      for (uint32_t c = 0; c < 4; ++c)
+        {
+          NS_TEST_ASSERT_MSG_EQ ((corners[c] < pattern->GetNumOfGridPoints ()), true, "Corner of drawn position outside the grid");
+          NS_TEST_ASSERT_MSG_EQ (std::isnan (gains[corners[c]]), false, "Invalid corner of drawn position");
+          NS_TEST_ASSERT_MSG_GT (SatUtils::LinearToDb (gains[corners[c]]), minGain_dB.Get () - 1e-9, "Corner of drawn position below minimum gain");
+        }
+
+      positions.push_back (position);
+    }
+}
+
+void
+SatAntennaPatternValidPositionTestCase::DoRun (void)
+{
+  // Set simulation output details
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-antenna-gain-pattern", "valid-position", true);
+
+  // Grid of 6 x 6 points with an invalid row at latitude 12 and a column
+  // below the minimum acceptable gain at longitude 23
+  std::string filePathName = Singleton<SatEnvVariables>::Get ()->GetOutputPath () + "/ValidPositionTestPattern.txt";
+  std::ofstream ofs (filePathName.c_str ());
+
+  for (uint32_t lat = 10; lat <= 15; ++lat)
+    {
+      for (uint32_t lon = 20; lon <= 25; ++lon)
+        {
+          ofs << lat << " " << lon << " ";
+
+          if (lat == 12)
+            {
+              ofs << "NaN";
+            }
+          else if (lon == 23)
+            {
+              ofs << "40.0";
+            }
+          else
+            {
+              ofs << "50.0";
+            }
+
+          ofs << std::endl;
+        }
+    }
+
+  ofs.close ();
+
+  Ptr<SatAntennaGainPattern> pattern = CreateObject<SatAntennaGainPattern> (filePathName);
+
+  std::vector<GeoCoordinate> positions;
+  DrawPositions (pattern, 1000, positions);
+
+  std::set< std::pair<uint32_t, uint32_t> > cells;
+
+  for (uint32_t i = 0; i < positions.size (); ++i)
+    {
+      uint32_t latIndex = (uint32_t) std::floor (positions[i].GetLatitude ());
+      uint32_t lonIndex = (uint32_t) std::floor (positions[i].GetLongitude ());
+
+      NS_TEST_ASSERT_MSG_EQ ((latIndex == 11 || latIndex == 12), false, "Position drawn next to the invalid row at latitude " << positions[i].GetLatitude ());
+      NS_TEST_ASSERT_MSG_EQ ((lonIndex == 22 || lonIndex == 23), false, "Position drawn next to the invalid column at longitude " << positions[i].GetLongitude ());
+
+      cells.insert (std::make_pair (latIndex, lonIndex));
+    }
+
+  // Latitudes 10, 13 and 14 and longitudes 20, 21 and 24 of the lower left corners
+  NS_TEST_ASSERT_MSG_EQ (cells.size (), 9, "Not all the valid grid cells drawn");
+
+  // Shipped antenna pattern
+  std::string dataPath = Singleton<SatEnvVariables>::Get ()->LocateDataDirectory ();
+  Ptr<SatAntennaGainPattern> shippedPattern = CreateObject<SatAntennaGainPattern> (dataPath + "/antennapatterns/SatAntennaGain72Beams_12.txt");
+
+  positions.clear ();
+  DrawPositions (shippedPattern, 1000, positions);
+
   Singleton<SatEnvVariables>::Get ()->DoDispose ();
 }
 
@@ -134,6 +389,8 @@ SatAntennaPatternTestSuite::SatAntennaPatternTestSuite ()
   : TestSuite ("sat-antenna-gain-pattern-test", UNIT)
 {
   AddTestCase (new SatAntennaPatternTestCase, TestCase::QUICK);
+  AddTestCase (new SatAntennaPatternCacheTestCase, TestCase::QUICK);
+  AddTestCase (new SatAntennaPatternValidPositionTestCase, TestCase::QUICK);
 }
 
 // Do allocate an instance of this TestSuite
@@ -0,0 +1,779 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Jani Puttonen <jani.puttonen@magister.fi>
+ */
+
+/**
+ * \file satellite-channel-test.cc
+ * \ingroup satellite
+ * \brief Test cases to unit test the shared bursts, the destination node
+ * receivers, the interference culling and the link budget cache of SatChannel.
+ */
+
+#include <cmath>
+#include <sstream>
+#include <set>
+#include <vector>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/config.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/enum.h"
+#include "ns3/string.h"
+#include "ns3/object-vector.h"
+#include "ns3/cbr-helper.h"
+#include "ns3/packet.h"
+#include "ns3/mac48-address.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/channel-list.h"
+#include "../model/satellite-channel.h"
+#include "../model/satellite-net-device.h"
+#include "../model/satellite-phy.h"
+#include "../model/satellite-phy-tx.h"
+#include "../model/satellite-phy-rx.h"
+#include "../model/satellite-phy-rx-carrier.h"
+#include "../model/satellite-signal-parameters.h"
+#include "../model/satellite-mac-tag.h"
+#include "../model/satellite-mobility-model.h"
+#include "../model/satellite-utils.h"
+#include "../helper/satellite-helper.h"
+#include "../helper/satellite-beam-helper.h"
+#include "ns3/singleton.h"
+#include "../utils/satellite-env-variables.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test the burst shared by the receivers of a transmission.
+ *
+ *   1.  Create the larger scenario and a burst of tagged packets transmitted
+ *       by a UT to the return user channel.
+ *   2.  Remove the tags from the packets of the transmitter after the burst
+ *       has been created.
+ *   3.  Start the reception of the burst at all the receivers of the channel.
+ *   4.  Remove the tags from the packets of a receiver copy of the burst.
+ *
+ *   Expected result:
+ *     The burst keeps its tagged packets, i.e. it is not modified by the
+ *     transmitter nor by the receivers. The packets of the burst are copied
+ *     only by the receivers in the beam of the transmission, which receive
+ *     the burst, and not by the receivers which see it only as interference.
+ *     No receiver holds a reference to the packets of the burst.
+ */
+class SatChannelSharedBurstTestCase : public TestCase
+{
+public:
+  SatChannelSharedBurstTestCase ();
+  virtual ~SatChannelSharedBurstTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Check that the packets of the burst are not modified.
+   * \param burst the burst
+   * \param uids the UIDs of the transmitted packets
+   */
+  void CheckBurst (Ptr<const SatSignalBurst> burst, const std::vector<uint64_t>& uids);
+
+  /**
+   * \brief Trace sink for the received power of the carriers, i.e.
+   * the receptions started.
+   * \param rxPower_dbW received power in dBW
+   */
+  void RxPowerCallback (double rxPower_dbW);
+
+  uint32_t m_receptions;
+};
+
+SatChannelSharedBurstTestCase::SatChannelSharedBurstTestCase ()
+  : TestCase ("Test the burst shared by the receivers of a transmission."),
+    m_receptions (0)
+{
+}
+
+SatChannelSharedBurstTestCase::~SatChannelSharedBurstTestCase ()
+{
+}
+
+void
+SatChannelSharedBurstTestCase::RxPowerCallback (double rxPower_dbW)
+{
+  m_receptions++;
+}
+
+void
+SatChannelSharedBurstTestCase::CheckBurst (Ptr<const SatSignalBurst> burst, const std::vector<uint64_t>& uids)
+{
+  const SatSignalParameters::PacketsInBurst_t& packets = burst->GetTxParams ()->m_packetsInBurst;
+
+  NS_TEST_ASSERT_MSG_EQ (packets.size (), uids.size (), "Unexpected number of packets in burst");
+
+  for (uint32_t i = 0; (i < packets.size ()) && (i < uids.size ()); ++i)
+    {
+      SatMacTag tag;
+
+      NS_TEST_ASSERT_MSG_EQ (packets[i]->GetUid (), uids[i], "Unexpected packet in burst");
+      NS_TEST_ASSERT_MSG_EQ (packets[i]->PeekPacketTag (tag), true, "Packet in burst modified");
+      NS_TEST_ASSERT_MSG_EQ (packets[i]->GetReferenceCount (), 1, "Packet in burst referenced outside the burst");
+    }
+}
+
+void
+SatChannelSharedBurstTestCase::DoRun (void)
+{
+  // Set simulation output details
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-sat-channel", "shared-burst", true);
+
+  Ptr<SatHelper> helper = CreateObject<SatHelper> ();
+  helper->CreatePredefinedScenario (SatHelper::LARGER);
+
+  // Device #0 is the loopback device, #1 the subscriber network device and #2 the satellite device
+  Ptr<SatNetDevice> utDev = DynamicCast<SatNetDevice> (helper->UtNodes ().Get (0)->GetDevice (2));
+  NS_TEST_ASSERT_MSG_NE (utDev, 0, "UT device not found");
+
+  Ptr<SatPhy> utPhy = utDev->GetPhy ();
+  Ptr<SatSignalParameters> txParams = Create<SatSignalParameters> ();
+  txParams->m_phyTx = utPhy->GetPhyTx ();
+  txParams->m_beamId = utPhy->GetPhyRx ()->GetBeamId ();
+  txParams->m_carrierId = 0;
+  txParams->m_duration = MilliSeconds (1);
+  txParams->m_txPower_W = 1.0;
+  txParams->m_sinr = 1.0;
+  txParams->m_txInfo.packetType = SatEnums::PACKET_TYPE_DEDICATED_ACCESS;
+
+  std::vector<uint64_t> uids;
+
+  for (uint32_t i = 0; i < 3; ++i)
+    {
+      Ptr<Packet> packet = Create<Packet> (100);
+      SatMacTag tag;
+      tag.SetSourceAddress (Mac48Address::ConvertFrom (utDev->GetAddress ()));
+      tag.SetDestAddress (Mac48Address ("00:00:00:00:00:01"));
+      packet->AddPacketTag (tag);
+
+      txParams->m_packetsInBurst.push_back (packet);
+      uids.push_back (packet->GetUid ());
+    }
+
+  Ptr<SatSignalBurst> burst = Create<SatSignalBurst> (txParams);
+
+  // The transmitter may modify its own packets right after the transmission
+  for (uint32_t i = 0; i < txParams->m_packetsInBurst.size (); ++i)
+    {
+      SatMacTag tag;
+      txParams->m_packetsInBurst[i]->RemovePacketTag (tag);
+    }
+
+  CheckBurst (burst, uids);
+
+  // Start the reception at all the receivers of the return user channel
+  Ptr<SatChannel> channel = txParams->m_phyTx->GetChannel ();
+  channel->SetAttribute ("EnableInterferenceCulling", BooleanValue (false));
+  SatChannel::PhyRxContainer receivers = channel->GetAllBeamsReceivers (txParams);
+
+  uint32_t beamReceivers = 0;
+
+  for (uint32_t i = 0; i < receivers.size (); ++i)
+    {
+      ObjectVectorValue carriers;
+      receivers[i]->GetAttribute ("RxCarrierList", carriers);
+
+      for (ObjectVectorValue::Iterator it = carriers.Begin (); it != carriers.End (); ++it)
+        {
+          it->second->TraceConnectWithoutContext ("RxPowerTrace", MakeCallback (&SatChannelSharedBurstTestCase::RxPowerCallback, this));
+        }
+
+      if (receivers[i]->GetBeamId () == txParams->m_beamId)
+        {
+          beamReceivers++;
+        }
+    }
+
+  NS_TEST_ASSERT_MSG_GT (receivers.size (), beamReceivers, "No receivers seeing the burst only as interference");
+
+  SatSignalBurst::rxRecord_s rxRecord;
+  rxRecord.burst = burst;
+  rxRecord.channelType = channel->GetChannelType ();
+  rxRecord.carrierFreq_hz = 0.0;
+  rxRecord.rxPower_W = 1.0e-12;
+
+  for (uint32_t i = 0; i < receivers.size (); ++i)
+    {
+      receivers[i]->StartRx (rxRecord);
+    }
+
+  NS_TEST_ASSERT_MSG_GT (beamReceivers, 0, "No receivers in the beam of the transmission");
+  NS_TEST_ASSERT_MSG_EQ (m_receptions, beamReceivers, "Burst not received by the receivers in the beam");
+  NS_TEST_ASSERT_MSG_EQ (burst->GetNumOfRxCopies (), beamReceivers, "Packets copied by receivers not receiving the burst");
+
+  CheckBurst (burst, uids);
+
+  // The receivers modify their own copies of the packets
+  Ptr<SatSignalParameters> rxParams = burst->CreateRxParams (rxRecord);
+
+  for (uint32_t i = 0; i < rxParams->m_packetsInBurst.size (); ++i)
+    {
+      SatMacTag tag;
+      NS_TEST_ASSERT_MSG_EQ (rxParams->m_packetsInBurst[i]->GetUid (), uids[i], "Unexpected packet in receiver copy");
+      NS_TEST_ASSERT_MSG_EQ (rxParams->m_packetsInBurst[i]->RemovePacketTag (tag), true, "Packet tag not copied");
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (rxParams->m_rxPower_W, rxRecord.rxPower_W, "Rx power not set to receiver copy");
+
+  CheckBurst (burst, uids);
+
+  Simulator::Destroy ();
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test the receivers of SatChannel in OnlyDestNode
+ * mode to the terrestrial nodes.
+ *
+ *   1.  Create the larger scenario.
+ *   2.  Get the receivers of bursts in every beam of the forward user and the
+ *       return feeder channels, with unicast packets to receivers in the same
+ *       beam, in other beams and to unknown addresses, and with broadcast and
+ *       group packets.
+ *
+ *   Expected result:
+ *     The receivers are the same as given by checking the destination address
+ *     of the packets against each receiver of the channel in turn.
+ */
+class SatChannelDestNodeTestCase : public TestCase
+{
+public:
+  SatChannelDestNodeTestCase ();
+  virtual ~SatChannelDestNodeTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Get the receivers of a transmission by checking the destination
+   * addresses of the packets against each receiver of the channel in turn.
+   * \param allReceivers all the receivers of the channel
+   * \param txParams the parameters of the transmission
+   * \return the receivers of the transmission
+   */
+  SatChannel::PhyRxContainer GetLinearReceivers (const SatChannel::PhyRxContainer& allReceivers, Ptr<SatSignalParameters> txParams);
+
+  /**
+   * \brief Check the receivers of a burst to the given destinations.
+   * \param channel the channel
+   * \param beamId the beam of the transmission
+   * \param destinations the destination addresses of the packets in the burst
+   * \return the number of receivers of the burst
+   */
+  uint32_t CheckReceivers (Ptr<SatChannel> channel, uint32_t beamId, std::vector<Mac48Address> destinations);
+};
+
+SatChannelDestNodeTestCase::SatChannelDestNodeTestCase ()
+  : TestCase ("Test the destination node receivers of satellite channel.")
+{
+}
+
+SatChannelDestNodeTestCase::~SatChannelDestNodeTestCase ()
+{
+}
+
+SatChannel::PhyRxContainer
+SatChannelDestNodeTestCase::GetLinearReceivers (const SatChannel::PhyRxContainer& allReceivers, Ptr<SatSignalParameters> txParams)
+{
+  SatChannel::PhyRxContainer receivers;
+
+  for (SatChannel::PhyRxContainer::const_iterator rxIt = allReceivers.begin (); rxIt != allReceivers.end (); ++rxIt)
+    {
+      if ((*rxIt)->GetBeamId () == txParams->m_beamId)
+        {
+          for (uint32_t i = 0; i < txParams->m_packetsInBurst.size (); ++i)
+            {
+              SatMacTag tag;
+              txParams->m_packetsInBurst[i]->PeekPacketTag (tag);
+              Mac48Address dest = tag.GetDestAddress ();
+
+              if (dest == (*rxIt)->GetAddress () || dest.IsBroadcast () || dest.IsGroup ())
+                {
+                  receivers.push_back (*rxIt);
+                  break;
+                }
+            }
+        }
+    }
+
+  return receivers;
+}
+
+uint32_t
+SatChannelDestNodeTestCase::CheckReceivers (Ptr<SatChannel> channel, uint32_t beamId, std::vector<Mac48Address> destinations)
+{
+  Ptr<SatSignalParameters> txParams = Create<SatSignalParameters> ();
+  txParams->m_beamId = beamId;
+
+  for (uint32_t i = 0; i < destinations.size (); ++i)
+    {
+      Ptr<Packet> packet = Create<Packet> (100);
+      SatMacTag tag;
+      tag.SetDestAddress (destinations[i]);
+      packet->AddPacketTag (tag);
+      txParams->m_packetsInBurst.push_back (packet);
+    }
+
+  SatChannel::PhyRxContainer expected = GetLinearReceivers (channel->GetAllBeamsReceivers (txParams), txParams);
+  SatChannel::PhyRxContainer receivers = channel->GetDestNodeReceivers (txParams);
+
+  NS_TEST_EXPECT_MSG_EQ (receivers.size (), expected.size (), "Unexpected number of receivers in beam " << beamId);
+
+  for (uint32_t i = 0; (i < receivers.size ()) && (i < expected.size ()); ++i)
+    {
+      NS_TEST_EXPECT_MSG_EQ (receivers[i], expected[i], "Unexpected receiver in beam " << beamId);
+    }
+
+  return receivers.size ();
+}
+
+void
+SatChannelDestNodeTestCase::DoRun (void)
+{
+  // Set simulation output details
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-sat-channel", "dest-node", true);
+
+  Ptr<SatHelper> helper = CreateObject<SatHelper> ();
+  helper->CreatePredefinedScenario (SatHelper::LARGER);
+
+  Mac48Address unknown ("00:00:00:ff:ff:ff");
+  Mac48Address group = Mac48Address::GetMulticast (Ipv4Address ("224.1.1.1"));
+  uint32_t checkedChannels = 0;
+
+  for (uint32_t c = 0; c < ChannelList::GetNChannels (); ++c)
+    {
+      Ptr<SatChannel> channel = DynamicCast<SatChannel> (ChannelList::GetChannel (c));
+
+      if ((channel == 0) ||
+          ((channel->GetChannelType () != SatEnums::FORWARD_USER_CH) && (channel->GetChannelType () != SatEnums::RETURN_FEEDER_CH)))
+        {
+          continue;
+        }
+
+      // All the receivers of the channel in the receiver container order
+      channel->SetAttribute ("EnableInterferenceCulling", BooleanValue (false));
+      SatChannel::PhyRxContainer allReceivers = channel->GetAllBeamsReceivers (Create<SatSignalParameters> ());
+
+      std::set<uint32_t> beams;
+      for (uint32_t i = 0; i < allReceivers.size (); ++i)
+        {
+          beams.insert (allReceivers[i]->GetBeamId ());
+        }
+
+      for (std::set<uint32_t>::const_iterator beamIt = beams.begin (); beamIt != beams.end (); ++beamIt)
+        {
+          std::vector<Mac48Address> beamAddresses;
+          std::vector<Mac48Address> otherAddresses;
+
+          for (uint32_t i = 0; i < allReceivers.size (); ++i)
+            {
+              if (allReceivers[i]->GetBeamId () == *beamIt)
+                {
+                  beamAddresses.push_back (allReceivers[i]->GetAddress ());
+                }
+              else
+                {
+                  otherAddresses.push_back (allReceivers[i]->GetAddress ());
+                }
+            }
+
+          // Unicast to the receivers of the beam, also several packets to the same receiver
+          NS_TEST_ASSERT_MSG_GT (CheckReceivers (channel, *beamIt, std::vector<Mac48Address> (1, beamAddresses.front ())), 0,
+                                 "Unicast burst not received in beam " << *beamIt);
+
+          std::vector<Mac48Address> destinations (beamAddresses.rbegin (), beamAddresses.rend ());
+          destinations.push_back (beamAddresses.front ());
+          CheckReceivers (channel, *beamIt, destinations);
+
+          // Unicast to unknown receivers
+          NS_TEST_ASSERT_MSG_EQ (CheckReceivers (channel, *beamIt, std::vector<Mac48Address> (1, unknown)), 0,
+                                 "Burst to an unknown receiver received in beam " << *beamIt);
+
+          // Broadcast and group packets after unicast packets
+          destinations.clear ();
+          destinations.push_back (unknown);
+          destinations.push_back (Mac48Address::GetBroadcast ());
+          NS_TEST_ASSERT_MSG_EQ (CheckReceivers (channel, *beamIt, destinations), beamAddresses.size (),
+                                 "Broadcast burst not received by all the receivers in beam " << *beamIt);
+
+          destinations.back () = group;
+          NS_TEST_ASSERT_MSG_EQ (CheckReceivers (channel, *beamIt, destinations), beamAddresses.size (),
+                                 "Group burst not received by all the receivers in beam " << *beamIt);
+
+          if (!otherAddresses.empty ())
+            {
+              // Unicast to the receivers of other beams
+              CheckReceivers (channel, *beamIt, otherAddresses);
+
+              otherAddresses.push_back (beamAddresses.back ());
+              CheckReceivers (channel, *beamIt, otherAddresses);
+            }
+        }
+
+      checkedChannels++;
+    }
+
+  NS_TEST_ASSERT_MSG_GT (checkedChannels, 0, "No forward user or return feeder channels found");
+
+  Simulator::Destroy ();
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test the interference culling of SatChannel.
+ *
+ *   1.  Create the larger scenario with interference culling enabled.
+ *   2.  Get the receivers of a UT transmission from the return user channel.
+ *   3.  Move the UT to the position of a UT in another beam and get the
+ *       receivers again.
+ *
+ *   Expected result:
+ *     The culled receivers are exactly the receivers outside the beam of the
+ *     transmission with antenna gain coupling below the culling threshold,
+ *     both before and after the UT has moved.
+ */
+class SatChannelCullingTestCase : public TestCase
+{
+public:
+  SatChannelCullingTestCase ();
+  virtual ~SatChannelCullingTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Check the receivers of a transmission against the coupling
+   * calculated from the antenna gains.
+   * \param channel the channel
+   * \param txParams the parameters of the transmission
+   * \param threshold_dB culling threshold in dB
+   */
+  void CheckReceivers (Ptr<SatChannel> channel, Ptr<SatSignalParameters> txParams, double threshold_dB);
+};
+
+SatChannelCullingTestCase::SatChannelCullingTestCase ()
+  : TestCase ("Test interference culling of satellite channel.")
+{
+}
+
+SatChannelCullingTestCase::~SatChannelCullingTestCase ()
+{
+}
+
+void
+SatChannelCullingTestCase::CheckReceivers (Ptr<SatChannel> channel, Ptr<SatSignalParameters> txParams, double threshold_dB)
+{
+  // Without culling, all the receivers of the channel are returned
+  channel->SetAttribute ("EnableInterferenceCulling", BooleanValue (false));
+  SatChannel::PhyRxContainer allReceivers = channel->GetAllBeamsReceivers (txParams);
+  channel->SetAttribute ("EnableInterferenceCulling", BooleanValue (true));
+  SatChannel::PhyRxContainer receivers = channel->GetAllBeamsReceivers (txParams);
+
+  NS_TEST_ASSERT_MSG_EQ (allReceivers.size (), channel->GetNDevices (), "All receivers not returned without culling");
+
+  // Return user channel, thus the antenna gains are taken at the UT position
+  Ptr<MobilityModel> position = txParams->m_phyTx->GetMobility ();
+  std::vector<double> gains;
+  double wantedGain = 0.0;
+
+  for (uint32_t i = 0; i < allReceivers.size (); ++i)
+    {
+      double gain = txParams->m_phyTx->GetAntennaGain (position) * allReceivers[i]->GetAntennaGain (position);
+      gains.push_back (gain);
+
+      if (!std::isnan (gain) && (allReceivers[i]->GetBeamId () == txParams->m_beamId))
+        {
+          wantedGain = std::max (wantedGain, gain);
+        }
+    }
+
+  SatChannel::PhyRxContainer expected;
+
+  for (uint32_t i = 0; i < allReceivers.size (); ++i)
+    {
+      bool culled = (allReceivers[i]->GetBeamId () != txParams->m_beamId)
+        && (wantedGain > 0.0)
+        && !std::isnan (gains[i])
+        && (SatUtils::LinearToDb (gains[i] / wantedGain) < threshold_dB);
+
+      if (!culled)
+        {
+          expected.push_back (allReceivers[i]);
+        }
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (receivers.size (), expected.size (), "Unexpected number of culled receivers");
+
+  for (uint32_t i = 0; (i < receivers.size ()) && (i < expected.size ()); ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (receivers[i], expected[i], "Unexpected receiver " << i);
+    }
+}
+
+void
+SatChannelCullingTestCase::DoRun (void)
+{
+  // Set simulation output details
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-sat-channel", "culling", true);
+
+  const double threshold_dB = -20.0;
+  Config::SetDefault ("ns3::SatChannel::EnableInterferenceCulling", BooleanValue (true));
+  Config::SetDefault ("ns3::SatChannel::InterferenceCullingThreshold", DoubleValue (threshold_dB));
+
+  Ptr<SatHelper> helper = CreateObject<SatHelper> ();
+  helper->CreatePredefinedScenario (SatHelper::LARGER);
+
+  // Device #0 is the loopback device, #1 the subscriber network device and #2 the satellite device
+  NodeContainer uts = helper->UtNodes ();
+  Ptr<SatNetDevice> utDev = DynamicCast<SatNetDevice> (uts.Get (0)->GetDevice (2));
+  NS_TEST_ASSERT_MSG_NE (utDev, 0, "UT device not found");
+
+  Ptr<SatPhy> utPhy = utDev->GetPhy ();
+  Ptr<SatSignalParameters> txParams = Create<SatSignalParameters> ();
+  txParams->m_phyTx = utPhy->GetPhyTx ();
+  txParams->m_beamId = utPhy->GetPhyRx ()->GetBeamId ();
+
+  Ptr<SatChannel> channel = txParams->m_phyTx->GetChannel ();
+  CheckReceivers (channel, txParams, threshold_dB);
+
+  // Move the UT to the position of a UT in another beam, which shall update the coupling
+  for (uint32_t i = 1; i < uts.GetN (); ++i)
+    {
+      Ptr<SatNetDevice> dev = DynamicCast<SatNetDevice> (uts.Get (i)->GetDevice (2));
+
+      if (dev->GetPhy ()->GetPhyRx ()->GetBeamId () != txParams->m_beamId)
+        {
+          GeoCoordinate position = uts.Get (i)->GetObject<SatMobilityModel> ()->GetGeoPosition ();
+          uts.Get (0)->GetObject<SatMobilityModel> ()->SetGeoPosition (position);
+          break;
+        }
+    }
+
+  CheckReceivers (channel, txParams, threshold_dB);
+
+  Simulator::Destroy ();
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test the link budget cache of SatChannel.
+ *
+ *   1.  Create the simple scenario without fading and with the link budget
+ *       cache enabled, send packets in both directions and move the UT
+ *       in the middle of the simulation.
+ *   2.  Run the same simulation with a link budget cache of a single entry,
+ *       i.e. with the least recently used entry evicted for every new link.
+ *   3.  Run the same simulation with the link budget cache disabled.
+ *
+ *   Expected result:
+ *     The received powers traced by all the receivers of the UT and the GW
+ *     are the same in all the simulations, i.e. the cached link budgets are
+ *     the same as the calculated ones, also after the UT has moved and after
+ *     the entries have been evicted.
+ */
+class SatChannelLinkBudgetCacheTestCase : public TestCase
+{
+public:
+  SatChannelLinkBudgetCacheTestCase ();
+  virtual ~SatChannelLinkBudgetCacheTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Run the simulation.
+   * \param enableCache whether the link budget cache is enabled
+   * \param cacheSize maximum number of entries in the link budget cache
+   * \return the distinct received powers in dBW
+   */
+  std::set<double> RunSimulation (bool enableCache, uint32_t cacheSize);
+
+  /**
+   * \brief Check that the received powers are the same as the calculated ones.
+   * \param rxPowers the received powers of a simulation
+   * \param calculatedRxPowers the received powers of the simulation without cache
+   */
+  void CheckRxPowers (const std::set<double>& rxPowers, const std::set<double>& calculatedRxPowers);
+
+  /**
+   * \brief Trace sink for the received power of the carriers.
+   * \param rxPower_dbW received power in dBW
+   */
+  void RxPowerCallback (double rxPower_dbW);
+
+  std::set<double> m_rxPowers;
+};
+
+SatChannelLinkBudgetCacheTestCase::SatChannelLinkBudgetCacheTestCase ()
+  : TestCase ("Test link budget cache of satellite channel.")
+{
+}
+
+SatChannelLinkBudgetCacheTestCase::~SatChannelLinkBudgetCacheTestCase ()
+{
+}
+
+void
+SatChannelLinkBudgetCacheTestCase::RxPowerCallback (double rxPower_dbW)
+{
+  m_rxPowers.insert (rxPower_dbW);
+}
+
+std::set<double>
+SatChannelLinkBudgetCacheTestCase::RunSimulation (bool enableCache, uint32_t cacheSize)
+{
+  std::ostringstream ss;
+  ss << (enableCache ? "cache-" : "no-cache-") << cacheSize;
+
+  // Set simulation output details
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-sat-channel", ss.str (), true);
+
+  m_rxPowers.clear ();
+
+  Config::SetDefault ("ns3::SatChannel::EnableLinkBudgetCache", BooleanValue (enableCache));
+  Config::SetDefault ("ns3::SatChannel::LinkBudgetCacheSize", UintegerValue (cacheSize));
+  Config::SetDefault ("ns3::SatBeamHelper::FadingModel", EnumValue (SatEnums::FADING_OFF));
+
+  Ptr<SatHelper> helper = CreateObject<SatHelper> ();
+  helper->CreatePredefinedScenario (SatHelper::SIMPLE);
+
+  NodeContainer nodes;
+  nodes.Add (helper->UtNodes ());
+  nodes.Add (helper->GwNodes ());
+
+  for (uint32_t n = 0; n < nodes.GetN (); ++n)
+    {
+      for (uint32_t d = 0; d < nodes.Get (n)->GetNDevices (); ++d)
+        {
+          Ptr<SatNetDevice> dev = DynamicCast<SatNetDevice> (nodes.Get (n)->GetDevice (d));
+
+          if (dev == 0)
+            {
+              continue;
+            }
+
+          ObjectVectorValue carriers;
+          dev->GetPhy ()->GetPhyRx ()->GetAttribute ("RxCarrierList", carriers);
+
+          for (ObjectVectorValue::Iterator it = carriers.Begin (); it != carriers.End (); ++it)
+            {
+              it->second->TraceConnectWithoutContext ("RxPowerTrace", MakeCallback (&SatChannelLinkBudgetCacheTestCase::RxPowerCallback, this));
+            }
+        }
+    }
+
+  // Send packets in both directions
+  uint16_t port = 9;
+  NodeContainer utUsers = helper->GetUtUsers ();
+  NodeContainer gwUsers = helper->GetGwUsers ();
+
+  CbrHelper fwdCbr ("ns3::UdpSocketFactory", Address (InetSocketAddress (helper->GetUserAddress (utUsers.Get (0)), port)));
+  fwdCbr.SetAttribute ("Interval", StringValue ("0.1s"));
+  ApplicationContainer fwdApps = fwdCbr.Install (gwUsers);
+  fwdApps.Start (Seconds (1.0));
+  fwdApps.Stop (Seconds (3.0));
+
+  CbrHelper rtnCbr ("ns3::UdpSocketFactory", Address (InetSocketAddress (helper->GetUserAddress (gwUsers.Get (0)), port)));
+  rtnCbr.SetAttribute ("Interval", StringValue ("0.1s"));
+  ApplicationContainer rtnApps = rtnCbr.Install (utUsers);
+  rtnApps.Start (Seconds (1.0));
+  rtnApps.Stop (Seconds (3.0));
+
+  // Move the UT in the middle of the traffic
+  Ptr<SatMobilityModel> utMobility = helper->UtNodes ().Get (0)->GetObject<SatMobilityModel> ();
+  GeoCoordinate position = utMobility->GetGeoPosition ();
+  GeoCoordinate newPosition (position.GetLatitude () + 0.2, position.GetLongitude () + 0.2, position.GetAltitude ());
+  Simulator::Schedule (Seconds (2.0), &SatMobilityModel::SetGeoPosition, utMobility, newPosition);
+
+  Simulator::Stop (Seconds (4.0));
+  Simulator::Run ();
+
+  Simulator::Destroy ();
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+
+  return m_rxPowers;
+}
+
+void
+SatChannelLinkBudgetCacheTestCase::CheckRxPowers (const std::set<double>& rxPowers, const std::set<double>& calculatedRxPowers)
+{
+  NS_TEST_ASSERT_MSG_EQ (rxPowers.size (), calculatedRxPowers.size (), "Different received powers with the cache");
+
+  std::set<double>::const_iterator cachedIt = rxPowers.begin ();
+  std::set<double>::const_iterator calculatedIt = calculatedRxPowers.begin ();
+
+  for (; (cachedIt != rxPowers.end ()) && (calculatedIt != calculatedRxPowers.end ()); ++cachedIt, ++calculatedIt)
+    {
+      NS_TEST_ASSERT_MSG_EQ_TOL (*cachedIt, *calculatedIt, 1e-9, "Different received power with the cache");
+    }
+}
+
+void
+SatChannelLinkBudgetCacheTestCase::DoRun (void)
+{
+  std::set<double> evictedRxPowers = RunSimulation (true, 1);
+  std::set<double> cachedRxPowers = RunSimulation (true, 65536);
+  std::set<double> calculatedRxPowers = RunSimulation (false, 65536);
+
+  NS_TEST_ASSERT_MSG_GT (calculatedRxPowers.size (), 1, "Received powers before and after the move not traced");
+
+  CheckRxPowers (cachedRxPowers, calculatedRxPowers);
+  CheckRxPowers (evictedRxPowers, calculatedRxPowers);
+}
+
+/**
+ * \brief Test suite for satellite channel unit test cases.
+ */
+class SatChannelTestSuite : public TestSuite
+{
+public:
+  SatChannelTestSuite ();
+};
+
+SatChannelTestSuite::SatChannelTestSuite ()
+  : TestSuite ("sat-channel-test", UNIT)
+{
+  AddTestCase (new SatChannelSharedBurstTestCase, TestCase::QUICK);
+  AddTestCase (new SatChannelDestNodeTestCase, TestCase::QUICK);
+  AddTestCase (new SatChannelCullingTestCase, TestCase::QUICK);
+  AddTestCase (new SatChannelLinkBudgetCacheTestCase, TestCase::QUICK);
+}
+
+// Do allocate an instance of this TestSuite
+static SatChannelTestSuite satChannelTestSuite;
@@ -0,0 +1,930 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 Magister Solutions Ltd
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Jani Puttonen <jani.puttonen@magister.fi>
+ */
+
+/**
+ * \file satellite-crdsa-frame-decoder-test.cc
+ * \ingroup satellite
+ * \brief Test cases to unit test the CRDSA frame decoding.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <list>
+#include <map>
+#include <set>
+#include <vector>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/ptr.h"
+#include "ns3/object.h"
+#include "ns3/mac48-address.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/callback.h"
+#include "../model/satellite-utils.h"
+#include "../model/satellite-signal-parameters.h"
+#include "../model/satellite-link-results.h"
+#include "../model/satellite-phy-rx-carrier-per-frame.h"
+#include "../model/satellite-crdsa-frame-decoder.h"
+#include "../model/satellite-parallel-frame-decoder.h"
+
+using namespace ns3;
+
+/**
+ * \brief Received CRDSA packets of a test frame by slot ID, as collected by
+ * SatPhyRxCarrierPerFrame
+ */
+typedef std::map<uint32_t, std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> > crdsaTestFrame_t;
+
+/// constant error rate of the tests
+static const double CRDSA_TEST_CONSTANT_ERROR_RATE = 0.2;
+
+/// noise power of the feeder link receiver of the tests
+static const double CRDSA_TEST_NOISE_POWER_W = 1.0e-13;
+
+/**
+ * \brief SINR calculator of the satellite of the test frames, adding a C over I of 20 dB
+ * \param sinr SINR
+ * \return Final SINR
+ */
+static double
+CalculateTestSatelliteSinr (double sinr)
+{
+  return 1.0 / ((1.0 / sinr) + (1.0 / 100.0));
+}
+
+/**
+ * \brief SINR calculator of the feeder link receiver of the test frames, adding a C over I of 25 dB
+ * \param sinr SINR
+ * \return Final SINR
+ */
+static double
+CalculateTestFeederSinr (double sinr)
+{
+  return 1.0 / ((1.0 / sinr) + std::pow (10.0, -2.5));
+}
+
+/**
+ * \brief Draw a random value of the error model
+ * \param rng Random variable
+ * \return Random value between 0 and 1
+ */
+static double
+GetTestRandomValue (Ptr<UniformRandomVariable> rng)
+{
+  return rng->GetValue (0, 1);
+}
+
+/**
+ * \brief Create a random variable for the error model of a frame
+ * \param stream Stream number, random variables of the same stream give the same values
+ * \return Random variable
+ */
+static Ptr<UniformRandomVariable>
+CreateTestRandomVariable (int64_t stream)
+{
+  Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable> ();
+  rng->SetStream (stream);
+  return rng;
+}
+
+/**
+ * \brief Calculate SINR as SatPhyRxCarrier::CalculateSinr
+ */
+static double
+CalculateTestSinr (double rxPowerW,
+                   double ifPowerW,
+                   double rxNoisePowerW,
+                   double rxAciIfPowerW,
+                   double rxExtNoisePowerW,
+                   const SatPhyRxCarrierConf::SinrCalculatorCallback& sinrCalculate)
+{
+  double sinr = rxPowerW / (ifPowerW +  rxNoisePowerW + rxAciIfPowerW + rxExtNoisePowerW);
+  return sinrCalculate (sinr);
+}
+
+/**
+ * \brief Create random CRDSA frames. Each UT sends one unique payload
+ * with two or three replicas to random slots of the frame.
+ * \param rng Random variable used to create the frames
+ * \param numOfFrames Number of frames
+ * \return Frames
+ */
+static std::vector<crdsaTestFrame_t>
+CreateRandomFrames (Ptr<UniformRandomVariable> rng, uint32_t numOfFrames)
+{
+  std::vector<crdsaTestFrame_t> frames (numOfFrames);
+
+  for (uint32_t frame = 0; frame < numOfFrames; frame++)
+    {
+      uint32_t numOfSlots = rng->GetInteger (8, 32);
+      uint32_t numOfUts = rng->GetInteger (1, 24);
+
+      /// packets of each slot, with the slots of their replicas and their sender
+      std::vector<std::vector<std::pair<uint32_t, std::vector<uint16_t> > > > slots (numOfSlots);
+      std::vector<Mac48Address> addresses;
+      std::vector<double> rxPowers;
+
+      for (uint32_t ut = 0; ut < numOfUts; ut++)
+        {
+          uint32_t numOfReplicas = rng->GetInteger (2, 3);
+          std::vector<uint16_t> slotIds;
+
+          while (slotIds.size () < numOfReplicas)
+            {
+              uint16_t slotId = rng->GetInteger (0, numOfSlots - 1);
+
+              if (std::find (slotIds.begin (), slotIds.end (), slotId) == slotIds.end ())
+                {
+                  slotIds.push_back (slotId);
+                }
+            }
+
+          addresses.push_back (Mac48Address::Allocate ());
+          rxPowers.push_back (1.0e-13 * std::pow (10.0, rng->GetValue (0.5, 2.5)));
+
+          for (uint32_t i = 0; i < slotIds.size (); i++)
+            {
+              slots[slotIds[i]].push_back (std::make_pair (ut, slotIds));
+            }
+        }
+
+      for (uint32_t slotId = 0; slotId < numOfSlots; slotId++)
+        {
+          double slotPower = 0.0;
+
+          for (uint32_t i = 0; i < slots[slotId].size (); i++)
+            {
+              slotPower += rxPowers[slots[slotId][i].first];
+            }
+
+          for (uint32_t i = 0; i < slots[slotId].size (); i++)
+            {
+              uint32_t ut = slots[slotId][i].first;
+
+              Ptr<SatSignalParameters> rxParams = Create<SatSignalParameters> ();
+              rxParams->m_rxPowerInSatellite_W = rxPowers[ut];
+              rxParams->m_ifPowerInSatellite_W = slotPower - rxPowers[ut];
+              rxParams->m_rxNoisePowerInSatellite_W = 1.0e-13;
+              rxParams->m_rxAciIfPowerInSatellite_W = 1.0e-15;
+              rxParams->m_rxExtNoisePowerInSatellite_W = 1.0e-15;
+              rxParams->m_sinrCalculate = MakeCallback (&CalculateTestSatelliteSinr);
+              rxParams->m_rxPower_W = CRDSA_TEST_NOISE_POWER_W * std::pow (10.0, rng->GetValue (1.0, 2.0));
+              rxParams->m_ifPower_W = 0.0;
+              rxParams->m_txInfo.modCod = SatEnums::SAT_MODCOD_QPSK_1_TO_2;
+              rxParams->m_txInfo.waveformId = 3;
+
+              SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s params;
+              params.rxParams = rxParams;
+              params.sourceAddress = addresses[ut];
+              params.ownSlotId = slotId;
+              params.hasCollision = (slots[slotId].size () > 1);
+              params.packetHasBeenProcessed = false;
+              params.cSinr = 0.0;
+              params.ifPower = 0.0;
+              params.phyError = false;
+
+              /// the own slot is the first one in the replica tag
+              const std::vector<uint16_t>& slotIds = slots[slotId][i].second;
+
+              for (uint32_t j = 0; j < slotIds.size (); j++)
+                {
+                  if (slotIds[j] != slotId)
+                    {
+                      params.slotIdsForOtherReplicas.push_back (slotIds[j]);
+                    }
+                }
+
+              frames[frame][slotId].push_back (params);
+            }
+        }
+    }
+
+  return frames;
+}
+
+/**
+ * \brief Get the Rx parameters of the packets of a frame in the packet order of the frame decoder
+ * \param frame Frame
+ * \return Rx parameters of the packets
+ */
+static std::vector<Ptr<SatSignalParameters> >
+GetFramePackets (const crdsaTestFrame_t& frame)
+{
+  std::vector<Ptr<SatSignalParameters> > packets;
+
+  for (crdsaTestFrame_t::const_iterator iter = frame.begin (); iter != frame.end (); iter++)
+    {
+      std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>::const_iterator iterList;
+
+      for (iterList = iter->second.begin (); iterList != iter->second.end (); iterList++)
+        {
+          packets.push_back (iterList->rxParams);
+        }
+    }
+
+  return packets;
+}
+
+/**
+ * \brief Create decoders of test frames, one frame in each, as
+ * SatPhyRxCarrierPerFrame builds the decoder input. The random values of
+ * frame i are drawn from stream firstStream + i.
+ * \param frames Frames
+ * \param errorModel Error model of the decoding
+ * \param collisionModel Collision model of the decoding
+ * \param linkResults DVB-RCS2 link results of the AVI error model
+ * \param firstStream Random variable stream of the first frame
+ * \return Decoders
+ */
+static std::vector<SatCrdsaFrameDecoder>
+CreateDecoders (const std::vector<crdsaTestFrame_t>& frames,
+                SatPhyRxCarrierConf::ErrorModel errorModel,
+                SatPhyRxCarrierConf::RandomAccessCollisionModel collisionModel,
+                Ptr<SatLinkResultsDvbRcs2> linkResults,
+                int64_t firstStream)
+{
+  std::vector<SatCrdsaFrameDecoder> decoders (frames.size ());
+
+  for (uint32_t frame = 0; frame < frames.size (); frame++)
+    {
+      SatCrdsaFrameDecoder& decoder = decoders[frame];
+
+      decoder.SetModels (errorModel, CRDSA_TEST_CONSTANT_ERROR_RATE, collisionModel);
+      decoder.SetRandomValueCallback (MakeBoundCallback (&GetTestRandomValue, CreateTestRandomVariable (firstStream + frame)));
+      decoder.SetLinkResults (linkResults);
+
+      for (crdsaTestFrame_t::const_iterator iter = frames[frame].begin (); iter != frames[frame].end (); iter++)
+        {
+          std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>::const_iterator iterList;
+
+          for (iterList = iter->second.begin (); iterList != iter->second.end (); iterList++)
+            {
+              Ptr<SatSignalParameters> rxParams = iterList->rxParams;
+              SatCrdsaFrameDecoder::packet_s packet;
+
+              packet.ownSlotId = iterList->ownSlotId;
+              packet.slotIds = iterList->slotIdsForOtherReplicas;
+              packet.slotIds.push_back (iterList->ownSlotId);
+              std::sort (packet.slotIds.begin (), packet.slotIds.end ());
+              packet.sourceAddress = iterList->sourceAddress;
+              packet.rxPowerInSatelliteW = rxParams->m_rxPowerInSatellite_W;
+              packet.ifPowerInSatelliteW = rxParams->m_ifPowerInSatellite_W;
+              packet.rxNoisePowerInSatelliteW = rxParams->m_rxNoisePowerInSatellite_W;
+              packet.rxAciIfPowerInSatelliteW = rxParams->m_rxAciIfPowerInSatellite_W;
+              packet.rxExtNoisePowerInSatelliteW = rxParams->m_rxExtNoisePowerInSatellite_W;
+              packet.sinrCalculate = rxParams->m_sinrCalculate;
+              packet.ifPowerW = rxParams->m_ifPower_W;
+              packet.sinr = CalculateTestSinr (rxParams->m_rxPower_W, rxParams->m_ifPower_W,
+                                               CRDSA_TEST_NOISE_POWER_W, 0.0, 0.0,
+                                               MakeCallback (&CalculateTestFeederSinr));
+              packet.bitsPerSymbol = SatUtils::GetCodingRate (rxParams->m_txInfo.modCod) *
+                                     SatUtils::GetModulatedBits (rxParams->m_txInfo.modCod);
+              packet.waveformId = rxParams->m_txInfo.waveformId;
+
+              decoder.AddPacket (packet);
+            }
+        }
+    }
+
+  return decoders;
+}
+
+/**
+ * \brief Reference CRDSA frame decoding, the frame processing of
+ * SatPhyRxCarrierPerFrame before SatCrdsaFrameDecoder without the logging
+ * and the traces. The scan of the whole frame is restarted after each
+ * successfully received packet, and the random values are drawn when a
+ * packet is checked against the error model.
+ */
+class SatCrdsaBaselineFrameProcessor
+{
+public:
+  /**
+   * \brief Constructor
+   * \param errorModel Error model of the decoding
+   * \param collisionModel Collision model of the decoding
+   * \param linkResults DVB-RCS2 link results of the AVI error model
+   * \param rng Random variable of the error model
+   */
+  SatCrdsaBaselineFrameProcessor (SatPhyRxCarrierConf::ErrorModel errorModel,
+                                  SatPhyRxCarrierConf::RandomAccessCollisionModel collisionModel,
+                                  Ptr<SatLinkResultsDvbRcs2> linkResults,
+                                  Ptr<UniformRandomVariable> rng);
+
+  /**
+   * \brief Process the frame
+   * \param container Received packets of the frame, emptied in processing
+   * \return Unique payloads of the frame
+   */
+  std::vector<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> ProcessFrame (crdsaTestFrame_t& container);
+
+  bool m_failed;
+  std::vector<Ptr<SatSignalParameters> > m_processedPackets;
+
+private:
+  SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s ProcessReceivedCrdsaPacket (SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s packet,
+                                                                             uint32_t numOfPacketsForThisSlot);
+  bool CheckAgainstLinkResults (double cSinr, Ptr<SatSignalParameters> rxParams);
+  void FindAndRemoveReplicas (SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s packet);
+  void EliminateInterference (crdsaTestFrame_t::iterator iter, SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s processedPacket);
+  bool IsReplica (SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s packet,
+                  std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>::iterator iter);
+  bool HaveSameSlotIds (SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s packet,
+                        std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>::iterator iter);
+
+  SatPhyRxCarrierConf::ErrorModel m_errorModel;
+  SatPhyRxCarrierConf::RandomAccessCollisionModel m_collisionModel;
+  Ptr<SatLinkResultsDvbRcs2> m_linkResults;
+  Ptr<UniformRandomVariable> m_rng;
+  crdsaTestFrame_t* m_container;
+};
+
+SatCrdsaBaselineFrameProcessor::SatCrdsaBaselineFrameProcessor (SatPhyRxCarrierConf::ErrorModel errorModel,
+                                                                SatPhyRxCarrierConf::RandomAccessCollisionModel collisionModel,
+                                                                Ptr<SatLinkResultsDvbRcs2> linkResults,
+                                                                Ptr<UniformRandomVariable> rng)
+  : m_failed (false),
+    m_errorModel (errorModel),
+    m_collisionModel (collisionModel),
+    m_linkResults (linkResults),
+    m_rng (rng),
+    m_container (0)
+{
+}
+
+std::vector<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>
+SatCrdsaBaselineFrameProcessor::ProcessFrame (crdsaTestFrame_t& container)
+{
+  m_container = &container;
+
+  crdsaTestFrame_t::iterator iter;
+  std::vector<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> combinedPacketsForFrame;
+  SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s processedPacket;
+
+  bool nothingToProcess = true;
+
+  do
+    {
+      /// reset the flag
+      nothingToProcess = true;
+
+      /// go through the packets
+      for (iter = m_container->begin (); iter != m_container->end (); iter++)
+        {
+          std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>::iterator iterList;
+
+          for (iterList = iter->second.begin (); iterList != iter->second.end (); iterList++)
+            {
+              if (!iterList->packetHasBeenProcessed)
+                {
+                  /// process the received packet
+                  *iterList = ProcessReceivedCrdsaPacket (*iterList, iter->second.size ());
+
+                  /// packet successfully received
+                  if (!iterList->phyError)
+                    {
+                      nothingToProcess = false;
+
+                      /// save packet for processing outside the loop
+                      processedPacket = *iterList;
+
+                      /// remove the successfully received packet from the container
+                      iter->second.erase (iterList);
+
+                      /// eliminate the interference caused by this packet to other packets in this slot
+                      EliminateInterference (iter, processedPacket);
+
+                      /// break the cycle
+                      break;
+                    }
+                }
+            }
+
+          /// successfully received packet found
+          if (!nothingToProcess)
+            {
+              break;
+            }
+        }
+
+      if (!nothingToProcess)
+        {
+          /// find and remove replicas of the received packet
+          FindAndRemoveReplicas (processedPacket);
+
+          /// save the the received packet
+          combinedPacketsForFrame.push_back (processedPacket);
+        }
+    }
+  while (!nothingToProcess && !m_failed);
+
+  while (!m_container->empty () && !m_failed)
+    {
+      /// go through the packets
+      iter = m_container->begin ();
+
+      std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>::iterator iterList = iter->second.begin ();
+
+      if (iterList != iter->second.end ())
+        {
+          if (!iterList->packetHasBeenProcessed || !iterList->phyError)
+            {
+              /// all successfully received packets should have been processed by now
+              m_failed = true;
+              break;
+            }
+
+          /// find and remove replicas of the received packet
+          FindAndRemoveReplicas (*iterList);
+
+          /// save the the received packet
+          combinedPacketsForFrame.push_back (*iterList);
+
+          /// remove the packet from the container
+          iter->second.erase (iterList);
+
+          /// remove the empty slot container
+          if (iter->second.empty ())
+            {
+              m_container->erase (iter);
+            }
+        }
+      else
+        {
+          /// remove the empty slot container
+          m_container->erase (iter);
+        }
+    }
+
+  return combinedPacketsForFrame;
+}
+
+SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s
+SatCrdsaBaselineFrameProcessor::ProcessReceivedCrdsaPacket (SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s packet,
+                                                            uint32_t numOfPacketsForThisSlot)
+{
+  m_processedPackets.push_back (packet.rxParams);
+
+  double sinrSatellite = CalculateTestSinr ( packet.rxParams->m_rxPowerInSatellite_W,
+                                             packet.rxParams->m_ifPowerInSatellite_W,
+                                             packet.rxParams->m_rxNoisePowerInSatellite_W,
+                                             packet.rxParams->m_rxAciIfPowerInSatellite_W,
+                                             packet.rxParams->m_rxExtNoisePowerInSatellite_W,
+                                             packet.rxParams->m_sinrCalculate);
+
+  double sinr = CalculateTestSinr ( packet.rxParams->m_rxPower_W,
+                                    packet.rxParams->m_ifPower_W,
+                                    CRDSA_TEST_NOISE_POWER_W,
+                                    0.0,
+                                    0.0,
+                                    MakeCallback (&CalculateTestFeederSinr));
+
+  double cSinr = 1.0 / ( (1.0 / sinr) + (1.0 / sinrSatellite) );
+
+  packet.cSinr = cSinr;
+  packet.ifPower = packet.rxParams->m_ifPower_W;
+
+  if (m_collisionModel == SatPhyRxCarrierConf::RA_COLLISION_ALWAYS_DROP_ALL_COLLIDING_PACKETS)
+    {
+      /// there is a collision
+      if (numOfPacketsForThisSlot > 1)
+        {
+          /// not possible to have a successful reception
+          packet.phyError = true;
+        }
+      else
+        {
+          /// check against link results
+          packet.phyError = CheckAgainstLinkResults (packet.cSinr,packet.rxParams);
+        }
+    }
+  else
+    {
+      /// check against link results
+      packet.phyError = CheckAgainstLinkResults (packet.cSinr,packet.rxParams);
+    }
+
+  /// mark the packet as processed
+  packet.packetHasBeenProcessed = true;
+
+  return packet;
+}
+
+bool
+SatCrdsaBaselineFrameProcessor::CheckAgainstLinkResults (double cSinr, Ptr<SatSignalParameters> rxParams)
+{
+  /// Initialize with no errors
+  bool error = false;
+
+  switch (m_errorModel)
+    {
+    case SatPhyRxCarrierConf::EM_AVI:
+      {
+        double ebNo = cSinr / (SatUtils::GetCodingRate (rxParams->m_txInfo.modCod) *
+                               SatUtils::GetModulatedBits (rxParams->m_txInfo.modCod));
+
+        double ber = m_linkResults->GetBler (rxParams->m_txInfo.waveformId, SatUtils::LinearToDb (ebNo));
+        double r = m_rng->GetValue (0, 1);
+
+        if ( r < ber )
+          {
+            error = true;
+          }
+        break;
+      }
+    case SatPhyRxCarrierConf::EM_CONSTANT:
+      {
+        double r = m_rng->GetValue (0, 1);
+        if (r < CRDSA_TEST_CONSTANT_ERROR_RATE)
+          {
+            error = true;
+          }
+        break;
+      }
+    default:
+      {
+        /// No errors i.e. error = false;
+        break;
+      }
+    }
+  return error;
+}
+
+void
+SatCrdsaBaselineFrameProcessor::FindAndRemoveReplicas (SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s packet)
+{
+  for (uint32_t i = 0; i < packet.slotIdsForOtherReplicas.size (); i++)
+    {
+      /// get the vector of packets for processing
+      crdsaTestFrame_t::iterator iter;
+      iter = m_container->find (packet.slotIdsForOtherReplicas[i]);
+
+      if (iter == m_container->end ())
+        {
+          m_failed = true;
+          return;
+        }
+
+      std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>::iterator iterList;
+      SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s removedPacket;
+
+      bool replicaFound = false;
+
+      for (iterList = iter->second.begin (); iterList != iter->second.end (); )
+        {
+          /// check for the same UT & same slots
+          if (IsReplica (packet, iterList))
+            {
+              /// replica found for removal
+              replicaFound = true;
+              removedPacket = *iterList;
+              iter->second.erase (iterList++);
+            }
+          else
+            {
+              ++iterList;
+            }
+        }
+
+      if (!replicaFound)
+        {
+          m_failed = true;
+          return;
+        }
+
+      if (!packet.phyError)
+        {
+          EliminateInterference (iter, removedPacket);
+        }
+    }
+}
+
+void
+SatCrdsaBaselineFrameProcessor::EliminateInterference (crdsaTestFrame_t::iterator iter,
+                                                       SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s processedPacket)
+{
+  if (iter->second.empty ())
+    {
+      m_container->erase (iter);
+    }
+  else
+    {
+      std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>::iterator iterList;
+
+      for (iterList = iter->second.begin (); iterList != iter->second.end (); iterList++)
+        {
+          /// release packets in this slot for re-processing
+          iterList->packetHasBeenProcessed = false;
+
+          iterList->rxParams->m_ifPowerInSatellite_W -= processedPacket.rxParams->m_rxPowerInSatellite_W;
+
+          if (std::abs (iterList->rxParams->m_ifPowerInSatellite_W) < std::numeric_limits<double>::epsilon ())
+            {
+              iterList->rxParams->m_ifPowerInSatellite_W = 0;
+            }
+
+          if (iterList->rxParams->m_ifPower_W < 0 || iterList->rxParams->m_ifPowerInSatellite_W < 0)
+            {
+              m_failed = true;
+            }
+        }
+    }
+}
+
+bool
+SatCrdsaBaselineFrameProcessor::IsReplica (SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s packet,
+                                           std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>::iterator iter)
+{
+  bool isReplica = false;
+
+  if (iter->sourceAddress == packet.sourceAddress)
+    {
+      if (HaveSameSlotIds (packet, iter))
+        {
+          isReplica = true;
+        }
+    }
+  return isReplica;
+}
+
+bool
+SatCrdsaBaselineFrameProcessor::HaveSameSlotIds (SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s packet,
+                                                 std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>::iterator iter)
+{
+  std::set<uint16_t> firstSet;
+  std::set<uint16_t> secondSet;
+
+  firstSet.insert (packet.ownSlotId);
+  secondSet.insert (iter->ownSlotId);
+
+  /// sanity check
+  if (iter->slotIdsForOtherReplicas.size () != packet.slotIdsForOtherReplicas.size ())
+    {
+      m_failed = true;
+      return false;
+    }
+
+  /// form sets
+  for (uint32_t i = 0; i < iter->slotIdsForOtherReplicas.size (); i++)
+    {
+      firstSet.insert (packet.slotIdsForOtherReplicas[i]);
+      secondSet.insert (iter->slotIdsForOtherReplicas[i]);
+    }
+
+  return (firstSet == secondSet);
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test the incremental CRDSA frame decoding against
+ * the frame processing of SatPhyRxCarrierPerFrame before the frame decoder.
+ *
+ *  1.  Create random CRDSA frames for each error model and collision model.
+ *  2.  Decode the frames with SatCrdsaFrameDecoder, with the input built as
+ *      SatPhyRxCarrierPerFrame builds it.
+ *  3.  Process the same frames with the previous frame processing, which
+ *      restarts the scan of the frame after each successfully received packet.
+ *      The random values of both are drawn on demand from random variables
+ *      of the same stream.
+ *
+ *  Expected result:
+ *    Both decodings give the same unique payloads, processing order,
+ *    PHY errors, composite SINRs and interference powers.
+ */
+class SatCrdsaIncrementalDecodingTestCase : public TestCase
+{
+public:
+  SatCrdsaIncrementalDecodingTestCase ();
+  virtual ~SatCrdsaIncrementalDecodingTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SatCrdsaIncrementalDecodingTestCase::SatCrdsaIncrementalDecodingTestCase ()
+  : TestCase ("Test incremental CRDSA frame decoding against the previous frame processing.")
+{
+}
+
+SatCrdsaIncrementalDecodingTestCase::~SatCrdsaIncrementalDecodingTestCase ()
+{
+}
+
+void
+SatCrdsaIncrementalDecodingTestCase::DoRun (void)
+{
+  Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable> ();
+  rng->SetStream (11);
+
+  Ptr<SatLinkResultsDvbRcs2> linkResults = CreateObject<SatLinkResultsDvbRcs2> ();
+  linkResults->Initialize ();
+
+  SatPhyRxCarrierConf::ErrorModel errorModels[] = { SatPhyRxCarrierConf::EM_NONE,
+                                                    SatPhyRxCarrierConf::EM_CONSTANT,
+                                                    SatPhyRxCarrierConf::EM_AVI };
+
+  SatPhyRxCarrierConf::RandomAccessCollisionModel collisionModels[] = { SatPhyRxCarrierConf::RA_COLLISION_ALWAYS_DROP_ALL_COLLIDING_PACKETS,
+                                                                        SatPhyRxCarrierConf::RA_COLLISION_CHECK_AGAINST_SINR };
+
+  uint32_t successfulPackets = 0;
+  uint32_t failedPackets = 0;
+
+  for (uint32_t e = 0; e < 3; e++)
+    {
+      for (uint32_t c = 0; c < 2; c++)
+        {
+          std::vector<crdsaTestFrame_t> frames = CreateRandomFrames (rng, 64);
+          std::vector<SatCrdsaFrameDecoder> decoders = CreateDecoders (frames, errorModels[e], collisionModels[c], linkResults, 100);
+
+          for (uint32_t i = 0; i < frames.size (); i++)
+            {
+              SatCrdsaFrameDecoder& d = decoders[i];
+              d.Decode ();
+
+              /// the previous processing eliminates interference from the Rx parameters
+              std::vector<Ptr<SatSignalParameters> > packets = GetFramePackets (frames[i]);
+              std::map<const SatSignalParameters*, uint32_t> packetIndices;
+
+              for (uint32_t j = 0; j < packets.size (); j++)
+                {
+                  packetIndices[PeekPointer (packets[j])] = j;
+                }
+
+              SatCrdsaBaselineFrameProcessor reference (errorModels[e], collisionModels[c], linkResults, CreateTestRandomVariable (100 + i));
+              std::vector<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> results = reference.ProcessFrame (frames[i]);
+
+              NS_TEST_ASSERT_MSG_EQ (reference.m_failed, false, "Reference processing failed");
+              NS_TEST_ASSERT_MSG_EQ (d.GetError (), SatCrdsaFrameDecoder::DECODING_OK, "Frame decoding failed");
+              NS_TEST_ASSERT_MSG_EQ (d.GetProcessedPackets ().size (), reference.m_processedPackets.size (), "Different number of processings");
+              NS_TEST_ASSERT_MSG_EQ (d.GetDecodedPackets ().size (), results.size (), "Different number of unique payloads");
+
+              for (uint32_t j = 0; j < reference.m_processedPackets.size (); j++)
+                {
+                  NS_TEST_ASSERT_MSG_EQ (d.GetProcessedPackets ()[j], packetIndices[PeekPointer (reference.m_processedPackets[j])], "Different processing order");
+                }
+
+              for (uint32_t j = 0; j < results.size (); j++)
+                {
+                  uint32_t packet = d.GetDecodedPackets ()[j];
+
+                  NS_TEST_ASSERT_MSG_EQ (packet, packetIndices[PeekPointer (results[j].rxParams)], "Different unique payload");
+                  NS_TEST_ASSERT_MSG_EQ (d.HasPhyError (packet), results[j].phyError, "Different PHY error");
+                  NS_TEST_ASSERT_MSG_EQ (d.GetCompositeSinr (packet), results[j].cSinr, "Different composite SINR");
+
+                  if (results[j].phyError)
+                    {
+                      failedPackets++;
+                    }
+                  else
+                    {
+                      successfulPackets++;
+                    }
+                }
+
+              for (uint32_t j = 0; j < packets.size (); j++)
+                {
+                  NS_TEST_ASSERT_MSG_EQ (d.GetIfPowerInSatellite (j), packets[j]->m_ifPowerInSatellite_W, "Different interference power");
+                }
+            }
+        }
+    }
+
+  NS_TEST_ASSERT_MSG_GT (successfulPackets, (uint32_t) 0, "No packets received successfully");
+  NS_TEST_ASSERT_MSG_GT (failedPackets, (uint32_t) 0, "No packets received with errors");
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test parallel CRDSA frame decoding.
+ *
+ *  1.  Create random CRDSA frames for each error model and collision model.
+ *  2.  Decode the frames one by one.
+ *  3.  Decode copies of the frames in parallel with SatParallelFrameDecoder.
+ *
+ *  Expected result:
+ *    Parallel decoding gives the same decoded packets, processing order,
+ *    PHY errors, composite SINRs and interference powers as sequential decoding.
+ */
+class SatParallelFrameDecodingTestCase : public TestCase
+{
+public:
+  SatParallelFrameDecodingTestCase ();
+  virtual ~SatParallelFrameDecodingTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SatParallelFrameDecodingTestCase::SatParallelFrameDecodingTestCase ()
+  : TestCase ("Test parallel CRDSA frame decoding against sequential decoding.")
+{
+}
+
+SatParallelFrameDecodingTestCase::~SatParallelFrameDecodingTestCase ()
+{
+}
+
+void
+SatParallelFrameDecodingTestCase::DoRun (void)
+{
+  Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable> ();
+  rng->SetStream (12);
+
+  Ptr<SatLinkResultsDvbRcs2> linkResults = CreateObject<SatLinkResultsDvbRcs2> ();
+  linkResults->Initialize ();
+
+  Ptr<SatParallelFrameDecoder> parallelDecoder = CreateObject<SatParallelFrameDecoder> (4);
+
+  SatPhyRxCarrierConf::ErrorModel errorModels[] = { SatPhyRxCarrierConf::EM_NONE,
+                                                    SatPhyRxCarrierConf::EM_CONSTANT,
+                                                    SatPhyRxCarrierConf::EM_AVI };
+
+  SatPhyRxCarrierConf::RandomAccessCollisionModel collisionModels[] = { SatPhyRxCarrierConf::RA_COLLISION_ALWAYS_DROP_ALL_COLLIDING_PACKETS,
+                                                                        SatPhyRxCarrierConf::RA_COLLISION_CHECK_AGAINST_SINR };
+
+  uint32_t reprocessedPackets = 0;
+
+  for (uint32_t e = 0; e < 3; e++)
+    {
+      for (uint32_t c = 0; c < 2; c++)
+        {
+          /// both decoders of a frame draw their random values from the same stream
+          std::vector<crdsaTestFrame_t> testFrames = CreateRandomFrames (rng, 64);
+          std::vector<SatCrdsaFrameDecoder> sequential = CreateDecoders (testFrames, errorModels[e], collisionModels[c], linkResults, 200);
+          std::vector<SatCrdsaFrameDecoder> parallel = CreateDecoders (testFrames, errorModels[e], collisionModels[c], linkResults, 200);
+          std::vector<SatCrdsaFrameDecoder*> frames;
+
+          for (uint32_t i = 0; i < sequential.size (); i++)
+            {
+              sequential[i].Decode ();
+              frames.push_back (&parallel[i]);
+            }
+
+          parallelDecoder->DecodeFrames (frames);
+
+          for (uint32_t i = 0; i < sequential.size (); i++)
+            {
+              const SatCrdsaFrameDecoder& s = sequential[i];
+              const SatCrdsaFrameDecoder& p = parallel[i];
+
+              NS_TEST_ASSERT_MSG_EQ (p.GetError (), SatCrdsaFrameDecoder::DECODING_OK, "Frame decoding failed");
+              NS_TEST_ASSERT_MSG_EQ (p.GetError (), s.GetError (), "Different decoding error");
+              NS_TEST_ASSERT_MSG_EQ ((p.GetDecodedPackets () == s.GetDecodedPackets ()), true, "Different decoded packets");
+              NS_TEST_ASSERT_MSG_EQ ((p.GetProcessedPackets () == s.GetProcessedPackets ()), true, "Different processing order");
+
+              for (uint32_t j = 0; j < s.GetNumOfPackets (); j++)
+                {
+                  NS_TEST_ASSERT_MSG_EQ (p.HasPhyError (j), s.HasPhyError (j), "Different PHY error");
+                  NS_TEST_ASSERT_MSG_EQ (p.GetCompositeSinr (j), s.GetCompositeSinr (j), "Different composite SINR");
+                  NS_TEST_ASSERT_MSG_EQ (p.GetIfPowerInSatellite (j), s.GetIfPowerInSatellite (j), "Different interference power");
+                }
+
+              std::set<uint32_t> processedPackets (s.GetProcessedPackets ().begin (), s.GetProcessedPackets ().end ());
+              reprocessedPackets += s.GetProcessedPackets ().size () - processedPackets.size ();
+            }
+        }
+    }
+
+  // interference elimination shall have released packets for re-processing
+  NS_TEST_ASSERT_MSG_GT (reprocessedPackets, (uint32_t) 0, "No packets re-processed");
+
+  parallelDecoder->Dispose ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test suite for the CRDSA frame decoding.
+ */
+class SatCrdsaFrameDecoderTestSuite : public TestSuite
+{
+public:
+  SatCrdsaFrameDecoderTestSuite ();
+};
+
+SatCrdsaFrameDecoderTestSuite::SatCrdsaFrameDecoderTestSuite ()
+  : TestSuite ("sat-crdsa-frame-decoder-test", UNIT)
+{
+  AddTestCase (new SatCrdsaIncrementalDecodingTestCase, TestCase::QUICK);
+  AddTestCase (new SatParallelFrameDecodingTestCase, TestCase::QUICK);
+}
+
+// Do a static instance, so that test suite is added to TestSuite list
+static SatCrdsaFrameDecoderTestSuite satCrdsaFrameDecoderTestSuite;
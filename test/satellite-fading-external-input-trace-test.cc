@@ -24,13 +24,20 @@
  * \brief Test cases to unit test external fading traces
  */
 
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <limits>
 #include <vector>
 #include "ns3/log.h"
 #include "ns3/test.h"
 #include "ns3/timer.h"
 #include "ns3/simulator.h"
+#include "ns3/random-variable-stream.h"
 #include "../model/satellite-fading-external-input-trace-container.h"
+#include "../model/satellite-fading-external-input-trace-file.h"
 #include "../model/satellite-channel.h"
+#include "../model/geo-coordinate.h"
 #include "ns3/singleton.h"
 #include "../utils/satellite-env-variables.h"
 
@@ -108,6 +115,189 @@ SatFadingExternalInputTraceTestCase::DoRun (void)
   Singleton<SatEnvVariables>::Get ()->DoDispose ();
 }
 
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test that a memory mapped fading trace file and
+ * a fading trace file read to memory give the same fading values.
+ *
+ *  1.  Write a three column binary fading trace file.
+ *  2.  Create a trace from the file mapped to memory and from the file read to memory.
+ *  3.  Get the fading values of both traces at different times.
+ *
+ *  Expected result:
+ *    The fading values of both traces are equal.
+ */
+class SatFadingExternalInputTraceFileTestCase : public TestCase
+{
+public:
+  SatFadingExternalInputTraceFileTestCase ();
+  virtual ~SatFadingExternalInputTraceFileTestCase ();
+
+  void TestGetFading (Ptr<SatFadingExternalInputTrace> mappedTrace, Ptr<SatFadingExternalInputTrace> readTrace);
+
+private:
+  virtual void DoRun (void);
+
+  std::vector<double> m_mappedResults;
+  std::vector<double> m_readResults;
+};
+
+SatFadingExternalInputTraceFileTestCase::SatFadingExternalInputTraceFileTestCase ()
+  : TestCase ("Test memory mapped and read satellite fading external input trace files.")
+{
+}
+
+SatFadingExternalInputTraceFileTestCase::~SatFadingExternalInputTraceFileTestCase ()
+{
+}
+
+void SatFadingExternalInputTraceFileTestCase::TestGetFading (Ptr<SatFadingExternalInputTrace> mappedTrace, Ptr<SatFadingExternalInputTrace> readTrace)
+{
+  m_mappedResults.push_back (mappedTrace->GetFading ());
+  m_readResults.push_back (readTrace->GetFading ());
+}
+
+void
+SatFadingExternalInputTraceFileTestCase::DoRun (void)
+{
+  // Set simulation output details
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-sat-fading-external-input-trace", "file", true);
+
+  std::string fileName = Singleton<SatEnvVariables>::Get ()->GetOutputPath () + "/fading-trace-file-test.bin";
+  uint32_t rows = 1000;
+
+  // time, fading and scintillation columns with a constant time interval
+  std::ofstream ofs (fileName.c_str (), std::ios::out | std::ios::binary | std::ios::trunc);
+
+  for (uint32_t i = 0; i < rows; i++)
+    {
+      float sample[3] = { 0.01f * i, (float)(3.0 * std::sin (0.05 * i)), (float)(0.5 * std::cos (0.3 * i)) };
+      ofs.write ((const char*)sample, sizeof (sample));
+    }
+
+  ofs.close ();
+
+  Ptr<SatFadingExternalInputTraceFile> mappedFile = Create<SatFadingExternalInputTraceFile> (3, fileName, true);
+  Ptr<SatFadingExternalInputTraceFile> readFile = Create<SatFadingExternalInputTraceFile> (3, fileName, false);
+
+  NS_TEST_ASSERT_MSG_EQ (mappedFile->GetRows (), rows, "Unexpected number of rows in the mapped file");
+  NS_TEST_ASSERT_MSG_EQ (readFile->GetRows (), rows, "Unexpected number of rows in the read file");
+
+  Ptr<SatFadingExternalInputTrace> mappedTrace = Create<SatFadingExternalInputTrace> (SatFadingExternalInputTrace::FT_THREE_COLUMN, mappedFile);
+  Ptr<SatFadingExternalInputTrace> readTrace = Create<SatFadingExternalInputTrace> (SatFadingExternalInputTrace::FT_THREE_COLUMN, readFile);
+
+  NS_TEST_ASSERT_MSG_EQ (mappedTrace->TestFadingTrace (), true, "Mapped fading trace test failed");
+  NS_TEST_ASSERT_MSG_EQ (readTrace->TestFadingTrace (), true, "Read fading trace test failed");
+
+  for (double time = 0.0; time < 9.9; time += 0.0731)
+    {
+      Simulator::Schedule (Seconds (time), &SatFadingExternalInputTraceFileTestCase::TestGetFading, this, mappedTrace, readTrace);
+    }
+
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_GT (m_mappedResults.size (), (size_t) 0, "No fading values");
+
+  for (uint32_t i = 0; i < m_mappedResults.size (); ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_mappedResults[i], m_readResults[i], "Different fading from the mapped and the read file");
+    }
+
+  Simulator::Destroy ();
+
+  std::remove (fileName.c_str ());
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test the spatial index used to find the nearest
+ * external fading trace in position mode.
+ *
+ *  1.  Index a grid of trace positions on the Earth surface with duplicate positions.
+ *  2.  Find the nearest position of random positions and of the indexed positions
+ *      with the spatial index.
+ *  3.  Find the nearest positions by going through all the positions in order.
+ *
+ *  Expected result:
+ *    The spatial index finds the same position as the linear search, i.e. the
+ *    first one of the equally distant positions.
+ */
+class SatFadingExternalInputTracePositionTestCase : public TestCase
+{
+public:
+  SatFadingExternalInputTracePositionTestCase ();
+  virtual ~SatFadingExternalInputTracePositionTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SatFadingExternalInputTracePositionTestCase::SatFadingExternalInputTracePositionTestCase ()
+  : TestCase ("Test satellite fading external input trace position search.")
+{
+}
+
+SatFadingExternalInputTracePositionTestCase::~SatFadingExternalInputTracePositionTestCase ()
+{
+}
+
+void
+SatFadingExternalInputTracePositionTestCase::DoRun (void)
+{
+  Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable> ();
+  rng->SetStream (15);
+
+  std::vector<Vector> positions;
+
+  for (double latitude = 30.0; latitude <= 70.0; latitude += 2.5)
+    {
+      for (double longitude = -20.0; longitude <= 40.0; longitude += 2.5)
+        {
+          positions.push_back (GeoCoordinate (latitude, longitude, 0.0).ToVector ());
+        }
+    }
+
+  // duplicate positions shall resolve to the first one
+  for (uint32_t i = 0; i < 50; i++)
+    {
+      positions.push_back (positions[rng->GetInteger (0, positions.size () - 1)]);
+    }
+
+  SatFadingExternalInputTraceContainer::PositionIndex_t index;
+  SatFadingExternalInputTraceContainer::BuildPositionIndex (positions, index);
+
+  std::vector<Vector> searched (positions);
+
+  for (uint32_t i = 0; i < 2000; i++)
+    {
+      searched.push_back (GeoCoordinate (rng->GetValue (20.0, 80.0), rng->GetValue (-30.0, 50.0), rng->GetValue (0.0, 10000.0)).ToVector ());
+    }
+
+  for (uint32_t i = 0; i < searched.size (); i++)
+    {
+      uint32_t expected = 0;
+      double expectedDistance = std::numeric_limits<double>::max ();
+
+      for (uint32_t j = 0; j < positions.size (); j++)
+        {
+          double distance = CalculateDistance (searched[i], positions[j]);
+
+          if ( distance < expectedDistance )
+            {
+              expectedDistance = distance;
+              expected = j;
+            }
+        }
+
+      uint32_t nearest = SatFadingExternalInputTraceContainer::FindNearestPosition (index, searched[i]);
+
+      NS_TEST_ASSERT_MSG_EQ (nearest, expected, "Different nearest trace position");
+    }
+}
+
 /**
  * \ingroup satellite
  * \brief Test suite for satellite fading external input trace
@@ -122,6 +312,8 @@ SatFadingExternalInputTraceTestSuite::SatFadingExternalInputTraceTestSuite ()
   : TestSuite ("sat-fading-external-input-trace-test", UNIT)
 {
   AddTestCase (new SatFadingExternalInputTraceTestCase, TestCase::QUICK);
+  AddTestCase (new SatFadingExternalInputTraceFileTestCase, TestCase::QUICK);
+  AddTestCase (new SatFadingExternalInputTracePositionTestCase, TestCase::QUICK);
 }
 
 // Do allocate an instance of this TestSuite
@@ -0,0 +1,308 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 Magister Solutions Ltd
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Jani Puttonen <jani.puttonen@magister.fi>
+ */
+
+/**
+ * \ingroup satellite
+ * \file satellite-gw-llc-test.cc
+ * \brief GW LLC test suite
+ */
+
+#include <string>
+#include <vector>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/ptr.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/boolean.h"
+#include "ns3/nstime.h"
+#include "ns3/mac48-address.h"
+#include "../model/satellite-gw-llc.h"
+#include "../model/satellite-node-info.h"
+#include "../model/satellite-scheduling-object.h"
+#include "../model/satellite-enums.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Test case for the scheduling contexts of the backlogged flows of the GW LLC.
+ *
+ * Expected results
+ * - Packets are enqued to five flows of three UTs in a mixed order of flow ids
+ * - The scheduling contexts are given for exactly the five flows, in ascending order of
+ *   flow id and UT address
+ * - Two of the flows are drained to empty and one is drained partly with Tx opportunities.
+ *   The scheduling contexts are given for exactly the three flows with data left.
+ * - A packet is enqued again to one of the emptied flows, which is then given again in
+ *   the scheduling contexts in the right order
+ */
+class SatGwLlcSchedulingContextsTestCase : public TestCase
+{
+public:
+  SatGwLlcSchedulingContextsTestCase ();
+  virtual ~SatGwLlcSchedulingContextsTestCase ();
+
+protected:
+  /**
+   * Constructor for the derived test cases
+   * \param name Test case name
+   */
+  SatGwLlcSchedulingContextsTestCase (std::string name);
+
+  /**
+   * Enque packets of 100 bytes to a flow
+   * \param llc GW LLC
+   * \param ut Destination UT address
+   * \param flowId Flow identifier
+   * \param nPackets Number of packets
+   */
+  void Enque (Ptr<SatGwLlc> llc, Mac48Address ut, uint8_t flowId, uint32_t nPackets);
+
+  /**
+   * Give Tx opportunities to a flow
+   * \param llc GW LLC
+   * \param ut Destination UT address
+   * \param flowId Flow identifier
+   * \param nTxOpportunities Maximum number of Tx opportunities
+   * \return Bytes left in the flow after the Tx opportunities
+   */
+  uint32_t Drain (Ptr<SatGwLlc> llc, Mac48Address ut, uint8_t flowId, uint32_t nTxOpportunities);
+
+  /**
+   * Check the scheduling contexts of the GW LLC
+   * \param llc GW LLC
+   * \param uts Expected UT addresses of the scheduling contexts
+   * \param flowIds Expected flow ids of the scheduling contexts
+   */
+  void CheckSchedulingContexts (Ptr<SatGwLlc> llc, std::vector<Mac48Address> uts, std::vector<uint8_t> flowIds);
+
+private:
+  virtual void DoRun (void);
+};
+
+SatGwLlcSchedulingContextsTestCase::SatGwLlcSchedulingContextsTestCase ()
+  : TestCase ("Test the scheduling contexts of the backlogged flows of the GW LLC.")
+{
+}
+
+SatGwLlcSchedulingContextsTestCase::SatGwLlcSchedulingContextsTestCase (std::string name)
+  : TestCase (name)
+{
+}
+
+SatGwLlcSchedulingContextsTestCase::~SatGwLlcSchedulingContextsTestCase ()
+{
+}
+
+void
+SatGwLlcSchedulingContextsTestCase::Enque (Ptr<SatGwLlc> llc, Mac48Address ut, uint8_t flowId, uint32_t nPackets)
+{
+  for (uint32_t i = 0; i < nPackets; ++i)
+    {
+      llc->Enque (Create<Packet> (100), ut, flowId);
+    }
+}
+
+uint32_t
+SatGwLlcSchedulingContextsTestCase::Drain (Ptr<SatGwLlc> llc, Mac48Address ut, uint8_t flowId, uint32_t nTxOpportunities)
+{
+  uint32_t bytesLeft = 0;
+  uint32_t nextMinTxO = 0;
+
+  for (uint32_t i = 0; i < nTxOpportunities; ++i)
+    {
+      Ptr<Packet> p = llc->NotifyTxOpportunity (1000, ut, flowId, bytesLeft, nextMinTxO);
+      NS_TEST_EXPECT_MSG_NE (p, 0, "No packet given for a Tx opportunity");
+
+      if (bytesLeft == 0)
+        {
+          break;
+        }
+    }
+
+  return bytesLeft;
+}
+
+void
+SatGwLlcSchedulingContextsTestCase::CheckSchedulingContexts (Ptr<SatGwLlc> llc, std::vector<Mac48Address> uts, std::vector<uint8_t> flowIds)
+{
+  std::vector< Ptr<SatSchedulingObject> > so;
+  llc->GetSchedulingContexts (so);
+
+  NS_TEST_ASSERT_MSG_EQ (so.size (), flowIds.size (), "Unexpected number of scheduling contexts");
+
+  for (uint32_t i = 0; i < so.size () && i < flowIds.size (); ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ ((uint32_t) so[i]->GetFlowId (), (uint32_t) flowIds[i], "Unexpected flow id of scheduling context " << i);
+      NS_TEST_ASSERT_MSG_EQ (so[i]->GetMacAddress (), uts[i], "Unexpected UT address of scheduling context " << i);
+      NS_TEST_ASSERT_MSG_GT (so[i]->GetBufferedBytes (), 0, "No buffered bytes in scheduling context " << i);
+    }
+}
+
+void
+SatGwLlcSchedulingContextsTestCase::DoRun (void)
+{
+  Mac48Address gw ("00:00:00:00:00:01");
+  Mac48Address ut1 ("00:00:00:00:00:11");
+  Mac48Address ut2 ("00:00:00:00:00:12");
+  Mac48Address ut3 ("00:00:00:00:00:13");
+
+  Ptr<SatGwLlc> llc = CreateObject<SatGwLlc> ();
+  llc->SetNodeInfo (Create<SatNodeInfo> (SatEnums::NT_GW, 0, gw));
+
+  // Enque to the flows in a mixed order
+  Enque (llc, ut2, 1, 1);
+  Enque (llc, ut1, 3, 1);
+  Enque (llc, ut3, 0, 2);
+  Enque (llc, ut1, 1, 2);
+  Enque (llc, ut2, 2, 1);
+
+  // All the flows, by flow id and then by UT address
+  Mac48Address allUts[] = { ut3, ut1, ut2, ut2, ut1 };
+  uint8_t allFlowIds[] = { 0, 1, 1, 2, 3 };
+  CheckSchedulingContexts (llc, std::vector<Mac48Address> (allUts, allUts + 5), std::vector<uint8_t> (allFlowIds, allFlowIds + 5));
+
+  // Drain two flows to empty and one flow partly
+  NS_TEST_ASSERT_MSG_EQ (Drain (llc, ut1, 1, 10), 0, "Flow not emptied");
+  NS_TEST_ASSERT_MSG_EQ (Drain (llc, ut2, 2, 10), 0, "Flow not emptied");
+  NS_TEST_ASSERT_MSG_GT (Drain (llc, ut3, 0, 1), 0, "Flow emptied by a single Tx opportunity");
+
+  Mac48Address drainedUts[] = { ut3, ut2, ut1 };
+  uint8_t drainedFlowIds[] = { 0, 1, 3 };
+  CheckSchedulingContexts (llc, std::vector<Mac48Address> (drainedUts, drainedUts + 3), std::vector<uint8_t> (drainedFlowIds, drainedFlowIds + 3));
+
+  // An emptied flow comes back with a new packet
+  Enque (llc, ut1, 1, 1);
+
+  Mac48Address refilledUts[] = { ut3, ut1, ut2, ut1 };
+  uint8_t refilledFlowIds[] = { 0, 1, 1, 3 };
+  CheckSchedulingContexts (llc, std::vector<Mac48Address> (refilledUts, refilledUts + 4), std::vector<uint8_t> (refilledFlowIds, refilledFlowIds + 4));
+
+  llc->Dispose ();
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case for the scheduling contexts of the backlogged flows of the GW LLC
+ * with FWD link ARQ.
+ *
+ * Expected results
+ * - A flow drained to empty is not given in the scheduling contexts, while another
+ *   flow with data is
+ * - When the ARQ retransmission timer of the sent PDU expires, the retransmission
+ *   refills the flow, which is then given again in the scheduling contexts
+ * - The flow is not given after its retransmission is sent
+ * - After the last retransmission the PDU is dropped without refilling the flow,
+ *   so the flow is not given again
+ */
+class SatGwLlcArqSchedulingContextsTestCase : public SatGwLlcSchedulingContextsTestCase
+{
+public:
+  SatGwLlcArqSchedulingContextsTestCase ();
+  virtual ~SatGwLlcArqSchedulingContextsTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Run the simulator past the next ARQ retransmission timer expiry
+   */
+  void RunPastRetransmissionTimer ();
+};
+
+SatGwLlcArqSchedulingContextsTestCase::SatGwLlcArqSchedulingContextsTestCase ()
+  : SatGwLlcSchedulingContextsTestCase ("Test the scheduling contexts of the backlogged flows of the GW LLC with FWD link ARQ.")
+{
+}
+
+SatGwLlcArqSchedulingContextsTestCase::~SatGwLlcArqSchedulingContextsTestCase ()
+{
+}
+
+void
+SatGwLlcArqSchedulingContextsTestCase::RunPastRetransmissionTimer ()
+{
+  // The default retransmission timer is 0.6 s
+  Simulator::Stop (Seconds (0.7));
+  Simulator::Run ();
+}
+
+void
+SatGwLlcArqSchedulingContextsTestCase::DoRun (void)
+{
+  Mac48Address gw ("00:00:00:00:00:01");
+  Mac48Address ut1 ("00:00:00:00:00:11");
+  Mac48Address ut2 ("00:00:00:00:00:12");
+
+  Ptr<SatGwLlc> llc = CreateObject<SatGwLlc> ();
+  llc->SetAttribute ("FwdLinkArqEnabled", BooleanValue (true));
+  llc->SetNodeInfo (Create<SatNodeInfo> (SatEnums::NT_GW, 0, gw));
+
+  Enque (llc, ut1, 1, 1);
+  Enque (llc, ut2, 2, 1);
+
+  Mac48Address allUts[] = { ut1, ut2 };
+  uint8_t allFlowIds[] = { 1, 2 };
+  Mac48Address backloggedUts[] = { ut2 };
+  uint8_t backloggedFlowIds[] = { 2 };
+
+  // The first transmission and the two retransmissions empty the flow
+  for (uint32_t i = 0; i < 3; ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (Drain (llc, ut1, 1, 1), 0, "Flow not emptied");
+      CheckSchedulingContexts (llc, std::vector<Mac48Address> (backloggedUts, backloggedUts + 1), std::vector<uint8_t> (backloggedFlowIds, backloggedFlowIds + 1));
+
+      RunPastRetransmissionTimer ();
+
+      if (i < 2)
+        {
+          // Refilled by the retransmission
+          CheckSchedulingContexts (llc, std::vector<Mac48Address> (allUts, allUts + 2), std::vector<uint8_t> (allFlowIds, allFlowIds + 2));
+        }
+    }
+
+  // Maximum retransmissions reached, thus the PDU is dropped
+  CheckSchedulingContexts (llc, std::vector<Mac48Address> (backloggedUts, backloggedUts + 1), std::vector<uint8_t> (backloggedFlowIds, backloggedFlowIds + 1));
+
+  llc->Dispose ();
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test suite for GW LLC.
+ */
+class SatGwLlcTestSuite : public TestSuite
+{
+public:
+  SatGwLlcTestSuite ();
+};
+
+SatGwLlcTestSuite::SatGwLlcTestSuite ()
+  : TestSuite ("sat-gw-llc-test", UNIT)
+{
+  AddTestCase (new SatGwLlcSchedulingContextsTestCase, TestCase::QUICK);
+  AddTestCase (new SatGwLlcArqSchedulingContextsTestCase, TestCase::QUICK);
+}
+
+// Do a static instance, so that test suite is added to TestSuite list
+static SatGwLlcTestSuite satGwLlcTestSuite;
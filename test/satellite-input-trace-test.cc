@@ -0,0 +1,169 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 Magister Solutions Ltd
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Frans Laakso <frans.laakso@magister.fi>
+ */
+
+/**
+ * \file satellite-input-trace-test.cc
+ * \ingroup satellite
+ * \brief Test cases to unit test the input trace file containers.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/singleton.h"
+#include "../utils/satellite-env-variables.h"
+#include "../utils/satellite-input-fstream-time-double-container.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test that text and binary input trace files
+ * with the same samples give the same values.
+ *
+ *  1.  Write the same samples with irregular time intervals to a text file and to a binary file.
+ *  2.  Create SatInputFileStreamTimeDoubleContainer for both files.
+ *  3.  Get the next closest time samples of both containers at increasing simulation times,
+ *      with both small steps and jumps over several samples.
+ *
+ *  Expected result:
+ *    Both containers return the same rows.
+ */
+class SatInputTraceBinaryTestCase : public TestCase
+{
+public:
+  SatInputTraceBinaryTestCase ();
+  virtual ~SatInputTraceBinaryTestCase ();
+
+  void TestNextClosest (Ptr<SatInputFileStreamTimeDoubleContainer> textContainer, Ptr<SatInputFileStreamTimeDoubleContainer> binaryContainer);
+
+private:
+  virtual void DoRun (void);
+
+  std::vector<std::vector<double> > m_textResults;
+  std::vector<std::vector<double> > m_binaryResults;
+};
+
+SatInputTraceBinaryTestCase::SatInputTraceBinaryTestCase ()
+  : TestCase ("Test text and binary input trace files.")
+{
+}
+
+SatInputTraceBinaryTestCase::~SatInputTraceBinaryTestCase ()
+{
+}
+
+void
+SatInputTraceBinaryTestCase::TestNextClosest (Ptr<SatInputFileStreamTimeDoubleContainer> textContainer, Ptr<SatInputFileStreamTimeDoubleContainer> binaryContainer)
+{
+  m_textResults.push_back (textContainer->ProceedToNextClosestTimeSample ());
+  m_binaryResults.push_back (binaryContainer->ProceedToNextClosestTimeSample ());
+}
+
+void
+SatInputTraceBinaryTestCase::DoRun (void)
+{
+  // Set simulation output details
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-sat-input-trace", "", true);
+
+  Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable> ();
+  rng->SetStream (16);
+
+  std::string textFileName = Singleton<SatEnvVariables>::Get ()->GetOutputPath () + "/input-trace-test.txt";
+  std::string binaryFileName = Singleton<SatEnvVariables>::Get ()->GetOutputPath () + "/input-trace-test.bin";
+
+  std::ofstream textFile (textFileName.c_str (), std::ios::out | std::ios::trunc);
+  std::ofstream binaryFile (binaryFileName.c_str (), std::ios::out | std::ios::binary | std::ios::trunc);
+
+  textFile << std::setprecision (17);
+
+  double time = 0.0;
+
+  for (uint32_t i = 0; i < 2000; i++)
+    {
+      double row[2] = { time, 10.0 * std::log10 (rng->GetValue (1e-15, 1e-10)) };
+
+      textFile << row[0] << " " << row[1] << std::endl;
+      binaryFile.write ((const char*)row, sizeof (row));
+
+      time += rng->GetValue (0.001, 0.01);
+    }
+
+  textFile.close ();
+  binaryFile.close ();
+
+  Ptr<SatInputFileStreamTimeDoubleContainer> textContainer =
+    CreateObject<SatInputFileStreamTimeDoubleContainer> (textFileName, std::ios::in, 2);
+  Ptr<SatInputFileStreamTimeDoubleContainer> binaryContainer =
+    CreateObject<SatInputFileStreamTimeDoubleContainer> (binaryFileName, std::ios::in | std::ios::binary, 2);
+
+  double simTime = 0.0;
+
+  while (simTime < time)
+    {
+      Simulator::Schedule (Seconds (simTime), &SatInputTraceBinaryTestCase::TestNextClosest, this, textContainer, binaryContainer);
+
+      // mostly small steps, sometimes jumps over several samples
+      simTime += (rng->GetValue () < 0.9) ? rng->GetValue (0.0, 0.005) : rng->GetValue (0.05, 0.5);
+    }
+
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_GT (m_textResults.size (), (size_t) 0, "No samples");
+
+  for (uint32_t i = 0; i < m_textResults.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_textResults[i][0], m_binaryResults[i][0], "Different time sample from text and binary files");
+      NS_TEST_ASSERT_MSG_EQ (m_textResults[i][1], m_binaryResults[i][1], "Different value from text and binary files");
+    }
+
+  Simulator::Destroy ();
+
+  std::remove (textFileName.c_str ());
+  std::remove (binaryFileName.c_str ());
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test suite for the input trace file containers.
+ */
+class SatInputTraceTestSuite : public TestSuite
+{
+public:
+  SatInputTraceTestSuite ();
+};
+
+SatInputTraceTestSuite::SatInputTraceTestSuite ()
+  : TestSuite ("sat-input-trace-test", UNIT)
+{
+  AddTestCase (new SatInputTraceBinaryTestCase, TestCase::QUICK);
+}
+
+// Do a static instance, so that test suite is added to TestSuite list
+static SatInputTraceTestSuite satInputTraceTestSuite;
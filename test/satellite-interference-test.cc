@@ -25,6 +25,7 @@
  */
 
 // Include a header file from your module to test.
+#include <algorithm>
 #include "ns3/log.h"
 #include "ns3/test.h"
 #include "ns3/timer.h"
@@ -33,9 +34,12 @@
 #include "ns3/boolean.h"
 #include "ns3/string.h"
 #include "ns3/double.h"
+#include "ns3/nstime.h"
 #include "../model/satellite-constant-interference.h"
 #include "../model/satellite-traced-interference.h"
 #include "../model/satellite-per-packet-interference.h"
+#include "../model/satellite-per-packet-timeline-interference.h"
+#include "../model/satellite-slot-synchronous-interference.h"
 #include "ns3/singleton.h"
 #include "../utils/satellite-env-variables.h"
 
@@ -239,6 +243,235 @@ SatPerPacketInterferenceTestCase::DoRun (void)
   Singleton<SatEnvVariables>::Get ()->DoDispose ();
 }
 
+/**
+ * \ingroup satellite
+ * \brief Test case to compare timeline based per packet interference model against the per packet model.
+ *
+ * This case tests that SatPerPacketTimelineInterference calculates the same interference as SatPerPacketInterference.
+ *  1.  Create SatPerPacketInterference and SatPerPacketTimelineInterference objects.
+ *  2.  Add the same set of overlapping interfering and received events to both objects.
+ *  3.  Calculate interference for the received events with both objects at the end of receiving.
+ *
+ *  Expected result:
+ *   Both models should give the same interference for every received event.
+ *
+ */
+class SatPerPacketTimelineInterferenceTestCase : public TestCase
+{
+public:
+  SatPerPacketTimelineInterferenceTestCase ();
+  virtual ~SatPerPacketTimelineInterferenceTestCase ();
+
+  // adds interference to both model objects
+  void AddInterference (Time duration, double power, Address rxAddress);
+
+  // adds receivers own interference to both model objects and schedules receiving
+  void StartReceiver (Time duration, double power, Address rxAddress);
+
+  // receives packets i.e. calculates interference with both models and stops receiving.
+  void Receive (Ptr<SatInterference::InterferenceChangeEvent> refEvent, Ptr<SatInterference::InterferenceChangeEvent> event);
+
+private:
+  virtual void DoRun (void);
+  Ptr<SatPerPacketInterference> m_refInterference;
+  Ptr<SatPerPacketTimelineInterference> m_interference;
+  uint32_t m_receiveCount;
+};
+
+SatPerPacketTimelineInterferenceTestCase::SatPerPacketTimelineInterferenceTestCase ()
+  : TestCase ("Test satellite per packet timeline interference model against per packet model."),
+    m_receiveCount (0)
+{
+  m_refInterference = CreateObject<SatPerPacketInterference> ();
+  m_interference = CreateObject<SatPerPacketTimelineInterference> ();
+}
+
+SatPerPacketTimelineInterferenceTestCase::~SatPerPacketTimelineInterferenceTestCase ()
+{
+}
+
+void
+SatPerPacketTimelineInterferenceTestCase::AddInterference (Time duration, double power, Address rxAddress)
+{
+  m_refInterference->Add (duration, power, rxAddress);
+  m_interference->Add (duration, power, rxAddress);
+}
+
+void
+SatPerPacketTimelineInterferenceTestCase::StartReceiver (Time duration, double power, Address rxAddress)
+{
+  Ptr<SatInterference::InterferenceChangeEvent> refEvent = m_refInterference->Add (duration, power, rxAddress);
+  Ptr<SatInterference::InterferenceChangeEvent> event = m_interference->Add (duration, power, rxAddress);
+
+  m_refInterference->NotifyRxStart (refEvent);
+  m_interference->NotifyRxStart (event);
+
+  Simulator::Schedule (duration, &SatPerPacketTimelineInterferenceTestCase::Receive, this, refEvent, event);
+}
+
+void
+SatPerPacketTimelineInterferenceTestCase::Receive (Ptr<SatInterference::InterferenceChangeEvent> refEvent, Ptr<SatInterference::InterferenceChangeEvent> event)
+{
+  double refPower = m_refInterference->Calculate (refEvent);
+  double power = m_interference->Calculate (event);
+
+  NS_TEST_ASSERT_MSG_EQ_TOL (power, refPower, 1e-9 * std::max (1.0, refPower), "Interference differs from per packet model");
+
+  m_refInterference->NotifyRxEnd (refEvent);
+  m_interference->NotifyRxEnd (event);
+
+  m_receiveCount++;
+}
+
+void
+SatPerPacketTimelineInterferenceTestCase::DoRun (void)
+{
+  // Set simulation output details
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-sat-if-unit", "perpackettimeline", true);
+
+  // deterministic pseudo random pattern of overlapping interferers and receivers
+  uint32_t seed = 12345;
+  uint32_t receivers = 0;
+
+  for (uint32_t i = 0; i < 500; i++)
+    {
+      seed = seed * 1103515245 + 12345;
+      Time start = Time (i * 7 + (seed >> 16) % 5);
+      Time duration = Time (1 + (seed >> 8) % 60);
+      double power = 1.0 + (seed >> 4) % 100;
+
+      if (i % 3 == 0)
+        {
+          Simulator::Schedule (start, &SatPerPacketTimelineInterferenceTestCase::StartReceiver, this, duration, power, Mac48Address::ConvertFrom (Mac48Address::Allocate ()));
+          receivers++;
+        }
+      else
+        {
+          Simulator::Schedule (start, &SatPerPacketTimelineInterferenceTestCase::AddInterference, this, duration, power, Mac48Address::ConvertFrom (Mac48Address::Allocate ()));
+        }
+    }
+
+  // a long receiver keeps a large part of the timeline alive, after the
+  // start of the timeline has already moved
+  Simulator::Schedule (Time (1000), &SatPerPacketTimelineInterferenceTestCase::StartReceiver, this, Time (2000), 10.0, Mac48Address::ConvertFrom (Mac48Address::Allocate ()));
+  receivers++;
+
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_receiveCount, receivers, "Not all receivers calculated");
+
+  Simulator::Destroy ();
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test satellite slot synchronous interference model.
+ *
+ * This case tests that SatSlotSynchronousInterference collects bursts into slots correctly.
+ *  1.  Create SatSlotSynchronousInterference object with two time slots in a superframe.
+ *  2.  Add bursts of the slots of two superframes and bursts outside the slots, and notify receiving of them.
+ *  3.  Calculate interference for the received bursts at the end of receiving.
+ *
+ *  Expected result:
+ *   Interference of a burst in a slot should be the sum of power of the other bursts in the same slot
+ *   of the same superframe. Interference of a burst outside the slots should be the average power
+ *   of all the other bursts overlapping it.
+ *
+ */
+class SatSlotSynchronousInterferenceTestCase : public TestCase
+{
+public:
+  SatSlotSynchronousInterferenceTestCase ();
+  virtual ~SatSlotSynchronousInterferenceTestCase ();
+
+  // adds burst to model object and schedules receiving of it
+  void StartReceiver (Time duration, double power, uint32_t rxIndex);
+
+  // receives burst i.e. calculates interference and stops receiving.
+  void Receive (uint32_t rxIndex);
+
+private:
+  virtual void DoRun (void);
+  Ptr<SatSlotSynchronousInterference> m_interference;
+  Ptr<SatInterference::InterferenceChangeEvent> m_rxEvent[7];
+  double m_finalPower[7];
+};
+
+SatSlotSynchronousInterferenceTestCase::SatSlotSynchronousInterferenceTestCase ()
+  : TestCase ("Test satellite slot synchronous interference model.")
+{
+  m_interference = CreateObject<SatSlotSynchronousInterference> ();
+
+  for (uint32_t i = 0; i < 7; i++)
+    {
+      m_finalPower[i] = -1;
+    }
+}
+
+SatSlotSynchronousInterferenceTestCase::~SatSlotSynchronousInterferenceTestCase ()
+{
+}
+
+void
+SatSlotSynchronousInterferenceTestCase::StartReceiver (Time duration, double power, uint32_t rxIndex)
+{
+  m_rxEvent[rxIndex] = m_interference->Add (duration, power, Mac48Address::ConvertFrom (Mac48Address::Allocate ()));
+  m_interference->NotifyRxStart (m_rxEvent[rxIndex]);
+
+  Simulator::Schedule (duration, &SatSlotSynchronousInterferenceTestCase::Receive, this, rxIndex);
+}
+
+void
+SatSlotSynchronousInterferenceTestCase::Receive (uint32_t rxIndex)
+{
+  m_finalPower[rxIndex] = m_interference->Calculate (m_rxEvent[rxIndex]);
+  m_interference->NotifyRxEnd (m_rxEvent[rxIndex]);
+}
+
+void
+SatSlotSynchronousInterferenceTestCase::DoRun (void)
+{
+  // Set simulation output details
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-sat-if-unit", "slotsynchronous", true);
+
+  // superframe of duration 1000 with time slots 0 and 1 starting at 0 and 100
+  std::vector< std::pair<Time, Time> > slots;
+  slots.push_back (std::make_pair (Time (0), Time (100)));
+  slots.push_back (std::make_pair (Time (100), Time (100)));
+
+  m_interference->SetAttribute ("SlotTimingTolerance", TimeValue (Time (1)));
+  m_interference->SetSlots (Time (1000), slots);
+
+  // slot 0 with bursts 0 and 1, bursts 2 and 3 are misaligned and outside the slots
+  Simulator::Schedule (Time (0), &SatSlotSynchronousInterferenceTestCase::StartReceiver, this, Time (100), 10, 0);
+  Simulator::Schedule (Time (0), &SatSlotSynchronousInterferenceTestCase::StartReceiver, this, Time (100), 20, 1);
+  Simulator::Schedule (Time (30), &SatSlotSynchronousInterferenceTestCase::StartReceiver, this, Time (100), 40, 2);
+  Simulator::Schedule (Time (60), &SatSlotSynchronousInterferenceTestCase::StartReceiver, this, Time (100), 5, 3);
+
+  // slot 1 with burst 4
+  Simulator::Schedule (Time (100), &SatSlotSynchronousInterferenceTestCase::StartReceiver, this, Time (100), 7, 4);
+
+  // slot 0 of the next superframe with bursts 5 and 6
+  Simulator::Schedule (Time (1000), &SatSlotSynchronousInterferenceTestCase::StartReceiver, this, Time (100), 3, 5);
+  Simulator::Schedule (Time (1000), &SatSlotSynchronousInterferenceTestCase::StartReceiver, this, Time (100), 4, 6);
+
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ_TOL (m_finalPower[0], 20, 1e-12, "Final power incorrect");
+  NS_TEST_ASSERT_MSG_EQ_TOL (m_finalPower[1], 10, 1e-12, "Final power incorrect");
+  NS_TEST_ASSERT_MSG_EQ_TOL (m_finalPower[2], 26.6, 1e-9, "Final power incorrect");
+  NS_TEST_ASSERT_MSG_EQ_TOL (m_finalPower[3], 44.2, 1e-9, "Final power incorrect");
+  NS_TEST_ASSERT_MSG_EQ_TOL (m_finalPower[4], 0, 1e-12, "Final power incorrect");
+  NS_TEST_ASSERT_MSG_EQ_TOL (m_finalPower[5], 4, 1e-12, "Final power incorrect");
+  NS_TEST_ASSERT_MSG_EQ_TOL (m_finalPower[6], 3, 1e-12, "Final power incorrect");
+
+  Simulator::Destroy ();
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
 /**
  * \ingroup satellite
  * \brief Test suite for Satellite interference unit test cases.
@@ -254,6 +487,8 @@ SatInterferenceTestSuite::SatInterferenceTestSuite ()
 {
   AddTestCase (new SatConstantInterferenceTestCase, TestCase::QUICK);
   AddTestCase (new SatPerPacketInterferenceTestCase, TestCase::QUICK);
+  AddTestCase (new SatPerPacketTimelineInterferenceTestCase, TestCase::QUICK);
+  AddTestCase (new SatSlotSynchronousInterferenceTestCase, TestCase::QUICK);
 }
 
 // Do allocate an instance of this TestSuite
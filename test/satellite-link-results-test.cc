@@ -25,9 +25,16 @@
  * \brief Test cases for satellite link results.
  */
 
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <vector>
 #include <ns3/test.h>
 #include <ns3/satellite-link-results.h>
 #include <ns3/satellite-look-up-table.h>
+#include <ns3/satellite-utils.h>
+#include <ns3/satellite-env-variables.h>
+#include <ns3/singleton.h>
 #include <ns3/log.h>
 #include <ns3/ptr.h>
 
@@ -158,6 +165,129 @@ SatLinkResultsDvbS2TestCase::DoRun ()
 
 
 
+/*
+ * LOOK UP TABLE GRID TEST CASE
+ */
+
+/**
+ * \brief Test case for comparing the BLER values of the Es/No grid lookup of
+ *        SatLookUpTable with the linear search of the table.
+ *
+ * The BLER is queried over a dense Es/No sweep covering the table range and
+ * beyond, at the Es/No values of the table rows and at the midpoints between
+ * them. The test fails if any BLER differs from the one of the linear search
+ * and interpolation, or if a NaN Es/No does not give the maximum BLER.
+ */
+class SatLookUpTableGridTestCase : public TestCase
+{
+public:
+  /**
+   * \param filePathName path of the link results file to be tested
+   */
+  SatLookUpTableGridTestCase (std::string filePathName);
+private:
+  virtual void DoRun ();
+
+  /**
+   * \brief Get BLER with a linear search of the table rows
+   * \param table the look up table
+   * \param esNoDb Es/No in dB
+   * \return BLER
+   */
+  double GetLinearBler (Ptr<SatLookUpTable> table, double esNoDb) const;
+
+  std::string m_filePathName;
+};
+
+
+SatLookUpTableGridTestCase::SatLookUpTableGridTestCase (std::string filePathName)
+  : TestCase ("Comparing SatLookUpTable grid lookup with linear search for " + filePathName),
+    m_filePathName (filePathName)
+{
+}
+
+
+double
+SatLookUpTableGridTestCase::GetLinearBler (Ptr<SatLookUpTable> table, double esNoDb) const
+{
+  const std::vector<double>& esNo = table->GetEsNoDbValues ();
+  const std::vector<double>& bler = table->GetBlerValues ();
+  uint32_t n = esNo.size ();
+
+  if (esNoDb < esNo[0])
+    {
+      return 1.0;
+    }
+
+  uint32_t i = 0;
+
+  while ((i < n) && (esNoDb > esNo[i]))
+    {
+      i++;
+    }
+
+  if (i >= n)
+    {
+      return 0.0;
+    }
+
+  if (i == 0)
+    {
+      // Es/No equal to the first row, interpolation to the row itself
+      return bler[0];
+    }
+
+  return SatUtils::Interpolate (esNoDb, esNo[i - 1], esNo[i], bler[i - 1], bler[i]);
+}
+
+
+void
+SatLookUpTableGridTestCase::DoRun ()
+{
+  NS_LOG_FUNCTION (this << m_filePathName);
+
+  Ptr<SatLookUpTable> table = CreateObject<SatLookUpTable> (m_filePathName);
+
+  const std::vector<double>& esNo = table->GetEsNoDbValues ();
+  std::vector<double> sweep;
+
+  // dense sweep over the table range and one dB beyond both ends
+  double firstDb = esNo.front () - 1.0;
+  double lastDb = esNo.back () + 1.0;
+  uint32_t steps = (uint32_t) std::ceil ((lastDb - firstDb) / 0.001);
+
+  for (uint32_t i = 0; i <= steps; ++i)
+    {
+      sweep.push_back (firstDb + i * 0.001);
+    }
+
+  // the rows, the values next to them and the midpoints between the rows
+  for (uint32_t i = 0; i < esNo.size (); ++i)
+    {
+      sweep.push_back (esNo[i]);
+      sweep.push_back (esNo[i] - std::abs (esNo[i]) * std::numeric_limits<double>::epsilon ());
+      sweep.push_back (esNo[i] + std::abs (esNo[i]) * std::numeric_limits<double>::epsilon ());
+
+      if (i > 0)
+        {
+          sweep.push_back ((esNo[i - 1] + esNo[i]) / 2.0);
+        }
+    }
+
+  for (std::vector<double>::const_iterator it = sweep.begin (); it != sweep.end (); ++it)
+    {
+      NS_TEST_ASSERT_MSG_EQ (table->GetBler (*it), GetLinearBler (table, *it),
+                             "Grid lookup differs from linear search at Es/No " << *it << " dB");
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (table->GetBler (std::numeric_limits<double>::quiet_NaN ()), 1.0,
+                         "NaN Es/No should give maximum BLER");
+
+  table->Dispose ();
+}
+
+
+
 /*
  * TEST SUITE
  */
@@ -789,6 +919,31 @@ public:
 
     // END OF AUTO-GENERATED TEST CASES
 
+    // grid lookup of every shipped link results table
+    std::string dataPath = Singleton<SatEnvVariables>::Get ()->GetDataPath ();
+    std::string inputPath = Singleton<SatEnvVariables>::Get ()->LocateDirectory (dataPath + "/linkresults/");
+
+    for (uint32_t i = 2; i <= 22; ++i)
+      {
+        std::ostringstream ss;
+        ss << i;
+        AddTestCase (new SatLookUpTableGridTestCase (inputPath + "rcs2_waveformat" + ss.str () + ".txt"), TestCase::QUICK);
+      }
+
+    const char* dvbS2Tables[] = { "s2_qpsk_1_to_2.txt", "s2_qpsk_2_to_3.txt", "s2_qpsk_3_to_4.txt",
+                                  "s2_qpsk_3_to_5.txt", "s2_qpsk_4_to_5.txt", "s2_qpsk_5_to_6.txt",
+                                  "s2_qpsk_8_to_9.txt", "s2_qpsk_9_to_10.txt", "s2_8psk_2_to_3.txt",
+                                  "s2_8psk_3_to_4.txt", "s2_8psk_3_to_5.txt", "s2_8psk_5_to_6.txt",
+                                  "s2_8psk_8_to_9.txt", "s2_8psk_9_to_10.txt", "s2_16apsk_2_to_3.txt",
+                                  "s2_16apsk_3_to_4.txt", "s2_16apsk_4_to_5.txt", "s2_16apsk_5_to_6.txt",
+                                  "s2_16apsk_8_to_9.txt", "s2_16apsk_9_to_10.txt", "s2_32apsk_3_to_4.txt",
+                                  "s2_32apsk_4_to_5.txt", "s2_32apsk_5_to_6.txt", "s2_32apsk_8_to_9.txt" };
+
+    for (uint32_t i = 0; i < sizeof (dvbS2Tables) / sizeof (dvbS2Tables[0]); ++i)
+      {
+        AddTestCase (new SatLookUpTableGridTestCase (inputPath + dvbS2Tables[i]), TestCase::QUICK);
+      }
+
   } // end of LinkResultTestSuite ()
 
 } g_linkResultTestSuite;
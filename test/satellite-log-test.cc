@@ -0,0 +1,239 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 Magister Solutions Ltd
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Frans Laakso <frans.laakso@magister.fi>
+ */
+
+/**
+ * \file satellite-log-test.cc
+ * \ingroup satellite
+ * \brief Test cases to unit test the simulator output log.
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+#include "ns3/singleton.h"
+#include "../utils/satellite-env-variables.h"
+#include "../model/satellite-log.h"
+
+using namespace ns3;
+
+/**
+ * \brief Function for reading the lines of a file
+ * \param fileName file name
+ * \return lines of the file
+ */
+static std::vector<std::string>
+ReadLines (std::string fileName)
+{
+  std::ifstream file (fileName.c_str ());
+  std::vector<std::string> lines;
+  std::string line;
+
+  while (std::getline (file, line))
+    {
+      lines.push_back (line);
+    }
+
+  return lines;
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test that plain and structured entries are written
+ * into the logs in the order they were added.
+ *
+ *  1.  Create a SatLog with all the log types enabled.
+ *  2.  Add plain and structured entries alternately to the warning log, and
+ *      interleave them with plain and structured entries of the error log and
+ *      a plain entry of a custom log.
+ *  3.  Dispose the log to write the files.
+ *
+ *  Expected result:
+ *    Each log file contains its own entries in the order they were added. The
+ *    structured entries have the same text as the corresponding plain messages.
+ */
+class SatLogOrderTestCase : public TestCase
+{
+public:
+  SatLogOrderTestCase ();
+  virtual ~SatLogOrderTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SatLogOrderTestCase::SatLogOrderTestCase ()
+  : TestCase ("Test the order and text of plain and structured log entries.")
+{
+}
+
+SatLogOrderTestCase::~SatLogOrderTestCase ()
+{
+}
+
+void
+SatLogOrderTestCase::DoRun (void)
+{
+  // Set simulation output details
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-sat-log-order", "", true);
+
+  std::string outputPath = Singleton<SatEnvVariables>::Get ()->GetOutputPath ();
+
+  Ptr<SatLog> log = CreateObject<SatLog> ();
+
+  log->AddToLog (SatLog::LOG_WARNING, "", "Plain warning 1");
+  log->AddToLog (SatLog::LOG_ERROR, SatLog::FMT_QUEUE_FULL, 2.0, (uint32_t) 5);
+  log->AddToLog (SatLog::LOG_WARNING, SatLog::FMT_QUEUE_FULL, 1.5, (uint32_t) 100);
+  log->AddToLog (SatLog::LOG_CUSTOM, "_test", "Plain custom");
+  log->AddToLog (SatLog::LOG_ERROR, "", "Plain error");
+  log->AddToLog (SatLog::LOG_WARNING, "", "Plain warning 2");
+  log->AddToLog (SatLog::LOG_WARNING, SatLog::FMT_CTRL_MSG_NOT_FOUND, (uint32_t) 7, "FWD", 0.1234567);
+  log->AddToLog (SatLog::LOG_WARNING, "", "Plain warning 3");
+
+  log->Dispose ();
+
+  std::vector<std::string> warnings = ReadLines (outputPath + "/log_warning");
+  std::vector<std::string> errors = ReadLines (outputPath + "/log_error");
+  std::vector<std::string> customs = ReadLines (outputPath + "/log_test");
+
+  NS_TEST_ASSERT_MSG_EQ (warnings.size (), 5, "Unexpected number of warning entries");
+  NS_TEST_ASSERT_MSG_EQ (warnings[0], "Plain warning 1", "Unexpected warning entry");
+  NS_TEST_ASSERT_MSG_EQ (warnings[1], "SatQueue is full: packet dropped! at: 1.5s MaxPackets: 100", "Unexpected warning entry");
+  NS_TEST_ASSERT_MSG_EQ (warnings[2], "Plain warning 2", "Unexpected warning entry");
+  NS_TEST_ASSERT_MSG_EQ (warnings[3], "Control message 7 is not found from the FWD link control msg container! at: 0.123457s", "Unexpected warning entry");
+  NS_TEST_ASSERT_MSG_EQ (warnings[4], "Plain warning 3", "Unexpected warning entry");
+
+  NS_TEST_ASSERT_MSG_EQ (errors.size (), 2, "Unexpected number of error entries");
+  NS_TEST_ASSERT_MSG_EQ (errors[0], "SatQueue is full: packet dropped! at: 2s MaxPackets: 5", "Unexpected error entry");
+  NS_TEST_ASSERT_MSG_EQ (errors[1], "Plain error", "Unexpected error entry");
+
+  NS_TEST_ASSERT_MSG_EQ (customs.size (), 1, "Unexpected number of custom entries");
+  NS_TEST_ASSERT_MSG_EQ (customs[0], "Plain custom", "Unexpected custom entry");
+
+  std::remove ((outputPath + "/log_warning").c_str ());
+  std::remove ((outputPath + "/log_error").c_str ());
+  std::remove ((outputPath + "/log_test").c_str ());
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test that disabled log types are dropped.
+ *
+ *  1.  Create a SatLog with EnabledLogTypes set to 0.
+ *  2.  Add plain and structured entries to all the predefined log types and a
+ *      plain entry to a custom log.
+ *  3.  Dispose the log.
+ *
+ *  Expected result:
+ *    No log type is enabled and no log file is created.
+ */
+class SatLogDisabledTestCase : public TestCase
+{
+public:
+  SatLogDisabledTestCase ();
+  virtual ~SatLogDisabledTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SatLogDisabledTestCase::SatLogDisabledTestCase ()
+  : TestCase ("Test that the entries of disabled log types are dropped.")
+{
+}
+
+SatLogDisabledTestCase::~SatLogDisabledTestCase ()
+{
+}
+
+void
+SatLogDisabledTestCase::DoRun (void)
+{
+  // Set simulation output details
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-sat-log-disabled", "", true);
+
+  std::string outputPath = Singleton<SatEnvVariables>::Get ()->GetOutputPath ();
+
+  std::vector<std::string> fileNames;
+  fileNames.push_back (outputPath + "/log");
+  fileNames.push_back (outputPath + "/log_info");
+  fileNames.push_back (outputPath + "/log_warning");
+  fileNames.push_back (outputPath + "/log_error");
+  fileNames.push_back (outputPath + "/log_test");
+
+  /// the output folder may be left from an earlier run
+  for (uint32_t i = 0; i < fileNames.size (); i++)
+    {
+      std::remove (fileNames[i].c_str ());
+    }
+
+  Ptr<SatLog> log = CreateObject<SatLog> ();
+  log->SetAttribute ("EnabledLogTypes", UintegerValue (0));
+
+  for (uint32_t i = SatLog::LOG_GENERIC; i <= SatLog::LOG_CUSTOM; i++)
+    {
+      SatLog::LogType_t logType = (SatLog::LogType_t) i;
+
+      NS_TEST_ASSERT_MSG_EQ (log->IsEnabled (logType), false, "Log type enabled");
+
+      log->AddToLog (logType, "_test", "Plain message");
+
+      if (logType != SatLog::LOG_CUSTOM)
+        {
+          log->AddToLog (logType, SatLog::FMT_QUEUE_FULL, 1.5, (uint32_t) 100);
+        }
+    }
+
+  log->Dispose ();
+
+  for (uint32_t i = 0; i < fileNames.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (Singleton<SatEnvVariables>::Get ()->IsValidFile (fileNames[i]), false, "Log file created for a disabled log type");
+    }
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test suite for the simulator output log.
+ */
+class SatLogTestSuite : public TestSuite
+{
+public:
+  SatLogTestSuite ();
+};
+
+SatLogTestSuite::SatLogTestSuite ()
+  : TestSuite ("sat-log-test", UNIT)
+{
+  AddTestCase (new SatLogOrderTestCase, TestCase::QUICK);
+  AddTestCase (new SatLogDisabledTestCase, TestCase::QUICK);
+}
+
+// Do a static instance, so that test suite is added to TestSuite list
+static SatLogTestSuite satLogTestSuite;
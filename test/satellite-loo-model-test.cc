@@ -0,0 +1,162 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 Magister Solutions Ltd
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Frans Laakso <frans.laakso@magister.fi>
+ */
+
+/**
+ * \file satellite-loo-model-test.cc
+ * \ingroup satellite
+ * \brief Test cases to unit test the Loo's model fader oscillators.
+ */
+
+#include <cmath>
+#include <complex>
+#include <vector>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/ptr.h"
+#include "ns3/object.h"
+#include "ns3/double.h"
+#include "ns3/random-variable-stream.h"
+#include "../model/satellite-loo-model.h"
+#include "../model/satellite-fading-oscillator.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test the oscillator sums of the Loo's model fader.
+ *
+ *  1.  Create random direct signal and multipath oscillators with fixed random streams,
+ *      both as oscillator banks and as SatFadingOscillator objects.
+ *  2.  Calculate the oscillator sums of the banks at different times.
+ *  3.  Calculate the sums of the SatFadingOscillator values at the same times.
+ *
+ *  Expected result:
+ *    The oscillator bank sums are equal to the SatFadingOscillator sums (in tolerance).
+ */
+class SatLooOscillatorSumTestCase : public TestCase
+{
+public:
+  SatLooOscillatorSumTestCase ();
+  virtual ~SatLooOscillatorSumTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SatLooOscillatorSumTestCase::SatLooOscillatorSumTestCase ()
+  : TestCase ("Test Loo's model oscillator sums against the fading oscillators.")
+{
+}
+
+SatLooOscillatorSumTestCase::~SatLooOscillatorSumTestCase ()
+{
+}
+
+void
+SatLooOscillatorSumTestCase::DoRun (void)
+{
+  for (uint32_t stream = 1; stream <= 5; stream++)
+    {
+      Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+      uniform->SetAttribute ("Min", DoubleValue (-1.0 * M_PI));
+      uniform->SetAttribute ("Max", DoubleValue (M_PI));
+      uniform->SetStream (stream);
+
+      Ptr<NormalRandomVariable> normal = CreateObject<NormalRandomVariable> ();
+      normal->SetStream (stream + 100);
+
+      uint32_t numOfOscillators = 10 * stream;
+
+      SatLooModel::oscillatorBank_s directBank;
+      SatLooModel::oscillatorBank_s multipathBank;
+      std::vector< Ptr<SatFadingOscillator> > directOscillators;
+      std::vector< Ptr<SatFadingOscillator> > multipathOscillators;
+
+      double directPhi = uniform->GetValue ();
+      double multipathPhi = uniform->GetValue ();
+
+      for (uint32_t i = 0; i < numOfOscillators; i++)
+        {
+          double directOmega = 2.0 * M_PI * 2.5 * std::cos (uniform->GetValue ());
+          double directAmplitude = std::pow (10, normal->GetValue (-2.0, 1.0) / 10) / numOfOscillators;
+
+          directBank.amplitudeReal.push_back (directAmplitude);
+          directBank.phase.push_back (directPhi);
+          directBank.omega.push_back (directOmega);
+          directOscillators.push_back (CreateObject<SatFadingOscillator> (directAmplitude, directPhi, directOmega));
+
+          double multipathOmega = 2.0 * M_PI * 30.0 * std::cos (uniform->GetValue ());
+          double psi = normal->GetValue ();
+          std::complex<double> multipathAmplitude = std::complex<double> (std::cos (psi), std::sin (psi)) * 2.0 / std::sqrt (numOfOscillators);
+
+          multipathBank.amplitudeReal.push_back (multipathAmplitude.real ());
+          multipathBank.amplitudeImag.push_back (multipathAmplitude.imag ());
+          multipathBank.phase.push_back (multipathPhi);
+          multipathBank.omega.push_back (multipathOmega);
+          multipathOscillators.push_back (CreateObject<SatFadingOscillator> (multipathAmplitude, multipathPhi, multipathOmega));
+        }
+
+      std::vector<double> phases;
+
+      for (double time = 0.0; time < 10.0; time += 0.0137)
+        {
+          std::complex<double> direct = SatLooModel::GetOscillatorCosineWaveSum (directBank, time, phases);
+          std::complex<double> multipath = SatLooModel::GetOscillatorComplexSum (multipathBank, time, phases);
+
+          std::complex<double> expectedDirect (0, 0);
+          std::complex<double> expectedMultipath (0, 0);
+
+          for (uint32_t i = 0; i < numOfOscillators; i++)
+            {
+              expectedDirect += directOscillators[i]->GetCosineWaveValueAt (time);
+              expectedMultipath += multipathOscillators[i]->GetComplexValueAt (time);
+            }
+
+          double tolerance = 1e-12 * (1.0 + std::abs (expectedDirect));
+
+          NS_TEST_ASSERT_MSG_EQ_TOL (direct.real (), expectedDirect.real (), tolerance, "Direct signal sum (real) not within tolerance");
+          NS_TEST_ASSERT_MSG_EQ_TOL (direct.imag (), expectedDirect.imag (), tolerance, "Direct signal sum (imag) not within tolerance");
+
+          tolerance = 1e-12 * (1.0 + std::abs (expectedMultipath));
+
+          NS_TEST_ASSERT_MSG_EQ_TOL (multipath.real (), expectedMultipath.real (), tolerance, "Multipath sum (real) not within tolerance");
+          NS_TEST_ASSERT_MSG_EQ_TOL (multipath.imag (), expectedMultipath.imag (), tolerance, "Multipath sum (imag) not within tolerance");
+        }
+    }
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test suite for the Loo's model fader.
+ */
+class SatLooModelTestSuite : public TestSuite
+{
+public:
+  SatLooModelTestSuite ();
+};
+
+SatLooModelTestSuite::SatLooModelTestSuite ()
+  : TestSuite ("sat-loo-model-test", UNIT)
+{
+  AddTestCase (new SatLooOscillatorSumTestCase, TestCase::QUICK);
+}
+
+// Do a static instance, so that test suite is added to TestSuite list
+static SatLooModelTestSuite satLooModelTestSuite;
@@ -0,0 +1,286 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 Magister Solutions Ltd
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Frans Laakso <frans.laakso@magister.fi>
+ */
+
+/**
+ * \file satellite-output-fstream-test.cc
+ * \ingroup satellite
+ * \brief Test cases to unit test the output file stream containers.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/singleton.h"
+#include "../utils/satellite-env-variables.h"
+#include "../utils/satellite-output-fstream-double-container.h"
+#include "../utils/satellite-output-fstream-writer.h"
+#include "../utils/satellite-output-binary-trace-file.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test that streamed output files are equal to
+ * the output files written at the end.
+ *
+ *  1.  Limit the chunk budget of the background writer to two chunks.
+ *  2.  Create a non-streamed SatOutputFileStreamDoubleContainer and two streamed
+ *      containers with different chunk sizes sharing the background writer.
+ *  3.  Add the same random rows to all the containers and write the files.
+ *
+ *  Expected result:
+ *    The streamed files are byte-identical to the non-streamed file.
+ */
+class SatOutputFileStreamStreamingTestCase : public TestCase
+{
+public:
+  SatOutputFileStreamStreamingTestCase ();
+  virtual ~SatOutputFileStreamStreamingTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  std::string ReadFile (std::string fileName);
+};
+
+SatOutputFileStreamStreamingTestCase::SatOutputFileStreamStreamingTestCase ()
+  : TestCase ("Test streamed output files against non-streamed output files.")
+{
+}
+
+SatOutputFileStreamStreamingTestCase::~SatOutputFileStreamStreamingTestCase ()
+{
+}
+
+std::string
+SatOutputFileStreamStreamingTestCase::ReadFile (std::string fileName)
+{
+  std::ifstream file (fileName.c_str (), std::ios::in | std::ios::binary);
+  std::ostringstream content;
+  content << file.rdbuf ();
+  return content.str ();
+}
+
+void
+SatOutputFileStreamStreamingTestCase::DoRun (void)
+{
+  // Set simulation output details
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-sat-output-fstream", "", true);
+
+  Singleton<SatOutputFileStreamWriter>::Get ()->SetAttribute ("MaxQueuedChunks", UintegerValue (2));
+
+  std::string plainFileName = Singleton<SatEnvVariables>::Get ()->GetOutputPath () + "/output-fstream-test-plain.txt";
+  std::string streamedFileName1 = Singleton<SatEnvVariables>::Get ()->GetOutputPath () + "/output-fstream-test-streamed-1.txt";
+  std::string streamedFileName2 = Singleton<SatEnvVariables>::Get ()->GetOutputPath () + "/output-fstream-test-streamed-2.txt";
+
+  uint32_t valuesInRow = 3;
+
+  Ptr<SatOutputFileStreamDoubleContainer> plain =
+    CreateObject<SatOutputFileStreamDoubleContainer> (plainFileName, std::ios::out, valuesInRow);
+  Ptr<SatOutputFileStreamDoubleContainer> streamed1 =
+    CreateObject<SatOutputFileStreamDoubleContainer> (streamedFileName1, std::ios::out, valuesInRow);
+  Ptr<SatOutputFileStreamDoubleContainer> streamed2 =
+    CreateObject<SatOutputFileStreamDoubleContainer> (streamedFileName2, std::ios::out, valuesInRow);
+
+  streamed1->SetAttribute ("EnableStreaming", BooleanValue (true));
+  streamed1->SetAttribute ("StreamingChunkRows", UintegerValue (7));
+  streamed2->SetAttribute ("EnableStreaming", BooleanValue (true));
+  streamed2->SetAttribute ("StreamingChunkRows", UintegerValue (64));
+
+  Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable> ();
+  rng->SetStream (17);
+
+  for (uint32_t i = 0; i < 5000; i++)
+    {
+      std::vector<double> row;
+      row.push_back (0.001 * i);
+      row.push_back (rng->GetValue (-1e6, 1e6));
+      row.push_back (rng->GetValue (0.0, 1e-9));
+
+      plain->AddToContainer (row);
+      streamed1->AddToContainer (row);
+      streamed2->AddToContainer (row);
+    }
+
+  plain->WriteContainerToFile ();
+  streamed1->WriteContainerToFile ();
+  streamed2->WriteContainerToFile ();
+
+  std::string plainContent = ReadFile (plainFileName);
+
+  NS_TEST_ASSERT_MSG_GT (plainContent.size (), (size_t) 0, "Empty output file");
+  NS_TEST_ASSERT_MSG_EQ ((ReadFile (streamedFileName1) == plainContent), true, "Streamed output differs from non-streamed output");
+  NS_TEST_ASSERT_MSG_EQ ((ReadFile (streamedFileName2) == plainContent), true, "Streamed output differs from non-streamed output");
+
+  Singleton<SatOutputFileStreamWriter>::Get ()->SetAttribute ("MaxQueuedChunks", UintegerValue (64));
+
+  std::remove (plainFileName.c_str ());
+  std::remove (streamedFileName1.c_str ());
+  std::remove (streamedFileName2.c_str ());
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test that binary output trace files converted with
+ * ext-utils/convertBinaryTrace.py are equal to the text output files.
+ *
+ *  1.  Create SatOutputFileStreamDoubleContainers of three keys, one of them empty.
+ *  2.  Add the same rows to a text and a binary container of each key. The rows
+ *      contain values needing rounding to six significant digits, exponents,
+ *      negative values, zeros and integers.
+ *  3.  Write the text files and the binary file of all the keys.
+ *  4.  Convert the binary file into text files with convertBinaryTrace.py.
+ *
+ *  Expected result:
+ *    The converter succeeds and the converted file of each key is
+ *    byte-identical to the text file of the key.
+ */
+class SatOutputFileStreamBinaryTestCase : public TestCase
+{
+public:
+  SatOutputFileStreamBinaryTestCase ();
+  virtual ~SatOutputFileStreamBinaryTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  std::string ReadFile (std::string fileName);
+};
+
+SatOutputFileStreamBinaryTestCase::SatOutputFileStreamBinaryTestCase ()
+  : TestCase ("Test binary output files converted to text against text output files.")
+{
+}
+
+SatOutputFileStreamBinaryTestCase::~SatOutputFileStreamBinaryTestCase ()
+{
+}
+
+std::string
+SatOutputFileStreamBinaryTestCase::ReadFile (std::string fileName)
+{
+  std::ifstream file (fileName.c_str (), std::ios::in | std::ios::binary);
+  std::ostringstream content;
+  content << file.rdbuf ();
+  return content.str ();
+}
+
+void
+SatOutputFileStreamBinaryTestCase::DoRun (void)
+{
+  // Set simulation output details
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-sat-output-fstream-binary", "", true);
+
+  std::string outputPath = Singleton<SatEnvVariables>::Get ()->GetOutputPath ();
+  std::string convertedPath = outputPath + "/converted";
+  std::string binaryFileName = outputPath + "/output-fstream-test.bin";
+  std::string script = Singleton<SatEnvVariables>::Get ()->LocateFile ("contrib/satellite/ext-utils/convertBinaryTrace.py");
+
+  if (!Singleton<SatEnvVariables>::Get ()->IsValidDirectory (convertedPath))
+    {
+      Singleton<SatEnvVariables>::Get ()->CreateDirectory (convertedPath);
+    }
+
+  std::vector<std::string> keys;
+  keys.push_back ("output-fstream-test-key-1.txt");
+  keys.push_back ("output-fstream-test-key-2.txt");
+  keys.push_back ("output-fstream-test-empty.txt");
+
+  uint32_t valuesInRow = 3;
+  uint32_t rows[] = { 1000, 7, 0 };
+
+  SatOutputBinaryTraceFile binaryFile (binaryFileName, valuesInRow);
+
+  Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable> ();
+  rng->SetStream (18);
+
+  for (uint32_t k = 0; k < keys.size (); k++)
+    {
+      Ptr<SatOutputFileStreamDoubleContainer> text =
+        CreateObject<SatOutputFileStreamDoubleContainer> (outputPath + "/" + keys[k], std::ios::out, valuesInRow);
+      Ptr<SatOutputFileStreamDoubleContainer> binary =
+        CreateObject<SatOutputFileStreamDoubleContainer> (outputPath + "/" + keys[k], std::ios::out, valuesInRow);
+
+      for (uint32_t i = 0; i < rows[k]; i++)
+        {
+          std::vector<double> row;
+          row.push_back (0.001 * i);
+          row.push_back (rng->GetValue (-1e7, 1e7));
+          row.push_back ((i % 4 == 0) ? 0.0 : ((i % 4 == 1) ? -0.0 : rng->GetValue (0.0, 1e-9)));
+
+          text->AddToContainer (row);
+          binary->AddToContainer (row);
+        }
+
+      text->WriteContainerToFile ();
+      binary->WriteContainerToBinaryFile (binaryFile);
+    }
+
+  binaryFile.Close ();
+
+  std::string command = "python3 " + script + " " + binaryFileName + " " + convertedPath + " > /dev/null";
+  NS_TEST_ASSERT_MSG_EQ (std::system (command.c_str ()), 0, "Converting the binary output file failed");
+
+  for (uint32_t k = 0; k < keys.size (); k++)
+    {
+      std::string textContent = ReadFile (outputPath + "/" + keys[k]);
+
+      NS_TEST_ASSERT_MSG_EQ (textContent.empty (), (rows[k] == 0), "Unexpected text output file size");
+      NS_TEST_ASSERT_MSG_EQ ((ReadFile (convertedPath + "/" + keys[k]) == textContent), true, "Converted output differs from text output");
+
+      std::remove ((outputPath + "/" + keys[k]).c_str ());
+      std::remove ((convertedPath + "/" + keys[k]).c_str ());
+    }
+
+  std::remove (binaryFileName.c_str ());
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test suite for the output file stream containers.
+ */
+class SatOutputFileStreamTestSuite : public TestSuite
+{
+public:
+  SatOutputFileStreamTestSuite ();
+};
+
+SatOutputFileStreamTestSuite::SatOutputFileStreamTestSuite ()
+  : TestSuite ("sat-output-fstream-test", UNIT)
+{
+  AddTestCase (new SatOutputFileStreamStreamingTestCase, TestCase::QUICK);
+  AddTestCase (new SatOutputFileStreamBinaryTestCase, TestCase::QUICK);
+}
+
+// Do a static instance, so that test suite is added to TestSuite list
+static SatOutputFileStreamTestSuite satOutputFileStreamTestSuite;
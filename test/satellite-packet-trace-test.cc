@@ -0,0 +1,202 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 Magister Solutions Ltd
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Jani Puttonen <jani.puttonen@magister.fi>
+ */
+
+/**
+ * \file satellite-packet-trace-test.cc
+ * \ingroup satellite
+ * \brief Test cases to unit test the packet trace.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/config.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
+#include "ns3/string.h"
+#include "ns3/nstime.h"
+#include "ns3/mac48-address.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/singleton.h"
+#include "../utils/satellite-env-variables.h"
+#include "../model/satellite-enums.h"
+#include "../model/satellite-packet-trace.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test that binary packet traces decoded with
+ * ext-utils/decodePacketTrace.py are equal to the text packet traces.
+ *
+ *  1.  Create a text SatPacketTrace and a binary SatPacketTrace with the
+ *      smallest binary buffer, so that the buffer is written many times.
+ *  2.  Add the same entries to both traces. The entries cover all the packet
+ *      events, node types, log levels and link directions, times needing
+ *      rounding to six significant digits and exponents, MAC addresses with
+ *      leading zeros and hexadecimal digits, and empty packet infos.
+ *  3.  Dispose the traces and decode the binary trace with decodePacketTrace.py.
+ *
+ *  Expected result:
+ *    The decoder succeeds and the decoded trace, header included, is
+ *    byte-identical to the text trace.
+ */
+class SatPacketTraceBinaryTestCase : public TestCase
+{
+public:
+  SatPacketTraceBinaryTestCase ();
+  virtual ~SatPacketTraceBinaryTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  Ptr<SatPacketTrace> CreateTrace (std::string fileName, bool binaryFormat);
+  std::string ReadFile (std::string fileName);
+};
+
+SatPacketTraceBinaryTestCase::SatPacketTraceBinaryTestCase ()
+  : TestCase ("Test decoded binary packet traces against text packet traces.")
+{
+}
+
+SatPacketTraceBinaryTestCase::~SatPacketTraceBinaryTestCase ()
+{
+}
+
+Ptr<SatPacketTrace>
+SatPacketTraceBinaryTestCase::CreateTrace (std::string fileName, bool binaryFormat)
+{
+  // the trace opens its file in the constructor, so the defaults are used
+  Config::SetDefault ("ns3::SatPacketTrace::FileName", StringValue (fileName));
+  Config::SetDefault ("ns3::SatPacketTrace::BinaryFormat", BooleanValue (binaryFormat));
+  Config::SetDefault ("ns3::SatPacketTrace::BinaryBufferSize", UintegerValue (1024));
+
+  return CreateObject<SatPacketTrace> ();
+}
+
+std::string
+SatPacketTraceBinaryTestCase::ReadFile (std::string fileName)
+{
+  std::ifstream file (fileName.c_str (), std::ios::in | std::ios::binary);
+  std::ostringstream content;
+  content << file.rdbuf ();
+  return content.str ();
+}
+
+void
+SatPacketTraceBinaryTestCase::DoRun (void)
+{
+  // Set simulation output details
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-sat-packet-trace", "", true);
+
+  std::string outputPath = Singleton<SatEnvVariables>::Get ()->GetOutputPath ();
+  std::string textFileName = outputPath + "/packet-trace-test-text.log";
+  std::string binaryFileName = outputPath + "/packet-trace-test-binary.bin";
+  std::string decodedFileName = outputPath + "/packet-trace-test-decoded.log";
+  std::string script = Singleton<SatEnvVariables>::Get ()->LocateFile ("contrib/satellite/ext-utils/decodePacketTrace.py");
+
+  Ptr<SatPacketTrace> textTrace = CreateTrace ("packet-trace-test-text", false);
+  Ptr<SatPacketTrace> binaryTrace = CreateTrace ("packet-trace-test-binary", true);
+
+  Config::SetDefault ("ns3::SatPacketTrace::FileName", StringValue ("PacketTrace"));
+  Config::SetDefault ("ns3::SatPacketTrace::BinaryFormat", BooleanValue (false));
+  Config::SetDefault ("ns3::SatPacketTrace::BinaryBufferSize", UintegerValue (1048576));
+
+  std::vector<Mac48Address> addresses;
+  addresses.push_back (Mac48Address ("00:00:00:00:00:01"));
+  addresses.push_back (Mac48Address ("00:1a:ff:0b:c0:de"));
+  addresses.push_back (Mac48Address ("ff:ff:ff:ff:ff:ff"));
+
+  std::vector<double> times;
+  times.push_back (0.0);
+  times.push_back (1.0e-7);
+  times.push_back (0.1);
+  times.push_back (1.23456789);
+  times.push_back (12345.678);
+
+  Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable> ();
+  rng->SetStream (19);
+
+  for (uint32_t i = 0; i < 2000; i++)
+    {
+      Time now = (i < times.size ()) ? Seconds (times[i]) : Seconds (rng->GetValue (0.0, 1000.0));
+      SatEnums::SatPacketEvent_t packetEvent = (SatEnums::SatPacketEvent_t) (i % (SatEnums::PACKET_DROP + 1));
+      SatEnums::SatNodeType_t nodeType = (SatEnums::SatNodeType_t) (i % (SatEnums::NT_UNDEFINED + 1));
+      SatEnums::SatLogLevel_t logLevel = (SatEnums::SatLogLevel_t) (i % (SatEnums::LL_CH + 1));
+      SatEnums::SatLinkDir_t linkDir = (SatEnums::SatLinkDir_t) (i % (SatEnums::LD_UNDEFINED + 1));
+      uint32_t nodeId = rng->GetInteger (0, 100000);
+      Mac48Address address = addresses[i % addresses.size ()];
+
+      std::ostringstream packetInfo;
+      for (uint32_t j = 0; j < i % 4; j++)
+        {
+          packetInfo << rng->GetInteger (0, 1000000) << " "
+                     << addresses[j % addresses.size ()] << " "
+                     << addresses[(j + 1) % addresses.size ()] << " ";
+        }
+
+      textTrace->AddTraceEntry (now, packetEvent, nodeType, nodeId, address, logLevel, linkDir, packetInfo.str ());
+      binaryTrace->AddTraceEntry (now, packetEvent, nodeType, nodeId, address, logLevel, linkDir, packetInfo.str ());
+    }
+
+  // releasing the traces closes their files
+  textTrace->Dispose ();
+  textTrace = 0;
+  binaryTrace->Dispose ();
+  binaryTrace = 0;
+
+  std::string command = "python3 " + script + " " + binaryFileName + " " + decodedFileName;
+  NS_TEST_ASSERT_MSG_EQ (std::system (command.c_str ()), 0, "Decoding the binary packet trace failed");
+
+  std::string textContent = ReadFile (textFileName);
+
+  NS_TEST_ASSERT_MSG_GT (textContent.size (), (size_t) 0, "Empty packet trace");
+  NS_TEST_ASSERT_MSG_EQ ((ReadFile (decodedFileName) == textContent), true, "Decoded packet trace differs from text packet trace");
+
+  std::remove (textFileName.c_str ());
+  std::remove (binaryFileName.c_str ());
+  std::remove (decodedFileName.c_str ());
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test suite for the packet trace.
+ */
+class SatPacketTraceTestSuite : public TestSuite
+{
+public:
+  SatPacketTraceTestSuite ();
+};
+
+SatPacketTraceTestSuite::SatPacketTraceTestSuite ()
+  : TestSuite ("sat-packet-trace-test", UNIT)
+{
+  AddTestCase (new SatPacketTraceBinaryTestCase, TestCase::QUICK);
+}
+
+// Do a static instance, so that test suite is added to TestSuite list
+static SatPacketTraceTestSuite satPacketTraceTestSuite;
@@ -52,6 +52,8 @@ using namespace ns3;
  *  1.  Simple test scenario set with helper
  *  2.  A single packet is transmitted from Node-2 UDP application to Node-1 UDP receiver using only CRDSA.
  *
+ *  The case is run also with the CRDSA frames decoded by the parallel frame decoder.
+ *
  *  Expected result:
  *    One UDP packet sent by UT connected node-2 using CBR application is received by
  *    GW connected node-1.
@@ -59,16 +61,21 @@ using namespace ns3;
 class SatCrdsaTest1 : public TestCase
 {
 public:
-  SatCrdsaTest1 ();
+  SatCrdsaTest1 (bool parallelFrameDecoding);
   virtual ~SatCrdsaTest1 ();
 
 private:
   virtual void DoRun (void);
+
+  bool m_parallelFrameDecoding;
 };
 
 // Add some help text to this case to describe what it is intended to test
-SatCrdsaTest1::SatCrdsaTest1 ()
-  : TestCase ("'CRDSA, test 1' case tests successful transmission of UDP packets from UT connected user to GW connected user in simple scenario using only CRDSA.")
+SatCrdsaTest1::SatCrdsaTest1 (bool parallelFrameDecoding)
+  : TestCase (parallelFrameDecoding ?
+              "'CRDSA, test 1' case tests successful transmission of UDP packets from UT connected user to GW connected user in simple scenario using only CRDSA and parallel frame decoding." :
+              "'CRDSA, test 1' case tests successful transmission of UDP packets from UT connected user to GW connected user in simple scenario using only CRDSA."),
+    m_parallelFrameDecoding (parallelFrameDecoding)
 {
 }
 
@@ -86,7 +93,7 @@ SatCrdsaTest1::DoRun (void)
 {
   // Set simulation output details
   Singleton<SatEnvVariables>::Get ()->DoInitialize ();
-  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-sat-random-access", "crdsa", true);
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-sat-random-access", m_parallelFrameDecoding ? "crdsa-parallel" : "crdsa", true);
 
   // Create simple scenario
 
@@ -111,6 +118,10 @@ SatCrdsaTest1::DoRun (void)
   Config::SetDefault ("ns3::SatPhyRxCarrierConf::EnableRandomAccessDynamicLoadControl", BooleanValue (false));
   Config::SetDefault ("ns3::SatPhyRxCarrierConf::RandomAccessAverageNormalizedOfferedLoadMeasurementWindowSize", UintegerValue (10));
 
+  // Decode the CRDSA frames with or without the parallel frame decoder
+  Config::SetDefault ("ns3::SatPhyRxCarrierPerFrame::EnableParallelFrameDecoding", BooleanValue (m_parallelFrameDecoding));
+  Config::SetDefault ("ns3::SatPhyRxCarrierPerFrame::ParallelFrameDecodingThreads", UintegerValue (4));
+
   // Set random access parameters (e.g. enable CRDSA)
   Config::SetDefault ("ns3::SatLowerLayerServiceConf::RaService0_MaximumUniquePayloadPerBlock", UintegerValue (3));
   Config::SetDefault ("ns3::SatLowerLayerServiceConf::RaService0_MaximumConsecutiveBlockAccessed", UintegerValue (6));
@@ -336,7 +347,8 @@ public:
 SatRandomAccessTestSuite::SatRandomAccessTestSuite ()
   : TestSuite ("sat-random-access-test", SYSTEM)
 {
-  AddTestCase (new SatCrdsaTest1, TestCase::QUICK);
+  AddTestCase (new SatCrdsaTest1 (false), TestCase::QUICK);
+  AddTestCase (new SatCrdsaTest1 (true), TestCase::QUICK);
 
   AddTestCase (new SatSlottedAlohaTest1, TestCase::QUICK);
 }
@@ -0,0 +1,461 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Budiarto Herman <budiarto.herman@magister.fi>
+ *
+ */
+
+/**
+ * \file satellite-stats-accumulator-test.cc
+ * \ingroup satellite
+ * \brief Test cases to unit test the native statistics accumulator.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/double.h"
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
+#include "ns3/singleton.h"
+#include "../utils/satellite-env-variables.h"
+#include "../stats/satellite-stats-accumulator.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Function for reading the rows of an accumulator output file.
+ * \param fileName name of the output file
+ * \param heading the first line of the file
+ * \return the rows after the heading, the values of a row as a vector
+ */
+static std::vector<std::vector<double> >
+ReadAccumulatorOutput (std::string fileName, std::string &heading)
+{
+  std::vector<std::vector<double> > rows;
+  std::ifstream ifs (fileName.c_str ());
+  std::string line;
+
+  std::getline (ifs, heading);
+
+  while (std::getline (ifs, line))
+    {
+      std::istringstream iss (line);
+      std::vector<double> row;
+      double value;
+
+      while (iss >> value)
+        {
+          row.push_back (value);
+        }
+
+      rows.push_back (row);
+    }
+
+  return rows;
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test the histogram, PDF, and CDF outputs of the
+ * statistics accumulator.
+ *
+ *  1.  Create accumulators with histogram, PDF, and CDF outputs with ten bins of
+ *      unit length, per identifier and in averaging mode.
+ *  2.  Add known samples to two identifiers, including samples outside the bin
+ *      range and samples of an unknown identifier.
+ *  3.  Write the output files.
+ *
+ *  Expected result:
+ *    The files have the heading and a row for each bin with the bin center and
+ *    the number of samples, the probability, or the cumulative probability of the bin.
+ *    Samples outside the range are in the first or the last bin, and samples of the
+ *    unknown identifier are discarded. In averaging mode, the averages of the
+ *    identifiers are the samples of a single distribution.
+ */
+class SatStatsAccumulatorDistributionTestCase : public TestCase
+{
+public:
+  SatStatsAccumulatorDistributionTestCase ();
+  virtual ~SatStatsAccumulatorDistributionTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  Ptr<SatStatsAccumulator> CreateAccumulator (SatStatsAccumulator::OutputType_t outputType,
+                                              bool averagingMode,
+                                              std::string fileName);
+
+  void CheckOutput (std::string fileName, const std::vector<double> &expected);
+};
+
+SatStatsAccumulatorDistributionTestCase::SatStatsAccumulatorDistributionTestCase ()
+  : TestCase ("Test the histogram, PDF, and CDF outputs of the statistics accumulator.")
+{
+}
+
+SatStatsAccumulatorDistributionTestCase::~SatStatsAccumulatorDistributionTestCase ()
+{
+}
+
+Ptr<SatStatsAccumulator>
+SatStatsAccumulatorDistributionTestCase::CreateAccumulator (SatStatsAccumulator::OutputType_t outputType,
+                                                            bool averagingMode,
+                                                            std::string fileName)
+{
+  Ptr<SatStatsAccumulator> accumulator = CreateObject<SatStatsAccumulator> ();
+  accumulator->SetAttribute ("MinValue", DoubleValue (0.0));
+  accumulator->SetAttribute ("MaxValue", DoubleValue (10.0));
+  accumulator->SetAttribute ("BinLength", DoubleValue (1.0));
+  accumulator->Configure (outputType, averagingMode, false, fileName, "% value_test frequency");
+  accumulator->AddIdentifier (7);
+  accumulator->AddIdentifier (3);
+
+  double samples3[] = { -1.0, 0.5, 1.5, 1.7, 9.9, 12.0 };
+
+  for (uint32_t i = 0; i < sizeof (samples3) / sizeof (double); i++)
+    {
+      accumulator->AddSample (3, samples3[i]);
+    }
+
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      accumulator->AddSample (7, 5.5);
+      accumulator->AddSample (5, 2.5);
+    }
+
+  accumulator->WriteToFile ();
+  return accumulator;
+}
+
+void
+SatStatsAccumulatorDistributionTestCase::CheckOutput (std::string fileName, const std::vector<double> &expected)
+{
+  std::string heading;
+  std::vector<std::vector<double> > rows = ReadAccumulatorOutput (fileName, heading);
+
+  NS_TEST_ASSERT_MSG_EQ (heading, "% value_test frequency", "Unexpected heading in " << fileName);
+  NS_TEST_ASSERT_MSG_EQ (rows.size (), expected.size (), "Unexpected number of bins in " << fileName);
+
+  for (uint32_t i = 0; i < rows.size () && i < expected.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (rows[i].size (), 2, "Unexpected number of values in " << fileName);
+      NS_TEST_ASSERT_MSG_EQ_TOL (rows[i][0], i + 0.5, 1e-9, "Unexpected bin center in " << fileName);
+      NS_TEST_ASSERT_MSG_EQ_TOL (rows[i][1], expected[i], 1e-6, "Unexpected value of bin " << i << " in " << fileName);
+    }
+
+  std::remove (fileName.c_str ());
+}
+
+void
+SatStatsAccumulatorDistributionTestCase::DoRun (void)
+{
+  // Set simulation output details
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-sat-stats-accumulator", "", true);
+
+  std::string path = Singleton<SatEnvVariables>::Get ()->GetOutputPath ();
+
+  // identifier 3: two samples in bins 0, 1, and 9 each
+  double histogram3[] = { 2, 2, 0, 0, 0, 0, 0, 0, 0, 2 };
+  double pdf3[] = { 1.0 / 3, 1.0 / 3, 0, 0, 0, 0, 0, 0, 0, 1.0 / 3 };
+  double cdf3[] = { 1.0 / 3, 2.0 / 3, 2.0 / 3, 2.0 / 3, 2.0 / 3, 2.0 / 3, 2.0 / 3, 2.0 / 3, 2.0 / 3, 1.0 };
+
+  // identifier 7: four samples in bin 5
+  double histogram7[] = { 0, 0, 0, 0, 0, 4, 0, 0, 0, 0 };
+  double pdf7[] = { 0, 0, 0, 0, 0, 1, 0, 0, 0, 0 };
+  double cdf7[] = { 0, 0, 0, 0, 0, 1, 1, 1, 1, 1 };
+
+  // averaging mode: average 4.1 of identifier 3 and 5.5 of identifier 7
+  double histogramAveraged[] = { 0, 0, 0, 0, 1, 1, 0, 0, 0, 0 };
+  double pdfAveraged[] = { 0, 0, 0, 0, 0.5, 0.5, 0, 0, 0, 0 };
+  double cdfAveraged[] = { 0, 0, 0, 0, 0.5, 1, 1, 1, 1, 1 };
+
+  CreateAccumulator (SatStatsAccumulator::OUTPUT_HISTOGRAM, false, path + "/accumulator-histogram");
+  CheckOutput (path + "/accumulator-histogram-3.txt", std::vector<double> (histogram3, histogram3 + 10));
+  CheckOutput (path + "/accumulator-histogram-7.txt", std::vector<double> (histogram7, histogram7 + 10));
+
+  CreateAccumulator (SatStatsAccumulator::OUTPUT_PROBABILITY, false, path + "/accumulator-pdf");
+  CheckOutput (path + "/accumulator-pdf-3.txt", std::vector<double> (pdf3, pdf3 + 10));
+  CheckOutput (path + "/accumulator-pdf-7.txt", std::vector<double> (pdf7, pdf7 + 10));
+
+  CreateAccumulator (SatStatsAccumulator::OUTPUT_CUMULATIVE, false, path + "/accumulator-cdf");
+  CheckOutput (path + "/accumulator-cdf-3.txt", std::vector<double> (cdf3, cdf3 + 10));
+  CheckOutput (path + "/accumulator-cdf-7.txt", std::vector<double> (cdf7, cdf7 + 10));
+
+  std::ifstream unknown ((path + "/accumulator-histogram-5.txt").c_str ());
+  NS_TEST_ASSERT_MSG_EQ (unknown.is_open (), false, "Output written for an unknown identifier");
+
+  CreateAccumulator (SatStatsAccumulator::OUTPUT_HISTOGRAM, true, path + "/accumulator-averaged-histogram");
+  CheckOutput (path + "/accumulator-averaged-histogram.txt", std::vector<double> (histogramAveraged, histogramAveraged + 10));
+
+  CreateAccumulator (SatStatsAccumulator::OUTPUT_PROBABILITY, true, path + "/accumulator-averaged-pdf");
+  CheckOutput (path + "/accumulator-averaged-pdf.txt", std::vector<double> (pdfAveraged, pdfAveraged + 10));
+
+  CreateAccumulator (SatStatsAccumulator::OUTPUT_CUMULATIVE, true, path + "/accumulator-averaged-cdf");
+  CheckOutput (path + "/accumulator-averaged-cdf.txt", std::vector<double> (cdfAveraged, cdfAveraged + 10));
+
+  Simulator::Destroy ();
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test the scalar output of the statistics
+ * accumulator with averages per second, as used by the throughput statistics.
+ *
+ *  1.  Create an accumulator with the scalar output and averages per second.
+ *  2.  Add known samples to two identifiers during ten seconds of simulation.
+ *  3.  Destroy the simulator, which writes the output file.
+ *
+ *  Expected result:
+ *    The file has the heading and a row for each identifier in ascending order
+ *    with the sum of the samples divided by the simulation time.
+ */
+class SatStatsAccumulatorAveragePerSecondTestCase : public TestCase
+{
+public:
+  SatStatsAccumulatorAveragePerSecondTestCase ();
+  virtual ~SatStatsAccumulatorAveragePerSecondTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SatStatsAccumulatorAveragePerSecondTestCase::SatStatsAccumulatorAveragePerSecondTestCase ()
+  : TestCase ("Test the scalar output of the statistics accumulator with averages per second.")
+{
+}
+
+SatStatsAccumulatorAveragePerSecondTestCase::~SatStatsAccumulatorAveragePerSecondTestCase ()
+{
+}
+
+void
+SatStatsAccumulatorAveragePerSecondTestCase::DoRun (void)
+{
+  // Set simulation output details
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-sat-stats-accumulator", "", true);
+
+  std::string fileName = Singleton<SatEnvVariables>::Get ()->GetOutputPath () + "/accumulator-per-second";
+
+  Ptr<SatStatsAccumulator> accumulator = CreateObject<SatStatsAccumulator> ();
+  accumulator->Configure (SatStatsAccumulator::OUTPUT_AVERAGE, false, true, fileName, "% identifier throughput_kbps");
+  accumulator->AddIdentifier (2);
+  accumulator->AddIdentifier (1);
+
+  for (uint32_t i = 0; i < 10; i++)
+    {
+      Simulator::Schedule (Seconds (i + 0.5), &SatStatsAccumulator::AddSample, accumulator, 1, 12.0);
+      Simulator::Schedule (Seconds (i + 0.5), &SatStatsAccumulator::AddSample, accumulator, 2, 4.0 * i);
+    }
+
+  Simulator::Stop (Seconds (10.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  std::string heading;
+  std::vector<std::vector<double> > rows = ReadAccumulatorOutput (fileName + ".txt", heading);
+
+  NS_TEST_ASSERT_MSG_EQ (heading, "% identifier throughput_kbps", "Unexpected heading");
+  NS_TEST_ASSERT_MSG_EQ (rows.size (), 2, "Unexpected number of identifiers");
+
+  if (rows.size () == 2)
+    {
+      NS_TEST_ASSERT_MSG_EQ (rows[0][0], 1, "Unexpected identifier order");
+      NS_TEST_ASSERT_MSG_EQ_TOL (rows[0][1], 12.0, 1e-9, "Unexpected average per second");
+      NS_TEST_ASSERT_MSG_EQ (rows[1][0], 2, "Unexpected identifier order");
+      NS_TEST_ASSERT_MSG_EQ_TOL (rows[1][1], 18.0, 1e-9, "Unexpected average per second");
+    }
+
+  std::remove ((fileName + ".txt").c_str ());
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test the windowed output of the statistics
+ * accumulator.
+ *
+ *  1.  Create accumulators with the windowed output and windows of ten seconds,
+ *      with sample statistics and with averages per second.
+ *  2.  Add known samples to two identifiers in two consecutive windows, and
+ *      after an empty window, one more sample to a later window.
+ *  3.  Run the simulation without stopping it and destroy the simulator.
+ *
+ *  Expected result:
+ *    The simulation ends at the end of the last window with samples. The files
+ *    have the heading and a row for each identifier with samples in a window,
+ *    with the end time of the window and the statistics of the samples of that
+ *    window only. Windows and identifiers without samples are omitted, and the
+ *    windows stay aligned to the configuration time.
+ */
+class SatStatsAccumulatorWindowedTestCase : public TestCase
+{
+public:
+  SatStatsAccumulatorWindowedTestCase ();
+  virtual ~SatStatsAccumulatorWindowedTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  void CheckRow (const std::vector<double> &row, double identifier, double time,
+                 double count, double mean, double minimum, double maximum, double median);
+};
+
+SatStatsAccumulatorWindowedTestCase::SatStatsAccumulatorWindowedTestCase ()
+  : TestCase ("Test the windowed output of the statistics accumulator.")
+{
+}
+
+SatStatsAccumulatorWindowedTestCase::~SatStatsAccumulatorWindowedTestCase ()
+{
+}
+
+void
+SatStatsAccumulatorWindowedTestCase::CheckRow (const std::vector<double> &row, double identifier, double time,
+                                               double count, double mean, double minimum, double maximum, double median)
+{
+  // identifier, time, count, mean, min, max, and four percentiles
+  NS_TEST_ASSERT_MSG_EQ (row.size (), 10, "Unexpected number of values in a window");
+
+  if (row.size () == 10)
+    {
+      NS_TEST_ASSERT_MSG_EQ (row[0], identifier, "Unexpected identifier");
+      NS_TEST_ASSERT_MSG_EQ_TOL (row[1], time, 1e-9, "Unexpected window end time");
+      NS_TEST_ASSERT_MSG_EQ (row[2], count, "Unexpected number of samples in the window");
+      NS_TEST_ASSERT_MSG_EQ_TOL (row[3], mean, 1e-9, "Unexpected mean of the window");
+      NS_TEST_ASSERT_MSG_EQ_TOL (row[4], minimum, 1e-9, "Unexpected minimum of the window");
+      NS_TEST_ASSERT_MSG_EQ_TOL (row[5], maximum, 1e-9, "Unexpected maximum of the window");
+      NS_TEST_ASSERT_MSG_EQ_TOL (row[6], median, 0.01 * std::abs (median), "Unexpected median of the window");
+    }
+}
+
+void
+SatStatsAccumulatorWindowedTestCase::DoRun (void)
+{
+  // Set simulation output details
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-sat-stats-accumulator", "", true);
+
+  std::string path = Singleton<SatEnvVariables>::Get ()->GetOutputPath ();
+  std::string fileName = path + "/accumulator-windowed";
+  std::string perSecondFileName = path + "/accumulator-windowed-per-second";
+
+  Ptr<SatStatsAccumulator> accumulator = CreateObject<SatStatsAccumulator> ();
+  accumulator->SetAttribute ("WindowLength", TimeValue (Seconds (10.0)));
+  accumulator->Configure (SatStatsAccumulator::OUTPUT_WINDOWED, false, false, fileName,
+                          "% identifier " + SatStatsAccumulator::GetWindowedHeading ("delay_sec", false));
+  accumulator->AddIdentifier (2);
+  accumulator->AddIdentifier (1);
+
+  // first window
+  Simulator::Schedule (Seconds (1.0), &SatStatsAccumulator::AddSample, accumulator, 1, 2.0);
+  Simulator::Schedule (Seconds (2.0), &SatStatsAccumulator::AddSample, accumulator, 2, -1.0);
+  Simulator::Schedule (Seconds (3.0), &SatStatsAccumulator::AddSample, accumulator, 1, 4.0);
+  Simulator::Schedule (Seconds (6.0), &SatStatsAccumulator::AddSample, accumulator, 1, 6.0);
+
+  // second window, without samples of identifier 2
+  Simulator::Schedule (Seconds (12.0), &SatStatsAccumulator::AddSample, accumulator, 1, 10.0);
+  Simulator::Schedule (Seconds (15.0), &SatStatsAccumulator::AddSample, accumulator, 1, 20.0);
+
+  // fourth window after an empty window
+  Simulator::Schedule (Seconds (35.0), &SatStatsAccumulator::AddSample, accumulator, 1, 7.0);
+
+  Ptr<SatStatsAccumulator> perSecondAccumulator = CreateObject<SatStatsAccumulator> ();
+  perSecondAccumulator->SetAttribute ("WindowLength", TimeValue (Seconds (10.0)));
+  perSecondAccumulator->Configure (SatStatsAccumulator::OUTPUT_WINDOWED, false, true, perSecondFileName,
+                                   "% identifier " + SatStatsAccumulator::GetWindowedHeading ("throughput_kbps", true));
+  perSecondAccumulator->AddIdentifier (1);
+
+  Simulator::Schedule (Seconds (1.0), &SatStatsAccumulator::AddSample, perSecondAccumulator, 1, 8.0);
+  Simulator::Schedule (Seconds (4.0), &SatStatsAccumulator::AddSample, perSecondAccumulator, 1, 12.0);
+  Simulator::Schedule (Seconds (25.0), &SatStatsAccumulator::AddSample, perSecondAccumulator, 1, 5.0);
+
+  // No stop time: the accumulators must not keep the event queue busy.
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ_TOL (Simulator::Now ().GetSeconds (), 40.0, 1e-9, "Simulation did not end after the last window");
+
+  Simulator::Destroy ();
+
+  std::string heading;
+  std::vector<std::vector<double> > rows = ReadAccumulatorOutput (fileName + ".txt", heading);
+
+  NS_TEST_ASSERT_MSG_EQ (heading, "% identifier time_sec samples delay_sec_mean delay_sec_min delay_sec_max"
+                         " delay_sec_p50 delay_sec_p95 delay_sec_p99 delay_sec_p99.9", "Unexpected heading");
+  NS_TEST_ASSERT_MSG_EQ (rows.size (), 4, "Unexpected number of windowed rows");
+
+  if (rows.size () == 4)
+    {
+      CheckRow (rows[0], 1, 10.0, 3, 4.0, 2.0, 6.0, 4.0);
+      CheckRow (rows[1], 2, 10.0, 1, -1.0, -1.0, -1.0, -1.0);
+      CheckRow (rows[2], 1, 20.0, 2, 15.0, 10.0, 20.0, 10.0);
+      CheckRow (rows[3], 1, 40.0, 1, 7.0, 7.0, 7.0, 7.0);
+    }
+
+  rows = ReadAccumulatorOutput (perSecondFileName + ".txt", heading);
+
+  NS_TEST_ASSERT_MSG_EQ (heading, "% identifier time_sec samples throughput_kbps", "Unexpected heading");
+  NS_TEST_ASSERT_MSG_EQ (rows.size (), 2, "Unexpected number of windowed rows");
+
+  if (rows.size () == 2)
+    {
+      NS_TEST_ASSERT_MSG_EQ (rows[0].size (), 4, "Unexpected number of values in a window");
+      NS_TEST_ASSERT_MSG_EQ_TOL (rows[0][1], 10.0, 1e-9, "Unexpected window end time");
+      NS_TEST_ASSERT_MSG_EQ (rows[0][2], 2, "Unexpected number of samples in the window");
+      NS_TEST_ASSERT_MSG_EQ_TOL (rows[0][3], 2.0, 1e-9, "Unexpected average per second of the window");
+      NS_TEST_ASSERT_MSG_EQ_TOL (rows[1][1], 30.0, 1e-9, "Unexpected window end time");
+      NS_TEST_ASSERT_MSG_EQ (rows[1][2], 1, "Unexpected number of samples in the window");
+      NS_TEST_ASSERT_MSG_EQ_TOL (rows[1][3], 0.5, 1e-9, "Unexpected average per second of the window");
+    }
+
+  std::remove ((fileName + ".txt").c_str ());
+  std::remove ((perSecondFileName + ".txt").c_str ());
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test suite for the native statistics accumulator.
+ */
+class SatStatsAccumulatorTestSuite : public TestSuite
+{
+public:
+  SatStatsAccumulatorTestSuite ();
+};
+
+SatStatsAccumulatorTestSuite::SatStatsAccumulatorTestSuite ()
+  : TestSuite ("sat-stats-accumulator-test", UNIT)
+{
+  AddTestCase (new SatStatsAccumulatorDistributionTestCase, TestCase::QUICK);
+  AddTestCase (new SatStatsAccumulatorAveragePerSecondTestCase, TestCase::QUICK);
+  AddTestCase (new SatStatsAccumulatorWindowedTestCase, TestCase::QUICK);
+}
+
+// Do a static instance, so that test suite is added to TestSuite list
+static SatStatsAccumulatorTestSuite satStatsAccumulatorTestSuite;
@@ -0,0 +1,417 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Budiarto Herman <budiarto.herman@magister.fi>
+ *
+ */
+
+/**
+ * \file satellite-stats-identifier-map-test.cc
+ * \ingroup satellite
+ * \brief Test cases to unit test the identifier lookup table of the statistics.
+ */
+
+#include <vector>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/address.h"
+#include "ns3/mac16-address.h"
+#include "ns3/mac48-address.h"
+#include "ns3/mac64-address.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/ipv6-address.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/inet6-socket-address.h"
+#include "../stats/satellite-stats-identifier-map.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Function for creating a unique MAC address.
+ * \param n number of the address
+ * \return the MAC address
+ */
+static Address
+CreateTestMacAddress (uint32_t n)
+{
+  uint8_t buffer[6];
+  buffer[0] = 0x02;
+  buffer[1] = 0x00;
+  buffer[2] = (n >> 24) & 0xff;
+  buffer[3] = (n >> 16) & 0xff;
+  buffer[4] = (n >> 8) & 0xff;
+  buffer[5] = n & 0xff;
+
+  Mac48Address address;
+  address.CopyFrom (buffer);
+  return address;
+}
+
+/**
+ * \ingroup satellite
+ * \brief Function for getting the first slot probed for an address in a table
+ * of the given size. This is the FNV-1a hash of the serialized address used by
+ * SatStatsIdentifierMap, so that the tests can choose colliding addresses.
+ * \param address the address
+ * \param slots number of slots in the table, a power of two
+ * \return the slot index
+ */
+static uint32_t
+GetTestHomeSlot (const Address &address, uint32_t slots)
+{
+  uint8_t buffer[Address::MAX_SIZE + 2];
+  const uint32_t length = address.CopyAllTo (buffer, Address::MAX_SIZE + 2);
+
+  uint32_t hash = 2166136261U;
+
+  for (uint32_t i = 0; i < length; i++)
+    {
+      hash ^= buffer[i];
+      hash *= 16777619U;
+    }
+
+  return hash & (slots - 1);
+}
+
+/**
+ * \ingroup satellite
+ * \brief Function for finding MAC addresses with a given first probed slot.
+ * \param homeSlot the first probed slot
+ * \param slots number of slots in the table
+ * \param count number of addresses to find
+ * \param n number of the first address to try, updated past the tried addresses
+ * \return the addresses
+ */
+static std::vector<Address>
+FindTestAddresses (uint32_t homeSlot, uint32_t slots, uint32_t count, uint32_t &n)
+{
+  std::vector<Address> addresses;
+
+  while (addresses.size () < count)
+    {
+      const Address address = CreateTestMacAddress (n++);
+
+      if (GetTestHomeSlot (address, slots) == homeSlot)
+        {
+          addresses.push_back (address);
+        }
+    }
+
+  return addresses;
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test colliding addresses and probing over the end of
+ * the table.
+ *
+ *  1.  Fill the initial table of 16 slots up to its load limit of 8 entries with
+ *      addresses probing first the slots 14, 15, 0, and 1, so that the probe
+ *      sequence of slot 15 wraps around to slot 0 and continues to slot 5.
+ *  2.  Look up all the addresses.
+ *  3.  Look up missing addresses probing first the slots 14, 15, 0, and 5.
+ *  4.  Overwrite the identifiers of an address at the end of the probe sequence
+ *      and of an address moved past the end of the table.
+ *
+ *  Expected result:
+ *    All the inserted addresses are found with their identifiers and the missing
+ *    addresses are not found. Overwriting replaces the identifier without adding
+ *    an entry.
+ */
+class SatStatsIdentifierMapCollisionTestCase : public TestCase
+{
+public:
+  SatStatsIdentifierMapCollisionTestCase ();
+  virtual ~SatStatsIdentifierMapCollisionTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SatStatsIdentifierMapCollisionTestCase::SatStatsIdentifierMapCollisionTestCase ()
+  : TestCase ("Test colliding addresses and probing over the end of the identifier table.")
+{
+}
+
+SatStatsIdentifierMapCollisionTestCase::~SatStatsIdentifierMapCollisionTestCase ()
+{
+}
+
+void
+SatStatsIdentifierMapCollisionTestCase::DoRun (void)
+{
+  const uint32_t slots = 16;
+  uint32_t n = 0;
+
+  std::vector<Address> addresses;
+  std::vector<Address> found;
+
+  found = FindTestAddresses (14, slots, 1, n);
+  addresses.insert (addresses.end (), found.begin (), found.end ());
+  found = FindTestAddresses (15, slots, 3, n);
+  addresses.insert (addresses.end (), found.begin (), found.end ());
+  found = FindTestAddresses (0, slots, 2, n);
+  addresses.insert (addresses.end (), found.begin (), found.end ());
+  found = FindTestAddresses (1, slots, 2, n);
+  addresses.insert (addresses.end (), found.begin (), found.end ());
+
+  SatStatsIdentifierMap map;
+
+  for (uint32_t i = 0; i < addresses.size (); i++)
+    {
+      map.Insert (addresses[i], 100 + i);
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (map.GetSize (), addresses.size (), "Unexpected table size");
+
+  for (uint32_t i = 0; i < addresses.size (); i++)
+    {
+      uint32_t identifier = 0;
+      NS_TEST_ASSERT_MSG_EQ (map.Find (addresses[i], identifier), true, "Inserted address not found");
+      NS_TEST_ASSERT_MSG_EQ (identifier, 100 + i, "Unexpected identifier");
+    }
+
+  std::vector<Address> missing;
+  uint32_t missingSlots[] = { 14, 15, 0, 5 };
+
+  for (uint32_t s = 0; s < 4; s++)
+    {
+      found = FindTestAddresses (missingSlots[s], slots, 2, n);
+      missing.insert (missing.end (), found.begin (), found.end ());
+    }
+
+  for (uint32_t i = 0; i < missing.size (); i++)
+    {
+      uint32_t identifier = 12345;
+      NS_TEST_ASSERT_MSG_EQ (map.Find (missing[i], identifier), false, "Missing address found");
+      NS_TEST_ASSERT_MSG_EQ (identifier, 12345, "Identifier changed by a failed lookup");
+    }
+
+  /// the last address probing slot 1 and the last address probing slot 15, stored in slot 1
+  map.Insert (addresses[7], 200);
+  map.Insert (addresses[3], 201);
+
+  NS_TEST_ASSERT_MSG_EQ (map.GetSize (), addresses.size (), "Overwriting added an entry");
+
+  for (uint32_t i = 0; i < addresses.size (); i++)
+    {
+      uint32_t expected = (i == 7) ? 200 : ((i == 3) ? 201 : 100 + i);
+      uint32_t identifier = 0;
+      NS_TEST_ASSERT_MSG_EQ (map.Find (addresses[i], identifier), true, "Inserted address not found");
+      NS_TEST_ASSERT_MSG_EQ (identifier, expected, "Unexpected identifier");
+    }
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test the growing of the table.
+ *
+ *  1.  Insert addresses colliding in the initial table until the table grows,
+ *      and continue with 2000 MAC and IPv4 addresses, growing the table many times.
+ *  2.  Look up all the addresses after each growth.
+ *  3.  Overwrite the identifiers of every third address and look up all the
+ *      addresses again.
+ *
+ *  Expected result:
+ *    The entries are re-inserted in each growth, so all the addresses are found
+ *    with their latest identifiers and the size is the number of different
+ *    addresses.
+ */
+class SatStatsIdentifierMapGrowTestCase : public TestCase
+{
+public:
+  SatStatsIdentifierMapGrowTestCase ();
+  virtual ~SatStatsIdentifierMapGrowTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  bool CheckAll (const SatStatsIdentifierMap &map,
+                 const std::vector<Address> &addresses,
+                 const std::vector<uint32_t> &identifiers);
+};
+
+SatStatsIdentifierMapGrowTestCase::SatStatsIdentifierMapGrowTestCase ()
+  : TestCase ("Test the growing of the identifier table.")
+{
+}
+
+SatStatsIdentifierMapGrowTestCase::~SatStatsIdentifierMapGrowTestCase ()
+{
+}
+
+bool
+SatStatsIdentifierMapGrowTestCase::CheckAll (const SatStatsIdentifierMap &map,
+                                             const std::vector<Address> &addresses,
+                                             const std::vector<uint32_t> &identifiers)
+{
+  for (uint32_t i = 0; i < addresses.size (); i++)
+    {
+      uint32_t identifier = 0;
+
+      if (!map.Find (addresses[i], identifier) || identifier != identifiers[i])
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+
+void
+SatStatsIdentifierMapGrowTestCase::DoRun (void)
+{
+  uint32_t n = 0;
+
+  /// all probing the last slot of the initial table, so that the table grows while full of collisions
+  std::vector<Address> addresses = FindTestAddresses (15, 16, 9, n);
+  std::vector<uint32_t> identifiers;
+
+  for (uint32_t i = 0; i < addresses.size (); i++)
+    {
+      identifiers.push_back (i);
+    }
+
+  for (uint32_t i = 0; i < 2000; i++)
+    {
+      addresses.push_back (CreateTestMacAddress (n++));
+      identifiers.push_back (identifiers.size ());
+
+      addresses.push_back (Ipv4Address (0x0a000000 + i));
+      identifiers.push_back (identifiers.size ());
+    }
+
+  SatStatsIdentifierMap map;
+
+  for (uint32_t i = 0; i < addresses.size (); i++)
+    {
+      map.Insert (addresses[i], identifiers[i]);
+
+      /// the table has just grown when the number of entries is a power of two plus one
+      if (i > 0 && (i & (i - 1)) == 0)
+        {
+          std::vector<Address> inserted (addresses.begin (), addresses.begin () + i + 1);
+          std::vector<uint32_t> insertedIdentifiers (identifiers.begin (), identifiers.begin () + i + 1);
+
+          NS_TEST_ASSERT_MSG_EQ (map.GetSize (), i + 1, "Unexpected table size");
+          NS_TEST_ASSERT_MSG_EQ (CheckAll (map, inserted, insertedIdentifiers), true, "Entry lost in growing the table");
+        }
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (map.GetSize (), addresses.size (), "Unexpected table size");
+  NS_TEST_ASSERT_MSG_EQ (CheckAll (map, addresses, identifiers), true, "Entry lost in growing the table");
+
+  for (uint32_t i = 0; i < addresses.size (); i += 3)
+    {
+      identifiers[i] += 1000000;
+      map.Insert (addresses[i], identifiers[i]);
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (map.GetSize (), addresses.size (), "Overwriting added an entry");
+  NS_TEST_ASSERT_MSG_EQ (CheckAll (map, addresses, identifiers), true, "Identifier not overwritten");
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test lookups of missing addresses of each address type.
+ *
+ *  1.  Insert MAC and IPv4 addresses as the statistics helpers do.
+ *  2.  Look up the IPv4 address of a socket address, as done for received packets.
+ *  3.  Look up missing addresses of each address type, including addresses
+ *      with the same content as an inserted address but a different type,
+ *      and an empty address.
+ *
+ *  Expected result:
+ *    The IPv4 address of the socket address is found. The missing addresses are
+ *    not found and the identifier is left untouched.
+ */
+class SatStatsIdentifierMapAddressTypeTestCase : public TestCase
+{
+public:
+  SatStatsIdentifierMapAddressTypeTestCase ();
+  virtual ~SatStatsIdentifierMapAddressTypeTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SatStatsIdentifierMapAddressTypeTestCase::SatStatsIdentifierMapAddressTypeTestCase ()
+  : TestCase ("Test lookups of missing addresses of each address type in the identifier table.")
+{
+}
+
+SatStatsIdentifierMapAddressTypeTestCase::~SatStatsIdentifierMapAddressTypeTestCase ()
+{
+}
+
+void
+SatStatsIdentifierMapAddressTypeTestCase::DoRun (void)
+{
+  SatStatsIdentifierMap map;
+
+  /// the content of the MAC address equals the serialized socket address 10.0.0.1:9
+  map.Insert (Mac48Address ("0a:00:00:01:09:00"), 1);
+  map.Insert (Mac48Address ("00:00:00:00:00:01"), 2);
+  map.Insert (Ipv4Address ("10.0.0.1"), 3);
+  map.Insert (Ipv4Address ("10.0.0.2"), 4);
+
+  uint32_t identifier = 0;
+  const Address ipv4Addr = InetSocketAddress::ConvertFrom (InetSocketAddress (Ipv4Address ("10.0.0.2"), 9)).GetIpv4 ();
+  NS_TEST_ASSERT_MSG_EQ (map.Find (ipv4Addr, identifier), true, "IPv4 address of a socket address not found");
+  NS_TEST_ASSERT_MSG_EQ (identifier, 4, "Unexpected identifier");
+
+  std::vector<Address> missing;
+  missing.push_back (Mac48Address ("00:00:00:00:00:02"));
+  missing.push_back (Mac16Address ("00:01"));
+  missing.push_back (Mac64Address ("00:00:00:00:00:00:00:01"));
+  missing.push_back (Ipv4Address ("10.0.0.3"));
+  missing.push_back (Ipv6Address ("2001:db8::1"));
+  missing.push_back (InetSocketAddress (Ipv4Address ("10.0.0.1"), 9));
+  missing.push_back (Inet6SocketAddress (Ipv6Address ("2001:db8::1"), 9));
+  missing.push_back (Address ());
+
+  for (uint32_t i = 0; i < missing.size (); i++)
+    {
+      identifier = 12345;
+      NS_TEST_ASSERT_MSG_EQ (map.Find (missing[i], identifier), false, "Missing address found");
+      NS_TEST_ASSERT_MSG_EQ (identifier, 12345, "Identifier changed by a failed lookup");
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (map.GetSize (), 4, "Unexpected table size");
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test suite for the identifier lookup table of the statistics.
+ */
+class SatStatsIdentifierMapTestSuite : public TestSuite
+{
+public:
+  SatStatsIdentifierMapTestSuite ();
+};
+
+SatStatsIdentifierMapTestSuite::SatStatsIdentifierMapTestSuite ()
+  : TestSuite ("sat-stats-identifier-map-test", UNIT)
+{
+  AddTestCase (new SatStatsIdentifierMapCollisionTestCase, TestCase::QUICK);
+  AddTestCase (new SatStatsIdentifierMapGrowTestCase, TestCase::QUICK);
+  AddTestCase (new SatStatsIdentifierMapAddressTypeTestCase, TestCase::QUICK);
+}
+
+// Do a static instance, so that test suite is added to TestSuite list
+static SatStatsIdentifierMapTestSuite satStatsIdentifierMapTestSuite;
@@ -0,0 +1,255 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014 Magister Solutions
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Budiarto Herman <budiarto.herman@magister.fi>
+ *
+ */
+
+/**
+ * \file satellite-stats-quantile-sketch-test.cc
+ * \ingroup satellite
+ * \brief Test cases to unit test the quantile sketch of the statistics.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <vector>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/ptr.h"
+#include "ns3/double.h"
+#include "ns3/random-variable-stream.h"
+#include "../stats/satellite-stats-quantile-sketch.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Function for drawing samples of a known distribution.
+ * \param distribution index of the distribution: exponential, log-normal,
+ *        uniform over negative and positive values, or normal
+ * \param stream random stream
+ * \param numOfSamples number of samples
+ * \return the samples
+ */
+static std::vector<double>
+CreateSketchTestSamples (uint32_t distribution, int64_t stream, uint32_t numOfSamples)
+{
+  Ptr<RandomVariableStream> rng;
+
+  switch (distribution)
+    {
+    case 0:
+      rng = CreateObjectWithAttributes<ExponentialRandomVariable> ("Mean", DoubleValue (0.05),
+                                                                    "Bound", DoubleValue (0.0));
+      break;
+    case 1:
+      rng = CreateObjectWithAttributes<LogNormalRandomVariable> ("Mu", DoubleValue (0.0),
+                                                                  "Sigma", DoubleValue (2.0));
+      break;
+    case 2:
+      rng = CreateObjectWithAttributes<UniformRandomVariable> ("Min", DoubleValue (-100.0),
+                                                                "Max", DoubleValue (100.0));
+      break;
+    default:
+      rng = CreateObjectWithAttributes<NormalRandomVariable> ("Mean", DoubleValue (-20.0),
+                                                               "Variance", DoubleValue (25.0));
+      break;
+    }
+
+  rng->SetStream (stream);
+
+  std::vector<double> samples;
+
+  for (uint32_t i = 0; i < numOfSamples; i++)
+    {
+      samples.push_back (rng->GetValue ());
+    }
+
+  return samples;
+}
+
+/// Quantiles checked by the test cases.
+static const double g_sketchTestQuantiles[] = { 0.0, 0.001, 0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.95, 0.99, 0.999, 1.0 };
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test the relative accuracy of the quantile sketch.
+ *
+ *  1.  Add samples of exponential, log-normal, uniform, and normal distributions
+ *      to sketches with different relative accuracies.
+ *  2.  Get the estimates of several quantiles, including the minimum and the maximum.
+ *  3.  Sort the samples and take the true values at the same ranks.
+ *
+ *  Expected result:
+ *    Each estimate is within the relative accuracy of the true value.
+ */
+class SatStatsQuantileSketchAccuracyTestCase : public TestCase
+{
+public:
+  SatStatsQuantileSketchAccuracyTestCase ();
+  virtual ~SatStatsQuantileSketchAccuracyTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SatStatsQuantileSketchAccuracyTestCase::SatStatsQuantileSketchAccuracyTestCase ()
+  : TestCase ("Test the relative accuracy of the quantile sketch on known distributions.")
+{
+}
+
+SatStatsQuantileSketchAccuracyTestCase::~SatStatsQuantileSketchAccuracyTestCase ()
+{
+}
+
+void
+SatStatsQuantileSketchAccuracyTestCase::DoRun (void)
+{
+  double accuracies[] = { 0.005, 0.01, 0.05 };
+
+  for (uint32_t distribution = 0; distribution < 4; distribution++)
+    {
+      std::vector<double> samples = CreateSketchTestSamples (distribution, 22 + distribution, 20000);
+      std::vector<double> sorted = samples;
+      std::sort (sorted.begin (), sorted.end ());
+
+      for (uint32_t a = 0; a < sizeof (accuracies) / sizeof (double); a++)
+        {
+          SatStatsQuantileSketch sketch (accuracies[a]);
+
+          for (uint32_t i = 0; i < samples.size (); i++)
+            {
+              sketch.Add (samples[i]);
+            }
+
+          NS_TEST_ASSERT_MSG_EQ (sketch.GetCount (), samples.size (), "Unexpected number of samples");
+
+          for (uint32_t q = 0; q < sizeof (g_sketchTestQuantiles) / sizeof (double); q++)
+            {
+              const uint64_t rank = static_cast<uint64_t> (g_sketchTestQuantiles[q] * (sorted.size () - 1));
+              const double expected = sorted[rank];
+              const double estimate = sketch.GetQuantile (g_sketchTestQuantiles[q]);
+
+              NS_TEST_ASSERT_MSG_EQ_TOL (estimate, expected, accuracies[a] * std::abs (expected) * (1.0 + 1e-9),
+                                         "Quantile " << g_sketchTestQuantiles[q] << " of distribution " << distribution
+                                                     << " not within relative accuracy " << accuracies[a]);
+            }
+        }
+    }
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test merging quantile sketches.
+ *
+ *  1.  Split samples of known distributions into two parts and add the parts to two sketches.
+ *  2.  Add all the samples to a third sketch.
+ *  3.  Merge the second sketch into the first sketch. Repeat with a small number
+ *      of buckets, so that the buckets of the smallest magnitudes are collapsed.
+ *
+ *  Expected result:
+ *    The merged sketch has the same state and the same quantiles as the sketch of all the samples.
+ */
+class SatStatsQuantileSketchMergeTestCase : public TestCase
+{
+public:
+  SatStatsQuantileSketchMergeTestCase ();
+  virtual ~SatStatsQuantileSketchMergeTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SatStatsQuantileSketchMergeTestCase::SatStatsQuantileSketchMergeTestCase ()
+  : TestCase ("Test merging quantile sketches against sketching the union of the samples.")
+{
+}
+
+SatStatsQuantileSketchMergeTestCase::~SatStatsQuantileSketchMergeTestCase ()
+{
+}
+
+void
+SatStatsQuantileSketchMergeTestCase::DoRun (void)
+{
+  uint32_t maxBuckets[] = { 2048, 64 };
+
+  for (uint32_t distribution = 0; distribution < 4; distribution++)
+    {
+      std::vector<double> samples = CreateSketchTestSamples (distribution, 32 + distribution, 10000);
+
+      for (uint32_t b = 0; b < sizeof (maxBuckets) / sizeof (uint32_t); b++)
+        {
+          SatStatsQuantileSketch first (0.01, maxBuckets[b]);
+          SatStatsQuantileSketch second (0.01, maxBuckets[b]);
+          SatStatsQuantileSketch all (0.01, maxBuckets[b]);
+
+          for (uint32_t i = 0; i < samples.size (); i++)
+            {
+              // uneven split, so that the parts have different ranges
+              if (i < samples.size () / 3 || samples[i] > samples[0])
+                {
+                  first.Add (samples[i]);
+                }
+              else
+                {
+                  second.Add (samples[i]);
+                }
+              all.Add (samples[i]);
+            }
+
+          first.Merge (second);
+
+          NS_TEST_ASSERT_MSG_EQ (first.GetCount (), all.GetCount (), "Unexpected number of samples in merged sketch");
+
+          std::ostringstream merged;
+          std::ostringstream expected;
+          first.Print (merged);
+          all.Print (expected);
+
+          NS_TEST_ASSERT_MSG_EQ (merged.str (), expected.str (), "Merged sketch differs from sketch of all samples");
+
+          for (uint32_t q = 0; q < sizeof (g_sketchTestQuantiles) / sizeof (double); q++)
+            {
+              NS_TEST_ASSERT_MSG_EQ (first.GetQuantile (g_sketchTestQuantiles[q]), all.GetQuantile (g_sketchTestQuantiles[q]),
+                                     "Quantile " << g_sketchTestQuantiles[q] << " of merged sketch differs");
+            }
+        }
+    }
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test suite for the quantile sketch of the statistics.
+ */
+class SatStatsQuantileSketchTestSuite : public TestSuite
+{
+public:
+  SatStatsQuantileSketchTestSuite ();
+};
+
+SatStatsQuantileSketchTestSuite::SatStatsQuantileSketchTestSuite ()
+  : TestSuite ("sat-stats-quantile-sketch-test", UNIT)
+{
+  AddTestCase (new SatStatsQuantileSketchAccuracyTestCase, TestCase::QUICK);
+  AddTestCase (new SatStatsQuantileSketchMergeTestCase, TestCase::QUICK);
+}
+
+// Do a static instance, so that test suite is added to TestSuite list
+static SatStatsQuantileSketchTestSuite satStatsQuantileSketchTestSuite;
@@ -22,11 +22,33 @@
 #include "ns3/log.h"
 #include "ns3/abort.h"
 #include "ns3/simulator.h"
+#include <algorithm>
+#include <cmath>
 
 NS_LOG_COMPONENT_DEFINE ("SatInputFileStreamTimeDoubleContainer");
 
 namespace ns3 {
 
+/**
+ * \brief Comparator for searching the first time sample at or after a time, with a time shift
+ */
+class SatShiftedTimeLess
+{
+public:
+  SatShiftedTimeLess (double timeShiftValue)
+    : m_timeShiftValue (timeShiftValue)
+  {
+  }
+
+  bool operator() (double sampleTime, double comparisonTimeValue) const
+  {
+    return sampleTime + m_timeShiftValue < comparisonTimeValue;
+  }
+
+private:
+  double m_timeShiftValue;
+};
+
 TypeId
 SatInputFileStreamTimeDoubleContainer::GetTypeId (void)
 {
@@ -39,7 +61,7 @@ SatInputFileStreamTimeDoubleContainer::GetTypeId (void)
 SatInputFileStreamTimeDoubleContainer::SatInputFileStreamTimeDoubleContainer (std::string filename, std::ios::openmode filemode, uint32_t valuesInRow)
   : m_inputFileStreamWrapper (),
     m_inputFileStream (),
-    m_container (),
+    m_columns (),
     m_fileName (filename),
     m_fileMode (filemode),
     m_valuesInRow (valuesInRow),
@@ -56,7 +78,7 @@ SatInputFileStreamTimeDoubleContainer::SatInputFileStreamTimeDoubleContainer (st
 SatInputFileStreamTimeDoubleContainer::SatInputFileStreamTimeDoubleContainer ()
   : m_inputFileStreamWrapper (),
     m_inputFileStream (),
-    m_container (),
+    m_columns (),
     m_fileName (),
     m_fileMode (),
     m_valuesInRow (),
@@ -101,12 +123,15 @@ SatInputFileStreamTimeDoubleContainer::UpdateContainer (std::string filename, st
 
   if (m_inputFileStream->is_open ())
     {
-      std::vector<double> tempVector = ReadRow ();
+      m_columns.resize (m_valuesInRow);
 
-      while (!m_inputFileStream->eof ())
+      if (filemode & std::ios::binary)
         {
-          m_container.push_back (tempVector);
-          tempVector = ReadRow ();
+          ReadBinaryRows ();
+        }
+      else
+        {
+          ReadTextRows ();
         }
       m_inputFileStream->close ();
     }
@@ -120,20 +145,52 @@ SatInputFileStreamTimeDoubleContainer::UpdateContainer (std::string filename, st
   ResetStream ();
 }
 
-std::vector<double>
-SatInputFileStreamTimeDoubleContainer::ReadRow ()
+void
+SatInputFileStreamTimeDoubleContainer::ReadTextRows ()
 {
   NS_LOG_FUNCTION (this);
 
-  double tempValue;
-  std::vector<double> tempVector;
+  std::vector<double> tempVector (m_valuesInRow);
+  ReadRow (tempVector);
+
+  while (!m_inputFileStream->eof ())
+    {
+      AddRow (tempVector);
+      ReadRow (tempVector);
+    }
+}
+
+void
+SatInputFileStreamTimeDoubleContainer::ReadBinaryRows ()
+{
+  NS_LOG_FUNCTION (this);
 
+  std::vector<double> tempVector (m_valuesInRow);
+
+  while (m_inputFileStream->read ((char*)&tempVector[0], m_valuesInRow * sizeof (double)))
+    {
+      AddRow (tempVector);
+    }
+}
+
+void
+SatInputFileStreamTimeDoubleContainer::ReadRow (std::vector<double>& row)
+{
+  NS_LOG_FUNCTION (this);
+
+  for ( uint32_t i = 0; i < m_valuesInRow; i++ )
+    {
+      *m_inputFileStream >> row[i];
+    }
+}
+
+void
+SatInputFileStreamTimeDoubleContainer::AddRow (const std::vector<double>& row)
+{
   for ( uint32_t i = 0; i < m_valuesInRow; i++ )
     {
-      *m_inputFileStream >> tempValue;
-      tempVector.push_back (tempValue);
+      m_columns[i].push_back (row[i]);
     }
-  return tempVector;
 }
 
 void
@@ -142,28 +199,30 @@ SatInputFileStreamTimeDoubleContainer::CheckContainerSanity ()
   NS_LOG_FUNCTION (this);
 
   /// check time sample sanity
-  if (m_container.size () < 1)
+  uint32_t numOfSamples = GetNumOfSamples ();
+
+  if (numOfSamples < 1)
     {
       NS_FATAL_ERROR ("SatInputFileStreamDoubleContainer::UpdateContainer - Empty file");
     }
-  else if (m_container.size () == 1)
+  else if (numOfSamples == 1)
     {
-      if (m_container[m_container.size () - 1].at (m_timeColumn) == 0)
+      if (GetTime (numOfSamples - 1) == 0)
         {
           NS_FATAL_ERROR ("SatInputFileStreamDoubleContainer::UpdateContainer - Invalid input file format (time sample error)");
         }
     }
   else
     {
-      double tempValue1 = m_container[0].at (m_timeColumn);
+      double tempValue1 = GetTime (0);
 
-      for (uint32_t i = 1; i < m_container.size (); i++)
+      for (uint32_t i = 1; i < numOfSamples; i++)
         {
-          if (tempValue1 > m_container[i].at (m_timeColumn))
+          if (tempValue1 > GetTime (i))
             {
               NS_FATAL_ERROR ("SatInputFileStreamDoubleContainer::UpdateContainer - Invalid input file format (time sample error)");
             }
-          tempValue1 = m_container[i].at (m_timeColumn);
+          tempValue1 = GetTime (i);
         }
     }
 }
@@ -173,11 +232,30 @@ SatInputFileStreamTimeDoubleContainer::ProceedToNextClosestTimeSample ()
 {
   NS_LOG_FUNCTION (this);
 
+  ProceedToNextClosestTimeSample (m_timeColumn);
+
+  std::vector<double> row (m_valuesInRow);
+
+  for (uint32_t i = 0; i < m_valuesInRow; i++)
+    {
+      row[i] = m_columns[i][m_lastValidPosition];
+    }
+
+  return row;
+}
+
+double
+SatInputFileStreamTimeDoubleContainer::ProceedToNextClosestTimeSample (uint32_t column)
+{
+  NS_LOG_FUNCTION (this << column);
+
+  NS_ASSERT (column < m_valuesInRow);
+
   while (!FindNextClosest (m_lastValidPosition,m_timeShiftValue, Now ().GetSeconds ()))
     {
       m_lastValidPosition = 0;
       m_numOfPasses++;
-      m_timeShiftValue = m_numOfPasses * m_container[m_container.size () - 1].at (m_timeColumn);
+      m_timeShiftValue = m_numOfPasses * GetTime (GetNumOfSamples () - 1);
 
       NS_LOG_INFO ("Looping samples again with shift value: " << m_timeShiftValue);
     }
@@ -188,7 +266,7 @@ SatInputFileStreamTimeDoubleContainer::ProceedToNextClosestTimeSample ()
       std::cout << "The container will loop samples from the beginning." << std::endl;
     }
 
-  return m_container[m_lastValidPosition];
+  return m_columns[column][m_lastValidPosition];
 }
 
 bool
@@ -196,49 +274,63 @@ SatInputFileStreamTimeDoubleContainer::FindNextClosest (uint32_t lastValidPositi
 {
   NS_LOG_FUNCTION (this);
 
+  uint32_t numOfSamples = GetNumOfSamples ();
+
   NS_ASSERT (m_timeColumn < m_valuesInRow);
-  NS_ASSERT (m_container.size () > 0);
-  NS_ASSERT (lastValidPosition >= 0 && lastValidPosition < m_container.size ());
+  NS_ASSERT (numOfSamples > 0);
+  NS_ASSERT (lastValidPosition >= 0 && lastValidPosition < numOfSamples);
 
   NS_LOG_INFO ("SatInputFileStreamDoubleContainer::FindNextClosest: lastValidPosition " << lastValidPosition << " column " << m_timeColumn << " timeShiftValue " << timeShiftValue << " comparisonTimeValue " << comparisonTimeValue);
 
-  bool valueFound = false;
+  const std::vector<double>& times = m_columns[m_timeColumn];
+  uint32_t position = lastValidPosition;
 
-  for (uint32_t i = lastValidPosition; i < m_container.size (); i++)
+  /// first sample at or after the comparison time, simulation time is monotone
+  /// so it is usually the last valid position or the one after it
+  if (times[position] + timeShiftValue < comparisonTimeValue)
     {
-      if (m_container[i].at (m_timeColumn) + timeShiftValue >= comparisonTimeValue)
+      position++;
+
+      if (position < numOfSamples && times[position] + timeShiftValue < comparisonTimeValue)
         {
-          double difference1 = std::abs (m_container[lastValidPosition].at (m_timeColumn) + timeShiftValue - comparisonTimeValue);
-          double difference2 = std::abs (m_container[i].at (m_timeColumn) + timeShiftValue - comparisonTimeValue);
+          position = std::lower_bound (times.begin () + position, times.end (), comparisonTimeValue,
+                                       SatShiftedTimeLess (timeShiftValue)) - times.begin ();
+        }
+    }
 
-          if (difference1 < difference2)
-            {
-              m_lastValidPosition = lastValidPosition;
-            }
-          else
-            {
-              m_lastValidPosition = i;
-            }
-          valueFound = true;
-          break;
+  bool valueFound = position < numOfSamples;
+
+  if (valueFound)
+    {
+      uint32_t previousPosition = (position > lastValidPosition) ? position - 1 : lastValidPosition;
+
+      double difference1 = std::abs (times[previousPosition] + timeShiftValue - comparisonTimeValue);
+      double difference2 = std::abs (times[position] + timeShiftValue - comparisonTimeValue);
+
+      if (difference1 < difference2)
+        {
+          m_lastValidPosition = previousPosition;
+        }
+      else
+        {
+          m_lastValidPosition = position;
         }
-      lastValidPosition = i;
     }
 
   if (valueFound && m_numOfPasses > 0 && m_lastValidPosition == 0)
     {
-      double difference1 = std::abs (m_container[m_lastValidPosition].at (m_timeColumn) + timeShiftValue - comparisonTimeValue);
-      double difference2 = std::abs (m_container[m_container.size () - 1].at (m_timeColumn) + ((m_numOfPasses - 1) * m_container[m_container.size () - 1].at (m_timeColumn)) - comparisonTimeValue);
+      double difference1 = std::abs (times[m_lastValidPosition] + timeShiftValue - comparisonTimeValue);
+      double difference2 = std::abs (times[numOfSamples - 1] + ((m_numOfPasses - 1) * times[numOfSamples - 1]) - comparisonTimeValue);
 
       if (difference1 > difference2)
         {
-          m_lastValidPosition = m_container.size () - 1;
+          m_lastValidPosition = numOfSamples - 1;
           m_numOfPasses--;
-          m_timeShiftValue = m_numOfPasses * m_container[m_container.size () - 1].at (m_timeColumn);
+          m_timeShiftValue = m_numOfPasses * times[numOfSamples - 1];
         }
     }
 
-  NS_LOG_INFO ("Done: " << valueFound << " value: " << m_container[m_lastValidPosition].at (m_timeColumn) << " @ line: " << m_lastValidPosition + 1 << " comparison time value: " << comparisonTimeValue << " passes: " << m_numOfPasses);
+  NS_LOG_INFO ("Done: " << valueFound << " value: " << times[m_lastValidPosition] << " @ line: " << m_lastValidPosition + 1 << " comparison time value: " << comparisonTimeValue << " passes: " << m_numOfPasses);
 
   return valueFound;
 }
@@ -270,17 +362,7 @@ SatInputFileStreamTimeDoubleContainer::ClearContainer ()
 {
   NS_LOG_FUNCTION (this);
 
-  if (!m_container.empty ())
-    {
-      for (uint32_t i = 0; i < m_container.size (); i++)
-        {
-          if (!m_container[i].empty ())
-            {
-              m_container[i].clear ();
-            }
-        }
-      m_container.clear ();
-    }
+  m_columns.clear ();
 
   m_valuesInRow = 0;
   m_lastValidPosition = 0;
@@ -22,6 +22,7 @@
 #define SAT_INPUT_FSTREAM_TIME_DOUBLE_CONTAINER_H
 
 #include <fstream>
+#include <vector>
 #include "ns3/object.h"
 #include "satellite-input-fstream-wrapper.h"
 
@@ -32,9 +33,12 @@ namespace ns3 {
  *
  * \brief Class for input file stream container for storing double values.
  * The class implements reading the values from a file, storing the values
- * and iterating the stored values.
+ * and iterating the stored values. The values are stored by column and the
+ * time samples are searched with a binary search.
  *
- * Row format is [time, value1, ..., value n].
+ * Row format is [time, value1, ..., value n]. If the file mode contains
+ * std::ios::binary, the file is read as consecutive rows of native doubles
+ * instead of text.
  */
 class SatInputFileStreamTimeDoubleContainer : public Object
 {
@@ -77,6 +81,13 @@ public:
    */
   std::vector<double> ProceedToNextClosestTimeSample ();
 
+  /**
+   * \brief Function for locating the next closest time sample and returning a single value related to it
+   * \param column index of the value in a row
+   * \return matching value
+   */
+  double ProceedToNextClosestTimeSample (uint32_t column);
+
   /**
    * \brief Do needed dispose actions
    */
@@ -99,10 +110,45 @@ private:
   void ClearContainer ();
 
   /**
-   * \brief Function for reading a row from file
-   * \return the row
+   * \brief Function for reading the rows from a text file
+   */
+  void ReadTextRows ();
+
+  /**
+   * \brief Function for reading the rows from a binary file
+   */
+  void ReadBinaryRows ();
+
+  /**
+   * \brief Function for reading a row from a text file
+   * \param row the row
+   */
+  void ReadRow (std::vector<double>& row);
+
+  /**
+   * \brief Function for adding a row to the columns
+   * \param row the row
+   */
+  void AddRow (const std::vector<double>& row);
+
+  /**
+   * \brief Function for getting the time of a sample
+   * \param position sample position
+   * \return time of the sample
+   */
+  inline double GetTime (uint32_t position) const
+  {
+    return m_columns[m_timeColumn][position];
+  }
+
+  /**
+   * \brief Function for getting the number of samples
+   * \return number of samples
    */
-  std::vector<double> ReadRow ();
+  inline uint32_t GetNumOfSamples () const
+  {
+    return m_columns.empty () ? 0 : m_columns[m_timeColumn].size ();
+  }
 
   /**
    * \brief Function for locating the next closest value index. This locator loops the samples if the container does not have enough samples. Next closest index value is saved to a separate member variable.
@@ -129,9 +175,9 @@ private:
   std::ifstream* m_inputFileStream;
 
   /**
-   * \brief Container for value rows
+   * \brief Container for value columns, one vector per column
    */
-  std::vector<std::vector<double> > m_container;
+  std::vector<std::vector<double> > m_columns;
 
   /**
    * \brief File name
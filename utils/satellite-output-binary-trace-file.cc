@@ -0,0 +1,115 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Frans Laakso <frans.laakso@magister.fi>
+ */
+
+#include "satellite-output-binary-trace-file.h"
+#include "ns3/log.h"
+#include "ns3/abort.h"
+
+NS_LOG_COMPONENT_DEFINE ("SatOutputBinaryTraceFile");
+
+namespace ns3 {
+
+SatOutputBinaryTraceFile::SatOutputBinaryTraceFile (std::string filename, uint32_t valuesInRow)
+  : m_stream (filename.c_str (), std::ios::out | std::ios::binary),
+    m_valuesInRow (valuesInRow)
+{
+  NS_LOG_FUNCTION (this << filename << valuesInRow);
+
+  NS_ABORT_MSG_UNLESS (m_stream.is_open (), "SatOutputBinaryTraceFile::SatOutputBinaryTraceFile - Unable to open " << filename);
+
+  m_stream.write ("SATTRACE", 8);
+  WriteValue<uint32_t> (FORMAT_VERSION);
+  WriteValue<uint32_t> (m_valuesInRow);
+
+  for (uint32_t i = 0; i < m_valuesInRow; i++)
+    {
+      WriteValue<uint8_t> (COLUMN_TYPE_DOUBLE);
+    }
+}
+
+SatOutputBinaryTraceFile::~SatOutputBinaryTraceFile ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_stream.is_open ())
+    {
+      Close ();
+    }
+}
+
+void
+SatOutputBinaryTraceFile::AddBlock (std::string key, const std::vector<std::vector<double> >& rows)
+{
+  NS_LOG_FUNCTION (this << key << rows.size ());
+
+  indexEntry_s entry;
+  entry.key = key;
+  entry.offset = m_stream.tellp ();
+  entry.rows = rows.size ();
+  m_index.push_back (entry);
+
+  WriteValue<uint64_t> (entry.rows);
+
+  std::vector<double> column (rows.size ());
+
+  for (uint32_t j = 0; j < m_valuesInRow; j++)
+    {
+      for (uint32_t i = 0; i < rows.size (); i++)
+        {
+          column[i] = rows[i][j];
+        }
+
+      if (!column.empty ())
+        {
+          m_stream.write ((const char*)&column[0], column.size () * sizeof (double));
+        }
+    }
+}
+
+void
+SatOutputBinaryTraceFile::Close ()
+{
+  NS_LOG_FUNCTION (this);
+
+  uint64_t indexOffset = m_stream.tellp ();
+
+  WriteValue<uint32_t> (m_index.size ());
+
+  for (uint32_t i = 0; i < m_index.size (); i++)
+    {
+      WriteValue<uint32_t> (m_index[i].key.size ());
+      m_stream.write (m_index[i].key.data (), m_index[i].key.size ());
+      WriteValue<uint64_t> (m_index[i].offset);
+      WriteValue<uint64_t> (m_index[i].rows);
+    }
+
+  WriteValue<uint64_t> (indexOffset);
+  m_stream.write ("SATINDEX", 8);
+
+  if (!m_stream.good ())
+    {
+      NS_ABORT_MSG ("SatOutputBinaryTraceFile::Close - Writing the file failed");
+    }
+
+  m_stream.close ();
+  m_index.clear ();
+}
+
+} // namespace ns3
@@ -0,0 +1,123 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Frans Laakso <frans.laakso@magister.fi>
+ */
+
+#ifndef SAT_OUTPUT_BINARY_TRACE_FILE_H
+#define SAT_OUTPUT_BINARY_TRACE_FILE_H
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace ns3 {
+
+/**
+ * \ingroup satellite
+ *
+ * \brief Class for writing the traces of all the keys of an output trace
+ * container into a single binary columnar file. The file can be converted
+ * to the text trace files with ext-utils/convertBinaryTrace.py.
+ *
+ * File layout, all values in the native byte order:
+ * - header: magic "SATTRACE", uint32 version, uint32 number of columns,
+ *   uint8 type of each column (1 = double)
+ * - one block per key: uint64 number of rows, followed by the values of
+ *   each column, column after column
+ * - index: uint32 number of keys, for each key uint32 name length, name,
+ *   uint64 block offset and uint64 number of rows
+ * - footer: uint64 index offset, magic "SATINDEX"
+ */
+class SatOutputBinaryTraceFile
+{
+public:
+  /**
+   * \brief Column type of double values
+   */
+  static const uint8_t COLUMN_TYPE_DOUBLE = 1;
+
+  /**
+   * \brief Format version
+   */
+  static const uint32_t FORMAT_VERSION = 1;
+
+  /**
+   * \brief Constructor, opens the file and writes the header
+   * \param filename file name
+   * \param valuesInRow number of values in a row
+   */
+  SatOutputBinaryTraceFile (std::string filename, uint32_t valuesInRow);
+
+  /**
+   * \brief Destructor, closes the file if not closed
+   */
+  ~SatOutputBinaryTraceFile ();
+
+  /**
+   * \brief Function for writing the rows of a key as a block
+   * \param key key name
+   * \param rows value rows
+   */
+  void AddBlock (std::string key, const std::vector<std::vector<double> >& rows);
+
+  /**
+   * \brief Function for writing the index and closing the file
+   */
+  void Close ();
+
+private:
+  /**
+   * \brief Index entry of a block
+   */
+  typedef struct
+  {
+    std::string key;
+    uint64_t offset;
+    uint64_t rows;
+  } indexEntry_s;
+
+  /**
+   * \brief Function for writing a value in the native byte order
+   * \param value value
+   */
+  template <typename T>
+  void WriteValue (T value)
+  {
+    m_stream.write ((const char*)&value, sizeof (T));
+  }
+
+  /**
+   * \brief Output file stream
+   */
+  std::ofstream m_stream;
+
+  /**
+   * \brief Number of values in a row
+   */
+  uint32_t m_valuesInRow;
+
+  /**
+   * \brief Index of the written blocks
+   */
+  std::vector<indexEntry_s> m_index;
+};
+
+} // namespace ns3
+
+#endif /* SAT_OUTPUT_BINARY_TRACE_FILE_H */
@@ -22,6 +22,11 @@
 #include "ns3/log.h"
 #include "ns3/abort.h"
 #include "ns3/simulator.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
+#include "ns3/singleton.h"
+#include "satellite-output-fstream-writer.h"
+#include <sstream>
 
 NS_LOG_COMPONENT_DEFINE ("SatOutputFileStreamDoubleContainer");
 
@@ -32,7 +37,17 @@ SatOutputFileStreamDoubleContainer::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::SatOutputFileStreamDoubleContainer")
     .SetParent<Object> ()
-    .AddConstructor<SatOutputFileStreamDoubleContainer> ();
+    .AddConstructor<SatOutputFileStreamDoubleContainer> ()
+    .AddAttribute ("EnableStreaming",
+                   "Write the values to the file during the simulation in chunks instead of at the end.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&SatOutputFileStreamDoubleContainer::m_enableStreaming),
+                   MakeBooleanChecker ())
+    .AddAttribute ("StreamingChunkRows",
+                   "Number of rows in a chunk written by the background writer.",
+                   UintegerValue (4096),
+                   MakeUintegerAccessor (&SatOutputFileStreamDoubleContainer::m_streamingChunkRows),
+                   MakeUintegerChecker<uint32_t> (1));
   return tid;
 }
 
@@ -40,6 +55,11 @@ SatOutputFileStreamDoubleContainer::SatOutputFileStreamDoubleContainer (std::str
   : m_outputFileStreamWrapper (),
     m_outputFileStream (),
     m_container (),
+    m_enableStreaming (false),
+    m_streamingChunkRows (4096),
+    m_streamingChunk (NULL),
+    m_streamingFile (0),
+    m_streamingFileOpen (false),
     m_fileName (filename),
     m_fileMode (filemode),
     m_valuesInRow (valuesInRow),
@@ -59,6 +79,11 @@ SatOutputFileStreamDoubleContainer::SatOutputFileStreamDoubleContainer ()
   : m_outputFileStreamWrapper (),
     m_outputFileStream (),
     m_container (),
+    m_enableStreaming (),
+    m_streamingChunkRows (),
+    m_streamingChunk (NULL),
+    m_streamingFile (),
+    m_streamingFileOpen (),
     m_fileName (),
     m_fileMode (),
     m_valuesInRow (),
@@ -91,6 +116,24 @@ SatOutputFileStreamDoubleContainer::WriteContainerToFile ()
 {
   NS_LOG_FUNCTION (this);
 
+  if (m_enableStreaming)
+    {
+      if (!m_streamingFileOpen)
+        {
+          OpenStreamingFile ();
+        }
+
+      CloseStreamingFile ();
+
+      if (m_printFigure)
+        {
+          PrintFigure ();
+        }
+
+      Reset ();
+      return;
+    }
+
   OpenStream ();
 
   if (m_outputFileStream->is_open ())
@@ -125,14 +168,45 @@ SatOutputFileStreamDoubleContainer::WriteContainerToFile ()
   Reset ();
 }
 
+void
+SatOutputFileStreamDoubleContainer::WriteContainerToBinaryFile (SatOutputBinaryTraceFile& file)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_enableStreaming)
+    {
+      WriteContainerToFile ();
+      return;
+    }
+
+  std::string key = m_fileName.substr (m_fileName.find_last_of ('/') + 1);
+  file.AddBlock (key, m_container);
+
+  if (m_printFigure)
+    {
+      PrintFigure ();
+    }
+
+  Reset ();
+}
+
 void
 SatOutputFileStreamDoubleContainer::PrintFigure ()
 {
   NS_LOG_FUNCTION (this);
 
-  Gnuplot2dDataset dataset = GetGnuplotDataset ();
   Gnuplot plot = GetGnuplot ();
-  plot.AddDataset (dataset);
+
+  if (m_enableStreaming)
+    {
+      Gnuplot2dFunction function = GetGnuplotFileFunction ();
+      plot.AddDataset (function);
+    }
+  else
+    {
+      Gnuplot2dDataset dataset = GetGnuplotDataset ();
+      plot.AddDataset (dataset);
+    }
 
   std::string plotFileName = m_fileName + ".plt";
   std::ofstream plotFile (plotFileName.c_str ());
@@ -159,9 +233,65 @@ SatOutputFileStreamDoubleContainer::AddToContainer (std::vector<double> newItem)
       NS_FATAL_ERROR ("SatOutputFileStreamDoubleContainer::AddToContainer - Invalid vector size");
     }
 
+  if (m_enableStreaming)
+    {
+      if (!m_streamingFileOpen)
+        {
+          OpenStreamingFile ();
+        }
+
+      if (m_streamingChunk == NULL)
+        {
+          m_streamingChunk = new std::vector<double> ();
+          m_streamingChunk->reserve (m_streamingChunkRows * m_valuesInRow);
+        }
+
+      m_streamingChunk->insert (m_streamingChunk->end (), newItem.begin (), newItem.end ());
+
+      if (m_streamingChunk->size () >= m_streamingChunkRows * m_valuesInRow)
+        {
+          WriteChunk ();
+        }
+      return;
+    }
+
   m_container.push_back (newItem);
 }
 
+void
+SatOutputFileStreamDoubleContainer::WriteChunk ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_streamingChunk != NULL)
+    {
+      Singleton<SatOutputFileStreamWriter>::Get ()->Write (m_streamingFile, m_streamingChunk, m_valuesInRow);
+      m_streamingChunk = NULL;
+    }
+}
+
+void
+SatOutputFileStreamDoubleContainer::OpenStreamingFile ()
+{
+  NS_LOG_FUNCTION (this);
+
+  m_streamingFile = Singleton<SatOutputFileStreamWriter>::Get ()->OpenFile (m_fileName, m_fileMode);
+  m_streamingFileOpen = true;
+}
+
+void
+SatOutputFileStreamDoubleContainer::CloseStreamingFile ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_streamingFileOpen)
+    {
+      WriteChunk ();
+      Singleton<SatOutputFileStreamWriter>::Get ()->CloseFile (m_streamingFile);
+      m_streamingFileOpen = false;
+    }
+}
+
 void
 SatOutputFileStreamDoubleContainer::OpenStream ()
 {
@@ -185,6 +315,8 @@ SatOutputFileStreamDoubleContainer::ResetStream ()
 {
   NS_LOG_FUNCTION (this);
 
+  CloseStreamingFile ();
+
   if (m_outputFileStreamWrapper != NULL)
     {
       delete m_outputFileStreamWrapper;
@@ -213,6 +345,12 @@ SatOutputFileStreamDoubleContainer::ClearContainer ()
       m_container.clear ();
     }
 
+  if (m_streamingChunk != NULL)
+    {
+      delete m_streamingChunk;
+      m_streamingChunk = NULL;
+    }
+
   m_valuesInRow = 0;
 }
 
@@ -282,6 +420,96 @@ SatOutputFileStreamDoubleContainer::ConvertValue (double value)
   return -1;
 }
 
+Gnuplot2dFunction
+SatOutputFileStreamDoubleContainer::GetGnuplotFileFunction ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_valuesInRow != 2)
+    {
+      NS_ABORT_MSG ("SatOutputFileStreamDoubleContainer::GetGnuplotFileFunction - Figure output not implemented for " << m_valuesInRow << " columns.");
+    }
+
+  std::stringstream function;
+  function << "\"" << m_fileName << "\" using 1:";
+
+  switch (m_figureUnitConversionType)
+    {
+    case RAW:
+      {
+        function << "2";
+        break;
+      }
+    case DECIBEL:
+      {
+        function << "(10.0 * log10 ($2))";
+        break;
+      }
+    case DECIBEL_AMPLITUDE:
+      {
+        function << "(20.0 * log10 ($2))";
+        break;
+      }
+    default:
+      {
+        NS_ABORT_MSG ("SatOutputFileStreamDoubleContainer::GetGnuplotFileFunction - Invalid conversion type.");
+        break;
+      }
+    }
+
+  Gnuplot2dFunction ret (m_title, function.str ());
+
+  switch (m_style)
+    {
+    case Gnuplot2dDataset::LINES:
+      {
+        ret.SetExtra ("with lines");
+        break;
+      }
+    case Gnuplot2dDataset::POINTS:
+      {
+        ret.SetExtra ("with points");
+        break;
+      }
+    case Gnuplot2dDataset::LINES_POINTS:
+      {
+        ret.SetExtra ("with linespoints");
+        break;
+      }
+    case Gnuplot2dDataset::DOTS:
+      {
+        ret.SetExtra ("with dots");
+        break;
+      }
+    case Gnuplot2dDataset::IMPULSES:
+      {
+        ret.SetExtra ("with impulses");
+        break;
+      }
+    case Gnuplot2dDataset::STEPS:
+      {
+        ret.SetExtra ("with steps");
+        break;
+      }
+    case Gnuplot2dDataset::FSTEPS:
+      {
+        ret.SetExtra ("with fsteps");
+        break;
+      }
+    case Gnuplot2dDataset::HISTEPS:
+      {
+        ret.SetExtra ("with histeps");
+        break;
+      }
+    default:
+      {
+        break;
+      }
+    }
+
+  return ret;
+}
+
 Gnuplot
 SatOutputFileStreamDoubleContainer::GetGnuplot ()
 {
@@ -24,6 +24,7 @@
 #include <fstream>
 #include "ns3/object.h"
 #include "satellite-output-fstream-wrapper.h"
+#include "satellite-output-binary-trace-file.h"
 #include <ns3/gnuplot.h>
 
 namespace ns3 {
@@ -34,6 +35,11 @@ namespace ns3 {
  * \brief Class for output file stream container for double values.
  * The class implements storing the values and writing the stored
  * values into a file. A figure output in two dimensions is also supported.
+ *
+ * With streaming enabled, the values are collected into chunks of a fixed
+ * number of rows and each full chunk is written by a background writer
+ * thread during the simulation, so the memory use does not grow with the
+ * simulation length.
  */
 class SatOutputFileStreamDoubleContainer : public Object
 {
@@ -74,6 +80,14 @@ public:
    */
   void WriteContainerToFile ();
 
+  /**
+   * \brief Function for writing the container contents as a block of a binary
+   * trace file. The block key is the file name without the directory. Streamed
+   * containers have already written their values and are written as text.
+   * \param file binary trace file
+   */
+  void WriteContainerToBinaryFile (SatOutputBinaryTraceFile& file);
+
   /**
    * \brief Function for adding the values to container
    */
@@ -139,12 +153,35 @@ private:
    */
   Gnuplot2dDataset GetGnuplotDataset ();
 
+  /**
+   * \brief Function for creating a Gnuplot function plotting the written
+   * file, used when the values are streamed
+   * \return function
+   */
+  Gnuplot2dFunction GetGnuplotFileFunction ();
+
   /**
    * \brief Function for creating Gnuplots
    * \return Gnuplot
    */
   Gnuplot GetGnuplot ();
 
+  /**
+   * \brief Function for passing the current chunk to the background writer
+   */
+  void WriteChunk ();
+
+  /**
+   * \brief Function for opening the streamed file in the background writer
+   */
+  void OpenStreamingFile ();
+
+  /**
+   * \brief Function for writing the remaining streamed values and closing
+   * the streamed file after the background writer has written them
+   */
+  void CloseStreamingFile ();
+
   /**
    * \brief Pointer to output file stream wrapper
    */
@@ -160,6 +197,31 @@ private:
    */
   std::vector<std::vector<double> > m_container;
 
+  /**
+   * \brief Write the values to the file during the simulation in chunks
+   */
+  bool m_enableStreaming;
+
+  /**
+   * \brief Number of rows in a streamed chunk
+   */
+  uint32_t m_streamingChunkRows;
+
+  /**
+   * \brief Chunk being filled, row after row
+   */
+  std::vector<double>* m_streamingChunk;
+
+  /**
+   * \brief Handle of the streamed file in the background writer
+   */
+  uint32_t m_streamingFile;
+
+  /**
+   * \brief Is the streamed file open in the background writer
+   */
+  bool m_streamingFileOpen;
+
   /**
    * \brief File name
    */
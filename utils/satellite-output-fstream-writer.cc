@@ -0,0 +1,253 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Frans Laakso <frans.laakso@magister.fi>
+ */
+
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+#include "satellite-output-fstream-writer.h"
+
+NS_LOG_COMPONENT_DEFINE ("SatOutputFileStreamWriter");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (SatOutputFileStreamWriter);
+
+TypeId
+SatOutputFileStreamWriter::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::SatOutputFileStreamWriter")
+    .SetParent<Object> ()
+    .AddAttribute ("MaxQueuedChunks",
+                   "Maximum number of chunks of all the streamed containers queued or being written by the background writer.",
+                   UintegerValue (64),
+                   MakeUintegerAccessor (&SatOutputFileStreamWriter::m_maxQueuedChunks),
+                   MakeUintegerChecker<uint32_t> (1));
+  return tid;
+}
+
+TypeId
+SatOutputFileStreamWriter::GetInstanceTypeId (void) const
+{
+  NS_LOG_FUNCTION (this);
+
+  return GetTypeId ();
+}
+
+SatOutputFileStreamWriter::SatOutputFileStreamWriter ()
+  : m_maxQueuedChunks (64),
+    m_files (),
+    m_nextFile (0),
+    m_jobs (),
+    m_pendingChunks (0),
+    m_stopWriter (false),
+    m_writerStarted (false)
+{
+  NS_LOG_FUNCTION (this);
+
+  // Attributes are needed already in construction phase:
+  // - ConstructSelf call in constructor
+  // - GetInstanceTypeId needs to be implemented
+  ObjectBase::ConstructSelf (AttributeConstructionList ());
+}
+
+SatOutputFileStreamWriter::~SatOutputFileStreamWriter ()
+{
+  NS_LOG_FUNCTION (this);
+
+  StopWriter ();
+
+  for (std::map<uint32_t, outputFile_s>::iterator it = m_files.begin (); it != m_files.end (); ++it)
+    {
+      delete it->second.wrapper;
+    }
+  m_files.clear ();
+}
+
+uint32_t
+SatOutputFileStreamWriter::OpenFile (std::string fileName, std::ios::openmode fileMode)
+{
+  NS_LOG_FUNCTION (this << fileName << fileMode);
+
+  outputFile_s outputFile;
+  outputFile.wrapper = new SatOutputFileStreamWrapper (fileName, fileMode);
+  outputFile.pendingChunks = 0;
+
+  std::lock_guard<std::mutex> lock (m_mutex);
+
+  uint32_t file = m_nextFile++;
+  m_files[file] = outputFile;
+
+  if (!m_writerStarted)
+    {
+      m_stopWriter = false;
+      m_writerStarted = true;
+      m_writer = std::thread (&SatOutputFileStreamWriter::WriterLoop, this);
+    }
+
+  return file;
+}
+
+void
+SatOutputFileStreamWriter::Write (uint32_t file, std::vector<double>* chunk, uint32_t valuesInRow)
+{
+  NS_LOG_FUNCTION (this << file << chunk->size () << valuesInRow);
+
+  std::unique_lock<std::mutex> lock (m_mutex);
+
+  std::map<uint32_t, outputFile_s>::iterator it = m_files.find (file);
+
+  if (it == m_files.end ())
+    {
+      NS_FATAL_ERROR ("SatOutputFileStreamWriter::Write - File " << file << " is not open");
+    }
+
+  // budget used, wait for the writer to write a chunk
+  while (m_pendingChunks >= m_maxQueuedChunks)
+    {
+      m_jobDone.wait (lock);
+    }
+
+  writeJob_s job;
+  job.file = file;
+  job.chunk = chunk;
+  job.valuesInRow = valuesInRow;
+
+  m_jobs.push_back (job);
+  m_pendingChunks++;
+  it->second.pendingChunks++;
+
+  m_jobQueued.notify_one ();
+}
+
+void
+SatOutputFileStreamWriter::CloseFile (uint32_t file)
+{
+  NS_LOG_FUNCTION (this << file);
+
+  std::unique_lock<std::mutex> lock (m_mutex);
+
+  std::map<uint32_t, outputFile_s>::iterator it = m_files.find (file);
+
+  if (it == m_files.end ())
+    {
+      NS_FATAL_ERROR ("SatOutputFileStreamWriter::CloseFile - File " << file << " is not open");
+    }
+
+  while (it->second.pendingChunks > 0)
+    {
+      m_jobDone.wait (lock);
+    }
+
+  it->second.wrapper->GetStream ()->close ();
+  delete it->second.wrapper;
+  m_files.erase (it);
+}
+
+void
+SatOutputFileStreamWriter::Flush ()
+{
+  NS_LOG_FUNCTION (this);
+
+  std::unique_lock<std::mutex> lock (m_mutex);
+
+  while (m_pendingChunks > 0)
+    {
+      m_jobDone.wait (lock);
+    }
+}
+
+void
+SatOutputFileStreamWriter::StopWriter ()
+{
+  NS_LOG_FUNCTION (this);
+
+  {
+    std::lock_guard<std::mutex> lock (m_mutex);
+
+    if (!m_writerStarted)
+      {
+        return;
+      }
+
+    m_stopWriter = true;
+    m_jobQueued.notify_one ();
+  }
+
+  m_writer.join ();
+  m_writerStarted = false;
+}
+
+void
+SatOutputFileStreamWriter::WriterLoop ()
+{
+  std::unique_lock<std::mutex> lock (m_mutex);
+
+  while (true)
+    {
+      while (m_jobs.empty () && !m_stopWriter)
+        {
+          m_jobQueued.wait (lock);
+        }
+
+      if (m_jobs.empty ())
+        {
+          break;
+        }
+
+      writeJob_s job = m_jobs.front ();
+      m_jobs.pop_front ();
+
+      // the file is not closed while it has pending chunks
+      outputFile_s& outputFile = m_files[job.file];
+      std::ofstream* stream = outputFile.wrapper->GetStream ();
+
+      lock.unlock ();
+      WriteJob (stream, job);
+      lock.lock ();
+
+      outputFile.pendingChunks--;
+      m_pendingChunks--;
+
+      m_jobDone.notify_all ();
+    }
+}
+
+void
+SatOutputFileStreamWriter::WriteJob (std::ofstream* stream, const writeJob_s& job)
+{
+  const std::vector<double>& values = *job.chunk;
+
+  for (uint32_t i = 0; i < values.size (); i++)
+    {
+      *stream << values[i];
+
+      if ((i + 1) % job.valuesInRow == 0)
+        {
+          *stream << "\n";
+        }
+      else
+        {
+          *stream << "\t";
+        }
+    }
+
+  delete job.chunk;
+}
+
+} // namespace ns3
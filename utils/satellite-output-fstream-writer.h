@@ -0,0 +1,201 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Frans Laakso <frans.laakso@magister.fi>
+ */
+
+#ifndef SAT_OUTPUT_FSTREAM_WRITER_H
+#define SAT_OUTPUT_FSTREAM_WRITER_H
+
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <stdint.h>
+#include "ns3/object.h"
+#include "satellite-output-fstream-wrapper.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup satellite
+ *
+ * \brief Background writer for streamed output file stream containers.
+ * The writer owns the output files of all the streamed containers. The
+ * simulator thread passes chunks of value rows to the writer and a single
+ * writer thread formats and writes them to the files. The number of chunks
+ * queued or being written is limited by one budget shared by all the files;
+ * a producer exceeding the budget blocks until the writer has written a
+ * chunk, which bounds the memory used by the chunks.
+ *
+ * Used through Singleton<SatOutputFileStreamWriter>, only from the
+ * simulator thread.
+ */
+class SatOutputFileStreamWriter : public Object
+{
+public:
+  /**
+   * \brief NS-3 function for type id
+   * \return type id
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * \brief NS-3 function for instance type id
+   * \return type id
+   */
+  virtual TypeId GetInstanceTypeId (void) const;
+
+  /**
+   * \brief Constructor
+   */
+  SatOutputFileStreamWriter ();
+
+  /**
+   * \brief Destructor, writes the queued chunks, stops the writer thread
+   * and closes the open files
+   */
+  ~SatOutputFileStreamWriter ();
+
+  /**
+   * \brief Function for opening an output file
+   * \param fileName file name
+   * \param fileMode file mode
+   * \return file handle
+   */
+  uint32_t OpenFile (std::string fileName, std::ios::openmode fileMode);
+
+  /**
+   * \brief Function for queuing a chunk of rows to be written to a file.
+   * The writer takes the ownership of the chunk. Blocks while the chunk
+   * budget of the writer is used.
+   * \param file file handle
+   * \param chunk values of the rows, row after row
+   * \param valuesInRow number of values in a row
+   */
+  void Write (uint32_t file, std::vector<double>* chunk, uint32_t valuesInRow);
+
+  /**
+   * \brief Function for closing a file after its queued chunks have been written
+   * \param file file handle
+   */
+  void CloseFile (uint32_t file);
+
+  /**
+   * \brief Function for waiting until all the queued chunks have been written
+   */
+  void Flush ();
+
+private:
+  /**
+   * \brief Queued chunk
+   */
+  typedef struct
+  {
+    uint32_t file;
+    std::vector<double>* chunk;
+    uint32_t valuesInRow;
+  } writeJob_s;
+
+  /**
+   * \brief Open output file
+   */
+  typedef struct
+  {
+    SatOutputFileStreamWrapper* wrapper;
+    uint32_t pendingChunks;
+  } outputFile_s;
+
+  /**
+   * \brief Function for stopping the writer thread after the queue is empty
+   */
+  void StopWriter ();
+
+  /**
+   * \brief Writer thread loop
+   */
+  void WriterLoop ();
+
+  /**
+   * \brief Function for writing a chunk to a stream
+   * \param stream output stream
+   * \param job queued chunk
+   */
+  static void WriteJob (std::ofstream* stream, const writeJob_s& job);
+
+  /**
+   * \brief Maximum number of chunks of all the files queued or being written
+   */
+  uint32_t m_maxQueuedChunks;
+
+  /**
+   * \brief Open files by file handle
+   */
+  std::map<uint32_t, outputFile_s> m_files;
+
+  /**
+   * \brief Handle of the next opened file
+   */
+  uint32_t m_nextFile;
+
+  /**
+   * \brief Queued chunks
+   */
+  std::deque<writeJob_s> m_jobs;
+
+  /**
+   * \brief Number of chunks queued or being written
+   */
+  uint32_t m_pendingChunks;
+
+  /**
+   * \brief Is the writer thread requested to stop
+   */
+  bool m_stopWriter;
+
+  /**
+   * \brief Is the writer thread running
+   */
+  bool m_writerStarted;
+
+  /**
+   * \brief Mutex protecting the files, the queue and the counters
+   */
+  std::mutex m_mutex;
+
+  /**
+   * \brief Signaled when a chunk is queued or the writer is stopped
+   */
+  std::condition_variable m_jobQueued;
+
+  /**
+   * \brief Signaled when a chunk has been written
+   */
+  std::condition_variable m_jobDone;
+
+  /**
+   * \brief Writer thread
+   */
+  std::thread m_writer;
+};
+
+} // namespace ns3
+
+#endif /* SAT_OUTPUT_FSTREAM_WRITER_H */